@@ -0,0 +1,74 @@
+// bench/audio-data-copy-to.bench.ts
+// AudioData.copyTo() layout and sample-format conversion, 8 channels at 48 kHz
+import { afterAll, bench, describe } from 'vitest';
+import { AudioData } from '@pproenca/node-webcodecs';
+import type { AudioSampleFormat } from '@pproenca/node-webcodecs';
+
+const CHANNELS = 8;
+const SAMPLE_RATE = 48_000;
+const COPIES = 200;
+
+const BUFFERS: Record<string, number> = {
+  '10 ms': SAMPLE_RATE / 100,
+  '100 ms': SAMPLE_RATE / 10,
+};
+
+// [source format, destination format]
+const CASES: Array<[AudioSampleFormat, AudioSampleFormat]> = [
+  ['f32-planar', 'f32'],
+  ['f32', 'f32-planar'],
+  ['s16', 'f32-planar'],
+  ['f32-planar', 's16'],
+  ['s32', 'f32'],
+  ['f32', 'u8'],
+];
+
+function createAudioData(format: AudioSampleFormat, frames: number): AudioData {
+  const samples = frames * CHANNELS;
+  const data = format.startsWith('s16')
+    ? new Int16Array(samples).map((_, i) => (i * 31) & 0x7fff)
+    : format.startsWith('s32')
+      ? new Int32Array(samples).map((_, i) => i * 65_537)
+      : new Float32Array(samples).map((_, i) => Math.sin(i / 10));
+  return new AudioData({
+    format,
+    sampleRate: SAMPLE_RATE,
+    numberOfFrames: frames,
+    numberOfChannels: CHANNELS,
+    timestamp: 0,
+    data,
+  });
+}
+
+const throughput: Record<string, string> = {};
+
+for (const [label, frames] of Object.entries(BUFFERS)) {
+  describe(`${CHANNELS} ch ${label} (${frames} frames)`, () => {
+    for (const [from, to] of CASES) {
+      const audio = createAudioData(from, frames);
+      const planar = to.endsWith('-planar');
+      const planes = planar ? CHANNELS : 1;
+      const destination = new ArrayBuffer(audio.allocationSize({ planeIndex: 0, format: to }));
+
+      bench(
+        `${from} -> ${to}`,
+        () => {
+          const start = performance.now();
+          for (let n = 0; n < COPIES; n++) {
+            for (let planeIndex = 0; planeIndex < planes; planeIndex++) {
+              audio.copyTo(destination, { planeIndex, format: to });
+            }
+          }
+          const seconds = (performance.now() - start) / 1000;
+          const msamples = (COPIES * frames * CHANNELS) / seconds / 1e6;
+          throughput[`${label} ${from} -> ${to}`] = `${Math.round(msamples)} Msamples/s`;
+        },
+        { iterations: 10, time: 0 }
+      );
+    }
+  });
+}
+
+afterAll(() => {
+  console.table(throughput);
+});
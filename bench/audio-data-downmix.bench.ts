@@ -0,0 +1,59 @@
+// bench/audio-data-downmix.bench.ts
+// 7.1 decoder output mixed down to stereo: copying every channel out and
+// mixing in JS versus AudioData.copyTo({ channelLayout: 'stereo' }).
+import { bench, describe } from 'vitest';
+import { AudioData } from '@pproenca/node-webcodecs';
+
+const CHANNELS = 8;
+const FRAMES = 1024;
+const COPIES = 200;
+
+// Row-normalized 7.1 -> stereo (FL FR FC LFE BL BR SL SR), as libswresample builds it
+const C = Math.SQRT1_2;
+const NORM = 1 + 3 * C;
+const LEFT = [1, 0, C, 0, C, 0, C, 0].map((g) => g / NORM);
+const RIGHT = [0, 1, C, 0, 0, C, 0, C].map((g) => g / NORM);
+
+const audio = new AudioData({
+  format: 'f32-planar',
+  sampleRate: 48_000,
+  numberOfFrames: FRAMES,
+  numberOfChannels: CHANNELS,
+  timestamp: 0,
+  data: new Float32Array(FRAMES * CHANNELS).map((_, i) => Math.sin(i / 10)),
+});
+
+describe(`7.1 -> stereo, ${FRAMES} frames`, () => {
+  const planes = Array.from({ length: CHANNELS }, () => new Float32Array(FRAMES));
+  const mixed = new Float32Array(FRAMES * 2);
+
+  bench(
+    'copy all channels + JS mix',
+    () => {
+      for (let n = 0; n < COPIES; n++) {
+        for (let ch = 0; ch < CHANNELS; ch++) audio.copyTo(planes[ch], { planeIndex: ch });
+        for (let i = 0; i < FRAMES; i++) {
+          let l = 0;
+          let r = 0;
+          for (let ch = 0; ch < CHANNELS; ch++) {
+            l += LEFT[ch] * planes[ch][i];
+            r += RIGHT[ch] * planes[ch][i];
+          }
+          mixed[i * 2] = l;
+          mixed[i * 2 + 1] = r;
+        }
+      }
+    },
+    { iterations: 10, time: 0 }
+  );
+
+  bench(
+    "copyTo channelLayout 'stereo'",
+    () => {
+      for (let n = 0; n < COPIES; n++) {
+        audio.copyTo(mixed, { planeIndex: 0, format: 'f32', channelLayout: 'stereo' });
+      }
+    },
+    { iterations: 10, time: 0 }
+  );
+});
@@ -0,0 +1,75 @@
+// bench/audio-encoder-conversion.bench.ts
+// Opus encode throughput when AudioData has to be converted to the encoder's
+// sample format (s16), rate (48 kHz) or channel count on the worker
+import { bench, describe } from 'vitest';
+import { AudioData, AudioEncoder } from '@pproenca/node-webcodecs';
+import type { AudioSampleFormat } from '@pproenca/node-webcodecs';
+
+const SECONDS = 2;
+
+interface Input {
+  format: AudioSampleFormat;
+  sampleRate: number;
+  channels: number;
+}
+
+const INPUTS: Record<string, Input> = {
+  'matching (s16 48 kHz stereo)': { format: 's16', sampleRate: 48_000, channels: 2 },
+  'format (f32 48 kHz stereo)': { format: 'f32', sampleRate: 48_000, channels: 2 },
+  'format + rate (f32-planar 44.1 kHz stereo)': {
+    format: 'f32-planar',
+    sampleRate: 44_100,
+    channels: 2,
+  },
+  'channels (s16 48 kHz mono)': { format: 's16', sampleRate: 48_000, channels: 1 },
+};
+
+/** 10 ms of a 440 Hz tone in the requested layout. */
+function createInput(input: Input, index: number): AudioData {
+  const frames = input.sampleRate / 100;
+  const planar = input.format.endsWith('-planar');
+  const samples = input.format.startsWith('s16')
+    ? new Int16Array(frames * input.channels)
+    : new Float32Array(frames * input.channels);
+  const scale = samples instanceof Int16Array ? 8000 : 0.25;
+  for (let i = 0; i < frames; i++) {
+    const t = (index * frames + i) / input.sampleRate;
+    const value = scale * Math.sin(2 * Math.PI * 440 * t);
+    for (let ch = 0; ch < input.channels; ch++) {
+      samples[planar ? ch * frames + i : i * input.channels + ch] = value;
+    }
+  }
+  return new AudioData({
+    format: input.format,
+    sampleRate: input.sampleRate,
+    numberOfFrames: frames,
+    numberOfChannels: input.channels,
+    timestamp: index * 10_000,
+    data: samples,
+  });
+}
+
+describe(`opus encode, ${SECONDS} s of 10 ms AudioData`, () => {
+  for (const [name, input] of Object.entries(INPUTS)) {
+    const inputs = Array.from({ length: SECONDS * 100 }, (_, i) => createInput(input, i));
+
+    bench(
+      name,
+      async () => {
+        let error: Error | null = null;
+        const encoder = new AudioEncoder({
+          output: () => {},
+          error: (e) => {
+            error = e;
+          },
+        });
+        encoder.configure({ codec: 'opus', sampleRate: 48_000, numberOfChannels: 2 });
+        for (const data of inputs) encoder.encode(data);
+        await encoder.flush();
+        encoder.close();
+        if (error) throw error;
+      },
+      { iterations: 5, time: 0 }
+    );
+  }
+});
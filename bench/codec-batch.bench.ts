@@ -0,0 +1,79 @@
+// bench/codec-batch.bench.ts
+// JS-side submission cost per chunk: decode()/encode() per element vs
+// decodeBatch()/encodeBatch() with 16- and 256-element batches
+import { beforeAll, bench, describe } from 'vitest';
+import { AudioDecoder, AudioEncoder } from '@pproenca/node-webcodecs';
+import type { AudioData, AudioDecoderConfig, EncodedAudioChunk } from '@pproenca/node-webcodecs';
+import { createAudioData, encodeAudioStream } from './helpers.js';
+
+const COUNT = 4096;
+const BATCH_SIZES = [1, 16, 256];
+const opts = { iterations: 20, time: 0 };
+
+let decoderConfig: AudioDecoderConfig;
+let decoder: AudioDecoder;
+let encoder: AudioEncoder;
+const chunkBatches = new Map<number, EncodedAudioChunk[][]>();
+const audioBatches = new Map<number, AudioData[][]>();
+
+function split<T>(items: T[], size: number): T[][] {
+  const batches: T[][] = [];
+  for (let i = 0; i < items.length; i += size) batches.push(items.slice(i, i + size));
+  return batches;
+}
+
+beforeAll(async () => {
+  const stream = await encodeAudioStream(256);
+  decoderConfig = stream.decoderConfig;
+  // Repeat the packets so every run submits COUNT chunks
+  const chunks: EncodedAudioChunk[] = [];
+  const audio: AudioData[] = [];
+  for (let i = 0; i < COUNT; i++) {
+    chunks.push(stream.chunks[i % stream.chunks.length]);
+    audio.push(createAudioData(i));
+  }
+  for (const size of BATCH_SIZES) {
+    chunkBatches.set(size, split(chunks, size));
+    audioBatches.set(size, split(audio, size));
+  }
+
+  decoder = new AudioDecoder({ output: (data) => data.close(), error: () => {} });
+  encoder = new AudioEncoder({ output: () => {}, error: () => {} });
+});
+
+// Queued work is dropped by reset(); only the submission cost is measured
+describe(`AudioDecoder opus, ${COUNT} chunks per run`, () => {
+  for (const size of BATCH_SIZES) {
+    const name = size === 1 ? 'decode() per chunk' : `decodeBatch() x${size}`;
+    bench(
+      name,
+      () => {
+        decoder.configure(decoderConfig);
+        for (const batch of chunkBatches.get(size)!) {
+          if (size === 1) decoder.decode(batch[0]);
+          else decoder.decodeBatch(batch);
+        }
+        decoder.reset();
+      },
+      opts
+    );
+  }
+});
+
+describe(`AudioEncoder opus, ${COUNT} AudioData per run`, () => {
+  for (const size of BATCH_SIZES) {
+    const name = size === 1 ? 'encode() per AudioData' : `encodeBatch() x${size}`;
+    bench(
+      name,
+      () => {
+        encoder.configure({ codec: 'opus', sampleRate: 48_000, numberOfChannels: 2 });
+        for (const batch of audioBatches.get(size)!) {
+          if (size === 1) encoder.encode(batch[0]);
+          else encoder.encodeBatch(batch);
+        }
+        encoder.reset();
+      },
+      opts
+    );
+  }
+});
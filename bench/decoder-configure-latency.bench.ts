@@ -0,0 +1,48 @@
+// bench/decoder-configure-latency.bench.ts
+// Rendition-switch cost: configure() + decode of the first key frame, alternating
+// 1280x720 and 640x360 H.264, with the warm context cache disabled and enabled
+import { afterAll, beforeAll, bench, describe } from 'vitest';
+import { VideoDecoder } from '@pproenca/node-webcodecs';
+import { encodeStream, type EncodedStream } from './helpers.js';
+
+const opts = { iterations: 200, time: 0 };
+
+let renditions: EncodedStream[] = [];
+let decoder: VideoDecoder;
+let switches = 0;
+
+beforeAll(async () => {
+  renditions = [
+    await encodeStream({ codec: 'avc1.42E01E', width: 1280, height: 720, bitrate: 2_000_000 }, 1),
+    await encodeStream({ codec: 'avc1.42E01E', width: 640, height: 360, bitrate: 800_000 }, 1),
+  ];
+  decoder = new VideoDecoder({ output: (frame) => frame.close(), error: () => {} });
+});
+
+afterAll(() => {
+  decoder.close();
+  VideoDecoder.codecContextCache({ maxEntries: 4 });
+});
+
+async function switchRendition(): Promise<void> {
+  const { chunks, decoderConfig } = renditions[switches++ % renditions.length];
+  decoder.configure(decoderConfig);
+  decoder.decode(chunks[0]);
+  await decoder.flush();
+}
+
+describe('VideoDecoder rendition switch (configure + first frame)', () => {
+  bench('cold: maxEntries 0', switchRendition, {
+    ...opts,
+    setup: () => {
+      VideoDecoder.codecContextCache({ maxEntries: 0 });
+    },
+  });
+
+  bench('warm: maxEntries 4', switchRendition, {
+    ...opts,
+    setup: () => {
+      VideoDecoder.codecContextCache({ maxEntries: 4 });
+    },
+  });
+});
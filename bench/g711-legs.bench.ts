@@ -0,0 +1,60 @@
+// bench/g711-legs.bench.ts
+// Telephony bridge shape: many concurrent G.711 legs, each decoding 20 ms
+// ulaw packets. The inline path decodes on the JS thread; a minOutputDuration
+// of one packet keeps every leg on its worker thread for comparison.
+import { bench, describe } from 'vitest';
+import { AudioDecoder, EncodedAudioChunk } from '@pproenca/node-webcodecs';
+import type { NodeAudioDecoderConfig } from '@pproenca/node-webcodecs';
+
+const LEGS = 200;
+const PACKETS = 50; // 1 s per leg
+const FRAMES = 160; // 20 ms at 8 kHz
+
+const packets = Array.from(
+  { length: PACKETS },
+  (_, i) =>
+    new EncodedAudioChunk({
+      type: 'key',
+      timestamp: i * 20_000,
+      duration: 20_000,
+      data: new Uint8Array(FRAMES).map((_, n) => (i * 31 + n) & 0xff),
+    })
+);
+
+const CONFIGS: Record<string, NodeAudioDecoderConfig> = {
+  inline: { codec: 'ulaw', sampleRate: 8000, numberOfChannels: 1 },
+  'worker thread': {
+    codec: 'ulaw',
+    sampleRate: 8000,
+    numberOfChannels: 1,
+    minOutputDuration: 20_000,
+  },
+};
+
+describe(`${LEGS} ulaw legs, ${PACKETS} x 20 ms packets each`, () => {
+  for (const [name, config] of Object.entries(CONFIGS)) {
+    bench(
+      name,
+      async () => {
+        let error: Error | null = null;
+        const decoders = Array.from({ length: LEGS }, () => {
+          const decoder = new AudioDecoder({
+            output: (data) => data.close(),
+            error: (e) => {
+              error = e;
+            },
+          });
+          decoder.configure(config);
+          return decoder;
+        });
+        for (const packet of packets) {
+          for (const decoder of decoders) decoder.decode(packet);
+        }
+        await Promise.all(decoders.map((decoder) => decoder.flush()));
+        for (const decoder of decoders) decoder.close();
+        if (error) throw error;
+      },
+      { iterations: 5, time: 0 }
+    );
+  }
+});
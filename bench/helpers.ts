@@ -0,0 +1,245 @@
+// bench/helpers.ts
+// Shared fixtures for vitest benchmarks (run with `npm run bench`)
+import { AudioData, AudioEncoder, VideoEncoder, VideoFrame } from '@pproenca/node-webcodecs';
+import type {
+  AudioDecoderConfig,
+  EncodedAudioChunk,
+  EncodedVideoChunk,
+  NodeVideoEncoderConfig,
+  NodeVideoEncoderEncodeOptions,
+  VideoDecoderConfig,
+} from '@pproenca/node-webcodecs';
+
+/** Build an I420 buffer with a moving gradient so encoders see real motion. */
+export function createI420Data(width: number, height: number, seed: number): Uint8Array {
+  const ySize = width * height;
+  const uvSize = (width / 2) * (height / 2);
+  const data = new Uint8Array(ySize + uvSize * 2);
+  for (let y = 0; y < height; y++) {
+    for (let x = 0; x < width; x++) {
+      data[y * width + x] = (x + y + seed * 3) & 0xff;
+    }
+  }
+  data.fill(128, ySize, ySize + uvSize);
+  data.fill((seed * 7) & 0xff, ySize + uvSize);
+  return data;
+}
+
+export function createI420Frame(
+  width: number,
+  height: number,
+  index: number,
+  frameDurationUs = 33_333
+): VideoFrame {
+  return new VideoFrame(createI420Data(width, height, index), {
+    format: 'I420',
+    codedWidth: width,
+    codedHeight: height,
+    timestamp: index * frameDurationUs,
+    duration: frameDurationUs,
+  });
+}
+
+export interface EncodeResult {
+  chunks: number;
+  bytes: number;
+}
+
+/**
+ * Encode `frameCount` synthetic frames and wait for flush.
+ * `options` lets callers attach per-frame encode options.
+ */
+export async function encodeClip(
+  config: NodeVideoEncoderConfig,
+  frameCount: number,
+  options: (index: number) => NodeVideoEncoderEncodeOptions = (i) => ({ keyFrame: i === 0 })
+): Promise<EncodeResult> {
+  const result: EncodeResult = { chunks: 0, bytes: 0 };
+  let error: Error | null = null;
+  const encoder = new VideoEncoder({
+    output: (chunk) => {
+      result.chunks++;
+      result.bytes += chunk.byteLength;
+    },
+    error: (e) => {
+      error = e;
+    },
+  });
+  encoder.configure(config);
+  for (let i = 0; i < frameCount; i++) {
+    const frame = createI420Frame(config.width, config.height, i);
+    encoder.encode(frame, options(i));
+    frame.close();
+  }
+  await encoder.flush();
+  encoder.close();
+  if (error) throw error;
+  return result;
+}
+
+/** Bits per second for a clip of `frameCount` frames at `framerate`. */
+export function bitrateOf(result: EncodeResult, frameCount: number, framerate: number): number {
+  return (result.bytes * 8 * framerate) / frameCount;
+}
+
+export interface EncodedStream {
+  chunks: EncodedVideoChunk[];
+  decoderConfig: VideoDecoderConfig;
+}
+
+/** Encode a synthetic clip once and keep the chunks for decode benchmarks. */
+export async function encodeStream(
+  config: NodeVideoEncoderConfig,
+  frameCount: number
+): Promise<EncodedStream> {
+  const chunks: EncodedVideoChunk[] = [];
+  let decoderConfig: VideoDecoderConfig | undefined;
+  const encoder = new VideoEncoder({
+    output: (chunk, metadata) => {
+      chunks.push(chunk);
+      decoderConfig ??= metadata?.decoderConfig;
+    },
+    error: (e) => {
+      throw e;
+    },
+  });
+  encoder.configure(config);
+  for (let i = 0; i < frameCount; i++) {
+    const frame = createI420Frame(config.width, config.height, i);
+    encoder.encode(frame, { keyFrame: i === 0 });
+    frame.close();
+  }
+  await encoder.flush();
+  encoder.close();
+  return { chunks, decoderConfig: decoderConfig ?? { codec: config.codec } };
+}
+
+/** 20 ms of 48 kHz stereo f32 sine (440 Hz) starting at sample `index * 960`. */
+export function createAudioData(index: number, frames = 960): AudioData {
+  const sampleRate = 48_000;
+  const data = new Float32Array(frames * 2);
+  for (let i = 0; i < frames; i++) {
+    const t = (index * frames + i) / sampleRate;
+    data[i * 2] = data[i * 2 + 1] = 0.25 * Math.sin(2 * Math.PI * 440 * t);
+  }
+  return new AudioData({
+    format: 'f32',
+    sampleRate,
+    numberOfFrames: frames,
+    numberOfChannels: 2,
+    timestamp: Math.round((index * frames * 1_000_000) / sampleRate),
+    data,
+  });
+}
+
+export interface EncodedAudioStream {
+  chunks: EncodedAudioChunk[];
+  decoderConfig: AudioDecoderConfig;
+}
+
+/** Encode `count` 20 ms opus packets once and keep them for decode benchmarks. */
+export async function encodeAudioStream(count: number): Promise<EncodedAudioStream> {
+  const chunks: EncodedAudioChunk[] = [];
+  let decoderConfig: AudioDecoderConfig | undefined;
+  const encoder = new AudioEncoder({
+    output: (chunk, metadata) => {
+      chunks.push(chunk);
+      decoderConfig ??= metadata?.decoderConfig;
+    },
+    error: (e) => {
+      throw e;
+    },
+  });
+  encoder.configure({ codec: 'opus', sampleRate: 48_000, numberOfChannels: 2, bitrate: 64_000 });
+  for (let i = 0; i < count; i++) {
+    const data = createAudioData(i);
+    encoder.encode(data);
+    data.close();
+  }
+  await encoder.flush();
+  encoder.close();
+  return {
+    chunks,
+    decoderConfig: decoderConfig ?? { codec: 'opus', sampleRate: 48_000, numberOfChannels: 2 },
+  };
+}
+
+/**
+ * Build an animated GIF (256-gray palette, looping) in memory. Pixel data is
+ * written as uncompressed LZW (a clear code every 250 literals), which keeps
+ * the writer tiny and makes decode cost, not decompression, dominate.
+ */
+export function createAnimatedGif(width: number, height: number, frames: number): Uint8Array {
+  const bytes: number[] = [];
+  const u16 = (v: number) => bytes.push(v & 0xff, (v >> 8) & 0xff);
+
+  bytes.push(...Buffer.from('GIF89a'));
+  u16(width);
+  u16(height);
+  bytes.push(0xf7, 0, 0); // Global color table, 256 entries
+  for (let i = 0; i < 256; i++) bytes.push(i, i, i);
+  // NETSCAPE2.0 application extension: loop forever
+  bytes.push(0x21, 0xff, 0x0b, ...Buffer.from('NETSCAPE2.0'), 0x03, 0x01, 0, 0, 0);
+
+  for (let f = 0; f < frames; f++) {
+    bytes.push(0x21, 0xf9, 0x04, 0x04); // Graphic control: dispose "do not dispose"
+    u16(4); // 40 ms
+    bytes.push(0, 0);
+    bytes.push(0x2c);
+    u16(0);
+    u16(0);
+    u16(width);
+    u16(height);
+    bytes.push(0, 8); // No local color table; LZW minimum code size 8
+
+    // 9-bit codes, LSB first
+    const data: number[] = [];
+    let acc = 0;
+    let bits = 0;
+    const emit = (code: number) => {
+      acc |= code << bits;
+      bits += 9;
+      while (bits >= 8) {
+        data.push(acc & 0xff);
+        acc >>= 8;
+        bits -= 8;
+      }
+    };
+    for (let i = 0; i < width * height; i++) {
+      if (i % 250 === 0) emit(256); // Clear
+      const x = i % width;
+      const y = Math.floor(i / width);
+      emit((x + y + f * 3) & 0xff);
+    }
+    emit(257); // End of information
+    if (bits > 0) data.push(acc & 0xff);
+    for (let i = 0; i < data.length; i += 255) {
+      const block = data.slice(i, i + 255);
+      bytes.push(block.length, ...block);
+    }
+    bytes.push(0);
+  }
+  bytes.push(0x3b);
+  return Uint8Array.from(bytes);
+}
+
+/** Uncompressed 24-bit BMP with a diagonal gradient (54-byte header + pixels). */
+export function createBmp(width: number, height: number): Uint8Array {
+  const rowSize = Math.ceil((width * 3) / 4) * 4;
+  const data = new Uint8Array(54 + rowSize * height);
+  const view = new DataView(data.buffer);
+  data.set([0x42, 0x4d]); // "BM"
+  view.setUint32(2, data.length, true);
+  view.setUint32(10, 54, true); // Pixel data offset
+  view.setUint32(14, 40, true); // BITMAPINFOHEADER
+  view.setInt32(18, width, true);
+  view.setInt32(22, height, true);
+  view.setUint16(26, 1, true); // Planes
+  view.setUint16(28, 24, true); // Bits per pixel
+  view.setUint32(34, rowSize * height, true);
+  for (let y = 0; y < height; y++) {
+    const row = 54 + y * rowSize;
+    for (let x = 0; x < width * 3; x++) data[row + x] = (x + y) & 0xff;
+  }
+  return data;
+}
@@ -0,0 +1,49 @@
+// bench/image-decoder-file-source.bench.ts
+// Large local image: reading the file into JS and passing the bytes, versus
+// the non-standard `data: {path}` source that the native layer memory-maps
+import { readFileSync, rmSync, writeFileSync } from 'node:fs';
+import { tmpdir } from 'node:os';
+import { join } from 'node:path';
+import { afterAll, beforeAll, bench, describe } from 'vitest';
+import { ImageDecoder } from '@pproenca/node-webcodecs';
+import type { NodeImageDecoderInit } from '@pproenca/node-webcodecs';
+import { createBmp } from './helpers.js';
+
+const opts = { iterations: 5, time: 0 };
+
+let path: string;
+
+beforeAll(() => {
+  path = join(tmpdir(), `webcodecs-bench-${process.pid}.bmp`);
+  writeFileSync(path, createBmp(8192, 8192)); // 192 MiB
+});
+
+afterAll(() => {
+  rmSync(path, { force: true });
+});
+
+async function decodeOnce(init: NodeImageDecoderInit): Promise<void> {
+  const decoder = new ImageDecoder(init);
+  await decoder.completed;
+  const { image } = await decoder.decode();
+  image.close();
+  decoder.close();
+}
+
+describe('ImageDecoder, 8192x8192 BMP from a local file', () => {
+  bench(
+    'readFileSync + BufferSource',
+    async () => {
+      await decodeOnce({ data: readFileSync(path), type: 'image/bmp' });
+    },
+    opts
+  );
+
+  bench(
+    'data: {path} (mmap)',
+    async () => {
+      await decodeOnce({ data: { path }, type: 'image/bmp' });
+    },
+    opts
+  );
+});
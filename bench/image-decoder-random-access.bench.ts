@@ -0,0 +1,60 @@
+// bench/image-decoder-random-access.bench.ts
+// Scrubbing an animated GIF: decode({frameIndex}) in random order on a fresh
+// decoder (first pass builds the frame index and cache) and on a warm one
+import { afterAll, beforeAll, bench, describe } from 'vitest';
+import { ImageDecoder } from '@pproenca/node-webcodecs';
+import { createAnimatedGif } from './helpers.js';
+
+const FRAMES = 300;
+const DECODES = 100;
+const opts = { iterations: 5, time: 0 };
+
+let gif: Uint8Array;
+let order: number[];
+let warm: ImageDecoder;
+
+// Deterministic shuffle so runs are comparable
+function randomOrder(count: number, length: number): number[] {
+  let seed = 12345;
+  const out: number[] = [];
+  for (let i = 0; i < count; i++) {
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    out.push(seed % length);
+  }
+  return out;
+}
+
+async function decodeInOrder(decoder: ImageDecoder, indices: number[]): Promise<void> {
+  for (const frameIndex of indices) {
+    const { image } = await decoder.decode({ frameIndex });
+    image.close();
+  }
+}
+
+beforeAll(async () => {
+  gif = createAnimatedGif(320, 180, FRAMES);
+  order = randomOrder(DECODES, FRAMES);
+
+  warm = new ImageDecoder({ data: gif, type: 'image/gif' });
+  await warm.tracks.ready;
+  await decodeInOrder(warm, Array.from({ length: FRAMES }, (_, i) => i));
+});
+
+afterAll(() => {
+  warm.close();
+});
+
+describe(`ImageDecoder GIF ${FRAMES} frames, ${DECODES} random decodes`, () => {
+  bench(
+    'fresh decoder',
+    async () => {
+      const decoder = new ImageDecoder({ data: gif, type: 'image/gif' });
+      await decoder.tracks.ready;
+      await decodeInOrder(decoder, order);
+      decoder.close();
+    },
+    opts
+  );
+
+  bench('warm decoder (frames cached)', () => decodeInOrder(warm, order), opts);
+});
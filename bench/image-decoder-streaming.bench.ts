@@ -0,0 +1,46 @@
+// bench/image-decoder-streaming.bench.ts
+// Streaming ingestion: a ~50 MB image delivered through a ReadableStream in
+// 16 KB chunks, timed until `completed` resolves and the image is decoded
+import { beforeAll, bench, describe } from 'vitest';
+import { ImageDecoder } from '@pproenca/node-webcodecs';
+import { createBmp } from './helpers.js';
+
+const CHUNK_SIZE = 16 * 1024;
+const opts = { iterations: 5, time: 0 };
+
+let image: Uint8Array;
+
+beforeAll(() => {
+  image = createBmp(4096, 4096); // 48 MiB of pixels
+});
+
+function chunkedStream(data: Uint8Array, chunkSize: number): ReadableStream<Uint8Array> {
+  let offset = 0;
+  return new ReadableStream({
+    pull(controller) {
+      if (offset >= data.length) {
+        controller.close();
+        return;
+      }
+      controller.enqueue(data.subarray(offset, offset + chunkSize));
+      offset += chunkSize;
+    },
+  });
+}
+
+describe(`ImageDecoder streaming, 4096x4096 BMP in ${CHUNK_SIZE / 1024} KB chunks`, () => {
+  bench(
+    'ingest + decode',
+    async () => {
+      const decoder = new ImageDecoder({
+        data: chunkedStream(image, CHUNK_SIZE) as unknown as BufferSource,
+        type: 'image/bmp',
+      });
+      await decoder.completed;
+      const { image: frame } = await decoder.decode();
+      frame.close();
+      decoder.close();
+    },
+    opts
+  );
+});
@@ -0,0 +1,71 @@
+// bench/is-config-supported.bench.ts
+// 10,000 isConfigSupported() calls per run, as issued by compatibility shims
+// probing a matrix of codec strings at session start
+import { bench, describe } from 'vitest';
+import { AudioDecoder, AudioEncoder, VideoDecoder, VideoEncoder } from '@pproenca/node-webcodecs';
+
+const CALLS = 10_000;
+const opts = { iterations: 10, time: 0 };
+
+const VIDEO_CODECS = ['avc1.42E01E', 'avc1.64001F', 'vp8', 'vp09.00.10.08', 'av01.0.04M.08'];
+const AUDIO_CODECS = ['opus', 'mp4a.40.2', 'flac', 'mp3', 'pcm-s16le'];
+
+describe(`isConfigSupported, ${CALLS} calls per run`, () => {
+  bench(
+    'VideoDecoder',
+    async () => {
+      const pending: Promise<unknown>[] = [];
+      for (let i = 0; i < CALLS; i++) {
+        const codec = VIDEO_CODECS[i % VIDEO_CODECS.length];
+        pending.push(
+          VideoDecoder.isConfigSupported({ codec, codedWidth: 1280, codedHeight: 720 })
+        );
+      }
+      await Promise.all(pending);
+    },
+    opts
+  );
+
+  bench(
+    'VideoEncoder',
+    async () => {
+      const pending: Promise<unknown>[] = [];
+      for (let i = 0; i < CALLS; i++) {
+        const codec = VIDEO_CODECS[i % VIDEO_CODECS.length];
+        pending.push(VideoEncoder.isConfigSupported({ codec, width: 1280, height: 720 }));
+      }
+      await Promise.all(pending);
+    },
+    opts
+  );
+
+  bench(
+    'AudioDecoder',
+    async () => {
+      const pending: Promise<unknown>[] = [];
+      for (let i = 0; i < CALLS; i++) {
+        const codec = AUDIO_CODECS[i % AUDIO_CODECS.length];
+        pending.push(
+          AudioDecoder.isConfigSupported({ codec, sampleRate: 48_000, numberOfChannels: 2 })
+        );
+      }
+      await Promise.all(pending);
+    },
+    opts
+  );
+
+  bench(
+    'AudioEncoder',
+    async () => {
+      const pending: Promise<unknown>[] = [];
+      for (let i = 0; i < CALLS; i++) {
+        const codec = AUDIO_CODECS[i % AUDIO_CODECS.length];
+        pending.push(
+          AudioEncoder.isConfigSupported({ codec, sampleRate: 48_000, numberOfChannels: 2 })
+        );
+      }
+      await Promise.all(pending);
+    },
+    opts
+  );
+});
@@ -0,0 +1,66 @@
+// bench/opus-complexity.bench.ts
+// Conferencing shape: many concurrent Opus voice streams in low-delay mode
+// with 10 ms frames. Compares per-stream encode cost across libopus
+// complexity settings; lower complexity trades quality for CPU.
+import { bench, describe } from 'vitest';
+import { AudioData, AudioEncoder } from '@pproenca/node-webcodecs';
+import type { NodeAudioEncoderConfig } from '@pproenca/node-webcodecs';
+
+const STREAMS = 50;
+const FRAMES = 100; // 1 s per stream
+const SAMPLES = 480; // 10 ms at 48 kHz
+
+const input = Array.from({ length: FRAMES }, (_, i) => {
+  const samples = new Float32Array(SAMPLES);
+  for (let n = 0; n < SAMPLES; n++) {
+    samples[n] = 0.25 * Math.sin((2 * Math.PI * 220 * (i * SAMPLES + n)) / 48000);
+  }
+  return samples;
+});
+
+function config(complexity: number): NodeAudioEncoderConfig {
+  return {
+    codec: 'opus',
+    sampleRate: 48000,
+    numberOfChannels: 1,
+    bitrate: 24_000,
+    opus: { application: 'lowdelay', frameDuration: 10_000, complexity },
+  };
+}
+
+describe(`${STREAMS} Opus streams, ${FRAMES} x 10 ms frames each`, () => {
+  for (const complexity of [0, 5, 10]) {
+    bench(
+      `complexity ${complexity}`,
+      async () => {
+        let error: Error | null = null;
+        const encoders = Array.from({ length: STREAMS }, () => {
+          const encoder = new AudioEncoder({
+            output: () => {},
+            error: (e) => {
+              error = e;
+            },
+          });
+          encoder.configure(config(complexity));
+          return encoder;
+        });
+        for (let i = 0; i < FRAMES; i++) {
+          const data = new AudioData({
+            format: 'f32',
+            sampleRate: 48000,
+            numberOfFrames: SAMPLES,
+            numberOfChannels: 1,
+            timestamp: i * 10_000,
+            data: input[i],
+          });
+          for (const encoder of encoders) encoder.encode(data);
+          data.close();
+        }
+        await Promise.all(encoders.map((encoder) => encoder.flush()));
+        for (const encoder of encoders) encoder.close();
+        if (error) throw error;
+      },
+      { iterations: 5, time: 0 }
+    );
+  }
+});
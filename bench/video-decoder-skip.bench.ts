@@ -0,0 +1,46 @@
+// bench/video-decoder-skip.bench.ts
+// Thumbnailing throughput: full decode vs skipFrames "nonref"/"nonkey"
+import { beforeAll, bench, describe } from 'vitest';
+import { VideoDecoder } from '@pproenca/node-webcodecs';
+import type { NodeVideoDecoderConfig } from '@pproenca/node-webcodecs';
+import { encodeStream, type EncodedStream } from './helpers.js';
+
+const FRAMES = 300;
+let stream: EncodedStream;
+
+beforeAll(async () => {
+  // High profile with B-frames so "nonref" has frames to skip; 1 s GOP
+  stream = await encodeStream(
+    { codec: 'avc1.640028', width: 1280, height: 720, bitrate: 3_000_000, framerate: 30 },
+    FRAMES
+  );
+});
+
+async function decodeAll(extra: Partial<NodeVideoDecoderConfig>): Promise<number> {
+  let frames = 0;
+  const decoder = new VideoDecoder({
+    output: (frame) => {
+      frames++;
+      frame.close();
+    },
+    error: (e) => {
+      throw e;
+    },
+  });
+  decoder.configure({ ...stream.decoderConfig, ...extra });
+  for (const chunk of stream.chunks) decoder.decode(chunk);
+  await decoder.flush();
+  decoder.close();
+  return frames;
+}
+
+describe(`1280x720 avc, ${FRAMES} frames`, () => {
+  const opts = { iterations: 5, time: 0 };
+  bench('full decode', () => decodeAll({}).then(() => undefined), opts);
+  bench('skipFrames=nonref', () => decodeAll({ skipFrames: 'nonref' }).then(() => undefined), opts);
+  bench(
+    'skipFrames=nonkey + skipLoopFilter',
+    () => decodeAll({ skipFrames: 'nonkey', skipLoopFilter: true }).then(() => undefined),
+    opts
+  );
+});
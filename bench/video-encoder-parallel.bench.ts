@@ -0,0 +1,34 @@
+// bench/video-encoder-parallel.bench.ts
+// Wall-clock for an offline 1080p encode with 1 vs N parallel closed-GOP segments.
+// Clip length defaults to 10 s; BENCH_DURATION_S=600 reproduces the 10-minute job.
+import os from 'node:os';
+import { bench, describe } from 'vitest';
+import { encodeClip } from './helpers.js';
+
+const FRAMERATE = 30;
+const DURATION_S = Number(process.env.BENCH_DURATION_S ?? 10);
+const FRAMES = DURATION_S * FRAMERATE;
+const MAX_SEGMENTS = Math.max(2, Math.min(16, Math.floor(os.cpus().length / 4)));
+
+describe(`1920x1080 ${DURATION_S}s avc (quality)`, () => {
+  for (const segments of [1, 2, MAX_SEGMENTS]) {
+    bench(
+      `parallelSegments=${segments}`,
+      async () => {
+        await encodeClip(
+          {
+            codec: 'avc1.640028',
+            width: 1920,
+            height: 1080,
+            bitrate: 6_000_000,
+            framerate: FRAMERATE,
+            latencyMode: 'quality',
+            parallelSegments: segments,
+          },
+          FRAMES
+        );
+      },
+      { iterations: 1, time: 0 }
+    );
+  }
+});
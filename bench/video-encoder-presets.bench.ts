@@ -0,0 +1,48 @@
+// bench/video-encoder-presets.bench.ts
+// Encode throughput (fps) and resulting bitrate across codecs and latency modes
+import { afterAll, bench, describe } from 'vitest';
+import type { NodeVideoEncoderConfig } from '@pproenca/node-webcodecs';
+import { bitrateOf, encodeClip } from './helpers.js';
+
+const WIDTH = 640;
+const HEIGHT = 360;
+const FRAMERATE = 30;
+const FRAMES = 60;
+
+const CODECS = ['avc1.42E01E', 'vp8', 'vp09.00.10.08', 'av01.0.04M.08'];
+
+const MODES: Record<string, Partial<NodeVideoEncoderConfig>> = {
+  quality: { latencyMode: 'quality' },
+  realtime: { latencyMode: 'realtime' },
+  'quality speed=10': { latencyMode: 'quality', encoderSpeed: 10 },
+};
+
+const bitrates: Record<string, string> = {};
+
+for (const codec of CODECS) {
+  describe(codec, () => {
+    for (const [mode, overrides] of Object.entries(MODES)) {
+      const config: NodeVideoEncoderConfig = {
+        codec,
+        width: WIDTH,
+        height: HEIGHT,
+        bitrate: 1_000_000,
+        framerate: FRAMERATE,
+        ...overrides,
+      };
+      bench(
+        `${mode} (${FRAMES} frames)`,
+        async () => {
+          const result = await encodeClip(config, FRAMES);
+          const kbps = Math.round(bitrateOf(result, FRAMES, FRAMERATE) / 1000);
+          bitrates[`${codec} ${mode}`] = `${kbps} kbps`;
+        },
+        { iterations: 3, time: 0 }
+      );
+    }
+  });
+}
+
+afterAll(() => {
+  console.table(bitrates);
+});
@@ -0,0 +1,45 @@
+// bench/video-encoder-quantizer.bench.ts
+// Encode throughput with externally driven per-frame QP versus internal VBR
+import { bench, describe } from 'vitest';
+import type { NodeVideoEncoderEncodeOptions } from '@pproenca/node-webcodecs';
+import { encodeClip } from './helpers.js';
+
+const WIDTH = 640;
+const HEIGHT = 360;
+const FRAMES = 60;
+
+const CODECS: Array<{ codec: string; key: 'avc' | 'hevc' | 'vp9' | 'av1'; qp: number }> = [
+  { codec: 'avc1.42E01E', key: 'avc', qp: 28 },
+  { codec: 'vp09.00.10.08', key: 'vp9', qp: 32 },
+  { codec: 'av01.0.04M.08', key: 'av1', qp: 32 },
+];
+
+for (const { codec, key, qp } of CODECS) {
+  describe(codec, () => {
+    const base = { codec, width: WIDTH, height: HEIGHT, framerate: 30 };
+
+    bench(
+      'variable bitrate',
+      async () => {
+        await encodeClip({ ...base, bitrate: 1_000_000, bitrateMode: 'variable' }, FRAMES);
+      },
+      { iterations: 3, time: 0 }
+    );
+
+    bench(
+      'quantizer (per-frame QP)',
+      async () => {
+        await encodeClip(
+          { ...base, bitrateMode: 'quantizer' },
+          FRAMES,
+          (i): NodeVideoEncoderEncodeOptions => ({
+            keyFrame: i === 0,
+            // Simple external rate control: coarser QP on non-key frames
+            [key]: { quantizer: i === 0 ? qp - 4 : qp },
+          })
+        );
+      },
+      { iterations: 3, time: 0 }
+    );
+  });
+}
@@ -12,6 +12,7 @@
         "src/audio_decoder.cpp",
         "src/video_decoder.cpp",
         "src/audio_encoder.cpp",
+        "src/audio_mixer.cpp",
         "src/video_encoder.cpp",
         "src/encoded_audio_chunk.cpp",
         "src/encoded_video_chunk.cpp",
@@ -49,7 +50,7 @@
               "MACOSX_DEPLOYMENT_TARGET": "15.0"
             },
             "libraries": [
-              "<!@(pkg-config --libs libavformat libavcodec libswscale libavutil 2>/dev/null || echo '-lavformat -lavcodec -lswscale -lavutil')",
+              "<!@(pkg-config --libs libavformat libavcodec libswscale libswresample libavutil 2>/dev/null || echo '-lavformat -lavcodec -lswscale -lswresample -lavutil')",
               "-framework CoreFoundation",
               "-framework CoreMedia",
               "-framework CoreVideo",
@@ -70,7 +71,7 @@
               "-fPIC"
             ],
             "libraries": [
-              "<!@(pkg-config --libs libavformat libavcodec libswscale libavutil 2>/dev/null || echo '-lavformat -lavcodec -lswscale -lavutil')",
+              "<!@(pkg-config --libs libavformat libavcodec libswscale libswresample libavutil 2>/dev/null || echo '-lavformat -lavcodec -lswscale -lswresample -lavutil')",
               "-lpthread",
               "-ldl"
             ]
@@ -97,6 +98,7 @@
               "<(ffmpeg_root)/lib/avformat.lib",
               "<(ffmpeg_root)/lib/avcodec.lib",
               "<(ffmpeg_root)/lib/swscale.lib",
+              "<(ffmpeg_root)/lib/swresample.lib",
               "<(ffmpeg_root)/lib/avutil.lib"
             ]
           }
@@ -6,10 +6,14 @@
 import { createRequire } from 'node:module';
 import type {
   AllowSharedBufferSource,
-  AudioDataCopyToOptions,
   AudioDataInit,
   AudioSampleFormat,
 } from '../types/webcodecs.js';
+import type {
+  AudioBufferPoolOptions,
+  AudioBufferPoolStats,
+  NodeAudioDataCopyToOptions,
+} from './extensions.js';
 
 // Native binding loader - require() necessary for native addons in ESM
 // See: https://nodejs.org/api/esm.html#interoperability-with-commonjs
@@ -24,8 +28,8 @@ interface NativeAudioData {
   readonly numberOfChannels: number;
   readonly duration: number;
   readonly timestamp: number;
-  allocationSize(options: AudioDataCopyToOptions): number;
-  copyTo(destination: AllowSharedBufferSource, options: AudioDataCopyToOptions): void;
+  allocationSize(options: NodeAudioDataCopyToOptions): number;
+  copyTo(destination: AllowSharedBufferSource, options: NodeAudioDataCopyToOptions): void;
   clone(): AudioData;
   close(): void;
 }
@@ -33,6 +37,7 @@ interface NativeAudioData {
 /** Native constructor interface for AudioData */
 interface NativeAudioDataConstructor {
   new (init: AudioDataInit): NativeAudioData;
+  bufferPool(options?: AudioBufferPoolOptions): AudioBufferPoolStats;
 }
 
 export class AudioData {
@@ -62,10 +67,10 @@ export class AudioData {
     return this.native.timestamp;
   }
 
-  allocationSize(options: AudioDataCopyToOptions): number {
+  allocationSize(options: NodeAudioDataCopyToOptions): number {
     return this.native.allocationSize(options);
   }
-  copyTo(destination: AllowSharedBufferSource, options: AudioDataCopyToOptions): void {
+  copyTo(destination: AllowSharedBufferSource, options: NodeAudioDataCopyToOptions): void {
     this.native.copyTo(destination, options);
   }
   clone(): AudioData {
@@ -74,4 +79,15 @@ export class AudioData {
   close(): void {
     this.native.close();
   }
+
+  /**
+   * Non-standard: configure the process-wide pool of audio sample buffers
+   * (shared by AudioData, AudioDecoder and AudioEncoder) and return its counters.
+   * Buffers are keyed by sample format, channel count and number of frames and
+   * recycled when the AudioData or codec frame holding them is released.
+   */
+  static bufferPool(options?: AudioBufferPoolOptions): AudioBufferPoolStats {
+    const NativeClass = bindings.AudioData as NativeAudioDataConstructor;
+    return NativeClass.bufferPool(options);
+  }
 }
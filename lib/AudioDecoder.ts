@@ -12,6 +12,12 @@ import type {
   EncodedAudioChunk,
   EventHandler,
 } from '../types/webcodecs.js';
+import type {
+  AudioCodecStats,
+  CodecContextCacheOptions,
+  CodecContextCacheStats,
+  NodeAudioDecoderConfig,
+} from './extensions.js';
 
 // Native binding loader - require() necessary for native addons in ESM
 // See: https://nodejs.org/api/esm.html#interoperability-with-commonjs
@@ -22,9 +28,11 @@ const bindings = require('bindings')('webcodecs');
 interface NativeAudioDecoder {
   readonly state: CodecState;
   readonly decodeQueueSize: number;
+  readonly stats: AudioCodecStats;
   ondequeue: EventHandler;
-  configure(config: AudioDecoderConfig): void;
+  configure(config: NodeAudioDecoderConfig): void;
   decode(chunk: EncodedAudioChunk): void;
+  decodeBatch(chunks: EncodedAudioChunk[]): void;
   flush(): Promise<void>;
   reset(): void;
   close(): void;
@@ -34,6 +42,7 @@ interface NativeAudioDecoder {
 interface NativeAudioDecoderConstructor {
   new (init: AudioDecoderInit): NativeAudioDecoder;
   isConfigSupported(config: AudioDecoderConfig): Promise<AudioDecoderSupport>;
+  codecContextCache(options?: CodecContextCacheOptions): CodecContextCacheStats;
 }
 
 export class AudioDecoder {
@@ -50,6 +59,10 @@ export class AudioDecoder {
   get decodeQueueSize(): number {
     return this.native.decodeQueueSize;
   }
+  /** Non-standard: sample buffer counters since the last configure(). */
+  get stats(): AudioCodecStats {
+    return this.native.stats;
+  }
   get ondequeue(): EventHandler {
     return this.native.ondequeue;
   }
@@ -58,7 +71,7 @@ export class AudioDecoder {
     this.native.ondequeue = value;
   }
 
-  configure(config: AudioDecoderConfig): void {
+  configure(config: NodeAudioDecoderConfig): void {
     this.native.configure(config);
   }
   decode(chunk: EncodedAudioChunk): void {
@@ -67,6 +80,14 @@ export class AudioDecoder {
     const nativeChunk = (chunk as { native?: unknown }).native ?? chunk;
     this.native.decode(nativeChunk);
   }
+  /**
+   * Non-standard: decode() for each chunk in order, enqueued in one native call.
+   * If a chunk is invalid, the chunks before it stay queued and the error is thrown.
+   */
+  decodeBatch(chunks: EncodedAudioChunk[]): void {
+    const nativeChunks = chunks.map((chunk) => (chunk as { native?: unknown }).native ?? chunk);
+    this.native.decodeBatch(nativeChunks as EncodedAudioChunk[]);
+  }
   flush(): Promise<void> {
     return this.native.flush();
   }
@@ -81,4 +102,15 @@ export class AudioDecoder {
     const NativeClass = bindings.AudioDecoder as NativeAudioDecoderConstructor;
     return NativeClass.isConfigSupported(config);
   }
+
+  /**
+   * Non-standard: configure the process-wide cache of warm decoder contexts
+   * (shared by VideoDecoder and AudioDecoder) and return its counters.
+   * configure() adopts a cached context when codec, description, size/sample
+   * rate and channels match, skipping avcodec_open2().
+   */
+  static codecContextCache(options?: CodecContextCacheOptions): CodecContextCacheStats {
+    const NativeClass = bindings.AudioDecoder as NativeAudioDecoderConstructor;
+    return NativeClass.codecContextCache(options);
+  }
 }
@@ -12,6 +12,7 @@ import type {
   CodecState,
   EventHandler,
 } from '../types/webcodecs.js';
+import type { AudioCodecStats, NodeAudioEncoderConfig } from './extensions.js';
 
 // Native binding loader - require() necessary for native addons in ESM
 // See: https://nodejs.org/api/esm.html#interoperability-with-commonjs
@@ -22,9 +23,11 @@ const bindings = require('bindings')('webcodecs');
 interface NativeAudioEncoder {
   readonly state: CodecState;
   readonly encodeQueueSize: number;
+  readonly stats: AudioCodecStats;
   ondequeue: EventHandler;
-  configure(config: AudioEncoderConfig): void;
+  configure(config: NodeAudioEncoderConfig): void;
   encode(data: AudioData): void;
+  encodeBatch(data: AudioData[]): void;
   flush(): Promise<void>;
   reset(): void;
   close(): void;
@@ -50,6 +53,10 @@ export class AudioEncoder {
   get encodeQueueSize(): number {
     return this.native.encodeQueueSize;
   }
+  /** Non-standard: sample buffer counters since the last configure(). */
+  get stats(): AudioCodecStats {
+    return this.native.stats;
+  }
   get ondequeue(): EventHandler {
     return this.native.ondequeue;
   }
@@ -58,7 +65,7 @@ export class AudioEncoder {
     this.native.ondequeue = value;
   }
 
-  configure(config: AudioEncoderConfig): void {
+  configure(config: NodeAudioEncoderConfig): void {
     this.native.configure(config);
   }
   /**
@@ -79,6 +86,13 @@ export class AudioEncoder {
   encode(data: AudioData): void {
     this.native.encode(data);
   }
+  /**
+   * Non-standard: encode() for each AudioData in order, enqueued in one native call.
+   * If an element is invalid, the ones before it stay queued and the error is thrown.
+   */
+  encodeBatch(data: AudioData[]): void {
+    this.native.encodeBatch(data);
+  }
   flush(): Promise<void> {
     return this.native.flush();
   }
@@ -0,0 +1,97 @@
+/**
+ * AudioMixer - TypeScript wrapper for the non-standard native AudioMixer
+ *
+ * Mixes AudioData from any number of named sources into one stream: inputs
+ * are resampled and remixed to the configured format, aligned on their
+ * timestamps and summed on a worker thread. Mixed blocks are f32-planar
+ * AudioData of `frameDuration` microseconds.
+ */
+
+import { createRequire } from 'node:module';
+import type {
+  AudioData,
+  AudioDataOutputCallback,
+  CodecState,
+  WebCodecsErrorCallback,
+} from '../types/webcodecs.js';
+import type { AudioMixerConfig, AudioMixerInit } from './extensions.js';
+
+// Native binding loader - require() necessary for native addons in ESM
+// See: https://nodejs.org/api/esm.html#interoperability-with-commonjs
+const require = createRequire(import.meta.url);
+const bindings = require('bindings')('webcodecs');
+
+/** Native binding interface for AudioMixer - matches C++ NAPI class shape */
+interface NativeAudioMixer {
+  readonly state: CodecState;
+  configure(config: AudioMixerConfig): void;
+  push(source: string, data: AudioData): void;
+  removeSource(source: string): void;
+  flush(): Promise<void>;
+  reset(): void;
+  close(): void;
+}
+
+/** Native constructor interface for AudioMixer */
+interface NativeAudioMixerConstructor {
+  new (init: { output: AudioDataOutputCallback; error: WebCodecsErrorCallback }): NativeAudioMixer;
+}
+
+export class AudioMixer {
+  private readonly native: NativeAudioMixer;
+
+  constructor(init: AudioMixerInit) {
+    const { encoder, error } = init;
+    if (encoder && init.output) {
+      throw new TypeError('AudioMixerInit takes either output or encoder, not both');
+    }
+
+    // Feeding an encoder skips a JS round trip per block for the caller; the
+    // encoder clones the samples, so the mixed AudioData is closed right away
+    const output: AudioDataOutputCallback | undefined = encoder
+      ? (data) => {
+          try {
+            encoder.encode(data);
+          } catch (e) {
+            error(e as DOMException);
+          } finally {
+            data.close();
+          }
+        }
+      : init.output;
+
+    const NativeClass = bindings.AudioMixer as NativeAudioMixerConstructor;
+    this.native = new NativeClass({ output: output as AudioDataOutputCallback, error });
+  }
+
+  get state(): CodecState {
+    return this.native.state;
+  }
+
+  configure(config: AudioMixerConfig): void {
+    this.native.configure(config);
+  }
+  /**
+   * Add audio from `source` at `data.timestamp`. Sources appear on their
+   * first push; `data` is cloned and may be closed after this call returns.
+   * Gaps in a source's timestamps are mixed as silence up to 1 s; after a
+   * longer jump the source restarts there and its unmixed audio is dropped.
+   */
+  push(source: string, data: AudioData): void {
+    this.native.push(source, data);
+  }
+  /** Mix what `source` has buffered, then stop waiting for it. */
+  removeSource(source: string): void {
+    this.native.removeSource(source);
+  }
+  /** Mix everything buffered without waiting out maxLatency. */
+  flush(): Promise<void> {
+    return this.native.flush();
+  }
+  reset(): void {
+    this.native.reset();
+  }
+  close(): void {
+    this.native.close();
+  }
+}
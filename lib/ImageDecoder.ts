@@ -10,6 +10,7 @@ import type {
   ImageDecoderInit,
   ImageTrackList,
 } from '../types/webcodecs.js';
+import type { NodeImageDecoderInit } from './extensions.js';
 
 // Native binding loader - require() necessary for native addons in ESM
 // See: https://nodejs.org/api/esm.html#interoperability-with-commonjs
@@ -29,14 +30,14 @@ interface NativeImageDecoder {
 
 /** Native constructor interface for ImageDecoder */
 interface NativeImageDecoderConstructor {
-  new (init: ImageDecoderInit): NativeImageDecoder;
+  new (init: ImageDecoderInit | NodeImageDecoderInit): NativeImageDecoder;
   isTypeSupported(type: string): Promise<boolean>;
 }
 
 export class ImageDecoder {
   private readonly native: NativeImageDecoder;
 
-  constructor(init: ImageDecoderInit) {
+  constructor(init: ImageDecoderInit | NodeImageDecoderInit) {
     const NativeClass = bindings.ImageDecoder as NativeImageDecoderConstructor;
     this.native = new NativeClass(init);
   }
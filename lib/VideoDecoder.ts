@@ -5,6 +5,7 @@
 
 import { createRequire } from 'node:module';
 import type {
+  BufferSource,
   CodecState,
   EncodedVideoChunk,
   EventHandler,
@@ -12,6 +13,11 @@ import type {
   VideoDecoderInit,
   VideoDecoderSupport,
 } from '../types/webcodecs.js';
+import type {
+  CodecContextCacheOptions,
+  CodecContextCacheStats,
+  NodeVideoDecoderConfig,
+} from './extensions.js';
 
 // Native binding loader - require() necessary for native addons in ESM
 // See: https://nodejs.org/api/esm.html#interoperability-with-commonjs
@@ -23,17 +29,20 @@ interface NativeVideoDecoder {
   readonly state: CodecState;
   readonly decodeQueueSize: number;
   ondequeue: EventHandler;
-  configure(config: VideoDecoderConfig): void;
+  configure(config: NodeVideoDecoderConfig): void;
   decode(chunk: EncodedVideoChunk): void;
+  decodeBatch(chunks: EncodedVideoChunk[]): void;
   flush(): Promise<void>;
   reset(): void;
   close(): void;
+  registerOutputBuffers(buffers: BufferSource[]): void;
 }
 
 /** Native constructor interface for VideoDecoder */
 interface NativeVideoDecoderConstructor {
   new (init: VideoDecoderInit): NativeVideoDecoder;
   isConfigSupported(config: VideoDecoderConfig): Promise<VideoDecoderSupport>;
+  codecContextCache(options?: CodecContextCacheOptions): CodecContextCacheStats;
 }
 
 export class VideoDecoder {
@@ -58,12 +67,19 @@ export class VideoDecoder {
     this.native.ondequeue = value;
   }
 
-  configure(config: VideoDecoderConfig): void {
+  configure(config: NodeVideoDecoderConfig): void {
     this.native.configure(config);
   }
   decode(chunk: EncodedVideoChunk): void {
     this.native.decode(chunk);
   }
+  /**
+   * Non-standard: decode() for each chunk in order, enqueued in one native call.
+   * If a chunk is invalid, the chunks before it stay queued and the error is thrown.
+   */
+  decodeBatch(chunks: EncodedVideoChunk[]): void {
+    this.native.decodeBatch(chunks);
+  }
   flush(): Promise<void> {
     return this.native.flush();
   }
@@ -74,8 +90,38 @@ export class VideoDecoder {
     this.native.close();
   }
 
+  /**
+   * Non-standard: decode into caller-supplied buffers (bring your own buffer).
+   *
+   * Requires a configuration with `outputFormat` and `outputSize`. Each buffer
+   * must hold one frame in that layout with planes packed back to back. Output
+   * frames reference the buffer they were written into; the buffer is reused
+   * once every frame referencing it is closed, and decoding waits while all
+   * buffers are in use. Views over a SharedArrayBuffer are accepted. Pass an
+   * empty array to unregister.
+   *
+   * The decoder writes into registered memory from its worker thread: do not
+   * detach or transfer a registered buffer (postMessage transfer lists,
+   * `ArrayBuffer.prototype.transfer()`) until it is unregistered and every
+   * frame written into it is closed. Detached buffers are rejected here.
+   */
+  registerOutputBuffers(buffers: BufferSource[]): void {
+    this.native.registerOutputBuffers(buffers);
+  }
+
   static isConfigSupported(config: VideoDecoderConfig): Promise<VideoDecoderSupport> {
     const NativeClass = bindings.VideoDecoder as NativeVideoDecoderConstructor;
     return NativeClass.isConfigSupported(config);
   }
+
+  /**
+   * Non-standard: configure the process-wide cache of warm decoder contexts
+   * (shared by VideoDecoder and AudioDecoder) and return its counters.
+   * configure() adopts a cached context when codec, description, size/sample
+   * rate and channels match, skipping avcodec_open2().
+   */
+  static codecContextCache(options?: CodecContextCacheOptions): CodecContextCacheStats {
+    const NativeClass = bindings.VideoDecoder as NativeVideoDecoderConstructor;
+    return NativeClass.codecContextCache(options);
+  }
 }
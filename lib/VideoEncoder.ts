@@ -7,12 +7,15 @@ import { createRequire } from 'node:module';
 import type {
   CodecState,
   EventHandler,
-  VideoEncoderConfig,
-  VideoEncoderEncodeOptions,
   VideoEncoderInit,
   VideoEncoderSupport,
   VideoFrame as VideoFrameType,
 } from '../types/webcodecs.js';
+import type {
+  NodeVideoEncoderConfig,
+  NodeVideoEncoderEncodeOptions,
+  VideoEncoderStats,
+} from './extensions.js';
 import { VideoFrame } from './VideoFrame.js';
 
 // Native binding loader - require() necessary for native addons in ESM
@@ -24,9 +27,14 @@ const bindings = require('bindings')('webcodecs');
 interface NativeVideoEncoder {
   readonly state: CodecState;
   readonly encodeQueueSize: number;
+  readonly stats: VideoEncoderStats;
   ondequeue: EventHandler;
-  configure(config: VideoEncoderConfig): void;
-  encode(frame: VideoFrame, options: VideoEncoderEncodeOptions): void;
+  configure(config: NodeVideoEncoderConfig): void;
+  encode(frame: VideoFrame, options: NodeVideoEncoderEncodeOptions): void;
+  encodeBatch(
+    frames: VideoFrame[],
+    options?: NodeVideoEncoderEncodeOptions | NodeVideoEncoderEncodeOptions[]
+  ): void;
   flush(): Promise<void>;
   reset(): void;
   close(): void;
@@ -35,7 +43,7 @@ interface NativeVideoEncoder {
 /** Native constructor interface for VideoEncoder */
 interface NativeVideoEncoderConstructor {
   new (init: VideoEncoderInit): NativeVideoEncoder;
-  isConfigSupported(config: VideoEncoderConfig): Promise<VideoEncoderSupport>;
+  isConfigSupported(config: NodeVideoEncoderConfig): Promise<VideoEncoderSupport>;
 }
 
 export class VideoEncoder {
@@ -52,6 +60,10 @@ export class VideoEncoder {
   get encodeQueueSize(): number {
     return this.native.encodeQueueSize;
   }
+  /** Non-standard: encoded/dropped frame counters since the last configure(). */
+  get stats(): VideoEncoderStats {
+    return this.native.stats;
+  }
   get ondequeue(): EventHandler {
     return this.native.ondequeue;
   }
@@ -60,7 +72,7 @@ export class VideoEncoder {
     this.native.ondequeue = value;
   }
 
-  configure(config: VideoEncoderConfig): void {
+  configure(config: NodeVideoEncoderConfig): void {
     this.native.configure(config);
   }
   /**
@@ -73,18 +85,32 @@ export class VideoEncoder {
    * the async encoding process.
    *
    * @param frame - The VideoFrame to encode. May be closed after this call returns.
-   * @param options - Encoding options, including keyFrame hint.
+   * @param options - Encoding options, including keyFrame hint and, with
+   *   bitrateMode "quantizer", the codec-specific per-frame quantizer.
    * @throws {InvalidStateError} If encoder state is not "configured".
    * @throws {TypeError} If frame is detached.
    * @throws {DataError} If frame orientation doesn't match active orientation.
    *
    * @see https://www.w3.org/TR/webcodecs/#dom-videoencoder-encode
    */
-  encode(frame: VideoFrame, options: VideoEncoderEncodeOptions): void {
+  encode(frame: VideoFrame, options: NodeVideoEncoderEncodeOptions): void {
     // Extract native object from wrapper if present (for TypeScript wrapper classes)
     const nativeFrame = (frame as { native?: unknown }).native ?? frame;
     this.native.encode(nativeFrame, options);
   }
+  /**
+   * Non-standard: encode() for each frame in order, enqueued in one native call.
+   *
+   * @param options - Applied to every frame, or an array with one entry per frame.
+   * If a frame is invalid, the frames before it stay queued and the error is thrown.
+   */
+  encodeBatch(
+    frames: VideoFrame[],
+    options?: NodeVideoEncoderEncodeOptions | NodeVideoEncoderEncodeOptions[]
+  ): void {
+    const nativeFrames = frames.map((frame) => (frame as { native?: unknown }).native ?? frame);
+    this.native.encodeBatch(nativeFrames as VideoFrame[], options);
+  }
   flush(): Promise<void> {
     return this.native.flush();
   }
@@ -95,7 +121,7 @@ export class VideoEncoder {
     this.native.close();
   }
 
-  static isConfigSupported(config: VideoEncoderConfig): Promise<VideoEncoderSupport> {
+  static isConfigSupported(config: NodeVideoEncoderConfig): Promise<VideoEncoderSupport> {
     const NativeClass = bindings.VideoEncoder as NativeVideoEncoderConstructor;
     return NativeClass.isConfigSupported(config);
   }
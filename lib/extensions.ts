@@ -0,0 +1,252 @@
+/**
+ * Extensions to the WebCodecs dictionaries.
+ *
+ * These members are accepted by the native layer in addition to the W3C
+ * dictionaries in types/webcodecs.d.ts (which is generated from the core
+ * WebIDL and must not be edited by hand). They are either defined by the
+ * WebCodecs Codec Registry or are node-webcodecs specific; browsers ignore
+ * unknown members, so configs using them remain portable.
+ */
+
+import type {
+  AudioData,
+  AudioDataCopyToOptions,
+  AudioDataOutputCallback,
+  AudioDecoderConfig,
+  AudioEncoderConfig,
+  ImageDecoderInit,
+  VideoDecoderConfig,
+  VideoEncoderConfig,
+  VideoEncoderEncodeOptions,
+  VideoPixelFormat,
+  WebCodecsErrorCallback,
+} from '../types/webcodecs.js';
+
+/** VideoEncoderConfig with node-webcodecs extensions. */
+export interface NodeVideoEncoderConfig extends VideoEncoderConfig {
+  /**
+   * Encoder speed hint from 0 (best compression) to 10 (fastest).
+   * Mapped onto x264/x265 `preset`, libvpx/libaom `cpu-used` and SVT-AV1 `preset`.
+   * When omitted, `latencyMode: "realtime"` selects a fast realtime preset.
+   */
+  encoderSpeed?: number;
+  /** Opt-in frame dropping for live sources where latency matters more than completeness. */
+  frameDropPolicy?: VideoEncoderFrameDropPolicy;
+  /**
+   * Offline split-and-stitch: encode this many closed-GOP segments concurrently
+   * on separate encoder instances. Requires `latencyMode: "quality"`.
+   * Output order, timestamps and the single decoderConfig are unchanged.
+   */
+  parallelSegments?: number;
+}
+
+/** Drops the oldest pending non-key frames; key frames are never dropped. */
+export interface VideoEncoderFrameDropPolicy {
+  /** Drop when encodeQueueSize would exceed this many frames. */
+  maxQueueSize?: number;
+  /** Drop when the previous frame took longer than one frame interval to encode. */
+  dropWhenLate?: boolean;
+}
+
+/** Counters returned by the non-standard `VideoEncoder.stats` getter (since last configure). */
+export interface VideoEncoderStats {
+  encodedFrames: number;
+  droppedFrames: number;
+  droppedFramesQueue: number;
+  droppedFramesLate: number;
+}
+
+/**
+ * Codec registry quantizer extension (used with `bitrateMode: "quantizer"`).
+ * Only avc and hevc are honored: `bitrateMode: "quantizer"` is not supported
+ * for av1 and vp9, whose encoders cannot change the quantizer per frame.
+ */
+export interface VideoEncoderQuantizerOptions {
+  /** 0-51 for avc/hevc (0-63 for av1/vp9 in the registry). */
+  quantizer?: number;
+}
+
+/**
+ * VideoEncoderEncodeOptions with the codec registry per-frame extensions.
+ * @see https://www.w3.org/TR/webcodecs-avc-codec-registration/#videoencoderencodeoptions-extensions
+ */
+export interface NodeVideoEncoderEncodeOptions extends VideoEncoderEncodeOptions {
+  av1?: VideoEncoderQuantizerOptions;
+  vp9?: VideoEncoderQuantizerOptions;
+  avc?: VideoEncoderQuantizerOptions;
+  hevc?: VideoEncoderQuantizerOptions;
+}
+
+/** VideoDecoderConfig with node-webcodecs fast-decode and worker-side output extensions. */
+export interface NodeVideoDecoderConfig extends VideoDecoderConfig {
+  /**
+   * Frames the decoder may discard: `"nonref"` skips non-reference frames,
+   * `"nonkey"` decodes key frames only. Output frames keep their timestamps.
+   */
+  skipFrames?: 'none' | 'nonref' | 'nonkey';
+  /** Skip in-loop deblocking; faster at the cost of blocking artifacts. */
+  skipLoopFilter?: boolean;
+  /** Decode at 1/2^lowres resolution (0-3) where the decoder supports it. */
+  lowres?: number;
+  /** Convert decoded frames to this pixel format on the decoder worker thread. */
+  outputFormat?: VideoPixelFormat;
+  /** Scale decoded frames to this size on the decoder worker thread. */
+  outputSize?: { width: number; height: number };
+}
+
+/**
+ * Opus encoder options.
+ * @see https://www.w3.org/TR/webcodecs-opus-codec-registration/#opus-encoder-config
+ */
+export interface OpusEncoderConfig {
+  /** Chunk framing; only `"opus"` (raw packets) is supported. */
+  format?: 'opus' | 'ogg';
+  /** Accepted for compatibility; libavcodec's libopus wrapper has no signal option. */
+  signal?: 'auto' | 'music' | 'voice';
+  /**
+   * `"voip"` favours speech intelligibility, `"lowdelay"` drops the speech
+   * modes for minimum delay.
+   */
+  application?: 'voip' | 'audio' | 'lowdelay';
+  /** Microseconds: 2500, 5000, 10000, 20000 (default), 40000, 60000, 80000, 100000 or 120000. */
+  frameDuration?: number;
+  /** 0-10; lower values cut encode CPU (about 3x over the range) at some quality cost. */
+  complexity?: number;
+  /** Expected packet loss percentage (0-100); tunes in-band FEC. */
+  packetlossperc?: number;
+  useinbandfec?: boolean;
+  /** Discontinuous transmission: tiny packets during silence. */
+  usedtx?: boolean;
+}
+
+/**
+ * AAC encoder options.
+ * @see https://www.w3.org/TR/webcodecs-aac-codec-registration/#aac-encoder-config
+ */
+export interface AacEncoderConfig {
+  /** `"adts"`: every chunk carries an ADTS header and decoderConfig has no description. */
+  format?: 'aac' | 'adts';
+}
+
+/** AudioEncoderConfig with the codec registry `opus` and `aac` members. */
+export interface NodeAudioEncoderConfig extends AudioEncoderConfig {
+  opus?: OpusEncoderConfig;
+  aac?: AacEncoderConfig;
+}
+
+/** AudioDecoderConfig with node-webcodecs worker-side output extensions. */
+export interface NodeAudioDecoderConfig extends AudioDecoderConfig {
+  /**
+   * Merge contiguous decoded frames into AudioData covering at least this many
+   * microseconds (0-10000000). Reduces output callbacks for small-frame codecs
+   * such as Opus; a timestamp gap or format change emits what is pending.
+   */
+  minOutputDuration?: number;
+  /**
+   * Conceal lost packets (0-10000000 microseconds, default 0: off). A decoded
+   * frame starting up to this long after the previous one ended is preceded
+   * by concealment AudioData covering the gap: the end of the last frame
+   * faded out, then silence. Starts within 1 ms of the expected timestamp
+   * are snapped to it; longer gaps restart the timeline.
+   */
+  maxConcealedGap?: number;
+}
+
+/**
+ * Counters returned by the non-standard `AudioDecoder.stats` / `AudioEncoder.stats`
+ * getters: sample buffers this codec took from the process-wide pool since the
+ * last configure().
+ */
+export interface AudioCodecStats {
+  bufferAcquisitions: number;
+  /** Acquisitions the pool could not serve from a recycled buffer. */
+  bufferAllocations: number;
+  bufferAllocationsPerSecond: number;
+}
+
+/** AudioDataCopyToOptions with node-webcodecs channel remixing. */
+export interface NodeAudioDataCopyToOptions extends AudioDataCopyToOptions {
+  /**
+   * Down/upmix or reorder channels while copying, e.g. `"stereo"` from 5.1 or
+   * 7.1 audio. Accepts FFmpeg layout names (`"mono"`, `"stereo"`, `"5.1"`,
+   * `"7.1"`, ...) and channel lists (`"FR+FL"` swaps a stereo pair).
+   * `planeIndex` and the allocation size then refer to the destination
+   * layout's channels; remixed outputs are normalized so they cannot clip.
+   */
+  channelLayout?: string;
+}
+
+/**
+ * Init for the non-standard `AudioMixer`. Mixed blocks go to `output`, or are
+ * passed to `encoder.encode()` and closed when an encoder is given instead.
+ */
+export interface AudioMixerInit {
+  output?: AudioDataOutputCallback;
+  /** An AudioEncoder configured for the mixer's sampleRate and numberOfChannels. */
+  encoder?: { encode(data: AudioData): void };
+  error: WebCodecsErrorCallback;
+}
+
+/** Configuration for the non-standard `AudioMixer`. */
+export interface AudioMixerConfig {
+  /** Output sample rate (1-768000); inputs are resampled to it. */
+  sampleRate: number;
+  /** Output channels (1-255); inputs are remixed to FFmpeg's default layout for the count. */
+  numberOfChannels: number;
+  /** Microseconds per mixed AudioData (default 20000). */
+  frameDuration?: number;
+  /**
+   * Microseconds of audio buffered past a block before it is mixed (a jitter
+   * buffer, default frameDuration). Sources that start or stall within it are
+   * mixed in time; samples arriving for an already mixed block are dropped.
+   */
+  maxLatency?: number;
+  /** Bend peaks above 0.75 so the sum never exceeds full scale (default true). */
+  softClip?: boolean;
+}
+
+/** Options for the non-standard `AudioData.bufferPool()`. */
+export interface AudioBufferPoolOptions {
+  /**
+   * Buffer shapes (sample format, channels, frames) kept process-wide (0-1024,
+   * default 32). Each shape retains its peak number of buffers in use; 0
+   * disables pooling and frees every idle buffer.
+   */
+  maxPools?: number;
+}
+
+/** Process-wide audio sample buffer pool counters. */
+export interface AudioBufferPoolStats {
+  maxPools: number;
+  pools: number;
+  acquired: number;
+  allocated: number;
+  evictions: number;
+}
+
+/** Options for the non-standard `VideoDecoder.codecContextCache()` / `AudioDecoder` equivalent. */
+export interface CodecContextCacheOptions {
+  /** Warm decoder contexts kept process-wide (0-64, default 4). 0 disables the cache. */
+  maxEntries?: number;
+}
+
+/** Process-wide warm decoder context cache counters. */
+export interface CodecContextCacheStats {
+  maxEntries: number;
+  entries: number;
+  /** configure() calls that adopted a cached context. */
+  hits: number;
+  /** configure() calls that opened a new context. */
+  misses: number;
+  evictions: number;
+}
+
+/** Non-standard ImageDecoder source: a local file, memory-mapped by the native layer. */
+export interface ImageDecoderFileSource {
+  path: string;
+}
+
+/** ImageDecoderInit whose `data` may also be an {@link ImageDecoderFileSource}. */
+export interface NodeImageDecoderInit extends Omit<ImageDecoderInit, 'data'> {
+  data: ImageDecoderInit['data'] | ImageDecoderFileSource;
+}
@@ -1,11 +1,13 @@
 // Re-export all types from the generated type definitions
 // Using 'export type *' ensures this is compile-time only (no runtime import)
 export type * from '../types/webcodecs.js';
+export type * from './extensions.js';
 
 // Export class implementations
 export { AudioDecoder } from './AudioDecoder.js';
 export { VideoDecoder } from './VideoDecoder.js';
 export { AudioEncoder } from './AudioEncoder.js';
+export { AudioMixer } from './AudioMixer.js';
 export { VideoEncoder } from './VideoEncoder.js';
 export { EncodedAudioChunk } from './EncodedAudioChunk.js';
 export { EncodedVideoChunk } from './EncodedVideoChunk.js';
@@ -9,6 +9,7 @@
 #include "video_color_space.h"
 #include "audio_decoder.h"
 #include "audio_encoder.h"
+#include "audio_mixer.h"
 #include "audio_data.h"
 #include "encoded_audio_chunk.h"
 #include "image_decoder.h"
@@ -33,6 +34,7 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
   webcodecs::EncodedAudioChunk::Init(env, exports);
   webcodecs::AudioDecoder::Init(env, exports);
   webcodecs::AudioEncoder::Init(env, exports);
+  webcodecs::AudioMixer::Init(env, exports);
 
   // Image codec classes (ImageTrack and ImageTrackList must be initialized before ImageDecoder
   // because ImageDecoder's constructor calls ImageTrackList::Create which uses constructor_)
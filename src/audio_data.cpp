@@ -2,7 +2,14 @@
 
 #include <cstring>
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #include "error_builder.h"
+#include "shared/audio_buffer_pool.h"
+#include "shared/channel_remix.h"
+#include "shared/sample_kernels.h"
 
 namespace webcodecs {
 
@@ -50,6 +57,151 @@ static int GetBytesPerSample(AVSampleFormat fmt) {
   return av_get_bytes_per_sample(fmt);
 }
 
+/**
+ * Helper: copyTo() through the vectorized sample kernels.
+ *
+ * Copies frame_count frames from frame_offset into dest: one plane of a
+ * planar destination, or every channel of an interleaved one. When both
+ * the layout and the sample type change, samples are rearranged into a
+ * small scratch block first and converted from there.
+ */
+static void CopySamples(const AVFrame* frame, int num_channels, int frame_offset, int frame_count,
+                        int plane_index, sample_kernels::SampleType src_type,
+                        sample_kernels::SampleType dest_type, bool dest_is_planar, uint8_t* dest) {
+  namespace sk = sample_kernels;
+  const bool src_is_planar = av_sample_fmt_is_planar(static_cast<AVSampleFormat>(frame->format));
+  const size_t src_size = sk::SampleSize(src_type);
+  const size_t dest_size = sk::SampleSize(dest_type);
+  const size_t channels = static_cast<size_t>(num_channels);
+  const size_t offset = static_cast<size_t>(frame_offset);
+  const size_t frames = static_cast<size_t>(frame_count);
+
+  // Same layout: a single contiguous run
+  if (dest_is_planar && src_is_planar) {
+    sk::Convert(src_type, frame->extended_data[plane_index] + offset * src_size, dest_type, dest,
+                frames);
+    return;
+  }
+  if (!dest_is_planar && !src_is_planar) {
+    sk::Convert(src_type, frame->extended_data[0] + offset * src_size * channels, dest_type, dest,
+                frames * channels);
+    return;
+  }
+
+  std::vector<const uint8_t*> planes;
+  if (src_is_planar) {
+    planes.resize(channels);
+    for (size_t ch = 0; ch < channels; ch++) {
+      planes[ch] = frame->extended_data[ch] + offset * src_size;
+    }
+  }
+  const uint8_t* interleaved = frame->extended_data[0] + offset * src_size * channels;
+
+  if (src_type == dest_type) {
+    if (src_is_planar) {
+      sk::Interleave(planes.data(), num_channels, frames, src_size, dest);
+    } else {
+      sk::Deinterleave(interleaved, num_channels, plane_index, frames, src_size, dest);
+    }
+    return;
+  }
+
+  // Layout and type both change: rearrange a block, then convert it
+  constexpr size_t kScratchSamples = 4096;
+  const size_t block = std::max<size_t>(1, kScratchSamples / channels);
+  const size_t block_samples = src_is_planar ? block * channels : block;
+  std::vector<uint8_t> scratch(block_samples * src_size);
+  for (size_t done = 0; done < frames; done += block) {
+    const size_t n = std::min(block, frames - done);
+    if (src_is_planar) {
+      sk::Interleave(planes.data(), num_channels, n, src_size, scratch.data());
+      for (auto& plane : planes) plane += n * src_size;
+      sk::Convert(src_type, scratch.data(), dest_type, dest + done * channels * dest_size,
+                  n * channels);
+    } else {
+      sk::Deinterleave(interleaved + done * channels * src_size, num_channels, plane_index, n,
+                       src_size, scratch.data());
+      sk::Convert(src_type, scratch.data(), dest_type, dest + done * dest_size, n);
+    }
+  }
+}
+
+/**
+ * Helper: copyTo() with a channelLayout (non-standard) that differs from
+ * the frame's.
+ *
+ * Works through blocks of f32 planes: f32-planar sources are read in place,
+ * other sources are converted/deinterleaved into scratch first. Each output
+ * channel is mixed straight into an f32 destination and through scratch
+ * (then converted or interleaved) otherwise.
+ */
+static void RemixSamples(const AVFrame* frame, const ChannelMatrix& matrix, int frame_offset,
+                         int frame_count, int plane_index, sample_kernels::SampleType src_type,
+                         sample_kernels::SampleType dest_type, bool dest_is_planar, uint8_t* dest) {
+  namespace sk = sample_kernels;
+  constexpr size_t kBlock = 1024;  // Frames
+  const bool src_is_planar = av_sample_fmt_is_planar(static_cast<AVSampleFormat>(frame->format));
+  const bool src_is_f32 = src_type == sk::SampleType::kF32;
+  const bool dest_is_f32 = dest_type == sk::SampleType::kF32;
+  const size_t src_size = sk::SampleSize(src_type);
+  const size_t dest_size = sk::SampleSize(dest_type);
+  const int in_channels = matrix.in_channels;
+  const int out_channels = matrix.out_channels;
+  const size_t offset = static_cast<size_t>(frame_offset);
+  const size_t frames = static_cast<size_t>(frame_count);
+
+  std::vector<float> in_scratch(src_is_planar && src_is_f32 ? 0 : kBlock * in_channels);
+  std::vector<float> out_scratch(dest_is_planar ? (dest_is_f32 ? 0 : kBlock) : kBlock * out_channels);
+  std::vector<float> packed(kBlock * std::max(in_channels, out_channels));
+  std::vector<const float*> in(in_channels);
+  std::vector<const uint8_t*> out(out_channels);
+
+  for (size_t done = 0; done < frames; done += kBlock) {
+    const size_t n = std::min(kBlock, frames - done);
+    const size_t pos = offset + done;
+
+    // Source channels as f32 planes
+    const uint8_t* interleaved = frame->extended_data[0] + pos * src_size * in_channels;
+    if (!src_is_planar && !src_is_f32) {
+      sk::Convert(src_type, interleaved, sk::SampleType::kF32, packed.data(), n * in_channels);
+      interleaved = reinterpret_cast<const uint8_t*>(packed.data());
+    }
+    for (int ch = 0; ch < in_channels; ch++) {
+      float* plane = in_scratch.data() + ch * kBlock;
+      if (src_is_planar && src_is_f32) {
+        in[ch] = reinterpret_cast<const float*>(frame->extended_data[ch]) + pos;
+        continue;
+      }
+      if (src_is_planar) {
+        sk::Convert(src_type, frame->extended_data[ch] + pos * src_size, sk::SampleType::kF32, plane, n);
+      } else {
+        sk::Deinterleave(interleaved, in_channels, ch, n, sizeof(float), reinterpret_cast<uint8_t*>(plane));
+      }
+      in[ch] = plane;
+    }
+
+    if (dest_is_planar) {
+      float* target = dest_is_f32 ? reinterpret_cast<float*>(dest) + done : out_scratch.data();
+      matrix.Apply(in.data(), n, plane_index, target);
+      if (!dest_is_f32) sk::Convert(sk::SampleType::kF32, target, dest_type, dest + done * dest_size, n);
+      continue;
+    }
+
+    for (int ch = 0; ch < out_channels; ch++) {
+      float* plane = out_scratch.data() + ch * kBlock;
+      matrix.Apply(in.data(), n, ch, plane);
+      out[ch] = reinterpret_cast<const uint8_t*>(plane);
+    }
+    uint8_t* block_dest = dest + done * out_channels * dest_size;
+    if (dest_is_f32) {
+      sk::Interleave(out.data(), out_channels, n, sizeof(float), block_dest);
+    } else {
+      sk::Interleave(out.data(), out_channels, n, sizeof(float), reinterpret_cast<uint8_t*>(packed.data()));
+      sk::Convert(sk::SampleType::kF32, packed.data(), dest_type, block_dest, n * out_channels);
+    }
+  }
+}
+
 Napi::Object AudioData::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function func = DefineClass(env, "AudioData",
                                     {
@@ -64,6 +216,7 @@ Napi::Object AudioData::Init(Napi::Env env, Napi::Object exports) {
                                         InstanceMethod<&AudioData::Clone>("clone"),
                                         InstanceMethod<&AudioData::Close>("close"),
                                         InstanceMethod<&AudioData::SerializeForTransfer>("serializeForTransfer"),
+                                        StaticMethod<&AudioBufferPoolMethod>("bufferPool"),
                                     });
 
   constructor = Napi::Persistent(func);
@@ -208,8 +361,8 @@ AudioData::AudioData(const Napi::CallbackInfo& info) : Napi::ObjectWrap<AudioDat
   frame_->channel_layout = av_get_default_channel_layout(num_channels);
 #endif
 
-  // Allocate frame buffer
-  int ret = av_frame_get_buffer(frame_.get(), 0);
+  // Allocate frame buffer (recycled once an AudioData of the same shape is closed)
+  int ret = GlobalAudioBufferPool::Instance().GetBuffer(frame_.get());
   if (ret < 0) {
     errors::ThrowTypeError(env, "Failed to allocate audio frame buffer");
     frame_.reset();
@@ -223,7 +376,7 @@ AudioData::AudioData(const Napi::CallbackInfo& info) : Napi::ObjectWrap<AudioDat
     // For planar formats, data is arranged as [ch0_samples][ch1_samples]...
     size_t plane_size = static_cast<size_t>(num_frames) * static_cast<size_t>(bytes_per_sample);
     for (int ch = 0; ch < num_channels; ch++) {
-      std::memcpy(frame_->data[ch], src_data + ch * plane_size, plane_size);
+      std::memcpy(frame_->extended_data[ch], src_data + ch * plane_size, plane_size);
     }
   } else {
     // For interleaved formats, all data is in data[0]
@@ -325,22 +478,65 @@ Napi::Value AudioData::GetTimestamp(const Napi::CallbackInfo& info) {
 
 // --- Methods ---
 
+/**
+ * Helper: Resolve the non-standard channelLayout copy option
+ *
+ * Sets *out_matrix to the remix matrix when options.channelLayout names a
+ * layout other than the frame's (left null otherwise). Returns false on
+ * error (throws JS exception).
+ */
+static bool ResolveChannelLayout(Napi::Env env, const AVFrame* frame, const Napi::Object& options,
+                                 std::shared_ptr<const ChannelMatrix>* out_matrix) {
+  out_matrix->reset();
+  if (!options.Has("channelLayout") || options.Get("channelLayout").IsUndefined()) {
+    return true;
+  }
+  if (!options.Get("channelLayout").IsString()) {
+    Napi::TypeError::New(env, "channelLayout must be a string").ThrowAsJavaScriptException();
+    return false;
+  }
+  const std::string name = options.Get("channelLayout").As<Napi::String>().Utf8Value();
+
+  AVChannelLayout out_layout = {};
+  if (av_channel_layout_from_string(&out_layout, name.c_str()) < 0) {
+    Napi::TypeError::New(env, "Invalid channelLayout: " + name).ThrowAsJavaScriptException();
+    return false;
+  }
+
+  AVChannelLayout in_layout = {};
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+  av_channel_layout_copy(&in_layout, &frame->ch_layout);
+#else
+  av_channel_layout_default(&in_layout, frame->channels);
+#endif
+
+  bool ok = true;
+  if (av_channel_layout_compare(&in_layout, &out_layout) != 0) {
+    *out_matrix = ChannelMatrixCache::Instance().Get(&in_layout, &out_layout);
+    if (!*out_matrix) {
+      errors::ThrowNotSupportedError(env, "Cannot remix " + std::to_string(in_layout.nb_channels) +
+                                              " channels to channelLayout " + name);
+      ok = false;
+    }
+  }
+  av_channel_layout_uninit(&in_layout);
+  av_channel_layout_uninit(&out_layout);
+  return ok;
+}
+
 /**
  * Helper: Compute Copy Element Count (with options)
  * Per W3C WebCodecs spec section 9.2.5
  *
- * Returns the element count, or -1 on error (throws JS exception).
+ * num_channels is the destination channel count (differs from the frame's
+ * with a channelLayout option). Returns the element count, or -1 on error
+ * (throws JS exception).
  */
 static int ComputeCopyElementCount(Napi::Env env, const AVFrame* frame,
                                    const std::string& src_format,
                                    const Napi::Object& options,
+                                   int num_channels,
                                    std::string& out_dest_format) {
-  // Get number of channels
-#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
-  int num_channels = frame->ch_layout.nb_channels;
-#else
-  int num_channels = frame->channels;
-#endif
   int num_frames = frame->nb_samples;
 
   // Step 1-2: destFormat defaults to [[format]], may be overridden by options.format
@@ -440,9 +636,20 @@ Napi::Value AudioData::AllocationSize(const Napi::CallbackInfo& info) {
   }
   Napi::Object options = info[0].As<Napi::Object>();
 
+  // Non-standard: channelLayout changes the number of destination channels
+  std::shared_ptr<const ChannelMatrix> matrix;
+  if (!ResolveChannelLayout(env, frame_.get(), options, &matrix)) {
+    return env.Undefined();  // Exception already thrown
+  }
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+  const int dest_channels = matrix ? matrix->out_channels : frame_->ch_layout.nb_channels;
+#else
+  const int dest_channels = matrix ? matrix->out_channels : frame_->channels;
+#endif
+
   // Step 2: Compute copy element count
   std::string dest_format;
-  int element_count = ComputeCopyElementCount(env, frame_.get(), format_, options, dest_format);
+  int element_count = ComputeCopyElementCount(env, frame_.get(), format_, options, dest_channels, dest_format);
   if (element_count < 0) {
     return env.Undefined();  // Exception already thrown
   }
@@ -500,9 +707,21 @@ Napi::Value AudioData::CopyTo(const Napi::CallbackInfo& info) {
   }
   Napi::Object options = info[1].As<Napi::Object>();
 
+  // Non-standard: remix to options.channelLayout
+  std::shared_ptr<const ChannelMatrix> matrix;
+  if (!ResolveChannelLayout(env, frame_.get(), options, &matrix)) {
+    return env.Undefined();  // Exception already thrown
+  }
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+  int num_channels = frame_->ch_layout.nb_channels;
+#else
+  int num_channels = frame_->channels;
+#endif
+  const int dest_channels = matrix ? matrix->out_channels : num_channels;
+
   // Step 2: Compute copy element count
   std::string dest_format;
-  int element_count = ComputeCopyElementCount(env, frame_.get(), format_, options, dest_format);
+  int element_count = ComputeCopyElementCount(env, frame_.get(), format_, options, dest_channels, dest_format);
   if (element_count < 0) {
     return env.Undefined();  // Exception already thrown
   }
@@ -526,11 +745,6 @@ Napi::Value AudioData::CopyTo(const Napi::CallbackInfo& info) {
   }
 
   // Determine frame count to copy
-#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
-  int num_channels = frame_->ch_layout.nb_channels;
-#else
-  int num_channels = frame_->channels;
-#endif
   int copy_frame_count = frame_->nb_samples - frame_offset;
   if (options.Has("frameCount") && options.Get("frameCount").IsNumber()) {
     copy_frame_count = options.Get("frameCount").As<Napi::Number>().Int32Value();
@@ -543,35 +757,24 @@ Napi::Value AudioData::CopyTo(const Napi::CallbackInfo& info) {
   bool dest_is_planar = av_sample_fmt_is_planar(dest_av_fmt);
 
   // Step 7-9: Copy with optional format conversion
-  // Check if format conversion is needed
-  bool needs_conversion = (src_av_fmt != dest_av_fmt);
-
-  if (!needs_conversion) {
-    // No conversion needed - direct copy with offset handling
-    if (dest_is_planar) {
-      // Planar destination: copy single plane
-      const uint8_t* src_ptr = frame_->data[plane_index] + frame_offset * src_bytes_per_sample;
-      std::memcpy(dest_data, src_ptr, copy_frame_count * src_bytes_per_sample);
-    } else {
-      // Interleaved destination
-      if (src_is_planar) {
-        // Planar source -> Interleaved destination (interleave)
-        uint8_t* dest = dest_data;
-        for (int sample = 0; sample < copy_frame_count; sample++) {
-          for (int ch = 0; ch < num_channels; ch++) {
-            const uint8_t* src_ptr = frame_->data[ch] + (frame_offset + sample) * src_bytes_per_sample;
-            std::memcpy(dest, src_ptr, src_bytes_per_sample);
-            dest += src_bytes_per_sample;
-          }
-        }
-      } else {
-        // Interleaved source -> Interleaved destination (direct copy)
-        const uint8_t* src_ptr = frame_->data[0] + frame_offset * src_bytes_per_sample * num_channels;
-        std::memcpy(dest_data, src_ptr, copy_frame_count * src_bytes_per_sample * num_channels);
-      }
+  // Layout changes and u8/s16/s32 <-> f32 use the vectorized kernels
+  sample_kernels::SampleType src_type;
+  sample_kernels::SampleType dest_type;
+  const bool kernel_types =
+      sample_kernels::ToSampleType(src_av_fmt, &src_type) && sample_kernels::ToSampleType(dest_av_fmt, &dest_type);
+  if (matrix) {
+    // Channel remixing works in f32, so any u8/s16/s32/f32 pair is fine
+    if (!kernel_types) {
+      errors::ThrowNotSupportedError(env, "channelLayout is not supported for this sample format");
+      return env.Undefined();
     }
+    RemixSamples(frame_.get(), *matrix, frame_offset, copy_frame_count, plane_index, src_type, dest_type,
+                 dest_is_planar, dest_data);
+  } else if (kernel_types && sample_kernels::CanConvert(src_type, dest_type)) {
+    CopySamples(frame_.get(), num_channels, frame_offset, copy_frame_count, plane_index, src_type,
+                dest_type, dest_is_planar, dest_data);
   } else {
-    // Format conversion needed - use libswresample
+    // Integer to integer conversion - use libswresample
     // Build channel layout
     AVChannelLayout ch_layout;
 #if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
@@ -29,6 +29,7 @@ class AudioData : public Napi::ObjectWrap<AudioData> {
 
   // Access underlying frame (for encoders)
   const AVFrame* frame() const { return frame_.get(); }
+  int64_t timestamp() const { return timestamp_; }
 
   // Check if closed (thread-safe)
   bool IsClosed() const { return closed_.load(std::memory_order_acquire); }
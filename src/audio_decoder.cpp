@@ -1,6 +1,7 @@
 #include "audio_decoder.h"
 
 #include <string>
+#include <vector>
 
 #include "audio_data.h"
 #include "encoded_audio_chunk.h"
@@ -22,13 +23,16 @@ Napi::Object AudioDecoder::Init(Napi::Env env, Napi::Object exports) {
                   {
                       InstanceAccessor<&AudioDecoder::GetState>("state"),
                       InstanceAccessor<&AudioDecoder::GetDecodeQueueSize>("decodeQueueSize"),
+                      InstanceAccessor<&AudioDecoder::GetStats>("stats"),
                       InstanceAccessor<&AudioDecoder::GetOndequeue, &AudioDecoder::SetOndequeue>("ondequeue"),
                       InstanceMethod<&AudioDecoder::Configure>("configure"),
                       InstanceMethod<&AudioDecoder::Decode>("decode"),
+                      InstanceMethod<&AudioDecoder::DecodeBatch>("decodeBatch"),
                       InstanceMethod<&AudioDecoder::Flush>("flush"),
                       InstanceMethod<&AudioDecoder::Reset>("reset"),
                       InstanceMethod<&AudioDecoder::Close>("close"),
                       StaticMethod<&AudioDecoder::IsConfigSupported>("isConfigSupported"),
+                      StaticMethod<&CodecContextCacheMethod>("codecContextCache"),
                   });
 
   constructor = Napi::Persistent(func);
@@ -281,6 +285,11 @@ Napi::Value AudioDecoder::GetDecodeQueueSize(const Napi::CallbackInfo& info) {
   return Napi::Number::New(info.Env(), static_cast<double>(decode_queue_size_.load(std::memory_order_acquire)));
 }
 
+Napi::Value AudioDecoder::GetStats(const Napi::CallbackInfo& info) {
+  // Non-standard: sample buffer counters since the last configure()
+  return AudioBufferCountersToObject(info.Env(), buffer_counters_);
+}
+
 Napi::Value AudioDecoder::GetOndequeue(const Napi::CallbackInfo& info) {
   if (ondequeue_callback_.IsEmpty()) {
     return info.Env().Null();
@@ -339,6 +348,28 @@ Napi::Value AudioDecoder::Configure(const Napi::CallbackInfo& info) {
     }
   }
 
+  // Non-standard: merge decoded frames into AudioData of at least this duration
+  active_config_.min_output_duration = 0;
+  if (config.Has("minOutputDuration") && config.Get("minOutputDuration").IsNumber()) {
+    double duration = config.Get("minOutputDuration").As<Napi::Number>().DoubleValue();
+    if (!(duration >= 0) || duration > 10000000) {
+      errors::ThrowTypeError(env, "minOutputDuration must be between 0 and 10000000 microseconds");
+      return env.Undefined();
+    }
+    active_config_.min_output_duration = static_cast<int64_t>(duration);
+  }
+
+  // Non-standard: fill timestamp gaps up to this long with concealment audio
+  active_config_.max_concealed_gap = 0;
+  if (config.Has("maxConcealedGap") && config.Get("maxConcealedGap").IsNumber()) {
+    double gap = config.Get("maxConcealedGap").As<Napi::Number>().DoubleValue();
+    if (!(gap >= 0) || gap > 10000000) {
+      errors::ThrowTypeError(env, "maxConcealedGap must be between 0 and 10000000 microseconds");
+      return env.Undefined();
+    }
+    active_config_.max_concealed_gap = static_cast<int64_t>(gap);
+  }
+
   // Validate codec string before queuing (fail fast)
   auto codec_info = ParseCodecString(active_config_.codec);
   if (!codec_info) {
@@ -371,6 +402,9 @@ Napi::Value AudioDecoder::Configure(const Napi::CallbackInfo& info) {
     return env.Undefined();
   }
 
+  // Stats cover the current configuration only
+  buffer_counters_.Reset();
+
   // [SPEC] 3. Set state to "configured"
   // [SPEC] 4. Set key chunk required to true
   state_.transition(raii::AtomicCodecState::State::Unconfigured, raii::AtomicCodecState::State::Configured);
@@ -388,62 +422,148 @@ Napi::Value AudioDecoder::Decode(const Napi::CallbackInfo& info) {
     return env.Undefined();
   }
 
+  AudioControlQueue::DecodeMessage msg;
+  if (!BuildDecodeMessage(env, info.Length() > 0 ? info[0] : env.Undefined(), &msg)) {
+    return env.Undefined();
+  }
+
+  // [SPEC] 3. Increment decodeQueueSize
+  decode_queue_size_.fetch_add(1, std::memory_order_relaxed);
+
+  // PCM/G.711 needs no codec state: with nothing queued ahead of this chunk
+  // it is decoded here, its output still delivered through the TSFN, and
+  // DecodeInline() releases the count as the worker would
+  if (queue_.Idle() && worker_->DecodeInline(msg.packet.get())) {
+    return env.Undefined();
+  }
+
+  // Enqueue decode message
+  if (!queue_.Enqueue(std::move(msg))) {
+    decode_queue_size_.fetch_sub(1, std::memory_order_relaxed);
+    errors::ThrowInvalidStateError(env, "Failed to enqueue decode");
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value AudioDecoder::DecodeBatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  // Non-standard: decode() for each element, enqueued under one lock/notify
+  if (!state_.IsConfigured()) {
+    errors::ThrowInvalidStateError(env, "decodeBatch called on " + std::string(state_.ToString()) + " decoder");
+    return env.Undefined();
+  }
+
+  if (info.Length() < 1 || !info[0].IsArray()) {
+    errors::ThrowTypeError(env, "decodeBatch requires an array of EncodedAudioChunk");
+    return env.Undefined();
+  }
+
+  Napi::Array chunks = info[0].As<Napi::Array>();
+  uint32_t length = chunks.Length();
+  std::vector<AudioControlQueue::Message> messages;
+  messages.reserve(length);
+  for (uint32_t i = 0; i < length; i++) {
+    AudioControlQueue::DecodeMessage msg;
+    if (!BuildDecodeMessage(env, chunks.Get(i), &msg)) {
+      // Same as decode() in a loop: earlier chunks stay queued, the error propagates
+      break;
+    }
+    if (messages.empty() && queue_.Idle()) {
+      // Counted like decode(); DecodeInline() releases it on success
+      decode_queue_size_.fetch_add(1, std::memory_order_relaxed);
+      if (worker_->DecodeInline(msg.packet.get())) continue;
+      decode_queue_size_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    messages.emplace_back(std::move(msg));
+  }
+
+  uint32_t count = static_cast<uint32_t>(messages.size());
+  decode_queue_size_.fetch_add(count, std::memory_order_relaxed);
+  if (!queue_.EnqueueBatch(messages)) {
+    decode_queue_size_.fetch_sub(count, std::memory_order_relaxed);
+    if (!env.IsExceptionPending()) {
+      errors::ThrowInvalidStateError(env, "Failed to enqueue decode");
+    }
+  }
+
+  return env.Undefined();
+}
+
+bool AudioDecoder::BuildDecodeMessage(Napi::Env env, const Napi::Value& value,
+                                      AudioControlQueue::DecodeMessage* msg) {
   // Validate chunk argument
-  if (info.Length() < 1 || !info[0].IsObject()) {
+  if (!value.IsObject()) {
     errors::ThrowTypeError(env, "EncodedAudioChunk is required");
-    return env.Undefined();
+    return false;
   }
 
-  Napi::Object chunk = info[0].As<Napi::Object>();
+  Napi::Object chunk = value.As<Napi::Object>();
+
+  // Native chunks carry type, timestamp and a refcounted packet, so they skip
+  // the property lookups and the data copy that plain objects need
+  EncodedAudioChunk* enc = nullptr;
+  if (chunk.InstanceOf(EncodedAudioChunk::constructor.Value())) {
+    enc = Napi::ObjectWrap<EncodedAudioChunk>::Unwrap(chunk);
+  }
 
   // Get chunk type
-  std::string chunk_type;
-  if (chunk.Has("type") && chunk.Get("type").IsString()) {
-    chunk_type = chunk.Get("type").As<Napi::String>().Utf8Value();
+  bool is_key = false;
+  if (enc) {
+    is_key = enc->is_key();
+  } else if (chunk.Has("type") && chunk.Get("type").IsString()) {
+    is_key = chunk.Get("type").As<Napi::String>().Utf8Value() == "key";
   }
 
   // [SPEC] 2. If key chunk required is true, check for key frame
   if (key_chunk_required_.load(std::memory_order_acquire)) {
-    if (chunk_type != "key") {
+    if (!is_key) {
       errors::ThrowDataError(env, "A key frame is required");
-      return env.Undefined();
+      return false;
     }
     key_chunk_required_.store(false, std::memory_order_release);
   }
 
-  // Get chunk data - support both EncodedAudioChunk wrapper and plain objects
-  const uint8_t* data = nullptr;
-  size_t size = 0;
-
-  // Try to get data from EncodedAudioChunk wrapper
-  if (chunk.InstanceOf(EncodedAudioChunk::constructor.Value())) {
-    EncodedAudioChunk* enc = Napi::ObjectWrap<EncodedAudioChunk>::Unwrap(chunk);
+  raii::AVPacketPtr packet;
+  int64_t timestamp = 0;
+  if (enc) {
     const AVPacket* pkt = enc->packet();
     if (pkt && pkt->data && pkt->size > 0) {
-      data = pkt->data;
-      size = static_cast<size_t>(pkt->size);
+      // Chunks are immutable, so the decode message can share the buffer
+      packet = raii::CloneAvPacket(pkt);
+      if (!packet) {
+        errors::ThrowEncodingError(env, "Failed to create packet");
+        return false;
+      }
     }
-  } else if (chunk.Has("data")) {
+    timestamp = enc->timestamp();
+  } else {
     // Plain object with data property
-    buffer_utils::ExtractBufferData(chunk.Get("data"), &data, &size);
-  }
-
-  if (!data || size == 0) {
-    errors::ThrowTypeError(env, "Chunk data is required");
-    return env.Undefined();
-  }
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    if (chunk.Has("data")) {
+      buffer_utils::ExtractBufferData(chunk.Get("data"), &data, &size);
+    }
+    if (data && size > 0) {
+      // Create AVPacket from data (deep copy for async processing)
+      packet = buffer_utils::CreatePacketFromBuffer(data, size);
+      if (!packet) {
+        errors::ThrowEncodingError(env, "Failed to create packet");
+        return false;
+      }
+    }
 
-  // Get timestamp (microseconds)
-  int64_t timestamp = 0;
-  if (chunk.Has("timestamp") && chunk.Get("timestamp").IsNumber()) {
-    timestamp = chunk.Get("timestamp").As<Napi::Number>().Int64Value();
+    // Get timestamp (microseconds)
+    if (chunk.Has("timestamp") && chunk.Get("timestamp").IsNumber()) {
+      timestamp = chunk.Get("timestamp").As<Napi::Number>().Int64Value();
+    }
   }
 
-  // Create AVPacket from data (deep copy for async processing)
-  raii::AVPacketPtr packet = buffer_utils::CreatePacketFromBuffer(data, size);
   if (!packet) {
-    errors::ThrowEncodingError(env, "Failed to create packet");
-    return env.Undefined();
+    errors::ThrowTypeError(env, "Chunk data is required");
+    return false;
   }
 
   // Set packet timestamp
@@ -451,22 +571,14 @@ Napi::Value AudioDecoder::Decode(const Napi::CallbackInfo& info) {
   packet->dts = timestamp;
 
   // Set key frame flag
-  if (chunk_type == "key") {
+  if (is_key) {
     packet->flags |= AV_PKT_FLAG_KEY;
+  } else {
+    packet->flags &= ~AV_PKT_FLAG_KEY;
   }
 
-  // [SPEC] 3. Increment decodeQueueSize
-  decode_queue_size_.fetch_add(1, std::memory_order_relaxed);
-
-  // Enqueue decode message
-  AudioControlQueue::DecodeMessage msg{std::move(packet)};
-  if (!queue_.Enqueue(std::move(msg))) {
-    decode_queue_size_.fetch_sub(1, std::memory_order_relaxed);
-    errors::ThrowInvalidStateError(env, "Failed to enqueue decode");
-    return env.Undefined();
-  }
-
-  return env.Undefined();
+  msg->packet = std::move(packet);
+  return true;
 }
 
 Napi::Value AudioDecoder::Flush(const Napi::CallbackInfo& info) {
@@ -609,7 +721,7 @@ Napi::Value AudioDecoder::IsConfigSupported(const Napi::CallbackInfo& info) {
   // [SPEC] 2. Create promise
   Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
 
-  // Check if codec is supported
+  // Answer from the process-wide capability table
   bool supported = IsCodecSupported(codec_string);
 
   // [SPEC] Create AudioDecoderSupport object
@@ -629,6 +741,12 @@ Napi::Value AudioDecoder::IsConfigSupported(const Napi::CallbackInfo& info) {
   if (config.Has("description")) {
     clonedConfig.Set("description", config.Get("description"));
   }
+  if (config.Has("minOutputDuration") && config.Get("minOutputDuration").IsNumber()) {
+    clonedConfig.Set("minOutputDuration", config.Get("minOutputDuration"));
+  }
+  if (config.Has("maxConcealedGap") && config.Get("maxConcealedGap").IsNumber()) {
+    clonedConfig.Set("maxConcealedGap", config.Get("maxConcealedGap"));
+  }
 
   result.Set("config", clonedConfig);
 
@@ -698,12 +816,43 @@ AudioDecoderWorker::AudioDecoderWorker(AudioControlQueue& queue, AudioDecoder* d
 
 AudioDecoderWorker::~AudioDecoderWorker() {
   Stop();
+  ReleaseCodecContext();
+}
+
+void AudioDecoderWorker::ReleaseCodecContext() {
+  if (codec_ctx_) {
+    // The next owner may outlive this decoder's counters
+    codec_ctx_->opaque = nullptr;
+    GlobalCodecContextCache::Instance().Put(codec_key_, std::move(codec_ctx_));
+  }
+}
+
+void AudioDecoderWorker::EmitFrame(raii::AVFramePtr frame) {
+  std::vector<raii::AVFramePtr> concealed;
+  int conceal_ret = concealer_.Push(std::move(frame), &concealed);
+
+  std::vector<raii::AVFramePtr> ready;
+  int ret = 0;
+  for (raii::AVFramePtr& part : concealed) {
+    ret = coalescer_.Push(std::move(part), &ready);
+    if (ret < 0) break;
+  }
+  for (raii::AVFramePtr& output : ready) {
+    OutputFrame(std::move(output));
+  }
+  if (ret < 0) {
+    OutputError(ret, "Failed to merge decoded audio");
+  } else if (conceal_ret < 0) {
+    OutputError(conceal_ret, "Failed to conceal lost audio");
+  }
 }
 
 bool AudioDecoderWorker::OnConfigure(const ConfigureMessage& msg) {
   // Get config from parent decoder
   if (!decoder_) return false;
 
+  inline_format_.reset();
+
   const AudioDecoder::DecoderConfig& config = decoder_->active_config_;
 
   // Parse codec string
@@ -720,45 +869,86 @@ bool AudioDecoderWorker::OnConfigure(const ConfigureMessage& msg) {
     return false;
   }
 
-  // Allocate codec context
-  codec_ctx_ = raii::MakeAvCodecContext(decoder);
-  if (!codec_ctx_) {
-    OutputError(AVERROR(ENOMEM), "Failed to allocate codec context");
-    return false;
+  // Frames merged under the previous configuration are complete outputs
+  raii::AVFramePtr rest = coalescer_.Flush();
+  if (rest) {
+    OutputFrame(std::move(rest));
   }
 
-  // Set codec parameters
-  if (config.sample_rate > 0) {
-    codec_ctx_->sample_rate = config.sample_rate;
-    sample_rate_ = config.sample_rate;
-  }
-  if (config.number_of_channels > 0) {
-    // FFmpeg 5.0+ uses ch_layout instead of channels
+  // Return the previous context to the warm cache before replacing it
+  ReleaseCodecContext();
+
+  // Everything fixed by avcodec_open2() identifies a reusable context
+  CodecContextKey key;
+  key.codec = decoder;
+  key.sample_rate = config.sample_rate;
+  key.channels = config.number_of_channels;
+  key.SetExtradata(config.description.data(), config.description.size());
+
+  // Adopt a flushed context from an earlier configure() when one matches
+  codec_ctx_ = GlobalCodecContextCache::Instance().Take(key);
+  if (!codec_ctx_) {
+    // Allocate codec context
+    codec_ctx_ = raii::MakeAvCodecContext(decoder);
+    if (!codec_ctx_) {
+      OutputError(AVERROR(ENOMEM), "Failed to allocate codec context");
+      return false;
+    }
+
+    // Set codec parameters
+    if (config.sample_rate > 0) {
+      codec_ctx_->sample_rate = config.sample_rate;
+    }
+    if (config.number_of_channels > 0) {
+      // FFmpeg 5.0+ uses ch_layout instead of channels
 #if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
-    av_channel_layout_default(&codec_ctx_->ch_layout, config.number_of_channels);
+      av_channel_layout_default(&codec_ctx_->ch_layout, config.number_of_channels);
 #else
-    codec_ctx_->channels = config.number_of_channels;
-    codec_ctx_->channel_layout = av_get_default_channel_layout(config.number_of_channels);
+      codec_ctx_->channels = config.number_of_channels;
+      codec_ctx_->channel_layout = av_get_default_channel_layout(config.number_of_channels);
 #endif
-    channels_ = config.number_of_channels;
-  }
+    }
+
+    // Handle description (extradata)
+    if (!config.description.empty()) {
+      codec_ctx_->extradata = static_cast<uint8_t*>(
+          av_mallocz(config.description.size() + AV_INPUT_BUFFER_PADDING_SIZE));
+      if (codec_ctx_->extradata) {
+        std::memcpy(codec_ctx_->extradata, config.description.data(), config.description.size());
+        codec_ctx_->extradata_size = static_cast<int>(config.description.size());
+      }
+    }
+
+    // Decoded samples land in process-wide pooled buffers that outlive this
+    // context; the allocator is installed before opening, as FFmpeg expects
+    codec_ctx_->opaque = &decoder_->buffer_counters_;
+    codec_ctx_->get_buffer2 = AudioBufferPoolGetBuffer2;
 
-  // Handle description (extradata)
-  if (!config.description.empty()) {
-    codec_ctx_->extradata = static_cast<uint8_t*>(
-        av_mallocz(config.description.size() + AV_INPUT_BUFFER_PADDING_SIZE));
-    if (codec_ctx_->extradata) {
-      std::memcpy(codec_ctx_->extradata, config.description.data(), config.description.size());
-      codec_ctx_->extradata_size = static_cast<int>(config.description.size());
+    // Open codec
+    int ret = avcodec_open2(codec_ctx_.get(), decoder, nullptr);
+    if (ret < 0) {
+      OutputError(ret, "Failed to open decoder");
+      codec_ctx_.reset();
+      return false;
     }
+  } else {
+    // An adopted context was opened by an earlier stream; attribute its
+    // pooled buffers to this one
+    codec_ctx_->opaque = &decoder_->buffer_counters_;
+    codec_ctx_->get_buffer2 = AudioBufferPoolGetBuffer2;
   }
+  codec_key_ = key;
+  concealer_.Configure(config.max_concealed_gap, &decoder_->buffer_counters_);
+  coalescer_.Configure(config.min_output_duration, &decoder_->buffer_counters_);
 
-  // Open codec
-  int ret = avcodec_open2(codec_ctx_.get(), decoder, nullptr);
-  if (ret < 0) {
-    OutputError(ret, "Failed to open decoder");
-    codec_ctx_.reset();
-    return false;
+  // Concealment needs true sample timestamps: with a packet time base the
+  // decoder moves pts past the samples it trims (Opus pre-skip)
+  codec_ctx_->pkt_timebase = concealer_.enabled() ? AVRational{1, 1000000} : AVRational{0, 1};
+
+  // Merging and concealment stay on this thread; otherwise stateless
+  // PCM/G.711 can be decoded by the JS thread whenever this worker is idle
+  if (config.min_output_duration == 0 && config.max_concealed_gap == 0) {
+    inline_format_ = pcm_codec::Find(codec_info->codec_id);
   }
 
   // Update sample format from codec context
@@ -773,6 +963,38 @@ bool AudioDecoderWorker::OnConfigure(const ConfigureMessage& msg) {
   return true;
 }
 
+bool AudioDecoderWorker::DecodeInline(const AVPacket* packet) {
+  if (!inline_format_ || !codec_ctx_ || !decoder_) return false;
+
+  // Same frame parameters as the libavcodec pcm decoder
+  raii::AVFramePtr frame = raii::MakeAvFrame();
+  int ret = frame ? 0 : AVERROR(ENOMEM);
+  if (ret >= 0) {
+    frame->sample_rate = sample_rate_;
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+    ret = av_channel_layout_copy(&frame->ch_layout, &codec_ctx_->ch_layout);
+#else
+    frame->channels = channels_;
+    frame->channel_layout = codec_ctx_->channel_layout;
+#endif
+  }
+  if (ret >= 0) {
+    ret = pcm_codec::DecodePacket(*inline_format_, packet, channels_, frame.get(), &decoder_->buffer_counters_);
+  }
+
+  if (ret >= 0) {
+    frame->pts = packet->pts;
+    OutputFrame(std::move(frame));
+  } else {
+    OutputError(ret, "Failed to decode PCM packet");
+  }
+
+  // [SPEC] Decrement decodeQueueSize (counted by the caller), as OnDecode() does
+  uint32_t new_size = decoder_->decode_queue_size_.fetch_sub(1, std::memory_order_relaxed) - 1;
+  SignalDequeue(new_size);
+  return true;
+}
+
 void AudioDecoderWorker::OnDecode(const DecodeMessage& msg) {
   // [SPEC] Always decrement queue size when decode work is processed, even on error
   // Use a lambda to ensure dequeue is signaled on all exit paths
@@ -819,10 +1041,11 @@ void AudioDecoderWorker::OnDecode(const DecodeMessage& msg) {
       return;
     }
 
-    // Clone frame for output (original stays in decoder)
-    raii::AVFramePtr output_frame = raii::CloneAvFrame(frame.get());
+    // Hand the pooled buffers over to the output frame (no new reference)
+    raii::AVFramePtr output_frame = raii::MakeAvFrame();
     if (output_frame) {
-      OutputFrame(std::move(output_frame));
+      av_frame_move_ref(output_frame.get(), frame.get());
+      EmitFrame(std::move(output_frame));
     }
 
     // Reset frame for next iteration
@@ -867,15 +1090,25 @@ void AudioDecoderWorker::OnFlush(const FlushMessage& msg) {
       return;
     }
 
-    // Clone and output frame
-    raii::AVFramePtr output_frame = raii::CloneAvFrame(frame.get());
+    // Move and output frame
+    raii::AVFramePtr output_frame = raii::MakeAvFrame();
     if (output_frame) {
-      OutputFrame(std::move(output_frame));
+      av_frame_move_ref(output_frame.get(), frame.get());
+      EmitFrame(std::move(output_frame));
     }
 
     av_frame_unref(frame.get());
   }
 
+  // Merged samples still waiting for minOutputDuration go out now
+  raii::AVFramePtr rest = coalescer_.Flush();
+  if (rest) {
+    OutputFrame(std::move(rest));
+  }
+
+  // The next key chunk may start a new stream; don't conceal up to it
+  concealer_.Reset();
+
   // Signal flush complete
   FlushComplete(msg.promise_id, true, "");
 }
@@ -884,10 +1117,15 @@ void AudioDecoderWorker::OnReset() {
   if (codec_ctx_) {
     avcodec_flush_buffers(codec_ctx_.get());
   }
+  concealer_.Reset();
+  coalescer_.Reset();
 }
 
 void AudioDecoderWorker::OnClose() {
-  codec_ctx_.reset();
+  inline_format_.reset();
+  concealer_.Reset();
+  coalescer_.Reset();
+  ReleaseCodecContext();
 }
 
 }  // namespace webcodecs
@@ -1,12 +1,18 @@
 #pragma once
 #include <napi.h>
 #include <memory>
+#include <optional>
 #include <queue>
 #include <unordered_map>
 #include "shared/utils.h"
 #include "shared/control_message_queue.h"
 #include "shared/codec_worker.h"
 #include "shared/safe_tsfn.h"
+#include "shared/codec_context_cache.h"
+#include "shared/audio_buffer_pool.h"
+#include "shared/audio_frame_coalescer.h"
+#include "shared/audio_gap_concealer.h"
+#include "shared/pcm_codec.h"
 #include "ffmpeg_raii.h"
 
 namespace webcodecs {
@@ -66,6 +72,9 @@ class AudioDecoder : public Napi::ObjectWrap<AudioDecoder> {
   // --- [SPEC] [[dequeue event scheduled]] - coalesces multiple dequeue events ---
   std::atomic<bool> dequeue_event_scheduled_{false};
 
+  // --- Non-standard sample buffer statistics (exposed via `stats`) ---
+  AudioBufferCounters buffer_counters_;
+
   // --- Pending Flush Promises ---
   std::unordered_map<uint32_t, Napi::Promise::Deferred> pending_flushes_;
   uint32_t next_flush_id_{0};
@@ -121,18 +130,22 @@ class AudioDecoder : public Napi::ObjectWrap<AudioDecoder> {
     int sample_rate = 0;
     int number_of_channels = 0;
     std::vector<uint8_t> description;
+    int64_t min_output_duration = 0;  // Non-standard: microseconds, 0 = one AudioData per frame
+    int64_t max_concealed_gap = 0;    // Non-standard: microseconds, 0 = gaps left open
   };
   DecoderConfig active_config_;
 
   // Attributes
   Napi::Value GetState(const Napi::CallbackInfo& info);
   Napi::Value GetDecodeQueueSize(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
   Napi::Value GetOndequeue(const Napi::CallbackInfo& info);
   void SetOndequeue(const Napi::CallbackInfo& info, const Napi::Value& value);
 
   // Methods
   Napi::Value Configure(const Napi::CallbackInfo& info);
   Napi::Value Decode(const Napi::CallbackInfo& info);
+  Napi::Value DecodeBatch(const Napi::CallbackInfo& info);
   Napi::Value Flush(const Napi::CallbackInfo& info);
   Napi::Value Reset(const Napi::CallbackInfo& info);
   Napi::Value Close(const Napi::CallbackInfo& info);
@@ -141,6 +154,8 @@ class AudioDecoder : public Napi::ObjectWrap<AudioDecoder> {
   // --- Internal Helpers ---
   void InitializeTSFNs(Napi::Env env);
   void ReleaseTSFNs();
+  // Validate one chunk and build its decode message; throws and returns false on error
+  bool BuildDecodeMessage(Napi::Env env, const Napi::Value& value, AudioControlQueue::DecodeMessage* msg);
 
   // Friend class for worker access
   friend class AudioDecoderWorker;
@@ -164,6 +179,18 @@ class AudioDecoderWorker : public CodecWorker<AudioControlQueue> {
   AudioDecoderWorker(const AudioDecoderWorker&) = delete;
   AudioDecoderWorker& operator=(const AudioDecoderWorker&) = delete;
 
+  /**
+   * Decode a PCM/G.711 packet on the calling (JS) thread, outputs and
+   * dequeue event going through the TSFNs as usual. Only call while
+   * AudioControlQueue::Idle(), which also orders it after every earlier
+   * message. The caller counts the chunk in decodeQueueSize first; on
+   * success it is released here like a processed DecodeMessage.
+   *
+   * @return false if the configured codec needs this worker (packet and
+   *         queue size untouched)
+   */
+  bool DecodeInline(const AVPacket* packet);
+
  protected:
   bool OnConfigure(const ConfigureMessage& msg) override;
   void OnDecode(const DecodeMessage& msg) override;
@@ -176,6 +203,23 @@ class AudioDecoderWorker : public CodecWorker<AudioControlQueue> {
 
   // --- FFmpeg Resources (owned by worker thread) ---
   raii::AVCodecContextPtr codec_ctx_;
+  CodecContextKey codec_key_;  // Identifies codec_ctx_ in the warm context cache
+
+  // Hand codec_ctx_ to the warm context cache (configure/close/destruction)
+  void ReleaseCodecContext();
+
+  // --- Gap Concealment (maxConcealedGap) ---
+  AudioGapConcealer concealer_;
+
+  // --- Output Coalescing (minOutputDuration) ---
+  AudioFrameCoalescer coalescer_;
+
+  // Output a decoded frame after concealing the gap before it, merged with
+  // its neighbours when coalescing
+  void EmitFrame(raii::AVFramePtr frame);
+
+  // --- Inline PCM/G.711 (set by OnConfigure, read by DecodeInline while idle) ---
+  std::optional<pcm_codec::Format> inline_format_;
 
   // --- Audio Parameters (copied from codec context after open) ---
   int sample_rate_ = 0;
@@ -1,17 +1,151 @@
 #include "audio_encoder.h"
 
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
 #include <string>
+#include <vector>
 
 #include "audio_data.h"
 #include "encoded_audio_chunk.h"
 #include "shared/codec_registry.h"
 #include "error_builder.h"
 #include "shared/buffer_utils.h"
+#include "shared/sample_kernels.h"
 
 namespace webcodecs {
 
 Napi::FunctionReference AudioEncoder::constructor;
 
+namespace {
+
+int FrameChannels(const AVFrame* frame) {
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+  return frame->ch_layout.nb_channels;
+#else
+  return frame->channels;
+#endif
+}
+
+// Frame durations (microseconds) libopus can produce
+constexpr int64_t kOpusFrameDurations[] = {2500, 5000, 10000, 20000, 40000, 60000, 80000, 100000, 120000};
+
+bool IsOneOf(const std::string& value, std::initializer_list<const char*> allowed) {
+  for (const char* candidate : allowed) {
+    if (value == candidate) return true;
+  }
+  return false;
+}
+
+/**
+ * Parse the codec registry `opus` and `aac` members of js into config
+ * (defaults when absent).
+ *
+ * @return Empty string on success, otherwise the TypeError message
+ */
+std::string ParseCodecExtensions(const Napi::Object& js, AudioEncoder::EncoderConfig* config) {
+  config->opus = AudioEncoder::OpusConfig{};
+  config->aac_format = "aac";
+
+  if (js.Has("opus") && js.Get("opus").IsObject()) {
+    Napi::Object opus = js.Get("opus").As<Napi::Object>();
+    AudioEncoder::OpusConfig& out = config->opus;
+
+    if (opus.Has("format") && opus.Get("format").IsString()) {
+      out.format = opus.Get("format").As<Napi::String>().Utf8Value();
+      if (!IsOneOf(out.format, {"opus", "ogg"})) return "opus.format must be \"opus\" or \"ogg\"";
+    }
+    if (opus.Has("signal") && opus.Get("signal").IsString()) {
+      out.signal = opus.Get("signal").As<Napi::String>().Utf8Value();
+      if (!IsOneOf(out.signal, {"auto", "music", "voice"})) {
+        return "opus.signal must be \"auto\", \"music\" or \"voice\"";
+      }
+    }
+    if (opus.Has("application") && opus.Get("application").IsString()) {
+      out.application = opus.Get("application").As<Napi::String>().Utf8Value();
+      if (!IsOneOf(out.application, {"voip", "audio", "lowdelay"})) {
+        return "opus.application must be \"voip\", \"audio\" or \"lowdelay\"";
+      }
+    }
+    if (opus.Has("frameDuration") && opus.Get("frameDuration").IsNumber()) {
+      out.frame_duration = opus.Get("frameDuration").As<Napi::Number>().Int64Value();
+      if (std::find(std::begin(kOpusFrameDurations), std::end(kOpusFrameDurations), out.frame_duration) ==
+          std::end(kOpusFrameDurations)) {
+        return "opus.frameDuration must be 2500, 5000, 10000, 20000, 40000, 60000, 80000, 100000 or 120000";
+      }
+    }
+    if (opus.Has("complexity") && opus.Get("complexity").IsNumber()) {
+      int64_t complexity = opus.Get("complexity").As<Napi::Number>().Int64Value();
+      if (complexity < 0 || complexity > 10) return "opus.complexity must be between 0 and 10";
+      out.complexity = static_cast<int>(complexity);
+    }
+    if (opus.Has("packetlossperc") && opus.Get("packetlossperc").IsNumber()) {
+      int64_t percent = opus.Get("packetlossperc").As<Napi::Number>().Int64Value();
+      if (percent < 0 || percent > 100) return "opus.packetlossperc must be between 0 and 100";
+      out.packetlossperc = static_cast<int>(percent);
+    }
+    if (opus.Has("useinbandfec") && opus.Get("useinbandfec").IsBoolean()) {
+      out.useinbandfec = opus.Get("useinbandfec").As<Napi::Boolean>().Value();
+    }
+    if (opus.Has("usedtx") && opus.Get("usedtx").IsBoolean()) {
+      out.usedtx = opus.Get("usedtx").As<Napi::Boolean>().Value();
+    }
+  }
+
+  if (js.Has("aac") && js.Get("aac").IsObject()) {
+    Napi::Object aac = js.Get("aac").As<Napi::Object>();
+    if (aac.Has("format") && aac.Get("format").IsString()) {
+      config->aac_format = aac.Get("format").As<Napi::String>().Utf8Value();
+      if (!IsOneOf(config->aac_format, {"aac", "adts"})) return "aac.format must be \"aac\" or \"adts\"";
+    }
+  }
+  return "";
+}
+
+// Copy the listed members of a codec registry dictionary that are present
+Napi::Object CloneMembers(Napi::Env env, const Napi::Object& src, std::initializer_list<const char*> names) {
+  Napi::Object dst = Napi::Object::New(env);
+  for (const char* name : names) {
+    if (src.Has(name) && !src.Get(name).IsUndefined()) dst.Set(name, src.Get(name));
+  }
+  return dst;
+}
+
+/**
+ * Map the codec registry Opus options and bitrateMode onto an unopened
+ * libopus (or native opus) encoder context. complexity is libopus'
+ * CPU/quality knob: encode cost per stream varies about 3x over 0-10.
+ *
+ * Options are hints: a library build that lacks one keeps its default.
+ */
+void ApplyOpusConfig(AVCodecContext* ctx, const AudioEncoder::EncoderConfig& config) {
+  const char* codec_name = ctx->codec ? ctx->codec->name : nullptr;
+  if (!codec_name || !ctx->priv_data) return;
+  const AudioEncoder::OpusConfig& opus = config.opus;
+  const double frame_duration_ms = static_cast<double>(opus.frame_duration) / 1000.0;
+
+  if (strcmp(codec_name, "libopus") == 0) {
+    if (!opus.application.empty()) {
+      av_opt_set(ctx->priv_data, "application", opus.application.c_str(), 0);
+    }
+    av_opt_set_double(ctx->priv_data, "frame_duration", frame_duration_ms, 0);
+    if (opus.complexity >= 0) {
+      ctx->compression_level = opus.complexity;
+    }
+    av_opt_set_int(ctx->priv_data, "packet_loss", opus.packetlossperc, 0);
+    av_opt_set_int(ctx->priv_data, "fec", opus.useinbandfec ? 1 : 0, 0);
+    av_opt_set_int(ctx->priv_data, "dtx", opus.usedtx ? 1 : 0, 0);
+    if (config.bitrate_mode == "constant") {
+      av_opt_set(ctx->priv_data, "vbr", "off", 0);
+    }
+  } else if (strcmp(codec_name, "opus") == 0) {
+    av_opt_set_double(ctx->priv_data, "opus_delay", frame_duration_ms, 0);
+  }
+}
+
+}  // namespace
+
 // =============================================================================
 // AUDIOENCODER IMPLEMENTATION
 // =============================================================================
@@ -22,9 +156,11 @@ Napi::Object AudioEncoder::Init(Napi::Env env, Napi::Object exports) {
                   {
                       InstanceAccessor<&AudioEncoder::GetState>("state"),
                       InstanceAccessor<&AudioEncoder::GetEncodeQueueSize>("encodeQueueSize"),
+                      InstanceAccessor<&AudioEncoder::GetStats>("stats"),
                       InstanceAccessor<&AudioEncoder::GetOndequeue, &AudioEncoder::SetOndequeue>("ondequeue"),
                       InstanceMethod<&AudioEncoder::Configure>("configure"),
                       InstanceMethod<&AudioEncoder::Encode>("encode"),
+                      InstanceMethod<&AudioEncoder::EncodeBatch>("encodeBatch"),
                       InstanceMethod<&AudioEncoder::Flush>("flush"),
                       InstanceMethod<&AudioEncoder::Reset>("reset"),
                       InstanceMethod<&AudioEncoder::Close>("close"),
@@ -206,9 +342,10 @@ void AudioEncoder::OnOutputChunk(Napi::Env env, Napi::Function jsCallback,
     decoderConfig.Set("sampleRate", Napi::Number::New(env, context->active_config_.sample_rate));
     decoderConfig.Set("numberOfChannels", Napi::Number::New(env, context->active_config_.number_of_channels));
 
-    // Include extradata as description if available
+    // Include extradata as description if available (ADTS chunks carry their own headers)
     AVCodecContext* codec_ctx = context->worker_->GetCodecContext();
-    if (codec_ctx && codec_ctx->extradata && codec_ctx->extradata_size > 0) {
+    if (codec_ctx && codec_ctx->extradata && codec_ctx->extradata_size > 0 &&
+        context->active_config_.aac_format != "adts") {
       Napi::ArrayBuffer desc = Napi::ArrayBuffer::New(env, codec_ctx->extradata_size);
       std::memcpy(desc.Data(), codec_ctx->extradata, codec_ctx->extradata_size);
       decoderConfig.Set("description", Napi::Uint8Array::New(env, codec_ctx->extradata_size, desc, 0));
@@ -303,6 +440,11 @@ Napi::Value AudioEncoder::GetEncodeQueueSize(const Napi::CallbackInfo& info) {
   return Napi::Number::New(info.Env(), static_cast<double>(encode_queue_size_.load(std::memory_order_acquire)));
 }
 
+Napi::Value AudioEncoder::GetStats(const Napi::CallbackInfo& info) {
+  // Non-standard: sample buffer counters since the last configure()
+  return AudioBufferCountersToObject(info.Env(), buffer_counters_);
+}
+
 Napi::Value AudioEncoder::GetOndequeue(const Napi::CallbackInfo& info) {
   if (ondequeue_callback_.IsEmpty()) {
     return info.Env().Null();
@@ -383,6 +525,13 @@ Napi::Value AudioEncoder::Configure(const Napi::CallbackInfo& info) {
     active_config_.bitrate_mode = config.Get("bitrateMode").As<Napi::String>().Utf8Value();
   }
 
+  // Codec registry extensions: opus.*, aac.format
+  std::string extension_error = ParseCodecExtensions(config, &active_config_);
+  if (!extension_error.empty()) {
+    errors::ThrowTypeError(env, extension_error);
+    return env.Undefined();
+  }
+
   // Validate codec string before queuing (fail fast)
   auto codec_info = ParseCodecString(active_config_.codec);
   if (!codec_info) {
@@ -396,6 +545,12 @@ Napi::Value AudioEncoder::Configure(const Napi::CallbackInfo& info) {
     return env.Undefined();
   }
 
+  // Chunks are raw Opus packets; Ogg encapsulation is a container's job
+  if (codec_info->codec_id == AV_CODEC_ID_OPUS && active_config_.opus.format == "ogg") {
+    errors::ThrowNotSupportedError(env, "opus.format \"ogg\" is not supported");
+    return env.Undefined();
+  }
+
   // Start worker if not running
   if (!worker_->IsRunning()) {
     worker_->Start();
@@ -413,6 +568,9 @@ Napi::Value AudioEncoder::Configure(const Napi::CallbackInfo& info) {
     return env.Undefined();
   }
 
+  // Stats cover the current configuration only
+  buffer_counters_.Reset();
+
   // [SPEC] 3. Set state to "configured"
   state_.transition(raii::AtomicCodecState::State::Unconfigured, raii::AtomicCodecState::State::Configured);
 
@@ -428,13 +586,85 @@ Napi::Value AudioEncoder::Encode(const Napi::CallbackInfo& info) {
     return env.Undefined();
   }
 
+  AudioControlQueue::EncodeMessage msg;
+  if (!BuildEncodeMessage(env, info.Length() > 0 ? info[0] : env.Undefined(), &msg)) {
+    return env.Undefined();
+  }
+
+  // [SPEC] Increment encodeQueueSize
+  encode_queue_size_.fetch_add(1, std::memory_order_relaxed);
+
+  // PCM/G.711 is a copy, byte swap or table lookup: with nothing queued ahead
+  // of this AudioData it is encoded here, its output still delivered through
+  // the TSFN, and EncodeInline() releases the count as the worker would
+  if (queue_.Idle() && worker_->EncodeInline(msg.frame.get())) {
+    return env.Undefined();
+  }
+
+  // Enqueue encode message
+  if (!queue_.Enqueue(std::move(msg))) {
+    encode_queue_size_.fetch_sub(1, std::memory_order_relaxed);
+    errors::ThrowInvalidStateError(env, "Failed to enqueue encode");
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value AudioEncoder::EncodeBatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  // Non-standard: encode() for each element, enqueued under one lock/notify
+  if (!state_.IsConfigured()) {
+    errors::ThrowInvalidStateError(env, "encodeBatch called on " + std::string(state_.ToString()) + " encoder");
+    return env.Undefined();
+  }
+
+  if (info.Length() < 1 || !info[0].IsArray()) {
+    errors::ThrowTypeError(env, "encodeBatch requires an array of AudioData");
+    return env.Undefined();
+  }
+
+  Napi::Array items = info[0].As<Napi::Array>();
+  uint32_t length = items.Length();
+  std::vector<AudioControlQueue::Message> messages;
+  messages.reserve(length);
+  for (uint32_t i = 0; i < length; i++) {
+    AudioControlQueue::EncodeMessage msg;
+    if (!BuildEncodeMessage(env, items.Get(i), &msg)) {
+      // Same as encode() in a loop: earlier data stays queued, the error propagates
+      break;
+    }
+    if (messages.empty() && queue_.Idle()) {
+      // Counted like encode(); EncodeInline() releases it on success
+      encode_queue_size_.fetch_add(1, std::memory_order_relaxed);
+      if (worker_->EncodeInline(msg.frame.get())) continue;
+      encode_queue_size_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    messages.emplace_back(std::move(msg));
+  }
+
+  uint32_t count = static_cast<uint32_t>(messages.size());
+  encode_queue_size_.fetch_add(count, std::memory_order_relaxed);
+  if (!queue_.EnqueueBatch(messages)) {
+    encode_queue_size_.fetch_sub(count, std::memory_order_relaxed);
+    if (!env.IsExceptionPending()) {
+      errors::ThrowInvalidStateError(env, "Failed to enqueue encode");
+    }
+  }
+
+  return env.Undefined();
+}
+
+bool AudioEncoder::BuildEncodeMessage(Napi::Env env, const Napi::Value& value,
+                                      AudioControlQueue::EncodeMessage* msg) {
   // Validate AudioData argument
-  if (info.Length() < 1 || !info[0].IsObject()) {
+  if (!value.IsObject()) {
     errors::ThrowTypeError(env, "AudioData is required");
-    return env.Undefined();
+    return false;
   }
 
-  Napi::Object dataObj = info[0].As<Napi::Object>();
+  Napi::Object dataObj = value.As<Napi::Object>();
 
   // Get AudioData wrapper - handle both native objects and TypeScript wrappers
   AudioData* audioDataWrapper = nullptr;
@@ -457,34 +687,29 @@ Napi::Value AudioEncoder::Encode(const Napi::CallbackInfo& info) {
 
   if (!audioDataWrapper) {
     errors::ThrowTypeError(env, "AudioData is required");
-    return env.Undefined();
+    return false;
   }
 
   const AVFrame* srcFrame = audioDataWrapper->frame();
   if (!srcFrame) {
     errors::ThrowTypeError(env, "AudioData is closed or invalid");
-    return env.Undefined();
+    return false;
   }
 
   // [SPEC] Clone frame for async processing
   raii::AVFramePtr frameClone = raii::CloneAvFrame(srcFrame);
   if (!frameClone) {
     errors::ThrowEncodingError(env, "Failed to clone audio data");
-    return env.Undefined();
+    return false;
   }
 
-  // [SPEC] Increment encodeQueueSize
-  encode_queue_size_.fetch_add(1, std::memory_order_relaxed);
+  // The worker anchors encoder timestamps on this (microseconds)
+  frameClone->pts = audioDataWrapper->timestamp();
 
-  // Enqueue encode message (audio has no keyFrame option)
-  AudioControlQueue::EncodeMessage msg{std::move(frameClone), false};
-  if (!queue_.Enqueue(std::move(msg))) {
-    encode_queue_size_.fetch_sub(1, std::memory_order_relaxed);
-    errors::ThrowInvalidStateError(env, "Failed to enqueue encode");
-    return env.Undefined();
-  }
-
-  return env.Undefined();
+  // Audio has no keyFrame option
+  msg->frame = std::move(frameClone);
+  msg->key_frame = false;
+  return true;
 }
 
 Napi::Value AudioEncoder::Flush(const Napi::CallbackInfo& info) {
@@ -630,15 +855,25 @@ Napi::Value AudioEncoder::IsConfigSupported(const Napi::CallbackInfo& info) {
 
   std::string codec_string = config.Get("codec").As<Napi::String>().Utf8Value();
 
+  AudioEncoder::EncoderConfig extensions;
+  std::string extension_error = ParseCodecExtensions(config, &extensions);
+  if (!extension_error.empty()) {
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    deferred.Reject(Napi::TypeError::New(env, extension_error).Value());
+    return deferred.Promise();
+  }
+
   // [SPEC] 2. Create promise
   Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
 
-  // Check if codec is supported for encoding
-  auto codec_info = ParseCodecString(codec_string);
-  bool supported = false;
-  if (codec_info) {
-    const AVCodec* encoder = avcodec_find_encoder(codec_info->codec_id);
-    supported = (encoder != nullptr);
+  // Answer from the process-wide capability table (no libavcodec calls after
+  // the first lookup of a codec)
+  int sample_rate = config.Get("sampleRate").As<Napi::Number>().Int32Value();
+  int channels = config.Get("numberOfChannels").As<Napi::Number>().Int32Value();
+  auto lookup = LookupCodecString(codec_string);
+  bool supported = lookup && lookup->capabilities->SupportsAudioEncode(sample_rate, channels);
+  if (lookup && lookup->info.codec_id == AV_CODEC_ID_OPUS && extensions.opus.format == "ogg") {
+    supported = false;
   }
 
   // [SPEC] Create AudioEncoderSupport object
@@ -661,6 +896,14 @@ Napi::Value AudioEncoder::IsConfigSupported(const Napi::CallbackInfo& info) {
   if (config.Has("bitrateMode") && config.Get("bitrateMode").IsString()) {
     clonedConfig.Set("bitrateMode", config.Get("bitrateMode"));
   }
+  if (config.Has("opus") && config.Get("opus").IsObject()) {
+    clonedConfig.Set("opus", CloneMembers(env, config.Get("opus").As<Napi::Object>(),
+                                          {"format", "signal", "application", "frameDuration", "complexity",
+                                           "packetlossperc", "useinbandfec", "usedtx"}));
+  }
+  if (config.Has("aac") && config.Get("aac").IsObject()) {
+    clonedConfig.Set("aac", CloneMembers(env, config.Get("aac").As<Napi::Object>(), {"format"}));
+  }
 
   result.Set("config", clonedConfig);
 
@@ -686,6 +929,8 @@ bool AudioEncoderWorker::OnConfigure(const ConfigureMessage& msg) {
   if (!encoder_) return false;
 
   const AudioEncoder::EncoderConfig& config = encoder_->active_config_;
+  inline_format_.reset();
+  adts_.reset();
 
   // Parse codec string
   auto codec_info = ParseCodecString(config.codec);
@@ -763,6 +1008,11 @@ bool AudioEncoderWorker::OnConfigure(const ConfigureMessage& msg) {
     codec_ctx_->rc_min_rate = codec_ctx_->bit_rate;
   }
 
+  // Codec registry Opus options (application, frame duration, complexity, FEC, DTX)
+  if (codec_info->codec_id == AV_CODEC_ID_OPUS) {
+    ApplyOpusConfig(codec_ctx_.get(), config);
+  }
+
   // Threading
   codec_ctx_->thread_count = 0;  // Auto-detect
 
@@ -774,10 +1024,34 @@ bool AudioEncoderWorker::OnConfigure(const ConfigureMessage& msg) {
     return false;
   }
 
+  // aac.format "adts": header fields come from the AudioSpecificConfig
+  if (codec_info->codec_id == AV_CODEC_ID_AAC && config.aac_format == "adts") {
+    adts_ = adts::ParseAudioSpecificConfig(codec_ctx_->extradata,
+                                           static_cast<size_t>(std::max(codec_ctx_->extradata_size, 0)));
+    if (!adts_) {
+      OutputError(AVERROR_PATCHWELCOME, "AAC configuration cannot be framed as ADTS");
+      codec_ctx_.reset();
+      return false;
+    }
+  }
+
+  // Fixed frame size encoders get their input re-chunked on this thread
+  if (!fifo_.Init(codec_ctx_.get(), &encoder_->buffer_counters_)) {
+    OutputError(AVERROR(ENOMEM), "Failed to allocate audio FIFO");
+    codec_ctx_.reset();
+    return false;
+  }
+
   // Reset state for new configuration
+  ResetResampler();
+  converted_.reset();
+  converted_capacity_ = 0;
   first_output_after_configure_ = true;
   sample_count_ = 0;
 
+  // Stateless PCM/G.711 can be encoded by the JS thread whenever this worker is idle
+  inline_format_ = pcm_codec::Find(codec_info->codec_id);
+
   return true;
 }
 
@@ -803,26 +1077,109 @@ void AudioEncoderWorker::OnEncode(const EncodeMessage& msg) {
     return;
   }
 
-  // Set frame PTS (sample-based for audio)
-  if (frame->pts == AV_NOPTS_VALUE) {
-    frame->pts = sample_count_;
+  // AudioData timestamps are microseconds; the encoder counts samples
+  const int in_rate = frame->sample_rate > 0 ? frame->sample_rate : sample_rate_;
+  const int64_t pts = frame->pts != AV_NOPTS_VALUE
+                          ? av_rescale_q(frame->pts, AVRational{1, 1000000}, codec_ctx_->time_base)
+                          : sample_count_;
+  sample_count_ = pts + av_rescale(frame->nb_samples, sample_rate_, in_rate);
+
+  int ret = 0;
+  if (frame->format == sample_fmt_ && FrameChannels(frame) == channels_ && in_rate == sample_rate_) {
+    // Input already matches; finish any conversion of earlier input first
+    if (swr_) ret = DrainResampler();
+    if (ret >= 0) ret = EncodeSamples(frame, pts);
+  } else {
+    AVFrame* converted = nullptr;
+    ret = ConvertFrame(frame, pts, &converted);
+    if (ret >= 0 && converted) ret = EncodeSamples(converted, converted->pts);
+  }
+  if (ret < 0) {
+    OutputError(ret, "Failed to encode audio: " + errors::FfmpegErrorString(ret));
   }
-  sample_count_ += frame->nb_samples;
 
-  // Send frame to encoder
+  // Normal exit path
+  signal_dequeue_on_exit();
+}
+
+bool AudioEncoderWorker::EncodeInline(const AVFrame* frame) {
+  if (!inline_format_ || !codec_ctx_ || !encoder_ || !frame || frame->nb_samples <= 0) return false;
+
+  // Resampling, channel mapping, samples held by the resampler and
+  // integer-to-integer conversions stay on the worker
+  const auto in_fmt = static_cast<AVSampleFormat>(frame->format);
+  const int in_rate = frame->sample_rate > 0 ? frame->sample_rate : sample_rate_;
+  sample_kernels::SampleType in_type;
+  sample_kernels::SampleType out_type;
+  if (swr_ || fifo_.enabled() || in_rate != sample_rate_ || FrameChannels(frame) != channels_ ||
+      !sample_kernels::ToSampleType(in_fmt, &in_type) ||
+      !sample_kernels::ToSampleType(sample_fmt_, &out_type) || !sample_kernels::CanConvert(in_type, out_type)) {
+    return false;
+  }
+
+  // Interleaved samples in the encoder's sample format, as OnEncode would
+  // have had libswresample produce them
+  const size_t frames = static_cast<size_t>(frame->nb_samples);
+  const size_t count = frames * channels_;
+  const size_t out_size = sample_kernels::SampleSize(out_type);
+  const uint8_t* samples = frame->extended_data[0];
+  if (av_sample_fmt_is_planar(in_fmt) && channels_ > 1) {
+    std::vector<const uint8_t*> planes(channels_);
+    if (in_type != out_type) {
+      inline_planes_.resize(count * out_size);
+      for (int ch = 0; ch < channels_; ch++) {
+        uint8_t* plane = inline_planes_.data() + ch * frames * out_size;
+        sample_kernels::Convert(in_type, frame->extended_data[ch], out_type, plane, frames);
+        planes[ch] = plane;
+      }
+    } else {
+      for (int ch = 0; ch < channels_; ch++) planes[ch] = frame->extended_data[ch];
+    }
+    inline_samples_.resize(count * out_size);
+    sample_kernels::Interleave(planes.data(), channels_, frames, out_size, inline_samples_.data());
+    samples = inline_samples_.data();
+  } else if (in_type != out_type) {
+    inline_samples_.resize(count * out_size);
+    sample_kernels::Convert(in_type, samples, out_type, inline_samples_.data(), count);
+    samples = inline_samples_.data();
+  }
+
+  raii::AVPacketPtr packet = raii::MakeAvPacket();
+  int ret = packet ? av_new_packet(packet.get(), static_cast<int>(count * inline_format_->coded_size))
+                   : AVERROR(ENOMEM);
+  if (ret >= 0) {
+    pcm_codec::Encode(*inline_format_, samples, count, packet->data);
+
+    // Timestamps as OnEncode and SendFrame derive them
+    const AVRational us{1, 1000000};
+    const int64_t pts = frame->pts != AV_NOPTS_VALUE ? av_rescale_q(frame->pts, us, codec_ctx_->time_base)
+                                                     : sample_count_;
+    sample_count_ = pts + frame->nb_samples;
+    const bool include_config = first_output_after_configure_;
+    first_output_after_configure_ = false;
+    OutputChunk(std::move(packet), true, av_rescale_q(pts, codec_ctx_->time_base, us),
+                av_rescale_q(frame->nb_samples, codec_ctx_->time_base, us), include_config);
+  } else {
+    OutputError(ret, "Failed to encode audio: " + errors::FfmpegErrorString(ret));
+  }
+
+  // [SPEC] Decrement encodeQueueSize (counted by the caller), as OnEncode() does
+  uint32_t new_size = encoder_->encode_queue_size_.fetch_sub(1, std::memory_order_relaxed) - 1;
+  SignalDequeue(new_size);
+  return true;
+}
+
+int AudioEncoderWorker::SendFrame(const AVFrame* frame) {
+  // Send frame to encoder (nullptr enters draining mode)
   int ret = avcodec_send_frame(codec_ctx_.get(), frame);
-  if (ret < 0 && ret != AVERROR(EAGAIN)) {
-    OutputError(ret, "Failed to send frame to encoder");
-    signal_dequeue_on_exit();
-    return;
+  if (ret < 0 && ret != AVERROR(EAGAIN) && !(frame == nullptr && ret == AVERROR_EOF)) {
+    return ret;
   }
 
   // Receive all available packets
   raii::AVPacketPtr packet = raii::MakeAvPacket();
   if (!packet) {
-    OutputError(AVERROR(ENOMEM), "Failed to allocate packet");
-    signal_dequeue_on_exit();
-    return;
+    return AVERROR(ENOMEM);
   }
 
   while (!ShouldExit()) {
@@ -835,13 +1192,11 @@ void AudioEncoderWorker::OnEncode(const EncodeMessage& msg) {
       break;  // End of stream
     }
     if (ret < 0) {
-      OutputError(ret, "Error receiving packet");
-      signal_dequeue_on_exit();
-      return;
+      return ret;
     }
 
     // Audio packets are typically all key frames
-    bool is_key = (packet->flags & AV_PKT_FLAG_KEY) != 0 || true;
+    bool is_key = true;
 
     // Include decoder config on first packet after configure
     bool include_config = first_output_after_configure_;
@@ -849,7 +1204,8 @@ void AudioEncoderWorker::OnEncode(const EncodeMessage& msg) {
       first_output_after_configure_ = false;
     }
 
-    // Get timestamp and duration
+    // EncodedAudioChunk timestamp and duration are microseconds
+    av_packet_rescale_ts(packet.get(), codec_ctx_->time_base, AVRational{1, 1000000});
     int64_t timestamp = packet->pts != AV_NOPTS_VALUE ? packet->pts : 0;
     int64_t duration = packet->duration > 0 ? packet->duration : 0;
 
@@ -862,8 +1218,114 @@ void AudioEncoderWorker::OnEncode(const EncodeMessage& msg) {
     av_packet_unref(packet.get());
   }
 
-  // Normal exit path
-  signal_dequeue_on_exit();
+  return 0;
+}
+
+int AudioEncoderWorker::EncodeSamples(AVFrame* frame, int64_t pts) {
+  if (!fifo_.enabled()) {
+    frame->pts = pts;
+    return SendFrame(frame);
+  }
+
+  // Re-chunk to exactly frame_size samples
+  int ret = fifo_.Write(frame, pts);
+  while (ret >= 0 && !ShouldExit()) {
+    raii::AVFramePtr chunk = fifo_.ReadFrame();
+    if (!chunk) break;
+    ret = SendFrame(chunk.get());
+  }
+  return ret;
+}
+
+int AudioEncoderWorker::ConvertFrame(const AVFrame* frame, int64_t pts, AVFrame** out) {
+  *out = nullptr;
+
+  if (frame) {
+    const int in_rate = frame->sample_rate > 0 ? frame->sample_rate : sample_rate_;
+    const int in_channels = FrameChannels(frame);
+    const auto in_fmt = static_cast<AVSampleFormat>(frame->format);
+    if (swr_ && (in_fmt != swr_in_fmt_ || in_rate != swr_in_rate_ || in_channels != swr_in_channels_)) {
+      int ret = DrainResampler();
+      if (ret < 0) return ret;
+    }
+
+    if (!swr_) {
+      AVChannelLayout in_layout;
+      AVChannelLayout out_layout;
+      av_channel_layout_default(&in_layout, in_channels);
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+      av_channel_layout_copy(&out_layout, &codec_ctx_->ch_layout);
+#else
+      av_channel_layout_default(&out_layout, channels_);
+#endif
+      swr_ = raii::MakeSwrContextInitialized(&out_layout, sample_fmt_, sample_rate_, &in_layout,
+                                             in_fmt, in_rate);
+      av_channel_layout_uninit(&in_layout);
+      av_channel_layout_uninit(&out_layout);
+      if (!swr_) return AVERROR(EINVAL);
+      swr_in_fmt_ = in_fmt;
+      swr_in_rate_ = in_rate;
+      swr_in_channels_ = in_channels;
+    }
+  }
+  if (!swr_) return 0;
+
+  // Samples held back by the resampler come out ahead of this input
+  const int64_t start = frame ? pts - swr_get_delay(swr_.get(), sample_rate_) : swr_next_pts_;
+  const int in_samples = frame ? frame->nb_samples : 0;
+  const int capacity = swr_get_out_samples(swr_.get(), in_samples);
+  if (capacity < 0) return capacity;
+  if (capacity == 0) return 0;
+
+  // Reuse the output frame unless the encoder still holds a reference to it
+  if (!converted_ || capacity > converted_capacity_ || !av_frame_is_writable(converted_.get())) {
+    converted_ = raii::MakeAvFrame();
+    if (!converted_) return AVERROR(ENOMEM);
+    converted_->format = sample_fmt_;
+    converted_->sample_rate = sample_rate_;
+    converted_->nb_samples = std::max(capacity, converted_capacity_);
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+    av_channel_layout_copy(&converted_->ch_layout, &codec_ctx_->ch_layout);
+#else
+    converted_->channels = channels_;
+    converted_->channel_layout = codec_ctx_->channel_layout;
+#endif
+    int ret = GlobalAudioBufferPool::Instance().GetBuffer(converted_.get(), &encoder_->buffer_counters_);
+    if (ret < 0) {
+      converted_.reset();
+      return ret;
+    }
+    converted_capacity_ = converted_->nb_samples;
+  }
+
+  const int converted = swr_convert(swr_.get(), converted_->extended_data, capacity,
+                                    frame ? const_cast<const uint8_t**>(frame->extended_data) : nullptr,
+                                    in_samples);
+  if (converted < 0) return converted;
+
+  swr_next_pts_ = start + converted;
+  if (converted > 0) {
+    converted_->nb_samples = converted;
+    converted_->pts = start;
+    *out = converted_.get();
+  }
+  return 0;
+}
+
+int AudioEncoderWorker::DrainResampler() {
+  AVFrame* converted = nullptr;
+  int ret = ConvertFrame(nullptr, 0, &converted);
+  if (ret >= 0 && converted) ret = EncodeSamples(converted, converted->pts);
+  ResetResampler();
+  return ret;
+}
+
+void AudioEncoderWorker::ResetResampler() {
+  swr_.reset();
+  swr_in_fmt_ = AV_SAMPLE_FMT_NONE;
+  swr_in_rate_ = 0;
+  swr_in_channels_ = 0;
+  swr_next_pts_ = 0;
 }
 
 void AudioEncoderWorker::OnFlush(const FlushMessage& msg) {
@@ -872,44 +1334,29 @@ void AudioEncoderWorker::OnFlush(const FlushMessage& msg) {
     return;
   }
 
-  // Send NULL frame to trigger drain
-  int ret = avcodec_send_frame(codec_ctx_.get(), nullptr);
-  if (ret < 0 && ret != AVERROR_EOF) {
+  // Samples still in the resampler, then samples short of a full frame
+  // going out as the last frame
+  int ret = DrainResampler();
+  if (ret < 0) {
+    fifo_.Reset();
     FlushComplete(msg.promise_id, false, errors::FfmpegErrorString(ret));
     return;
   }
-
-  // Receive all remaining packets
-  raii::AVPacketPtr packet = raii::MakeAvPacket();
-  if (!packet) {
-    FlushComplete(msg.promise_id, false, "Failed to allocate packet");
-    return;
-  }
-
-  while (!ShouldExit()) {
-    ret = avcodec_receive_packet(codec_ctx_.get(), packet.get());
-
-    if (ret == AVERROR_EOF) {
-      break;  // All packets drained
-    }
-    if (ret == AVERROR(EAGAIN)) {
-      break;  // Should not happen after null frame
-    }
+  raii::AVFramePtr tail = fifo_.ReadTail();
+  fifo_.Reset();
+  if (tail) {
+    ret = SendFrame(tail.get());
     if (ret < 0) {
       FlushComplete(msg.promise_id, false, errors::FfmpegErrorString(ret));
       return;
     }
+  }
 
-    bool is_key = true;
-    int64_t timestamp = packet->pts != AV_NOPTS_VALUE ? packet->pts : 0;
-    int64_t duration = packet->duration > 0 ? packet->duration : 0;
-
-    raii::AVPacketPtr outputPacket = raii::CloneAvPacket(packet.get());
-    if (outputPacket) {
-      OutputChunk(std::move(outputPacket), is_key, timestamp, duration, false);
-    }
-
-    av_packet_unref(packet.get());
+  // Send NULL frame to trigger drain, then receive all remaining packets
+  ret = SendFrame(nullptr);
+  if (ret < 0) {
+    FlushComplete(msg.promise_id, false, errors::FfmpegErrorString(ret));
+    return;
   }
 
   // Signal flush complete
@@ -920,11 +1367,19 @@ void AudioEncoderWorker::OnReset() {
   if (codec_ctx_) {
     avcodec_flush_buffers(codec_ctx_.get());
   }
+  fifo_.Reset();
+  ResetResampler();
   first_output_after_configure_ = true;
   sample_count_ = 0;
 }
 
 void AudioEncoderWorker::OnClose() {
+  inline_format_.reset();
+  adts_.reset();
+  fifo_.Reset();
+  ResetResampler();
+  converted_.reset();
+  converted_capacity_ = 0;
   codec_ctx_.reset();
 }
 
@@ -932,6 +1387,22 @@ void AudioEncoderWorker::OutputChunk(raii::AVPacketPtr packet, bool is_key,
                                       int64_t ts, int64_t dur, bool include_config) {
   if (!encoder_ || encoder_->state_.IsClosed()) return;
 
+  if (adts_) {
+    raii::AVPacketPtr framed = raii::MakeAvPacket();
+    int ret = framed ? av_new_packet(framed.get(), packet->size + static_cast<int>(adts::kHeaderSize))
+                     : AVERROR(ENOMEM);
+    if (ret >= 0 && !adts::WriteHeader(*adts_, static_cast<size_t>(packet->size), framed->data)) {
+      ret = AVERROR(ERANGE);
+    }
+    if (ret >= 0) ret = av_packet_copy_props(framed.get(), packet.get());
+    if (ret < 0) {
+      OutputError(ret, "Failed to add ADTS header");
+      return;
+    }
+    std::memcpy(framed->data + adts::kHeaderSize, packet->data, static_cast<size_t>(packet->size));
+    packet = std::move(framed);
+  }
+
   auto* data = new AudioEncoder::OutputData{
       std::move(packet),
       is_key,
@@ -18,12 +18,18 @@
 #include <atomic>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "ffmpeg_raii.h"
+#include "shared/aac_adts.h"
+#include "shared/audio_buffer_pool.h"
+#include "shared/audio_frame_fifo.h"
 #include "shared/control_message_queue.h"
 #include "shared/codec_worker.h"
+#include "shared/pcm_codec.h"
 #include "shared/safe_tsfn.h"
 
 namespace webcodecs {
@@ -95,6 +101,21 @@ class AudioEncoder : public Napi::ObjectWrap<AudioEncoder> {
   // ENCODER CONFIGURATION
   // ==========================================================================
 
+  /**
+   * Codec registry OpusEncoderConfig (`opus` member).
+   * @see https://www.w3.org/TR/webcodecs-opus-codec-registration/
+   */
+  struct OpusConfig {
+    std::string format = "opus";     // "opus" (raw packets) or "ogg" (not supported)
+    std::string application;         // "voip", "audio" or "lowdelay"; empty = encoder default
+    std::string signal;              // "auto", "music" or "voice" (no libavcodec option)
+    int64_t frame_duration = 20000;  // Microseconds
+    int complexity = -1;             // 0-10, -1 = encoder default
+    int packetlossperc = 0;          // Expected packet loss, 0-100
+    bool useinbandfec = false;
+    bool usedtx = false;
+  };
+
   /**
    * Deep-copied configuration for async processing.
    */
@@ -104,6 +125,8 @@ class AudioEncoder : public Napi::ObjectWrap<AudioEncoder> {
     int number_of_channels = 0;
     int64_t bitrate = 0;
     std::string bitrate_mode;  // "constant" or "variable"
+    OpusConfig opus;
+    std::string aac_format = "aac";  // Codec registry AacEncoderConfig.format: "aac" or "adts"
   };
 
   EncoderConfig active_config_;
@@ -164,6 +187,9 @@ class AudioEncoder : public Napi::ObjectWrap<AudioEncoder> {
   // [SPEC] [[dequeue event scheduled]] - coalesces multiple dequeue events
   std::atomic<bool> dequeue_event_scheduled_{false};
 
+  // Non-standard sample buffer statistics (exposed via `stats`)
+  AudioBufferCounters buffer_counters_;
+
   // Pending flush promises (protected by flush_mutex_)
   std::unordered_map<uint32_t, Napi::Promise::Deferred> pending_flushes_;
   uint32_t next_flush_id_{0};
@@ -183,6 +209,7 @@ class AudioEncoder : public Napi::ObjectWrap<AudioEncoder> {
 
   Napi::Value GetState(const Napi::CallbackInfo& info);
   Napi::Value GetEncodeQueueSize(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
   Napi::Value GetOndequeue(const Napi::CallbackInfo& info);
   void SetOndequeue(const Napi::CallbackInfo& info, const Napi::Value& value);
 
@@ -192,11 +219,16 @@ class AudioEncoder : public Napi::ObjectWrap<AudioEncoder> {
 
   Napi::Value Configure(const Napi::CallbackInfo& info);
   Napi::Value Encode(const Napi::CallbackInfo& info);
+  Napi::Value EncodeBatch(const Napi::CallbackInfo& info);
   Napi::Value Flush(const Napi::CallbackInfo& info);
   Napi::Value Reset(const Napi::CallbackInfo& info);
   Napi::Value Close(const Napi::CallbackInfo& info);
   static Napi::Value IsConfigSupported(const Napi::CallbackInfo& info);
 
+  // Validate one AudioData and build its encode message; throws and returns false on error
+  bool BuildEncodeMessage(Napi::Env env, const Napi::Value& value,
+                          AudioControlQueue::EncodeMessage* msg);
+
   // Friend declaration for worker access
   friend class AudioEncoderWorker;
 };
@@ -229,6 +261,19 @@ class AudioEncoderWorker : public CodecWorker<AudioControlQueue> {
    */
   AVCodecContext* GetCodecContext() const { return codec_ctx_.get(); }
 
+  /**
+   * Encode AudioData for a PCM/G.711 codec on the calling (JS) thread,
+   * output and dequeue event going through the TSFNs as usual. Only call
+   * while AudioControlQueue::Idle(), which also orders it after every
+   * earlier message. The caller counts the data in encodeQueueSize first;
+   * on success it is released here like a processed EncodeMessage.
+   *
+   * @return false if the input needs this worker (resampling, channel
+   *         mapping, integer-to-integer conversion) or the codec is not
+   *         PCM/G.711; frame is untouched
+   */
+  bool EncodeInline(const AVFrame* frame);
+
  protected:
   // ==========================================================================
   // VIRTUAL HANDLERS (called on worker thread)
@@ -251,11 +296,59 @@ class AudioEncoderWorker : public CodecWorker<AudioControlQueue> {
   bool first_output_after_configure_{true};
   int64_t sample_count_{0};  // Running sample position for PTS
 
+  // Re-chunks input to the encoder's fixed frame_size (AAC, Opus, MP3)
+  AudioFrameFifo fifo_;
+
+  // Converts input to the encoder's sample format, rate and channel count;
+  // kept while the input parameters stay the same
+  raii::SwrContextPtr swr_;
+  AVSampleFormat swr_in_fmt_{AV_SAMPLE_FMT_NONE};
+  int swr_in_rate_{0};
+  int swr_in_channels_{0};
+  int64_t swr_next_pts_{0};     // PTS following the last converted sample
+  raii::AVFramePtr converted_;  // Conversion output, reused while writable
+  int converted_capacity_{0};
+
+  // ADTS header fields when aac.format is "adts" (chunks carry the header)
+  std::optional<adts::Config> adts_;
+
+  // Inline PCM/G.711 (set by OnConfigure, used by EncodeInline while idle)
+  std::optional<pcm_codec::Format> inline_format_;
+  std::vector<uint8_t> inline_samples_;  // Interleaved input in sample_fmt_
+  std::vector<uint8_t> inline_planes_;   // Planar input converted to sample_fmt_
+
   // Codec parameters (copied from context after open)
   int sample_rate_{0};
   int channels_{0};
   AVSampleFormat sample_fmt_{AV_SAMPLE_FMT_NONE};
 
+  // ==========================================================================
+  // ENCODE HELPERS
+  // ==========================================================================
+
+  /**
+   * Send one frame (nullptr drains) and output every packet produced.
+   * Returns 0 or the negative AVERROR that stopped encoding.
+   */
+  int SendFrame(const AVFrame* frame);
+
+  /**
+   * Encode frame (pts in the codec time base), through the FIFO when the
+   * encoder has a fixed frame size.
+   */
+  int EncodeSamples(AVFrame* frame, int64_t pts);
+
+  /**
+   * Convert frame (nullptr drains the resampler) to the encoder's
+   * parameters. *out is nullptr when no samples came out, otherwise valid
+   * until the next call; its PTS accounts for the resampler delay.
+   */
+  int ConvertFrame(const AVFrame* frame, int64_t pts, AVFrame** out);
+
+  // Encode the samples still held by the resampler, then drop it
+  int DrainResampler();
+  void ResetResampler();
+
   // ==========================================================================
   // OUTPUT HELPERS
   // ==========================================================================
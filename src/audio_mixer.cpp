@@ -0,0 +1,650 @@
+#include "audio_mixer.h"
+
+#include <string>
+#include <vector>
+
+#include "audio_data.h"
+#include "error_builder.h"
+#include "shared/audio_buffer_pool.h"
+
+namespace webcodecs {
+
+Napi::FunctionReference AudioMixer::constructor;
+
+namespace {
+
+// Bounds shared with AudioData (sampleRate) and Opus (255 channels)
+constexpr int kMaxSampleRate = 768000;
+constexpr int kMaxChannels = 255;
+constexpr double kMaxDurationUs = 10000000;
+
+// Read an optional non-negative duration in microseconds; throws and returns false when invalid
+bool GetDuration(Napi::Env env, const Napi::Object& config, const char* name, double* value) {
+  if (!config.Has(name) || config.Get(name).IsUndefined()) return true;
+  Napi::Value v = config.Get(name);
+  double duration = v.IsNumber() ? v.As<Napi::Number>().DoubleValue() : -1;
+  if (!(duration >= 0) || duration > kMaxDurationUs) {
+    errors::ThrowTypeError(env, std::string(name) + " must be between 0 and 10000000 microseconds");
+    return false;
+  }
+  *value = duration;
+  return true;
+}
+
+// Native AudioData or the TypeScript wrapper around one
+AudioData* UnwrapAudioData(const Napi::Value& value) {
+  if (!value.IsObject()) return nullptr;
+  Napi::Object obj = value.As<Napi::Object>();
+  if (obj.InstanceOf(AudioData::constructor.Value())) {
+    return Napi::ObjectWrap<AudioData>::Unwrap(obj);
+  }
+  if (obj.Has("native")) {
+    Napi::Value native = obj.Get("native");
+    if (native.IsObject() && native.As<Napi::Object>().InstanceOf(AudioData::constructor.Value())) {
+      return Napi::ObjectWrap<AudioData>::Unwrap(native.As<Napi::Object>());
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+// =============================================================================
+// AUDIOMIXER IMPLEMENTATION
+// =============================================================================
+
+Napi::Object AudioMixer::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "AudioMixer",
+                                    {
+                                        InstanceAccessor<&AudioMixer::GetState>("state"),
+                                        InstanceMethod<&AudioMixer::Configure>("configure"),
+                                        InstanceMethod<&AudioMixer::Push>("push"),
+                                        InstanceMethod<&AudioMixer::RemoveSource>("removeSource"),
+                                        InstanceMethod<&AudioMixer::Flush>("flush"),
+                                        InstanceMethod<&AudioMixer::Reset>("reset"),
+                                        InstanceMethod<&AudioMixer::Close>("close"),
+                                    });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+  exports.Set("AudioMixer", func);
+  return exports;
+}
+
+AudioMixer::AudioMixer(const Napi::CallbackInfo& info) : Napi::ObjectWrap<AudioMixer>(info) {
+  Napi::Env env = info.Env();
+
+  // AudioMixerInit requires: output (AudioDataOutputCallback), error (WebCodecsErrorCallback)
+  if (info.Length() < 1 || !info[0].IsObject()) {
+    Napi::TypeError::New(env, "AudioMixerInit is required").ThrowAsJavaScriptException();
+    return;
+  }
+
+  Napi::Object init = info[0].As<Napi::Object>();
+
+  if (!init.Has("output") || !init.Get("output").IsFunction()) {
+    Napi::TypeError::New(env, "output callback is required").ThrowAsJavaScriptException();
+    return;
+  }
+
+  if (!init.Has("error") || !init.Get("error").IsFunction()) {
+    Napi::TypeError::New(env, "error callback is required").ThrowAsJavaScriptException();
+    return;
+  }
+
+  output_callback_ = Napi::Persistent(init.Get("output").As<Napi::Function>());
+  error_callback_ = Napi::Persistent(init.Get("error").As<Napi::Function>());
+
+  InitializeTSFNs(env);
+
+  // Create worker (but don't start until configure)
+  worker_ = std::make_unique<AudioMixerWorker>(queue_, this);
+}
+
+AudioMixer::~AudioMixer() {
+  Release();
+}
+
+void AudioMixer::Release() {
+  state_.Close();
+
+  if (worker_) {
+    worker_->Stop();
+  }
+
+  queue_.Shutdown();
+
+  ReleaseTSFNs();
+
+  {
+    std::lock_guard<std::mutex> lock(flush_mutex_);
+    // No Env here; unresolved promises are abandoned with the mixer
+    pending_flushes_.clear();
+  }
+
+  if (!output_callback_.IsEmpty()) {
+    output_callback_.Reset();
+  }
+  if (!error_callback_.IsEmpty()) {
+    error_callback_.Reset();
+  }
+}
+
+void AudioMixer::InitializeTSFNs(Napi::Env env) {
+  // Output TSFN - delivers mixed blocks to JS (uses raw AVFrame* pointer)
+  using OutputTSFNType = Napi::TypedThreadSafeFunction<AudioMixer, AVFrame*, &AudioMixer::OnOutputFrame>;
+  auto output_tsfn = OutputTSFNType::New(env, output_callback_.Value(), "AudioMixer::output", 0, 1, this);
+  output_tsfn_.Init(std::move(output_tsfn));
+
+  using ErrorTSFNType = Napi::TypedThreadSafeFunction<AudioMixer, ErrorData, &AudioMixer::OnError>;
+  auto error_tsfn = ErrorTSFNType::New(env, error_callback_.Value(), "AudioMixer::error", 0, 1, this);
+  error_tsfn_.Init(std::move(error_tsfn));
+
+  // Flush uses a dummy callback - the handler resolves the promise
+  Napi::Function dummyFn = Napi::Function::New(env, [](const Napi::CallbackInfo&) {});
+
+  using FlushTSFNType = Napi::TypedThreadSafeFunction<AudioMixer, FlushCompleteData, &AudioMixer::OnFlushComplete>;
+  auto flush_tsfn = FlushTSFNType::New(env, dummyFn, "AudioMixer::flush", 0, 1, this);
+  flush_tsfn_.Init(std::move(flush_tsfn));
+
+  // Unref so an idle mixer does not keep the process alive
+  output_tsfn_.Unref(env);
+  error_tsfn_.Unref(env);
+  flush_tsfn_.Unref(env);
+}
+
+void AudioMixer::ReleaseTSFNs() {
+  output_tsfn_.Release();
+  error_tsfn_.Release();
+  flush_tsfn_.Release();
+}
+
+// --- TSFN Callback Handlers ---
+
+void AudioMixer::OnOutputFrame(Napi::Env env, Napi::Function jsCallback,
+                               AudioMixer* context, AVFrame** data) {
+  if (!data || !*data) return;
+
+  AVFrame* frame = *data;
+  delete data;
+
+  if (!context || context->state_.IsClosed()) {
+    av_frame_free(&frame);
+    return;
+  }
+
+  if (!context->output_callback_.IsEmpty()) {
+    Napi::Object jsAudioData = AudioData::CreateFromFrame(env, frame, frame->pts);
+    if (!jsAudioData.IsEmpty()) {
+      context->output_callback_.Call({jsAudioData});
+    }
+  }
+
+  // AudioData::CreateFromFrame references the pooled samples
+  av_frame_free(&frame);
+}
+
+void AudioMixer::OnError(Napi::Env env, Napi::Function jsCallback,
+                         AudioMixer* context, ErrorData* data) {
+  if (!data) return;
+
+  std::string message = std::move(data->message);
+  delete data;
+
+  if (!context || context->state_.IsClosed()) {
+    return;
+  }
+
+  if (!context->error_callback_.IsEmpty()) {
+    Napi::Error error = Napi::Error::New(env, "OperationError: " + message);
+    error.Set("name", Napi::String::New(env, "OperationError"));
+    context->error_callback_.Call({error.Value()});
+  }
+
+  // Close the mixer on error, as codecs do
+  context->state_.Close();
+}
+
+void AudioMixer::OnFlushComplete(Napi::Env env, Napi::Function jsCallback,
+                                 AudioMixer* context, FlushCompleteData* data) {
+  if (!data) return;
+
+  uint32_t promise_id = data->promise_id;
+  bool success = data->success;
+  std::string error_message = std::move(data->error_message);
+  delete data;
+
+  if (!context) return;
+
+  std::lock_guard<std::mutex> lock(context->flush_mutex_);
+  auto it = context->pending_flushes_.find(promise_id);
+  if (it != context->pending_flushes_.end()) {
+    if (success) {
+      it->second.Resolve(env.Undefined());
+    } else {
+      Napi::Error error = Napi::Error::New(env, "OperationError: " + error_message);
+      error.Set("name", Napi::String::New(env, "OperationError"));
+      it->second.Reject(error.Value());
+    }
+    context->pending_flushes_.erase(it);
+  }
+}
+
+// --- Attributes ---
+
+Napi::Value AudioMixer::GetState(const Napi::CallbackInfo& info) {
+  return Napi::String::New(info.Env(), state_.ToString());
+}
+
+// --- Methods ---
+
+Napi::Value AudioMixer::Configure(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsObject()) {
+    errors::ThrowTypeError(env, "AudioMixerConfig is required");
+    return env.Undefined();
+  }
+
+  if (state_.IsClosed()) {
+    errors::ThrowInvalidStateError(env, "configure called on closed mixer");
+    return env.Undefined();
+  }
+
+  Napi::Object config = info[0].As<Napi::Object>();
+
+  if (!config.Has("sampleRate") || !config.Get("sampleRate").IsNumber()) {
+    errors::ThrowTypeError(env, "sampleRate is required and must be a number");
+    return env.Undefined();
+  }
+  if (!config.Has("numberOfChannels") || !config.Get("numberOfChannels").IsNumber()) {
+    errors::ThrowTypeError(env, "numberOfChannels is required and must be a number");
+    return env.Undefined();
+  }
+  const double sample_rate = config.Get("sampleRate").As<Napi::Number>().DoubleValue();
+  const double channels = config.Get("numberOfChannels").As<Napi::Number>().DoubleValue();
+  if (!(sample_rate >= 1) || sample_rate > kMaxSampleRate) {
+    errors::ThrowTypeError(env, "sampleRate must be between 1 and 768000");
+    return env.Undefined();
+  }
+  if (!(channels >= 1) || channels > kMaxChannels) {
+    errors::ThrowTypeError(env, "numberOfChannels must be between 1 and 255");
+    return env.Undefined();
+  }
+
+  // Block length and how far a source may run ahead of a lagging one
+  double frame_duration = 20000;
+  if (!GetDuration(env, config, "frameDuration", &frame_duration)) return env.Undefined();
+  double max_latency = frame_duration;
+  if (!GetDuration(env, config, "maxLatency", &max_latency)) return env.Undefined();
+
+  AudioMixBusConfig bus_config;
+  bus_config.sample_rate = static_cast<int>(sample_rate);
+  bus_config.channels = static_cast<int>(channels);
+  bus_config.frame_size = static_cast<size_t>(frame_duration * bus_config.sample_rate / 1000000);
+  bus_config.max_latency = static_cast<size_t>(max_latency * bus_config.sample_rate / 1000000);
+  if (bus_config.frame_size == 0) {
+    errors::ThrowTypeError(env, "frameDuration must cover at least one sample");
+    return env.Undefined();
+  }
+  if (config.Has("softClip") && !config.Get("softClip").IsUndefined()) {
+    bus_config.soft_clip = config.Get("softClip").ToBoolean().Value();
+  }
+  active_config_ = bus_config;
+
+  AudioMixerControlQueue::ConfigureMessage msg{[this]() -> bool {
+    // Runs on the worker thread; the configuration is applied by OnConfigure
+    return worker_ != nullptr;
+  }};
+
+  if (!worker_->IsRunning()) {
+    worker_->Start();
+  }
+
+  if (!queue_.Enqueue(std::move(msg))) {
+    errors::ThrowInvalidStateError(env, "Failed to enqueue configure");
+    return env.Undefined();
+  }
+
+  state_.transition(raii::AtomicCodecState::State::Unconfigured, raii::AtomicCodecState::State::Configured);
+  return env.Undefined();
+}
+
+Napi::Value AudioMixer::Push(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!state_.IsConfigured()) {
+    errors::ThrowInvalidStateError(env, "push called on " + std::string(state_.ToString()) + " mixer");
+    return env.Undefined();
+  }
+
+  if (info.Length() < 1 || !info[0].IsString()) {
+    errors::ThrowTypeError(env, "source must be a string");
+    return env.Undefined();
+  }
+
+  AudioData* audio_data = UnwrapAudioData(info.Length() > 1 ? info[1] : env.Undefined());
+  if (!audio_data) {
+    errors::ThrowTypeError(env, "AudioData is required");
+    return env.Undefined();
+  }
+
+  const AVFrame* src_frame = audio_data->frame();
+  if (!src_frame) {
+    errors::ThrowTypeError(env, "AudioData is closed or invalid");
+    return env.Undefined();
+  }
+
+  // The caller keeps (and may close) its AudioData; the clone shares the samples
+  raii::AVFramePtr frame = raii::CloneAvFrame(src_frame);
+  if (!frame) {
+    errors::ThrowEncodingError(env, "Failed to clone audio data");
+    return env.Undefined();
+  }
+  frame->pts = audio_data->timestamp();
+
+  AudioMixerControlQueue::DecodeMessage msg;
+  msg.packet.source = info[0].As<Napi::String>().Utf8Value();
+  msg.packet.frame = std::move(frame);
+  if (!queue_.Enqueue(std::move(msg))) {
+    errors::ThrowInvalidStateError(env, "Failed to enqueue push");
+  }
+  return env.Undefined();
+}
+
+Napi::Value AudioMixer::RemoveSource(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!state_.IsConfigured()) {
+    errors::ThrowInvalidStateError(env, "removeSource called on " + std::string(state_.ToString()) + " mixer");
+    return env.Undefined();
+  }
+
+  if (info.Length() < 1 || !info[0].IsString()) {
+    errors::ThrowTypeError(env, "source must be a string");
+    return env.Undefined();
+  }
+
+  // Ordered after the source's earlier pushes; a null frame ends it
+  AudioMixerControlQueue::DecodeMessage msg;
+  msg.packet.source = info[0].As<Napi::String>().Utf8Value();
+  if (!queue_.Enqueue(std::move(msg))) {
+    errors::ThrowInvalidStateError(env, "Failed to enqueue removeSource");
+  }
+  return env.Undefined();
+}
+
+Napi::Value AudioMixer::Flush(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!state_.IsConfigured()) {
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    Napi::Error error =
+        Napi::Error::New(env, "InvalidStateError: flush called on " + std::string(state_.ToString()) + " mixer");
+    error.Set("name", Napi::String::New(env, "InvalidStateError"));
+    deferred.Reject(error.Value());
+    return deferred.Promise();
+  }
+
+  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+  Napi::Promise promise = deferred.Promise();
+
+  uint32_t promise_id;
+  {
+    std::lock_guard<std::mutex> lock(flush_mutex_);
+    promise_id = next_flush_id_++;
+    pending_flushes_.emplace(promise_id, std::move(deferred));
+  }
+
+  AudioMixerControlQueue::FlushMessage msg{promise_id};
+  if (!queue_.Enqueue(std::move(msg))) {
+    std::lock_guard<std::mutex> lock(flush_mutex_);
+    auto it = pending_flushes_.find(promise_id);
+    if (it != pending_flushes_.end()) {
+      Napi::Error error = Napi::Error::New(env, "InvalidStateError: Failed to enqueue flush");
+      error.Set("name", Napi::String::New(env, "InvalidStateError"));
+      it->second.Reject(error.Value());
+      pending_flushes_.erase(it);
+    }
+  }
+
+  return promise;
+}
+
+Napi::Value AudioMixer::Reset(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (state_.IsClosed()) {
+    errors::ThrowInvalidStateError(env, "reset called on closed mixer");
+    return env.Undefined();
+  }
+
+  // Pending inputs are dropped (frames freed by RAII)
+  auto dropped = queue_.Clear();
+
+  AudioMixerControlQueue::ResetMessage msg{};
+  (void)queue_.Enqueue(std::move(msg));
+
+  {
+    std::lock_guard<std::mutex> lock(flush_mutex_);
+    for (auto& [id, deferred] : pending_flushes_) {
+      Napi::Error error = Napi::Error::New(env, "AbortError: Mixer was reset");
+      error.Set("name", Napi::String::New(env, "AbortError"));
+      deferred.Reject(error.Value());
+    }
+    pending_flushes_.clear();
+  }
+
+  state_.transition(raii::AtomicCodecState::State::Configured, raii::AtomicCodecState::State::Unconfigured);
+  return env.Undefined();
+}
+
+Napi::Value AudioMixer::Close(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  // Reject pending flushes here, where there is a valid Env
+  {
+    std::lock_guard<std::mutex> lock(flush_mutex_);
+    for (auto& [id, deferred] : pending_flushes_) {
+      Napi::Error error = Napi::Error::New(env, "AbortError: Mixer was closed");
+      error.Set("name", Napi::String::New(env, "AbortError"));
+      deferred.Reject(error.Value());
+    }
+    pending_flushes_.clear();
+  }
+
+  Release();
+  return env.Undefined();
+}
+
+// =============================================================================
+// AUDIOMIXERWORKER IMPLEMENTATION
+// =============================================================================
+
+AudioMixerWorker::AudioMixerWorker(AudioMixerControlQueue& queue, AudioMixer* mixer)
+    : CodecWorker<AudioMixerControlQueue>(queue), mixer_(mixer) {
+  SetOutputFrameCallback([this](raii::AVFramePtr frame) {
+    if (!mixer_ || mixer_->state_.IsClosed()) return;
+
+    // OnOutputFrame takes ownership and calls av_frame_free
+    AVFrame* raw_frame = frame.release();
+    auto* data = new AVFrame*(raw_frame);
+    if (!mixer_->output_tsfn_.Call(data)) {
+      av_frame_free(&raw_frame);
+      delete data;
+    }
+  });
+
+  SetOutputErrorCallback([this](int error_code, const std::string& message) {
+    if (!mixer_ || mixer_->state_.IsClosed()) return;
+
+    auto* data = new AudioMixer::ErrorData{error_code, message};
+    if (!mixer_->error_tsfn_.Call(data)) {
+      delete data;
+    }
+  });
+
+  SetFlushCompleteCallback([this](uint32_t promise_id, bool success, const std::string& error) {
+    if (!mixer_) return;
+
+    auto* data = new AudioMixer::FlushCompleteData{promise_id, success, error};
+    if (!mixer_->flush_tsfn_.Call(data)) {
+      delete data;
+    }
+  });
+}
+
+AudioMixerWorker::~AudioMixerWorker() {
+  Stop();
+  av_channel_layout_uninit(&out_layout_);
+}
+
+bool AudioMixerWorker::OnConfigure(const ConfigureMessage& msg) {
+  if (!mixer_) return false;
+
+  const AudioMixBusConfig& config = mixer_->active_config_;
+  bus_.Configure(config);
+  resamplers_.clear();
+  av_channel_layout_uninit(&out_layout_);
+  av_channel_layout_default(&out_layout_, config.channels);
+  return true;
+}
+
+void AudioMixerWorker::EnsureScratch(int frames) {
+  const int channels = bus_.config().channels;
+  scratch_.resize(channels);
+  scratch_planes_.resize(channels);
+  for (int ch = 0; ch < channels; ch++) {
+    if (scratch_[ch].size() < static_cast<size_t>(frames)) scratch_[ch].resize(frames);
+    scratch_planes_[ch] = reinterpret_cast<uint8_t*>(scratch_[ch].data());
+  }
+}
+
+bool AudioMixerWorker::PushFrame(const std::string& source, const AVFrame* frame) {
+  const AudioMixBusConfig& config = bus_.config();
+  if (frame->nb_samples <= 0 || frame->sample_rate <= 0) return true;
+
+  // Already in the bus format: mixed straight from the AudioData's planes
+  if (frame->format == AV_SAMPLE_FMT_FLTP && frame->sample_rate == config.sample_rate &&
+      frame->ch_layout.nb_channels == config.channels) {
+    DrainResampler(source);
+    bus_.Push(source, reinterpret_cast<const float* const*>(frame->extended_data), frame->nb_samples,
+              frame->pts);
+    return true;
+  }
+
+  auto it = resamplers_.find(source);
+  if (it == resamplers_.end() || it->second->format != frame->format ||
+      it->second->sample_rate != frame->sample_rate ||
+      av_channel_layout_compare(&it->second->layout, &frame->ch_layout) != 0) {
+    // A format change mid-stream starts a new resampler; the old one is drained first
+    DrainResampler(source);
+    auto created = std::make_unique<Resampler>();
+    created->swr = raii::MakeSwrContextInitialized(&out_layout_, AV_SAMPLE_FMT_FLTP, config.sample_rate,
+                                                   &frame->ch_layout, static_cast<AVSampleFormat>(frame->format),
+                                                   frame->sample_rate);
+    if (!created->swr || av_channel_layout_copy(&created->layout, &frame->ch_layout) < 0) {
+      OutputError(AVERROR(EINVAL), "Cannot convert the audio of source " + source + " to the mixer format");
+      return false;
+    }
+    created->format = frame->format;
+    created->sample_rate = frame->sample_rate;
+    it = resamplers_.emplace(source, std::move(created)).first;
+  }
+
+  Resampler& r = *it->second;
+  // The resampler holds back a few samples; its output starts that much earlier
+  const int64_t timestamp = frame->pts - swr_get_delay(r.swr.get(), 1000000);
+  const int capacity = swr_get_out_samples(r.swr.get(), frame->nb_samples);
+  EnsureScratch(capacity);
+  const int frames = swr_convert(r.swr.get(), scratch_planes_.data(), capacity,
+                                 const_cast<const uint8_t**>(frame->extended_data), frame->nb_samples);
+  if (frames < 0) {
+    OutputError(frames, "Failed to resample audio of source " + source);
+    return false;
+  }
+  r.next_timestamp = frame->pts + av_rescale(frame->nb_samples, 1000000, frame->sample_rate);
+  if (frames > 0) {
+    bus_.Push(source, reinterpret_cast<const float* const*>(scratch_planes_.data()), frames, timestamp);
+  }
+  return true;
+}
+
+void AudioMixerWorker::DrainResampler(const std::string& source) {
+  auto it = resamplers_.find(source);
+  if (it == resamplers_.end()) return;
+
+  Resampler& r = *it->second;
+  const int64_t timestamp = r.next_timestamp - swr_get_delay(r.swr.get(), 1000000);
+  const int capacity = swr_get_out_samples(r.swr.get(), 0);
+  if (capacity > 0) {
+    EnsureScratch(capacity);
+    const int frames = swr_convert(r.swr.get(), scratch_planes_.data(), capacity, nullptr, 0);
+    if (frames > 0) {
+      bus_.Push(source, reinterpret_cast<const float* const*>(scratch_planes_.data()), frames, timestamp);
+    }
+  }
+  resamplers_.erase(it);
+}
+
+void AudioMixerWorker::EmitReady(bool drain) {
+  const AudioMixBusConfig& config = bus_.config();
+  for (size_t frames = bus_.Pending(drain); frames > 0 && !ShouldExit(); frames = bus_.Pending(drain)) {
+    raii::AVFramePtr frame = raii::MakeAvFrame();
+    int ret = frame ? 0 : AVERROR(ENOMEM);
+    if (ret >= 0) {
+      frame->format = AV_SAMPLE_FMT_FLTP;
+      frame->sample_rate = config.sample_rate;
+      frame->nb_samples = static_cast<int>(frames);
+      ret = av_channel_layout_copy(&frame->ch_layout, &out_layout_);
+    }
+    if (ret >= 0) {
+      // Full blocks all share one pool key
+      ret = GlobalAudioBufferPool::Instance().GetBuffer(frame.get());
+    }
+    if (ret < 0) {
+      OutputError(ret, "Failed to allocate mixed audio");
+      return;
+    }
+
+    frame->pts = bus_.timestamp();
+    bus_.Mix(reinterpret_cast<float* const*>(frame->extended_data), frames);
+    OutputFrame(std::move(frame));
+  }
+}
+
+void AudioMixerWorker::OnDecode(const DecodeMessage& msg) {
+  if (ShouldExit()) return;
+
+  const AudioMixerInput& input = msg.packet;
+  if (!input.frame) {
+    DrainResampler(input.source);
+    bus_.RemoveSource(input.source);
+  } else if (!PushFrame(input.source, input.frame.get())) {
+    return;
+  }
+  EmitReady(false);
+}
+
+void AudioMixerWorker::OnFlush(const FlushMessage& msg) {
+  std::vector<std::string> sources;
+  sources.reserve(resamplers_.size());
+  for (const auto& [source, resampler] : resamplers_) sources.push_back(source);
+  for (const std::string& source : sources) DrainResampler(source);
+
+  // Lagging sources are not waited for; the last block may be short
+  EmitReady(true);
+  FlushComplete(msg.promise_id, true, "");
+}
+
+void AudioMixerWorker::OnReset() {
+  bus_.Reset();
+  resamplers_.clear();
+}
+
+void AudioMixerWorker::OnClose() {
+  bus_.Reset();
+  resamplers_.clear();
+}
+
+}  // namespace webcodecs
@@ -0,0 +1,203 @@
+#pragma once
+#include <napi.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "shared/utils.h"
+#include "shared/control_message_queue.h"
+#include "shared/codec_worker.h"
+#include "shared/safe_tsfn.h"
+#include "shared/audio_mix_bus.h"
+#include "ffmpeg_raii.h"
+
+namespace webcodecs {
+
+// Forward declarations
+class AudioMixerWorker;
+
+/**
+ * One push() or removeSource() call, queued in order with the control
+ * messages. A null frame ends the source.
+ */
+struct AudioMixerInput {
+  std::string source;
+  raii::AVFramePtr frame;
+};
+
+/**
+ * Control queue for AudioMixer.
+ * PacketType: input AudioData (cloned frames) per source
+ * FrameType: unused (no encode messages)
+ */
+using AudioMixerControlQueue = ControlMessageQueue<AudioMixerInput, raii::AVFramePtr>;
+
+/**
+ * AudioMixer - Non-standard mixer of AudioData from many sources
+ *
+ * Sums timestamped AudioData from any number of sources (conference
+ * participants, music beds, ...) into one f32-planar stream of fixed-size
+ * blocks at the configured sample rate and channel count. Inputs are
+ * resampled and remixed per source with libswresample, aligned on their
+ * timestamps and summed with the vectorized kernels of AudioMixBus,
+ * followed by an optional soft clipper.
+ *
+ * Architecture:
+ * - JS main thread: validates and clones inputs, enqueues messages
+ * - Worker thread: resampling, alignment and mixing
+ * - Mixed blocks go back as AudioData via SafeThreadSafeFunction
+ *
+ * Thread Safety:
+ * - All public methods are called from the JS main thread
+ * - State transitions use atomic operations
+ * - Output ordering guaranteed by single worker thread (FIFO)
+ */
+class AudioMixer : public Napi::ObjectWrap<AudioMixer> {
+ public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  explicit AudioMixer(const Napi::CallbackInfo& info);
+  ~AudioMixer() override;
+
+  // Non-copyable, non-movable (Google C++ Style Guide)
+  AudioMixer(const AudioMixer&) = delete;
+  AudioMixer& operator=(const AudioMixer&) = delete;
+  AudioMixer(AudioMixer&&) = delete;
+  AudioMixer& operator=(AudioMixer&&) = delete;
+
+  static Napi::FunctionReference constructor;
+
+  // RAII Release - cleans up all resources
+  void Release();
+
+ private:
+  // --- Message Queue ---
+  AudioMixerControlQueue queue_;
+
+  // --- Worker Thread ---
+  std::unique_ptr<AudioMixerWorker> worker_;
+
+  // --- Thread-Safe State ---
+  raii::AtomicCodecState state_;
+
+  // --- Pending Flush Promises ---
+  std::unordered_map<uint32_t, Napi::Promise::Deferred> pending_flushes_;
+  uint32_t next_flush_id_{0};
+  std::mutex flush_mutex_;
+
+  // --- Data structs for TSFN callbacks (must be defined before TSFN types) ---
+  struct ErrorData {
+    int error_code;
+    std::string message;
+  };
+
+  struct FlushCompleteData {
+    uint32_t promise_id;
+    bool success;
+    std::string error_message;
+  };
+
+  // --- TSFN Callback Handlers (called on JS thread) ---
+  static void OnOutputFrame(Napi::Env env, Napi::Function jsCallback,
+                            AudioMixer* context, AVFrame** data);
+  static void OnError(Napi::Env env, Napi::Function jsCallback,
+                      AudioMixer* context, ErrorData* data);
+  static void OnFlushComplete(Napi::Env env, Napi::Function jsCallback,
+                              AudioMixer* context, FlushCompleteData* data);
+
+  // --- TSFN types with CallJs template parameter ---
+  using OutputTSFN = SafeThreadSafeFunction<AudioMixer, AVFrame*, &AudioMixer::OnOutputFrame>;
+  OutputTSFN output_tsfn_;
+
+  using ErrorTSFN = SafeThreadSafeFunction<AudioMixer, ErrorData, &AudioMixer::OnError>;
+  ErrorTSFN error_tsfn_;
+
+  using FlushTSFN = SafeThreadSafeFunction<AudioMixer, FlushCompleteData, &AudioMixer::OnFlushComplete>;
+  FlushTSFN flush_tsfn_;
+
+  // --- JS Callbacks (stored for TSFN delivery) ---
+  Napi::FunctionReference output_callback_;
+  Napi::FunctionReference error_callback_;
+
+  // --- Mixer Configuration (read by the worker on configure) ---
+  AudioMixBusConfig active_config_;
+
+  // Attributes
+  Napi::Value GetState(const Napi::CallbackInfo& info);
+
+  // Methods
+  Napi::Value Configure(const Napi::CallbackInfo& info);
+  Napi::Value Push(const Napi::CallbackInfo& info);
+  Napi::Value RemoveSource(const Napi::CallbackInfo& info);
+  Napi::Value Flush(const Napi::CallbackInfo& info);
+  Napi::Value Reset(const Napi::CallbackInfo& info);
+  Napi::Value Close(const Napi::CallbackInfo& info);
+
+  // --- Internal Helpers ---
+  void InitializeTSFNs(Napi::Env env);
+  void ReleaseTSFNs();
+
+  // Friend class for worker access
+  friend class AudioMixerWorker;
+};
+
+/**
+ * AudioMixerWorker - Worker thread implementation for AudioMixer
+ *
+ * Processes messages from AudioMixerControlQueue:
+ * - Configure: reset the mix bus for the output format
+ * - Decode (push/removeSource): resample to the bus format, mix ready blocks
+ * - Flush: drain resamplers and mix everything buffered
+ * - Reset: drop all sources
+ */
+class AudioMixerWorker : public CodecWorker<AudioMixerControlQueue> {
+ public:
+  explicit AudioMixerWorker(AudioMixerControlQueue& queue, AudioMixer* mixer);
+  ~AudioMixerWorker() override;
+
+  // Non-copyable, non-movable
+  AudioMixerWorker(const AudioMixerWorker&) = delete;
+  AudioMixerWorker& operator=(const AudioMixerWorker&) = delete;
+
+ protected:
+  bool OnConfigure(const ConfigureMessage& msg) override;
+  void OnDecode(const DecodeMessage& msg) override;
+  void OnFlush(const FlushMessage& msg) override;
+  void OnReset() override;
+  void OnClose() override;
+
+ private:
+  // Converts one source to the bus format; no context when it already matches
+  struct Resampler {
+    raii::SwrContextPtr swr;
+    int format = AV_SAMPLE_FMT_NONE;
+    int sample_rate = 0;
+    AVChannelLayout layout = {};
+    int64_t next_timestamp = 0;  // Microseconds, end of the last input
+
+    Resampler() = default;
+    Resampler(const Resampler&) = delete;
+    Resampler& operator=(const Resampler&) = delete;
+    ~Resampler() { av_channel_layout_uninit(&layout); }
+  };
+
+  AudioMixer* mixer_;  // Parent mixer (for callbacks)
+
+  AudioMixBus bus_;
+  AVChannelLayout out_layout_ = {};
+  std::unordered_map<std::string, std::unique_ptr<Resampler>> resamplers_;
+
+  // Resampler output, one plane per bus channel
+  std::vector<std::vector<float>> scratch_;
+  std::vector<uint8_t*> scratch_planes_;
+
+  // Resample frame into the bus
+  bool PushFrame(const std::string& source, const AVFrame* frame);
+  // Push the samples still inside source's resampler and forget it
+  void DrainResampler(const std::string& source);
+  // Output every block the bus has ready (drain: everything buffered)
+  void EmitReady(bool drain);
+  // Size scratch_ for frames and point scratch_planes_ at it
+  void EnsureScratch(int frames);
+};
+
+}  // namespace webcodecs
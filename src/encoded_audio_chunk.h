@@ -28,6 +28,8 @@ class EncodedAudioChunk : public Napi::ObjectWrap<EncodedAudioChunk> {
 
   // Access underlying packet (for decoders)
   const AVPacket* packet() const { return packet_.get(); }
+  bool is_key() const { return type_ == "key"; }
+  int64_t timestamp() const { return timestamp_; }
 
   // Access constructor for InstanceOf checks
   static Napi::FunctionReference constructor;
@@ -28,6 +28,8 @@ class EncodedVideoChunk : public Napi::ObjectWrap<EncodedVideoChunk> {
 
   // Access underlying packet (for decoders)
   const AVPacket* packet() const { return packet_.get(); }
+  bool is_key() const { return type_ == "key"; }
+  int64_t timestamp() const { return timestamp_; }
 
   // Public for VideoDecoder access
   static Napi::FunctionReference constructor;
@@ -68,6 +68,15 @@ static bool IsStreamDisturbedOrLocked(Napi::Env env, const Napi::Object& stream)
   return false;
 }
 
+// Helper to check for the non-standard {path: string} file source
+static bool IsFileSource(const Napi::Value& value) {
+  if (!value.IsObject() || value.IsArrayBuffer() || value.IsTypedArray()) {
+    return false;
+  }
+  Napi::Object obj = value.As<Napi::Object>();
+  return obj.Has("path") && obj.Get("path").IsString();
+}
+
 // =============================================================================
 // IMAGEDECODER IMPLEMENTATION
 // =============================================================================
@@ -183,6 +192,13 @@ ImageDecoder::ImageDecoder(const Napi::CallbackInfo& info)
 
     // [SPEC 10.2.2] Step 17.6: In parallel, perform Fetch Stream Data Loop
     StartStreamReadLoop(env);
+  } else if (IsFileSource(data_value)) {
+    // Non-standard {path} source: the worker maps the file, nothing is
+    // copied through JS
+    is_streaming_ = false;
+    msg.is_streaming = false;
+    msg.path = data_value.As<Napi::Object>().Get("path").As<Napi::String>().Utf8Value();
+    (void)queue_.Enqueue(std::move(msg));
   } else {
     // [SPEC 10.2.2] Step 18: BufferSource handling
     is_streaming_ = false;
@@ -289,6 +305,13 @@ bool ImageDecoder::ValidateInit(Napi::Env env, const Napi::Object& init) {
           .ThrowAsJavaScriptException();
       return false;
     }
+  } else if (IsFileSource(data)) {
+    // Non-standard {path} source
+    if (data.As<Napi::Object>().Get("path").As<Napi::String>().Utf8Value().empty()) {
+      Napi::TypeError::New(env, "data.path must be a non-empty string")
+          .ThrowAsJavaScriptException();
+      return false;
+    }
   } else if (!data.IsArrayBuffer() && !data.IsTypedArray() && !data.IsBuffer()) {
     Napi::TypeError::New(env, "data must be BufferSource or ReadableStream")
         .ThrowAsJavaScriptException();
@@ -491,7 +514,10 @@ void ImageDecoder::OnError(Napi::Env env, Napi::Function /*jsCallback*/,
     std::lock_guard<std::mutex> lock(context->promise_mutex_);
     auto it = context->pending_decodes_.find(data->promise_id);
     if (it != context->pending_decodes_.end()) {
-      Napi::Error error = Napi::Error::New(env, data->message);
+      // AVERROR_EXIT: a decode waiting for streamed data was aborted by reset()
+      Napi::Error error = data->error_code == AVERROR_EXIT
+                              ? errors::CreateAbortError(env, data->message)
+                              : Napi::Error::New(env, data->message);
       it->second.Reject(error.Value());
       context->pending_decodes_.erase(it);
     }
@@ -714,19 +740,17 @@ void ImageDecoder::Close(const Napi::CallbackInfo& info) {
   // 2. Set [[closed]] to true
   closed_.store(true, std::memory_order_release);
 
-  // 3. Abort pending decode operations
-  std::vector<uint32_t> cancelled_ids = queue_.ClearDecodes();
+  // 3. Abort pending decode operations: queued ones, and those the worker
+  // holds while waiting for streamed data
+  (void)queue_.ClearDecodes();
 
-  // Reject cancelled promises with AbortError
+  // Reject every pending promise with AbortError
   {
     std::lock_guard<std::mutex> lock(promise_mutex_);
-    for (uint32_t id : cancelled_ids) {
-      auto it = pending_decodes_.find(id);
-      if (it != pending_decodes_.end()) {
-        it->second.Reject(errors::CreateAbortError(env, "ImageDecoder closed").Value());
-        pending_decodes_.erase(it);
-      }
+    for (auto& [id, deferred] : pending_decodes_) {
+      deferred.Reject(errors::CreateAbortError(env, "ImageDecoder closed").Value());
     }
+    pending_decodes_.clear();
   }
 
   // 4. Reject ready promise if not resolved
@@ -1,6 +1,9 @@
 #include "image_decoder_worker.h"
 
+#include <algorithm>
 #include <chrono>
+#include <climits>
+#include <memory>
 
 #include "error_builder.h"
 
@@ -18,29 +21,26 @@ namespace webcodecs {
 
 namespace {
 
+// Reads from the worker's segmented buffer, which may still be growing in
+// streaming mode: the size is re-read on every call, never captured
 struct IOContext {
-  const uint8_t* data;
-  size_t size;
+  const SegmentedBuffer* data;
   size_t position;
 };
 
 int ReadPacket(void* opaque, uint8_t* buf, int buf_size) {
   auto* ctx = static_cast<IOContext*>(opaque);
-  if (ctx->position >= ctx->size) {
+  size_t read = ctx->data->Read(ctx->position, buf, static_cast<size_t>(buf_size));
+  if (read == 0) {
     return AVERROR_EOF;
   }
-
-  size_t remaining = ctx->size - ctx->position;
-  size_t to_read = std::min(static_cast<size_t>(buf_size), remaining);
-
-  std::memcpy(buf, ctx->data + ctx->position, to_read);
-  ctx->position += to_read;
-
-  return static_cast<int>(to_read);
+  ctx->position += read;
+  return static_cast<int>(read);
 }
 
 int64_t SeekPacket(void* opaque, int64_t offset, int whence) {
   auto* ctx = static_cast<IOContext*>(opaque);
+  const size_t size = ctx->data->size();
 
   switch (whence) {
     case SEEK_SET:
@@ -50,21 +50,107 @@ int64_t SeekPacket(void* opaque, int64_t offset, int whence) {
       ctx->position += static_cast<size_t>(offset);
       break;
     case SEEK_END:
-      ctx->position = ctx->size + static_cast<size_t>(offset);
+      ctx->position = size + static_cast<size_t>(offset);
       break;
     case AVSEEK_SIZE:
-      return static_cast<int64_t>(ctx->size);
+      return static_cast<int64_t>(size);
     default:
       return AVERROR(EINVAL);
   }
 
-  if (ctx->position > ctx->size) {
-    ctx->position = ctx->size;
+  if (ctx->position > size) {
+    ctx->position = size;
   }
 
   return static_cast<int64_t>(ctx->position);
 }
 
+/**
+ * Decoders that composite each frame onto a canvas kept inside the decoder
+ * (disposal/blend ops). Their packets cannot be decoded in isolation even
+ * when the demuxer flags them as key, so only frame 0 is a random access
+ * point for them.
+ */
+bool CompositesFrames(AVCodecID codec_id) {
+  return codec_id == AV_CODEC_ID_GIF || codec_id == AV_CODEC_ID_APNG ||
+         codec_id == AV_CODEC_ID_WEBP;
+}
+
+// =============================================================================
+// STREAMING HEADER SNIFFER
+// =============================================================================
+
+enum class HeaderState {
+  kIncomplete,  // Known format, header not fully buffered yet
+  kComplete,    // Enough bytes to establish tracks
+  kUnknown,     // No sniffer for this type; rely on attempt backoff
+};
+
+uint32_t ReadBE16(const SegmentedBuffer& data, size_t pos) {
+  return (static_cast<uint32_t>(data.At(pos)) << 8) | data.At(pos + 1);
+}
+
+uint32_t ReadLE32(const SegmentedBuffer& data, size_t pos) {
+  return static_cast<uint32_t>(data.At(pos)) | (static_cast<uint32_t>(data.At(pos + 1)) << 8) |
+         (static_cast<uint32_t>(data.At(pos + 2)) << 16) |
+         (static_cast<uint32_t>(data.At(pos + 3)) << 24);
+}
+
+// JPEG: walk marker segments up to and including the first SOFn
+HeaderState SniffJpeg(const SegmentedBuffer& data) {
+  size_t pos = 2;  // After SOI
+  while (pos + 4 <= data.size()) {
+    if (data.At(pos) != 0xFF) return HeaderState::kUnknown;  // Let the demuxer judge
+    const uint8_t marker = data.At(pos + 1);
+    if (marker == 0xFF) {
+      pos++;  // Fill byte
+      continue;
+    }
+    const size_t segment_end = pos + 2 + ReadBE16(data, pos + 2);
+    const bool sof = marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 &&
+                     marker != 0xCC;
+    if (sof) {
+      return segment_end <= data.size() ? HeaderState::kComplete : HeaderState::kIncomplete;
+    }
+    if (marker == 0xDA) return HeaderState::kComplete;  // SOS before SOF: malformed, try anyway
+    pos = segment_end;
+  }
+  return HeaderState::kIncomplete;
+}
+
+/**
+ * Decide whether enough of a streamed image has arrived for
+ * avformat_open_input() + avformat_find_stream_info() to succeed.
+ */
+HeaderState SniffImageHeader(const std::string& type, const SegmentedBuffer& data) {
+  const size_t size = data.size();
+  if (type == "image/png" || type == "image/apng") {
+    return size >= 33 ? HeaderState::kComplete : HeaderState::kIncomplete;  // Signature + IHDR
+  }
+  if (type == "image/gif") {
+    if (size < 13) return HeaderState::kIncomplete;
+    const uint8_t flags = data.At(10);
+    const size_t palette = (flags & 0x80) ? 3u << ((flags & 0x07) + 1) : 0;
+    return size >= 13 + palette ? HeaderState::kComplete : HeaderState::kIncomplete;
+  }
+  if (type == "image/bmp") {
+    if (size < 18) return HeaderState::kIncomplete;
+    return size >= 14 + ReadLE32(data, 14) ? HeaderState::kComplete : HeaderState::kIncomplete;
+  }
+  if (type == "image/webp") {
+    return size >= 30 ? HeaderState::kComplete : HeaderState::kIncomplete;  // RIFF + first chunk
+  }
+  if (type == "image/jpeg") {
+    return size >= 4 ? SniffJpeg(data) : HeaderState::kIncomplete;
+  }
+  return HeaderState::kUnknown;
+}
+
+ImageFrameIndexEntry MakeIndexEntry(const AVPacket& packet, AVCodecID codec_id, bool first) {
+  const bool key = (packet.flags & AV_PKT_FLAG_KEY) != 0 && (first || !CompositesFrames(codec_id));
+  return ImageFrameIndexEntry{packet.pos, key};
+}
+
 }  // namespace
 
 // =============================================================================
@@ -172,6 +258,7 @@ void ImageDecoderWorker::WorkerLoop() {
               OnDecode(m);
             },
             [this](ImageResetMessage&) {
+              AbortWaitingDecodes();
               OnReset();
             },
             [this](ImageCloseMessage&) {
@@ -199,7 +286,7 @@ void ImageDecoderWorker::WorkerLoop() {
 // MESSAGE HANDLERS
 // =============================================================================
 
-bool ImageDecoderWorker::OnConfigure(const ImageConfigureMessage& msg) {
+bool ImageDecoderWorker::OnConfigure(ImageConfigureMessage& msg) {
   // Store configuration
   type_ = msg.type;
   desired_width_ = msg.desired_width;
@@ -209,18 +296,34 @@ bool ImageDecoderWorker::OnConfigure(const ImageConfigureMessage& msg) {
   color_space_conversion_ = msg.color_space_conversion;
   stream_complete_ = false;
   configured_ = false;
+  next_configure_attempt_ = 0;
+  image_data_.Clear();
+  waiting_decodes_.clear();
+  progressive_scanner_.Reset(is_streaming_ ? type_ : std::string());
+  partial_ctx_.reset();
+  partial_generation_ = 0;
 
   // For streaming mode, we wait for data to arrive via ImageStreamDataMessage
   if (is_streaming_) {
-    image_data_.clear();
-    read_position_ = 0;
     // Don't try to configure yet - wait for enough data
     return true;
   }
 
-  // Non-streaming mode: copy image data for memory-based I/O
-  image_data_ = msg.data;
-  read_position_ = 0;
+  if (!msg.path.empty()) {
+    // File source: read the mapping in place, no copy
+    auto file = std::make_shared<MappedFile>();
+    std::string error;
+    if (!file->Open(msg.path, &error)) {
+      OutputError(0, AVERROR(EIO), error);
+      return false;
+    }
+    const uint8_t* data = file->data();
+    const size_t size = file->size();
+    image_data_.AppendView(data, size, std::move(file));
+  } else {
+    // Non-streaming mode: take over the message's copy of the image data
+    image_data_.Append(std::move(msg.data));
+  }
 
   if (image_data_.empty()) {
     OutputError(0, AVERROR_INVALIDDATA, "Empty image data");
@@ -242,13 +345,13 @@ bool ImageDecoderWorker::TryConfigureFromBuffer() {
   // Create custom I/O context for reading from memory
   // We need to keep the IOContext alive, so we'll allocate it and store
   // ownership in the AVIOContext opaque field
-  auto* io_ctx_data = new IOContext{image_data_.data(), image_data_.size(), 0};
+  auto* io_ctx_data = new IOContext{&image_data_, 0};
 
   constexpr int kBufferSize = 32768;  // 32KB buffer
   auto* avio_buffer = static_cast<uint8_t*>(av_malloc(kBufferSize));
   if (!avio_buffer) {
     delete io_ctx_data;
-    OutputError(0, AVERROR(ENOMEM), "Failed to allocate I/O buffer");
+    ConfigureError(AVERROR(ENOMEM), "Failed to allocate I/O buffer");
     return false;
   }
 
@@ -260,7 +363,7 @@ bool ImageDecoderWorker::TryConfigureFromBuffer() {
   if (!avio_ctx) {
     av_free(avio_buffer);
     delete io_ctx_data;
-    OutputError(0, AVERROR(ENOMEM), "Failed to allocate AVIO context");
+    ConfigureError(AVERROR(ENOMEM), "Failed to allocate AVIO context");
     return false;
   }
 
@@ -269,7 +372,7 @@ bool ImageDecoderWorker::TryConfigureFromBuffer() {
   // Allocate format context
   AVFormatContext* fmt_ctx = avformat_alloc_context();
   if (!fmt_ctx) {
-    OutputError(0, AVERROR(ENOMEM), "Failed to allocate format context");
+    ConfigureError(AVERROR(ENOMEM), "Failed to allocate format context");
     return false;
   }
 
@@ -280,7 +383,7 @@ bool ImageDecoderWorker::TryConfigureFromBuffer() {
   // NOTE: avformat_open_input() frees fmt_ctx on failure, so don't double-free
   int ret = avformat_open_input(&fmt_ctx, nullptr, nullptr, nullptr);
   if (ret < 0) {
-    OutputError(0, ret, "Failed to open image: " + errors::FfmpegErrorString(ret));
+    ConfigureError(ret, "Failed to open image: " + errors::FfmpegErrorString(ret));
     return false;
   }
 
@@ -289,7 +392,7 @@ bool ImageDecoderWorker::TryConfigureFromBuffer() {
   // Find stream info
   ret = avformat_find_stream_info(fmt_ctx_.get(), nullptr);
   if (ret < 0) {
-    OutputError(0, ret, "Failed to find stream info: " + errors::FfmpegErrorString(ret));
+    ConfigureError(ret, "Failed to find stream info: " + errors::FfmpegErrorString(ret));
     return false;
   }
 
@@ -346,7 +449,7 @@ bool ImageDecoderWorker::TryConfigureFromBuffer() {
   }
 
   if (tracks_.empty()) {
-    OutputError(0, AVERROR_INVALIDDATA, "No video streams found in image");
+    ConfigureError(AVERROR_INVALIDDATA, "No video streams found in image");
     return false;
   }
 
@@ -355,41 +458,59 @@ bool ImageDecoderWorker::TryConfigureFromBuffer() {
     best_stream = 0;
   }
   selected_stream_index_ = tracks_[best_stream].stream_index;
+
+  // In-memory data: index every frame of the selected track up front. This
+  // gives the real frame count for formats whose demuxer does not report
+  // one (GIF) and the byte offsets used for random access.
+  if (!is_streaming_) {
+    BuildFrameIndex();
+    if (frame_index_.size() > tracks_[best_stream].frame_count) {
+      tracks_[best_stream].frame_count = static_cast<uint32_t>(frame_index_.size());
+      tracks_[best_stream].animated = true;
+      if (!av_dict_get(fmt_ctx_->streams[selected_stream_index_]->metadata, "loop_count",
+                       nullptr, 0)) {
+        tracks_[best_stream].repetition_count = -1.0f;
+      }
+    }
+  }
   total_frame_count_ = tracks_[best_stream].frame_count;
 
   // Open codec for selected stream
   AVStream* stream = fmt_ctx_->streams[selected_stream_index_];
   const AVCodec* codec = avcodec_find_decoder(stream->codecpar->codec_id);
   if (!codec) {
-    OutputError(0, AVERROR_DECODER_NOT_FOUND,
-                "No decoder found for codec: " +
-                    std::string(avcodec_get_name(stream->codecpar->codec_id)));
+    ConfigureError(AVERROR_DECODER_NOT_FOUND,
+                   "No decoder found for codec: " +
+                       std::string(avcodec_get_name(stream->codecpar->codec_id)));
     return false;
   }
 
   codec_ctx_ = raii::MakeAvCodecContext(codec);
   if (!codec_ctx_) {
-    OutputError(0, AVERROR(ENOMEM), "Failed to allocate codec context");
+    ConfigureError(AVERROR(ENOMEM), "Failed to allocate codec context");
     return false;
   }
 
   ret = avcodec_parameters_to_context(codec_ctx_.get(), stream->codecpar);
   if (ret < 0) {
-    OutputError(0, ret, "Failed to copy codec params: " + errors::FfmpegErrorString(ret));
+    ConfigureError(ret, "Failed to copy codec params: " + errors::FfmpegErrorString(ret));
     return false;
   }
 
   // Set threading
   codec_ctx_->thread_count = 0;  // Auto
   codec_ctx_->thread_type = FF_THREAD_FRAME;
+  ApplyDesiredSize(stream);
 
   ret = avcodec_open2(codec_ctx_.get(), codec, nullptr);
   if (ret < 0) {
-    OutputError(0, ret, "Failed to open codec: " + errors::FfmpegErrorString(ret));
+    ConfigureError(ret, "Failed to open codec: " + errors::FfmpegErrorString(ret));
     return false;
   }
 
   current_frame_index_ = 0;
+  packets_sent_ = 0;
+  frame_cache_.Clear();
   configured_ = true;
 
   // Signal track info to ImageDecoder
@@ -404,7 +525,7 @@ bool ImageDecoderWorker::TryConfigureFromBuffer() {
   return true;
 }
 
-void ImageDecoderWorker::OnStreamData(const ImageStreamDataMessage& msg) {
+void ImageDecoderWorker::OnStreamData(ImageStreamDataMessage& msg) {
   // [SPEC] Fetch Stream Data Loop - chunk steps:
   // 1. If [[closed]] is true, abort
   // 2. If chunk is not Uint8Array, close with DataError (handled in JS)
@@ -412,25 +533,39 @@ void ImageDecoderWorker::OnStreamData(const ImageStreamDataMessage& msg) {
   // 4. If [[tracks established]] is false, run Establish Tracks
   // 5. Otherwise, run Update Tracks
 
-  // Append chunk to accumulated data
-  image_data_.insert(image_data_.end(), msg.chunk.begin(), msg.chunk.end());
+  // Append chunk to accumulated data (no copy of earlier chunks)
+  image_data_.Append(std::move(msg.chunk));
 
-  // Try to configure if not yet done
-  if (!configured_) {
-    // Try to configure with accumulated data
-    // This may fail if not enough data yet - that's OK, we'll try again
-    // when more data arrives
-    bool success = TryConfigureFromBuffer();
-    if (!success && !image_data_.empty()) {
-      // Failed to configure - clear the I/O context we may have partially created
-      // The error will be reported when stream ends or more data doesn't help
-      io_ctx_.reset();
-      fmt_ctx_.reset();
-      codec_ctx_.reset();
-    }
+  // A new progressive step may satisfy decode({completeFramesOnly: false})
+  const bool refined = progressive_scanner_.Update(image_data_);
+
+  if (configured_) {
+    // The format context reads the growing buffer directly; let it read
+    // past the end it hit before this chunk arrived
+    if (io_ctx_) io_ctx_->eof_reached = 0;
+    if (refined) ServeWaitingDecodes();
+    return;
   }
+
+  // Opening the input probes and parses from the first byte, so only try
+  // once the format's header is complete, and after a failed attempt wait
+  // until the buffer has doubled: total probing work stays linear
+  if (image_data_.size() < next_configure_attempt_) return;
+  HeaderState header = SniffImageHeader(type_, image_data_);
+  if (header == HeaderState::kIncomplete) return;
+
+  if (!TryConfigureFromBuffer()) {
+    // Not enough data yet - drop the partially created contexts and retry
+    // later; errors are reported if the stream ends without success
+    codec_ctx_.reset();
+    fmt_ctx_.reset();
+    io_ctx_.reset();
+    next_configure_attempt_ = image_data_.size() * 2;
+    return;
+  }
+  if (progressive_scanner_.generation() > 0) ServeWaitingDecodes();
   // Note: For streaming mode, we don't support updating tracks after initial
-  // configuration (progressive decoding) - this is a simplification.
+  // configuration - this is a simplification.
 }
 
 void ImageDecoderWorker::OnStreamEnd() {
@@ -439,20 +574,33 @@ void ImageDecoderWorker::OnStreamEnd() {
   // 2. Resolve [[completed promise]]
 
   stream_complete_ = true;
+  partial_ctx_.reset();  // Only complete frames from here on
 
   if (!configured_) {
     // Try one last time to configure with all accumulated data
+    // (failures are reported now that the stream is complete)
     bool success = TryConfigureFromBuffer();
     if (!success) {
-      // Not enough data to decode - signal error
-      OutputError(0, AVERROR_INVALIDDATA,
-                  "Stream ended with insufficient data to decode image");
+      if (image_data_.empty()) {
+        OutputError(0, AVERROR_INVALIDDATA,
+                    "Stream ended with insufficient data to decode image");
+      }
+      ServeWaitingDecodes();  // Rejects them: nothing to decode
       return;
     }
+  } else {
+    // Configured on a prefix: stream info probing may have buffered a
+    // truncated first packet, so restart demuxing on the complete data
+    if (io_ctx_) io_ctx_->eof_reached = 0;
+    ClearFrameCache();
+    OnReset();
   }
 
   // Signal that stream is complete
   OutputCompleted();
+
+  // Requests that waited for the data now decode the complete frame
+  ServeWaitingDecodes();
 }
 
 void ImageDecoderWorker::OnStreamError(const ImageStreamErrorMessage& msg) {
@@ -462,6 +610,15 @@ void ImageDecoderWorker::OnStreamError(const ImageStreamErrorMessage& msg) {
 }
 
 void ImageDecoderWorker::OnDecode(const ImageDecodeMessage& msg) {
+  // [SPEC] While the stream is incomplete, a decode waits until the frame
+  // (or, without completeFramesOnly, a partial image of it) is available
+  if (is_streaming_ && !stream_complete_) {
+    if (!TryDecodeWhileStreaming(msg)) {
+      waiting_decodes_.push_back(msg);
+    }
+    return;
+  }
+
   if (!codec_ctx_ || !fmt_ctx_) {
     OutputError(msg.promise_id, AVERROR_INVALIDDATA, "Decoder not configured");
     return;
@@ -475,26 +632,32 @@ void ImageDecoderWorker::OnDecode(const ImageDecodeMessage& msg) {
     return;
   }
 
-  // Seek to frame if necessary
-  if (msg.frame_index != current_frame_index_) {
-    if (!SeekToFrame(msg.frame_index)) {
-      OutputError(msg.promise_id, AVERROR(EIO),
-                  "Failed to seek to frame " + std::to_string(msg.frame_index));
-      return;
-    }
-  }
-
-  // Decode frame
+  // Composited frames already decoded are answered from the cache
   int64_t timestamp = 0;
   int64_t duration = 0;
-  raii::AVFramePtr frame = DecodeNextFrame(&timestamp, &duration);
+  raii::AVFramePtr frame = frame_cache_.Get(msg.frame_index, &timestamp, &duration);
 
   if (!frame) {
-    OutputError(msg.promise_id, AVERROR(EIO), "Failed to decode frame");
-    return;
-  }
+    // Seek to frame if necessary
+    if (msg.frame_index != current_frame_index_) {
+      if (!SeekToFrame(msg.frame_index)) {
+        OutputError(msg.promise_id, AVERROR(EIO),
+                    "Failed to seek to frame " + std::to_string(msg.frame_index));
+        return;
+      }
+    }
 
-  current_frame_index_ = msg.frame_index + 1;
+    // Decode frame
+    frame = PrepareOutputFrame(DecodeNextFrame(&timestamp, &duration));
+
+    if (!frame) {
+      OutputError(msg.promise_id, AVERROR(EIO), "Failed to decode frame");
+      return;
+    }
+
+    frame_cache_.Put(msg.frame_index, frame.get(), timestamp, duration);
+    current_frame_index_ = msg.frame_index + 1;
+  }
 
   // Build result
   ImageDecodeResult result;
@@ -512,8 +675,10 @@ void ImageDecoderWorker::OnReset() {
     avcodec_flush_buffers(codec_ctx_.get());
   }
 
-  // Reset to beginning
+  // Reset to beginning (the frame index and cache stay valid: same data)
   current_frame_index_ = 0;
+  packets_sent_ = 0;
+  partial_generation_ = 0;  // The next partial decode returns the latest step
 
   // Seek I/O context back to start
   if (io_ctx_) {
@@ -531,10 +696,13 @@ void ImageDecoderWorker::OnReset() {
 
 void ImageDecoderWorker::OnClose() {
   // Release FFmpeg resources in reverse order of creation
+  ClearFrameCache();
+  waiting_decodes_.clear();
+  partial_ctx_.reset();
   codec_ctx_.reset();
   fmt_ctx_.reset();
   io_ctx_.reset();
-  image_data_.clear();
+  image_data_.Clear();
   tracks_.clear();
 }
 
@@ -549,8 +717,9 @@ void ImageDecoderWorker::OnUpdateTrack(const ImageUpdateTrackMessage& msg) {
     return;  // Same track, nothing to do
   }
 
-  // Close current codec
+  // Close current codec; frames of the old track are no longer valid
   codec_ctx_.reset();
+  ClearFrameCache();
 
   // Open new codec for selected stream
   selected_stream_index_ = new_stream_index;
@@ -577,6 +746,7 @@ void ImageDecoderWorker::OnUpdateTrack(const ImageUpdateTrackMessage& msg) {
 
   codec_ctx_->thread_count = 0;
   codec_ctx_->thread_type = FF_THREAD_FRAME;
+  ApplyDesiredSize(stream);
 
   ret = avcodec_open2(codec_ctx_.get(), codec, nullptr);
   if (ret < 0) {
@@ -584,7 +754,12 @@ void ImageDecoderWorker::OnUpdateTrack(const ImageUpdateTrackMessage& msg) {
     return;
   }
 
+  // Index the new track (this also rewinds to its first frame)
+  if (!is_streaming_) {
+    BuildFrameIndex();
+  }
   current_frame_index_ = 0;
+  packets_sent_ = 0;
 }
 
 // =============================================================================
@@ -618,6 +793,12 @@ void ImageDecoderWorker::OutputCompleted() {
   }
 }
 
+void ImageDecoderWorker::ConfigureError(int error_code, const std::string& message) {
+  // A streamed prefix may simply be too short; only the final attempt counts
+  if (is_streaming_ && !stream_complete_) return;
+  OutputError(0, error_code, message);
+}
+
 // =============================================================================
 // DECODE HELPERS
 // =============================================================================
@@ -633,26 +814,112 @@ bool ImageDecoderWorker::SeekToFrame(uint32_t frame_index) {
     return true;
   }
 
-  // For animated images, we need to decode frames sequentially
-  // because most image formats don't support random access
-  if (frame_index < current_frame_index_) {
-    // Need to go backwards - reset and decode forward
+  // Animated frames are composited onto the previous canvas, so decoding
+  // has to restart from a random access point: the nearest indexed key
+  // frame, or the beginning
+  if (!SeekToRandomAccessPoint(frame_index) && frame_index < current_frame_index_) {
     OnReset();
   }
 
-  // Decode frames until we reach the target
+  // Decode frames until we reach the target, caching them for later scrubbing
   while (current_frame_index_ < frame_index) {
-    int64_t ts, dur;
-    raii::AVFramePtr frame = DecodeNextFrame(&ts, &dur);
+    int64_t ts = 0;
+    int64_t dur = 0;
+    raii::AVFramePtr frame = PrepareOutputFrame(DecodeNextFrame(&ts, &dur));
     if (!frame) {
       return false;
     }
+    frame_cache_.Put(current_frame_index_, frame.get(), ts, dur);
     current_frame_index_++;
   }
 
   return true;
 }
 
+bool ImageDecoderWorker::SeekToRandomAccessPoint(uint32_t frame_index) {
+  if (frame_index_.empty()) return false;
+
+  const bool backwards = frame_index < current_frame_index_;
+  const uint32_t limit =
+      std::min(frame_index, static_cast<uint32_t>(frame_index_.size() - 1));
+  for (uint32_t k = limit; k > 0; k--) {
+    if (!backwards && k <= current_frame_index_) return false;  // Decoding forward is closer
+    const ImageFrameIndexEntry& entry = frame_index_[k];
+    if (!entry.key || entry.pos < 0) continue;
+
+    if (av_seek_frame(fmt_ctx_.get(), selected_stream_index_, entry.pos, AVSEEK_FLAG_BYTE) < 0) {
+      return false;
+    }
+    avcodec_flush_buffers(codec_ctx_.get());
+    current_frame_index_ = k;
+    packets_sent_ = k;
+    return true;
+  }
+  return false;
+}
+
+void ImageDecoderWorker::BuildFrameIndex() {
+  ClearFrameCache();
+
+  raii::AVPacketPtr packet = raii::MakeAvPacket();
+  if (!packet) return;
+
+  const AVCodecID codec_id = fmt_ctx_->streams[selected_stream_index_]->codecpar->codec_id;
+  while (!ShouldExit() && av_read_frame(fmt_ctx_.get(), packet.get()) >= 0) {
+    if (packet->stream_index == selected_stream_index_) {
+      frame_index_.push_back(MakeIndexEntry(*packet, codec_id, frame_index_.empty()));
+    }
+    av_packet_unref(packet.get());
+  }
+
+  // Rewind to the first frame for decoding
+  OnReset();
+}
+
+void ImageDecoderWorker::ClearFrameCache() {
+  frame_index_.clear();
+  frame_cache_.Clear();
+}
+
+void ImageDecoderWorker::ApplyDesiredSize(const AVStream* stream) {
+  output_width_ = 0;
+  output_height_ = 0;
+  const int width = stream->codecpar->width;
+  const int height = stream->codecpar->height;
+  if ((!desired_width_ && !desired_height_) || width <= 0 || height <= 0) {
+    return;
+  }
+
+  // A single desired dimension scales the other one proportionally
+  int64_t target_w = desired_width_.value_or(0);
+  int64_t target_h = desired_height_.value_or(0);
+  if (target_w <= 0) target_w = (target_h * width + height / 2) / height;
+  if (target_h <= 0) target_h = (target_w * height + width / 2) / width;
+  output_width_ = static_cast<int>(std::max<int64_t>(1, std::min<int64_t>(target_w, INT_MAX)));
+  output_height_ = static_cast<int>(std::max<int64_t>(1, std::min<int64_t>(target_h, INT_MAX)));
+
+  // DCT-domain downscaling (JPEG: 1/2, 1/4, 1/8) skips most of the IDCT and
+  // shrinks the decoded frame; keep it at or above the output size so the
+  // final swscale pass only ever downsamples
+  int lowres = 0;
+  const int max_lowres = codec_ctx_->codec ? codec_ctx_->codec->max_lowres : 0;
+  while (lowres < max_lowres &&
+         AV_CEIL_RSHIFT(width, lowres + 1) >= output_width_ &&
+         AV_CEIL_RSHIFT(height, lowres + 1) >= output_height_) {
+    lowres++;
+  }
+  codec_ctx_->lowres = lowres;
+}
+
+raii::AVFramePtr ImageDecoderWorker::PrepareOutputFrame(raii::AVFramePtr frame) {
+  if (!frame || output_width_ <= 0 ||
+      (frame->width == output_width_ && frame->height == output_height_)) {
+    return frame;
+  }
+  return scaler_.ConvertScaled(frame.get(), static_cast<AVPixelFormat>(frame->format),
+                               output_width_, output_height_);
+}
+
 raii::AVFramePtr ImageDecoderWorker::DecodeNextFrame(int64_t* timestamp,
                                                       int64_t* duration) {
   if (!fmt_ctx_ || !codec_ctx_) {
@@ -713,6 +980,13 @@ raii::AVFramePtr ImageDecoderWorker::DecodeNextFrame(int64_t* timestamp,
       continue;
     }
 
+    // Extend the frame index on the first pass over this packet
+    if (packets_sent_ == frame_index_.size()) {
+      frame_index_.push_back(MakeIndexEntry(*packet, stream->codecpar->codec_id,
+                                            frame_index_.empty()));
+    }
+    packets_sent_++;
+
     // Send packet to decoder
     ret = avcodec_send_packet(codec_ctx_.get(), packet.get());
     av_packet_unref(packet.get());
@@ -750,4 +1024,106 @@ raii::AVFramePtr ImageDecoderWorker::DecodeNextFrame(int64_t* timestamp,
   return nullptr;  // Exiting
 }
 
+// =============================================================================
+// PROGRESSIVE DECODING
+// =============================================================================
+
+bool ImageDecoderWorker::TryDecodeWhileStreaming(const ImageDecodeMessage& msg) {
+  // Partial images exist for the first frame of progressive formats only;
+  // everything else waits for the complete stream
+  if (msg.complete_frames_only || msg.frame_index != 0 || !configured_) {
+    return false;
+  }
+
+  // Each request resolves with a newer step than the previous one
+  const int generation = progressive_scanner_.generation();
+  if (generation <= partial_generation_) {
+    return false;
+  }
+  partial_generation_ = generation;
+
+  raii::AVFramePtr frame = PrepareOutputFrame(DecodePrefix(progressive_scanner_.boundary()));
+  if (!frame) {
+    return false;  // Not decodable yet; retried at the next step
+  }
+
+  ImageDecodeResult result;
+  result.frame = std::move(frame);
+  result.complete = false;
+  OutputDecodeResult(msg.promise_id, std::move(result));
+  return true;
+}
+
+void ImageDecoderWorker::ServeWaitingDecodes() {
+  if (waiting_decodes_.empty()) return;
+
+  // OnDecode() parks requests that still cannot be answered again, in order
+  std::vector<ImageDecodeMessage> waiting;
+  waiting.swap(waiting_decodes_);
+  for (const ImageDecodeMessage& msg : waiting) {
+    OnDecode(msg);
+  }
+}
+
+void ImageDecoderWorker::AbortWaitingDecodes() {
+  for (const ImageDecodeMessage& msg : waiting_decodes_) {
+    OutputError(msg.promise_id, AVERROR_EXIT, "Decode aborted due to reset");
+  }
+  waiting_decodes_.clear();
+}
+
+raii::AVFramePtr ImageDecoderWorker::DecodePrefix(size_t size) {
+  if (!fmt_ctx_ || size == 0 || size > static_cast<size_t>(INT_MAX) - 2) {
+    return nullptr;
+  }
+
+  // FFmpeg image decoders take the whole file as one packet and cannot
+  // resume a truncated one, so each step decodes the prefix again; the
+  // scanner keeps the number of steps small
+  if (!partial_ctx_) {
+    const AVCodecParameters* par = fmt_ctx_->streams[selected_stream_index_]->codecpar;
+    const AVCodec* codec = avcodec_find_decoder(par->codec_id);
+    if (!codec) return nullptr;
+
+    partial_ctx_ = raii::MakeAvCodecContext(codec);
+    if (!partial_ctx_ || avcodec_parameters_to_context(partial_ctx_.get(), par) < 0) {
+      partial_ctx_.reset();
+      return nullptr;
+    }
+    partial_ctx_->thread_count = 1;  // One packet per step: frame threads only add latency
+    partial_ctx_->lowres = codec_ctx_ ? codec_ctx_->lowres : 0;
+    if (avcodec_open2(partial_ctx_.get(), codec, nullptr) < 0) {
+      partial_ctx_.reset();
+      return nullptr;
+    }
+  } else {
+    avcodec_flush_buffers(partial_ctx_.get());
+  }
+
+  // The prefix ends where the next scan begins; terminate it with EOI so
+  // the decoder finishes the coefficients it has instead of waiting for more
+  raii::AVPacketPtr packet = raii::MakeAvPacket();
+  raii::AVFramePtr frame = raii::MakeAvFrame();
+  if (!packet || !frame || av_new_packet(packet.get(), static_cast<int>(size + 2)) < 0) {
+    return nullptr;
+  }
+  image_data_.Read(0, packet->data, size);
+  packet->data[size] = 0xFF;
+  packet->data[size + 1] = 0xD9;
+  packet->flags |= AV_PKT_FLAG_KEY;
+
+  if (avcodec_send_packet(partial_ctx_.get(), packet.get()) < 0) {
+    return nullptr;
+  }
+  int ret = avcodec_receive_frame(partial_ctx_.get(), frame.get());
+  if (ret == AVERROR(EAGAIN)) {
+    avcodec_send_packet(partial_ctx_.get(), nullptr);  // Drain
+    ret = avcodec_receive_frame(partial_ctx_.get(), frame.get());
+  }
+  if (ret < 0) {
+    return nullptr;
+  }
+  return frame;
+}
+
 }  // namespace webcodecs
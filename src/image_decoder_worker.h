@@ -21,6 +21,11 @@
 
 #include "ffmpeg_raii.h"
 #include "shared/control_message_queue.h"
+#include "shared/decoded_frame_cache.h"
+#include "shared/format_converter.h"
+#include "shared/mapped_file.h"
+#include "shared/progressive_scanner.h"
+#include "shared/segmented_buffer.h"
 
 namespace webcodecs {
 
@@ -37,6 +42,16 @@ struct ImageTrackInfo {
   int stream_index = 0;
 };
 
+/**
+ * Frame index entry recorded while demuxing the selected track.
+ * Entry i describes the packet that decodes to frame i (image codecs emit
+ * one frame per packet).
+ */
+struct ImageFrameIndexEntry {
+  int64_t pos = -1;  // Byte offset of the packet in the image data (-1 if unknown)
+  bool key = false;  // Decodable without earlier frames (random access point)
+};
+
 /**
  * Decoded frame result.
  */
@@ -44,7 +59,7 @@ struct ImageDecodeResult {
   raii::AVFramePtr frame;
   int64_t timestamp = 0;
   int64_t duration = 0;
-  bool complete = true;  // Always true for non-progressive decoding
+  bool complete = true;  // false for a partial (progressive) image of a streamed frame
 };
 
 /**
@@ -140,7 +155,7 @@ class ImageDecoderWorker {
    * Handle Configure message.
    * Opens format context from memory, parses tracks, opens codec.
    */
-  bool OnConfigure(const ImageConfigureMessage& msg);
+  bool OnConfigure(ImageConfigureMessage& msg);
 
   /**
    * Handle Decode message.
@@ -168,9 +183,9 @@ class ImageDecoderWorker {
 
   /**
    * Handle StreamData message (streaming mode).
-   * Appends data chunk to accumulated buffer.
+   * Appends data chunk to accumulated buffer (taking ownership of it).
    */
-  void OnStreamData(const ImageStreamDataMessage& msg);
+  void OnStreamData(ImageStreamDataMessage& msg);
 
   /**
    * Handle StreamEnd message (streaming mode).
@@ -210,17 +225,81 @@ class ImageDecoderWorker {
    */
   void OutputCompleted();
 
+  /**
+   * Report a configuration failure. Silent while a stream is still
+   * delivering data, since a later attempt may succeed.
+   */
+  void ConfigureError(int error_code, const std::string& message);
+
   /**
    * Seek to a specific frame index.
+   * Decoded frames passed on the way are added to the frame cache.
    * Returns true if successful.
    */
   bool SeekToFrame(uint32_t frame_index);
 
+  /**
+   * Reposition the demuxer at the indexed random access point k, if the
+   * index has one with current_frame_index_ < k <= frame_index (or any
+   * k <= frame_index when seeking backwards).
+   * Returns false if no such point is known or the byte seek failed.
+   */
+  bool SeekToRandomAccessPoint(uint32_t frame_index);
+
+  /**
+   * Demux the selected track once, recording every frame in frame_index_,
+   * then rewind. Used for in-memory data before decoding starts.
+   */
+  void BuildFrameIndex();
+
+  /**
+   * Drop the frame index and cached frames (new data or track).
+   */
+  void ClearFrameCache();
+
+  /**
+   * Resolve desiredWidth/desiredHeight against the stream's coded size and
+   * set codec_ctx_->lowres to the largest DCT downscale that still covers
+   * it. Must run before avcodec_open2().
+   */
+  void ApplyDesiredSize(const AVStream* stream);
+
+  /**
+   * Scale a decoded frame to the desired size (cached SwsContext).
+   * Frames already at that size are returned unchanged.
+   */
+  raii::AVFramePtr PrepareOutputFrame(raii::AVFramePtr frame);
+
   /**
    * Decode the next frame from the current position.
    */
   raii::AVFramePtr DecodeNextFrame(int64_t* timestamp, int64_t* duration);
 
+  /**
+   * Answer a decode request while the stream is still incomplete. With
+   * completeFramesOnly false, frame 0 resolves with a partial image
+   * (complete = false) once a newer progressive step has arrived.
+   * Returns false if the request has to wait for more data.
+   */
+  bool TryDecodeWhileStreaming(const ImageDecodeMessage& msg);
+
+  /**
+   * Retry parked decode requests (new progressive step, end of stream).
+   */
+  void ServeWaitingDecodes();
+
+  /**
+   * Reject parked decode requests with an abort (reset()).
+   */
+  void AbortWaitingDecodes();
+
+  /**
+   * Decode the first size buffered bytes (a JPEG prefix ending on a scan
+   * boundary) as a single packet on a separate codec context, producing
+   * the partial image those bytes describe.
+   */
+  raii::AVFramePtr DecodePrefix(size_t size);
+
   // Message queue reference (owned by ImageDecoder)
   ImageControlQueue& queue_;
 
@@ -254,9 +333,10 @@ class ImageDecoderWorker {
   // Codec context (decoder)
   raii::AVCodecContextPtr codec_ctx_;
 
-  // Image data buffer (copied from configure message)
-  std::vector<uint8_t> image_data_;
-  size_t read_position_ = 0;
+  // Encoded image data: the configure message's buffer, a view of the
+  // mapped {path} file, or the streamed chunks as received (read by the
+  // AVIO callbacks)
+  SegmentedBuffer image_data_;
 
   // Track information
   std::vector<ImageTrackInfo> tracks_;
@@ -265,19 +345,38 @@ class ImageDecoderWorker {
   // Frame tracking for animated images
   uint32_t current_frame_index_ = 0;
   uint32_t total_frame_count_ = 1;
+  uint32_t packets_sent_ = 0;  // Selected-track packets sent since the last seek point
+
+  // Random access: frame index built on the first forward pass, plus an LRU
+  // of composited frames so scrubbing does not re-decode from the start
+  std::vector<ImageFrameIndexEntry> frame_index_;
+  DecodedFrameCache frame_cache_;
 
   // Configuration
   std::string type_;
   std::optional<uint32_t> desired_width_;
   std::optional<uint32_t> desired_height_;
 
+  // Resolved output size for the selected track (0 = decoded size)
+  int output_width_ = 0;
+  int output_height_ = 0;
+  format_converter::FormatConverter scaler_;
+
   // Streaming mode state
   bool is_streaming_ = false;       // true if data comes from ReadableStream
   bool stream_complete_ = false;    // true when stream has closed
   bool configured_ = false;         // true when codec is initialized (after enough data received)
+  size_t next_configure_attempt_ = 0;  // Buffered bytes required before retrying configuration
   std::optional<bool> prefer_animation_;  // Stored for deferred configuration
   std::string color_space_conversion_;    // Stored for deferred configuration
 
+  // Progressive decoding (streaming mode): decode requests waiting for more
+  // data, refinement boundaries found so far, and the prefix decoder
+  std::vector<ImageDecodeMessage> waiting_decodes_;
+  ProgressiveScanner progressive_scanner_;
+  raii::AVCodecContextPtr partial_ctx_;
+  int partial_generation_ = 0;  // Last progressive step decoded
+
   /**
    * Try to configure the decoder with accumulated data.
    * For streaming mode, called when enough data has accumulated.
@@ -0,0 +1,80 @@
+#pragma once
+/**
+ * aac_adts.h - ADTS Framing for Raw AAC Encoder Output
+ *
+ * libavcodec AAC encoders emit raw access units plus an AudioSpecificConfig
+ * in extradata. With AudioEncoderConfig.aac.format "adts" (codec registry)
+ * every chunk instead carries a 7-byte ADTS header (no CRC) and
+ * decoderConfig has no description. The header fields are derived once from
+ * the AudioSpecificConfig:
+ *
+ * - profile = audio object type - 1; HE-AAC (SBR/PS, types 5 and 29) is
+ *   signalled implicitly as AAC-LC at the core sample rate, as in ADTS
+ *   streams written by FFmpeg's muxer
+ * - Escaped object types, explicit sample rates and PCE channel
+ *   configurations cannot be expressed and are rejected
+ *
+ * Thread Safety:
+ * - Stateless; safe to call from any thread
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace webcodecs {
+namespace adts {
+
+constexpr size_t kHeaderSize = 7;
+constexpr size_t kMaxFrameSize = (1 << 13) - 1;  // 13-bit frame length field
+
+struct Config {
+  int object_type;     // MPEG-4 audio object type (1-4)
+  int sampling_index;  // samplingFrequencyIndex (0-12)
+  int channel_config;  // channelConfiguration (1-7)
+};
+
+/**
+ * @return ADTS parameters for an AudioSpecificConfig, or std::nullopt when
+ *         ADTS cannot represent it
+ */
+inline std::optional<Config> ParseAudioSpecificConfig(const uint8_t* data, size_t size) {
+  if (!data || size < 2) return std::nullopt;
+  int object_type = data[0] >> 3;
+  const int sampling_index = ((data[0] & 0x07) << 1) | (data[1] >> 7);
+  const int channel_config = (data[1] >> 3) & 0x0f;
+
+  if (object_type == 5 || object_type == 29) {
+    // extensionSamplingFrequencyIndex (4 bits), then the core object type
+    if (size < 3) return std::nullopt;
+    object_type = (data[2] >> 2) & 0x1f;
+  }
+
+  if (object_type < 1 || object_type > 4) return std::nullopt;
+  if (sampling_index > 12 || channel_config < 1 || channel_config > 7) return std::nullopt;
+  return Config{object_type, sampling_index, channel_config};
+}
+
+/**
+ * Write the header of a frame carrying payload_size bytes of raw AAC to
+ * out[0..kHeaderSize).
+ *
+ * @return false if the frame is too long for the 13-bit length field
+ */
+inline bool WriteHeader(const Config& config, size_t payload_size, uint8_t* out) {
+  const size_t frame_size = payload_size + kHeaderSize;
+  if (frame_size > kMaxFrameSize) return false;
+
+  out[0] = 0xff;  // syncword
+  out[1] = 0xf1;  // syncword, MPEG-4, layer 0, no CRC
+  out[2] = static_cast<uint8_t>(((config.object_type - 1) << 6) | (config.sampling_index << 2) |
+                                (config.channel_config >> 2));
+  out[3] = static_cast<uint8_t>(((config.channel_config & 0x03) << 6) | (frame_size >> 11));
+  out[4] = static_cast<uint8_t>((frame_size >> 3) & 0xff);
+  out[5] = static_cast<uint8_t>(((frame_size & 0x07) << 5) | 0x1f);  // buffer fullness 0x7ff (VBR)
+  out[6] = 0xfc;                                                      // one raw data block
+  return true;
+}
+
+}  // namespace adts
+}  // namespace webcodecs
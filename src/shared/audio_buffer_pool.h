@@ -0,0 +1,348 @@
+#pragma once
+/**
+ * audio_buffer_pool.h - Process-Wide Pool of Audio Sample Buffers
+ *
+ * Audio frame sizes are very regular per stream (1024 samples for AAC, 960
+ * or 480 for Opus, 160 for a 20 ms G.711 packet), yet every AudioData,
+ * every decoded frame and every re-chunked encoder frame used to get a
+ * fresh av_frame_get_buffer() allocation, or a buffer from a libavcodec
+ * pool that died with its codec context. This pool keeps one AVBufferPool
+ * per (sample format, channels, nb_samples), shared by all streams, so
+ * buffers survive configure()/close() and are reused across streams:
+ *
+ * - GetBuffer() is av_frame_get_buffer(frame, 0) from the pool: one buffer
+ *   holds every plane
+ * - AudioBufferPoolGetBuffer2() is an AVCodecContext::get_buffer2 that
+ *   routes the output of DR1-capable audio decoders through the pool
+ * - AudioBufferCounters attribute acquisitions and real allocations to a
+ *   stream (the decoder/encoder stats getters report allocations/sec)
+ *
+ * Thread Safety:
+ * - All operations are mutex-protected, including av_buffer_pool_get() so
+ *   a pool is never evicted under a caller; counters are atomics
+ * - Buffers may be released from any thread
+ *
+ * Memory Model:
+ * - Each AVBufferPool keeps every buffer returned to it, so a key costs its
+ *   peak number of buffers in flight
+ * - LRU eviction with a maximum number of keys (default 32, 0 disables
+ *   pooling); an evicted pool is freed once its last buffer returns
+ */
+
+// Only include napi.h when not in pure C++ testing mode
+#ifndef WEBCODECS_TESTING
+#include <napi.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <utility>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/buffer.h>
+#include <libavutil/frame.h>
+#include <libavutil/mem.h>
+#include <libavutil/samplefmt.h>
+}
+
+namespace webcodecs {
+
+// ===========================================================================
+// POOL KEY
+// ===========================================================================
+
+struct AudioBufferPoolKey {
+  AVSampleFormat format = AV_SAMPLE_FMT_NONE;
+  int channels = 0;
+  int nb_samples = 0;
+
+  bool operator==(const AudioBufferPoolKey& other) const {
+    return format == other.format && channels == other.channels && nb_samples == other.nb_samples;
+  }
+};
+
+// ===========================================================================
+// STATISTICS
+// ===========================================================================
+
+/**
+ * Per-stream counters, owned by a decoder or encoder and reset on
+ * configure().
+ */
+struct AudioBufferCounters {
+  std::atomic<uint64_t> acquired{0};   // Buffers handed out
+  std::atomic<uint64_t> allocated{0};  // Of those, newly allocated (pool empty)
+  std::atomic<int64_t> since_ns{0};    // steady_clock time of the last Reset()
+
+  void Reset() {
+    acquired.store(0, std::memory_order_relaxed);
+    allocated.store(0, std::memory_order_relaxed);
+    since_ns.store(NowNs(), std::memory_order_relaxed);
+  }
+
+  /** Allocations per second since the last Reset(). */
+  [[nodiscard]] double AllocationsPerSecond() const {
+    const int64_t elapsed = NowNs() - since_ns.load(std::memory_order_relaxed);
+    if (elapsed <= 0) return 0.0;
+    return static_cast<double>(allocated.load(std::memory_order_relaxed)) * 1e9 / static_cast<double>(elapsed);
+  }
+
+  static int64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+};
+
+struct AudioBufferPoolStats {
+  std::atomic<uint64_t> acquired{0};   // Buffers handed out
+  std::atomic<uint64_t> allocated{0};  // Of those, newly allocated (pool empty)
+  std::atomic<uint64_t> evictions{0};  // Keys dropped to respect the limit
+};
+
+// ===========================================================================
+// GLOBAL AUDIO BUFFER POOL
+// ===========================================================================
+
+class GlobalAudioBufferPool {
+ public:
+  static constexpr size_t kDefaultMaxPools = 32;
+
+  // Beyond the samples: decoder SIMD loops may write up to a vector past the
+  // last sample (libavcodec pads its own audio buffers the same way)
+  static constexpr int kPadding = 64;
+
+  /**
+   * Get the global pool instance.
+   * Thread-safe lazy initialization.
+   */
+  static GlobalAudioBufferPool& Instance() {
+    static GlobalAudioBufferPool pool;
+    return pool;
+  }
+
+  /**
+   * Set the maximum number of keys kept. 0 disables pooling: GetBuffer()
+   * falls back to av_frame_get_buffer().
+   */
+  void SetMaxPools(size_t max_pools) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_pools_ = max_pools;
+    EvictLocked();
+  }
+
+  [[nodiscard]] size_t max_pools() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_pools_;
+  }
+
+  [[nodiscard]] size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pools_.size();
+  }
+
+  [[nodiscard]] const AudioBufferPoolStats& stats() const { return stats_; }
+
+  /**
+   * Allocate the sample buffer of frame, like av_frame_get_buffer(frame, 0).
+   * format, nb_samples and the channel layout must be set; all planes share
+   * one pooled buffer (frame->buf[0]).
+   *
+   * @param counters Per-stream counters to update, may be nullptr
+   * @return 0 on success, negative AVERROR on failure
+   */
+  int GetBuffer(AVFrame* frame, AudioBufferCounters* counters = nullptr) {
+    const auto format = static_cast<AVSampleFormat>(frame->format);
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+    const int channels = frame->ch_layout.nb_channels;
+#else
+    const int channels = frame->channels;
+#endif
+    if (frame->buf[0] || format == AV_SAMPLE_FMT_NONE || channels <= 0 || frame->nb_samples <= 0) {
+      return AVERROR(EINVAL);
+    }
+
+    const AudioBufferPoolKey key{format, channels, frame->nb_samples};
+    AVBufferRef* buffer = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (max_pools_ > 0) {
+        AVBufferPool* pool = FindLocked(key);
+        if (!pool) return AVERROR(ENOMEM);
+        allocating_for_ = counters;
+        buffer = av_buffer_pool_get(pool);
+        allocating_for_ = nullptr;
+        if (!buffer) return AVERROR(ENOMEM);
+      }
+    }
+    stats_.acquired.fetch_add(1, std::memory_order_relaxed);
+    if (counters) counters->acquired.fetch_add(1, std::memory_order_relaxed);
+
+    if (!buffer) {
+      // Pooling disabled: every buffer is an allocation
+      stats_.allocated.fetch_add(1, std::memory_order_relaxed);
+      if (counters) counters->allocated.fetch_add(1, std::memory_order_relaxed);
+      return av_frame_get_buffer(frame, 0);
+    }
+    frame->buf[0] = buffer;
+
+    if (av_sample_fmt_is_planar(format) && channels > AV_NUM_DATA_POINTERS) {
+      frame->extended_data = static_cast<uint8_t**>(av_calloc(static_cast<size_t>(channels), sizeof(uint8_t*)));
+      if (!frame->extended_data) {
+        frame->extended_data = frame->data;
+        av_buffer_unref(&frame->buf[0]);
+        return AVERROR(ENOMEM);
+      }
+    } else {
+      frame->extended_data = frame->data;
+    }
+
+    int ret = av_samples_fill_arrays(frame->extended_data, &frame->linesize[0], buffer->data, channels,
+                                     frame->nb_samples, format, 0);
+    if (ret < 0) {
+      if (frame->extended_data != frame->data) av_freep(&frame->extended_data);
+      frame->extended_data = frame->data;
+      av_buffer_unref(&frame->buf[0]);
+      return ret;
+    }
+    if (frame->extended_data != frame->data) {
+      for (int i = 0; i < AV_NUM_DATA_POINTERS; i++) {
+        frame->data[i] = frame->extended_data[i];
+      }
+    }
+    return 0;
+  }
+
+  /**
+   * Free every idle buffer and pool (testing, memory pressure). Buffers in
+   * use stay valid.
+   */
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : pools_) av_buffer_pool_uninit(&entry.second);
+    pools_.clear();
+  }
+
+  void ResetStats() {
+    stats_.acquired.store(0, std::memory_order_relaxed);
+    stats_.allocated.store(0, std::memory_order_relaxed);
+    stats_.evictions.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  GlobalAudioBufferPool() = default;
+  ~GlobalAudioBufferPool() { Clear(); }
+
+  GlobalAudioBufferPool(const GlobalAudioBufferPool&) = delete;
+  GlobalAudioBufferPool& operator=(const GlobalAudioBufferPool&) = delete;
+
+  // Runs inside av_buffer_pool_get() when the pool is empty (mutex_ held)
+#if LIBAVUTIL_VERSION_MAJOR >= 57
+  static AVBufferRef* Allocate(void* opaque, size_t size) {
+#else
+  static AVBufferRef* Allocate(void* opaque, int size) {
+#endif
+    auto* self = static_cast<GlobalAudioBufferPool*>(opaque);
+    self->stats_.allocated.fetch_add(1, std::memory_order_relaxed);
+    if (self->allocating_for_) self->allocating_for_->allocated.fetch_add(1, std::memory_order_relaxed);
+    return av_buffer_alloc(size);
+  }
+
+  // Pool for key, moved to the front of the LRU list (created on a miss)
+  AVBufferPool* FindLocked(const AudioBufferPoolKey& key) {
+    for (auto it = pools_.begin(); it != pools_.end(); ++it) {
+      if (it->first == key) {
+        if (it != pools_.begin()) pools_.splice(pools_.begin(), pools_, it);
+        return pools_.front().second;
+      }
+    }
+
+    const int size = av_samples_get_buffer_size(nullptr, key.channels, key.nb_samples, key.format, 0);
+    if (size <= 0) return nullptr;
+    AVBufferPool* pool = av_buffer_pool_init2(static_cast<size_t>(size) + kPadding, this, Allocate, nullptr);
+    if (!pool) return nullptr;
+    pools_.emplace_front(key, pool);
+    EvictLocked();
+    return pool;
+  }
+
+  void EvictLocked() {
+    while (pools_.size() > max_pools_) {
+      // Idle buffers are freed now, buffers in use when they return
+      av_buffer_pool_uninit(&pools_.back().second);
+      pools_.pop_back();
+      stats_.evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  mutable std::mutex mutex_;
+  // Most recently used first
+  std::list<std::pair<AudioBufferPoolKey, AVBufferPool*>> pools_;
+  size_t max_pools_ = kDefaultMaxPools;
+  AudioBufferPoolStats stats_;
+  AudioBufferCounters* allocating_for_ = nullptr;  // Stream of the running GetBuffer()
+};
+
+/**
+ * AVCodecContext::get_buffer2 for audio decoders: sample buffers come from
+ * GlobalAudioBufferPool, counted against the AudioBufferCounters in
+ * ctx->opaque (may be nullptr). Video, and decoders without
+ * AV_CODEC_CAP_DR1 (which do not support custom allocators), fall back to
+ * the default allocator.
+ */
+inline int AudioBufferPoolGetBuffer2(AVCodecContext* ctx, AVFrame* frame, int flags) {
+  if (ctx->codec_type != AVMEDIA_TYPE_AUDIO || !ctx->codec || !(ctx->codec->capabilities & AV_CODEC_CAP_DR1)) {
+    return avcodec_default_get_buffer2(ctx, frame, flags);
+  }
+  return GlobalAudioBufferPool::Instance().GetBuffer(frame, static_cast<AudioBufferCounters*>(ctx->opaque));
+}
+
+#ifndef WEBCODECS_TESTING
+/**
+ * Non-standard static AudioData.bufferPool(options?): applies {maxPools}
+ * when given and returns the process-wide pool counters.
+ */
+inline Napi::Value AudioBufferPoolMethod(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  GlobalAudioBufferPool& pool = GlobalAudioBufferPool::Instance();
+
+  if (info.Length() > 0 && info[0].IsObject()) {
+    Napi::Object options = info[0].As<Napi::Object>();
+    if (options.Has("maxPools") && options.Get("maxPools").IsNumber()) {
+      int64_t max_pools = options.Get("maxPools").As<Napi::Number>().Int64Value();
+      if (max_pools < 0 || max_pools > 1024) {
+        Napi::TypeError::New(env, "maxPools must be between 0 and 1024").ThrowAsJavaScriptException();
+        return env.Undefined();
+      }
+      pool.SetMaxPools(static_cast<size_t>(max_pools));
+    }
+  }
+
+  const AudioBufferPoolStats& stats = pool.stats();
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("maxPools", Napi::Number::New(env, static_cast<double>(pool.max_pools())));
+  result.Set("pools", Napi::Number::New(env, static_cast<double>(pool.size())));
+  result.Set("acquired", Napi::Number::New(env, static_cast<double>(stats.acquired.load())));
+  result.Set("allocated", Napi::Number::New(env, static_cast<double>(stats.allocated.load())));
+  result.Set("evictions", Napi::Number::New(env, static_cast<double>(stats.evictions.load())));
+  return result;
+}
+
+/** Per-stream buffer counters for the AudioDecoder/AudioEncoder `stats` getters. */
+inline Napi::Object AudioBufferCountersToObject(Napi::Env env, const AudioBufferCounters& counters) {
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("bufferAcquisitions",
+             Napi::Number::New(env, static_cast<double>(counters.acquired.load(std::memory_order_relaxed))));
+  result.Set("bufferAllocations",
+             Napi::Number::New(env, static_cast<double>(counters.allocated.load(std::memory_order_relaxed))));
+  result.Set("bufferAllocationsPerSecond", Napi::Number::New(env, counters.AllocationsPerSecond()));
+  return result;
+}
+#endif
+
+}  // namespace webcodecs
@@ -0,0 +1,183 @@
+#pragma once
+/**
+ * audio_frame_coalescer.h - Merges Small Decoded Audio Frames
+ *
+ * Opus (2.5-20 ms) and AAC-LD decoders produce hundreds of frames per second
+ * per stream, and every one becomes an AudioData and an output callback on
+ * the JS thread. With AudioDecoderConfig.minOutputDuration (non-standard) the
+ * decoder worker passes its frames through this coalescer, which
+ * concatenates consecutive frames until they cover at least that duration:
+ *
+ * - Frames are merged only while format, sample rate and channel count stay
+ *   the same and each frame starts where the previous one ended (within
+ *   half a sample); anything else first emits what is pending
+ * - Frames without a timestamp are passed through on their own
+ * - Flush() emits the pending remainder (decoder flush() and configure());
+ *   Reset() drops it (decoder reset())
+ *
+ * Timestamps (AVFrame::pts) are microseconds, as delivered to AudioData.
+ * Merged frames are allocated from GlobalAudioBufferPool.
+ *
+ * Thread Safety:
+ * - Not thread-safe; owned and used by a single worker thread
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+extern "C" {
+#include <libavutil/frame.h>
+#include <libavutil/mathematics.h>
+#include <libavutil/samplefmt.h>
+}
+
+#include "../ffmpeg_raii.h"
+#include "audio_buffer_pool.h"
+
+namespace webcodecs {
+
+class AudioFrameCoalescer {
+ public:
+  AudioFrameCoalescer() = default;
+
+  // Non-copyable (owns pending frames)
+  AudioFrameCoalescer(const AudioFrameCoalescer&) = delete;
+  AudioFrameCoalescer& operator=(const AudioFrameCoalescer&) = delete;
+
+  /**
+   * Set the minimum output duration in microseconds; 0 disables merging.
+   * Drops anything pending. counters (may be nullptr) are charged for the
+   * buffers of merged frames.
+   */
+  void Configure(int64_t min_duration_us, AudioBufferCounters* counters = nullptr) {
+    Reset();
+    min_duration_us_ = std::max<int64_t>(0, min_duration_us);
+    counters_ = counters;
+  }
+
+  [[nodiscard]] bool enabled() const { return min_duration_us_ > 0; }
+
+  /** Frames held back, waiting for more samples. */
+  [[nodiscard]] size_t pending() const { return pending_.size(); }
+
+  /**
+   * Add a decoded frame. Frames ready for output, in order, are appended
+   * to *ready.
+   *
+   * @return 0 on success, negative AVERROR if a merged frame could not be
+   *         allocated (pending frames are dropped)
+   */
+  int Push(raii::AVFramePtr frame, std::vector<raii::AVFramePtr>* ready) {
+    if (!frame) return 0;
+    if (!enabled()) {
+      ready->push_back(std::move(frame));
+      return 0;
+    }
+
+    if (!pending_.empty() && !Continues(frame.get())) {
+      int ret = EmitPending(ready);
+      if (ret < 0) return ret;
+    }
+    if (frame->pts == AV_NOPTS_VALUE || frame->sample_rate <= 0) {
+      ready->push_back(std::move(frame));
+      return 0;
+    }
+
+    pending_samples_ += frame->nb_samples;
+    pending_.push_back(std::move(frame));
+    if (PendingDurationUs() >= min_duration_us_) return EmitPending(ready);
+    return 0;
+  }
+
+  /**
+   * @return Pending samples as one frame, or nullptr if nothing is pending
+   */
+  raii::AVFramePtr Flush() {
+    std::vector<raii::AVFramePtr> ready;
+    if (EmitPending(&ready) < 0 || ready.empty()) return nullptr;
+    return std::move(ready.front());
+  }
+
+  /** Drop pending frames. */
+  void Reset() {
+    pending_.clear();
+    pending_samples_ = 0;
+  }
+
+ private:
+  static int Channels(const AVFrame* frame) {
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+    return frame->ch_layout.nb_channels;
+#else
+    return frame->channels;
+#endif
+  }
+
+  int64_t PendingDurationUs() const {
+    return av_rescale(pending_samples_, 1000000, pending_.front()->sample_rate);
+  }
+
+  // Same parameters as the pending frames and starting where they end
+  bool Continues(const AVFrame* frame) const {
+    const AVFrame* first = pending_.front().get();
+    if (frame->format != first->format || frame->sample_rate != first->sample_rate ||
+        Channels(frame) != Channels(first) || frame->pts == AV_NOPTS_VALUE) {
+      return false;
+    }
+    const int64_t expected = first->pts + PendingDurationUs();
+    const int64_t tolerance = std::max<int64_t>(1, 500000 / first->sample_rate);
+    return std::llabs(frame->pts - expected) <= tolerance;
+  }
+
+  int EmitPending(std::vector<raii::AVFramePtr>* ready) {
+    if (pending_.empty()) return 0;
+    if (pending_.size() == 1) {
+      ready->push_back(std::move(pending_.front()));
+      Reset();
+      return 0;
+    }
+
+    const AVFrame* first = pending_.front().get();
+    raii::AVFramePtr merged = raii::MakeAvFrame();
+    int ret = merged ? av_frame_copy_props(merged.get(), first) : AVERROR(ENOMEM);
+    if (ret >= 0) {
+      merged->format = first->format;
+      merged->sample_rate = first->sample_rate;
+      merged->nb_samples = static_cast<int>(pending_samples_);
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+      ret = av_channel_layout_copy(&merged->ch_layout, &first->ch_layout);
+#else
+      merged->channels = first->channels;
+      merged->channel_layout = first->channel_layout;
+#endif
+    }
+    if (ret >= 0) ret = GlobalAudioBufferPool::Instance().GetBuffer(merged.get(), counters_);
+    if (ret < 0) {
+      Reset();
+      return ret;
+    }
+
+    const int channels = Channels(first);
+    const auto format = static_cast<AVSampleFormat>(first->format);
+    int offset = 0;
+    for (const raii::AVFramePtr& part : pending_) {
+      av_samples_copy(merged->extended_data, part->extended_data, offset, 0, part->nb_samples,
+                      channels, format);
+      offset += part->nb_samples;
+    }
+    merged->pts = first->pts;
+
+    ready->push_back(std::move(merged));
+    Reset();
+    return 0;
+  }
+
+  int64_t min_duration_us_ = 0;
+  AudioBufferCounters* counters_ = nullptr;  // Owned by the decoder
+  std::vector<raii::AVFramePtr> pending_;
+  int64_t pending_samples_ = 0;
+};
+
+}  // namespace webcodecs
@@ -0,0 +1,215 @@
+#pragma once
+/**
+ * audio_frame_fifo.h - Sample FIFO that Re-Chunks Audio to the Encoder Frame Size
+ *
+ * AAC (1024), Opus (960 at 48 kHz) and MP3 (1152) encoders only accept
+ * frames of exactly AVCodecContext::frame_size samples, while AudioData
+ * from capture paths arrives in arbitrary sizes. This FIFO sits in front of
+ * avcodec_send_frame():
+ *
+ * - Write() appends the samples of an input frame of any size
+ * - ReadFrame() returns the next frame of exactly frame_size samples
+ * - ReadTail() returns what is left at flush, as a short last frame when
+ *   the encoder accepts one (AV_CODEC_CAP_SMALL_LAST_FRAME), otherwise
+ *   padded with silence to frame_size
+ *
+ * Timestamps:
+ * - The first write after Init()/Reset() anchors the output timeline;
+ *   output frame n starts at anchor + samples emitted before it (encoder
+ *   time base 1/sample_rate), so output PTS stay sample-accurate however
+ *   the input was sliced
+ *
+ * Memory Model:
+ * - Output frame buffers come from GlobalAudioBufferPool (one buffer per
+ *   frame, all planes); they return to it once the encoder releases them
+ *
+ * Thread Safety:
+ * - Not thread-safe; owned and used by a single worker thread
+ */
+
+#include <cstdint>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/audio_fifo.h>
+#include <libavutil/frame.h>
+#include <libavutil/samplefmt.h>
+}
+
+#include "../ffmpeg_raii.h"
+#include "audio_buffer_pool.h"
+
+namespace webcodecs {
+
+class AudioFrameFifo {
+ public:
+  AudioFrameFifo() = default;
+  ~AudioFrameFifo() { Release(); }
+
+  // Non-copyable (owns the FIFO)
+  AudioFrameFifo(const AudioFrameFifo&) = delete;
+  AudioFrameFifo& operator=(const AudioFrameFifo&) = delete;
+
+  /**
+   * Set up for an opened encoder. Encoders without a fixed frame size
+   * (frame_size 0 or AV_CODEC_CAP_VARIABLE_FRAME_SIZE) leave the FIFO
+   * disabled: their input is sent as is.
+   *
+   * @param counters Stream counters for output buffers, may be nullptr
+   * @return false on allocation failure
+   */
+  bool Init(const AVCodecContext* ctx, AudioBufferCounters* counters = nullptr) {
+    Release();
+    const bool variable =
+        ctx->codec && (ctx->codec->capabilities & AV_CODEC_CAP_VARIABLE_FRAME_SIZE) != 0;
+    if (ctx->frame_size <= 0 || variable) return true;
+
+    format_ = ctx->sample_fmt;
+    frame_size_ = ctx->frame_size;
+    sample_rate_ = ctx->sample_rate;
+    small_last_frame_ =
+        ctx->codec && (ctx->codec->capabilities & AV_CODEC_CAP_SMALL_LAST_FRAME) != 0;
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+    if (av_channel_layout_copy(&ch_layout_, &ctx->ch_layout) < 0) return false;
+    channels_ = ch_layout_.nb_channels;
+#else
+    channel_layout_ = ctx->channel_layout;
+    channels_ = ctx->channels;
+#endif
+
+    counters_ = counters;
+    fifo_ = av_audio_fifo_alloc(format_, channels_, frame_size_ * 2);
+    if (!fifo_) {
+      Release();
+      return false;
+    }
+    return true;
+  }
+
+  /** true when input has to be re-chunked (fixed frame size encoder). */
+  [[nodiscard]] bool enabled() const { return fifo_ != nullptr; }
+
+  [[nodiscard]] int frame_size() const { return frame_size_; }
+
+  /** Samples buffered but not yet returned. */
+  [[nodiscard]] int buffered() const { return fifo_ ? av_audio_fifo_size(fifo_) : 0; }
+
+  /**
+   * Drop buffered samples and forget the timestamp anchor.
+   */
+  void Reset() {
+    if (fifo_) av_audio_fifo_reset(fifo_);
+    anchored_ = false;
+    next_pts_ = 0;
+  }
+
+  /**
+   * Buffer the samples of frame, whose format and channel count must match
+   * the encoder's. pts (1/sample_rate) anchors the timeline on the first
+   * write after a reset.
+   *
+   * @return 0 on success, negative AVERROR on failure
+   */
+  int Write(const AVFrame* frame, int64_t pts) {
+    if (!fifo_) return AVERROR(EINVAL);
+    if (frame->nb_samples <= 0) return 0;
+    if (!anchored_) {
+      next_pts_ = pts;
+      anchored_ = true;
+    }
+    const int written = av_audio_fifo_write(
+        fifo_, reinterpret_cast<void**>(frame->extended_data), frame->nb_samples);
+    return written < 0 ? written : 0;
+  }
+
+  /**
+   * @return Next frame of exactly frame_size samples, or nullptr if fewer
+   *         are buffered
+   */
+  [[nodiscard]] raii::AVFramePtr ReadFrame() {
+    if (!fifo_ || av_audio_fifo_size(fifo_) < frame_size_) return nullptr;
+    return Read(frame_size_);
+  }
+
+  /**
+   * @return Remaining samples as a final frame (see file comment), or
+   *         nullptr if nothing is buffered
+   */
+  [[nodiscard]] raii::AVFramePtr ReadTail() {
+    const int remaining = buffered();
+    if (remaining <= 0) return nullptr;
+    return Read(remaining);
+  }
+
+ private:
+  raii::AVFramePtr Read(int nb_samples) {
+    raii::AVFramePtr frame = AllocFrame();
+    if (!frame) return nullptr;
+
+    const int read =
+        av_audio_fifo_read(fifo_, reinterpret_cast<void**>(frame->extended_data), nb_samples);
+    if (read < nb_samples) return nullptr;
+
+    if (nb_samples < frame_size_) {
+      if (small_last_frame_) {
+        frame->nb_samples = nb_samples;
+      } else {
+        av_samples_set_silence(frame->extended_data, nb_samples, frame_size_ - nb_samples,
+                               channels_, format_);
+      }
+    }
+
+    frame->pts = next_pts_;
+    next_pts_ += nb_samples;
+    return frame;
+  }
+
+  // Frame of frame_size samples backed by a pooled buffer
+  raii::AVFramePtr AllocFrame() {
+    raii::AVFramePtr frame = raii::MakeAvFrame();
+    if (!frame) return nullptr;
+
+    frame->format = format_;
+    frame->nb_samples = frame_size_;
+    frame->sample_rate = sample_rate_;
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+    if (av_channel_layout_copy(&frame->ch_layout, &ch_layout_) < 0) return nullptr;
+#else
+    frame->channel_layout = channel_layout_;
+    frame->channels = channels_;
+#endif
+
+    if (GlobalAudioBufferPool::Instance().GetBuffer(frame.get(), counters_) < 0) return nullptr;
+    return frame;
+  }
+
+  void Release() {
+    if (fifo_) av_audio_fifo_free(fifo_);
+    fifo_ = nullptr;
+    counters_ = nullptr;
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+    av_channel_layout_uninit(&ch_layout_);
+#endif
+    frame_size_ = 0;
+    channels_ = 0;
+    Reset();
+  }
+
+  AVAudioFifo* fifo_ = nullptr;
+  AudioBufferCounters* counters_ = nullptr;  // Owned by the encoder
+  AVSampleFormat format_ = AV_SAMPLE_FMT_NONE;
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+  AVChannelLayout ch_layout_{};
+#else
+  uint64_t channel_layout_ = 0;
+#endif
+  int channels_ = 0;
+  int frame_size_ = 0;
+  int sample_rate_ = 0;
+  bool small_last_frame_ = false;
+
+  bool anchored_ = false;
+  int64_t next_pts_ = 0;  // PTS of the next sample returned (1/sample_rate)
+};
+
+}  // namespace webcodecs
@@ -0,0 +1,249 @@
+#pragma once
+/**
+ * audio_gap_concealer.h - Fills Timestamp Gaps in Decoded Audio
+ *
+ * Live ingest (RTP and friends) loses packets, and a decoder fed what is
+ * left produces audio with holes in its timeline. With
+ * AudioDecoderConfig.maxConcealedGap (non-standard) the decoder worker
+ * passes its frames through this concealer, which follows the timeline
+ * sample by sample:
+ *
+ * - A frame starting within kRepairToleranceUs of where the previous one
+ *   ended is restamped to start exactly there (timestamp repair)
+ * - A frame starting later, by at most the configured gap, is preceded by
+ *   concealment frames covering the hole: the tail of the last frame played
+ *   backwards (so the waveform continues without a step) and faded out
+ *   over at most kFadeUs, then silence. Concealment frames have the size of
+ *   the last frame, the final one shortened to end where the gap does
+ * - Longer gaps, jumps backwards and format changes are passed through and
+ *   restart the timeline at the new frame
+ * - Frames without a timestamp are passed through on their own
+ *
+ * Timestamps (AVFrame::pts) are microseconds, as delivered to AudioData.
+ * Concealment frames are allocated from GlobalAudioBufferPool.
+ *
+ * Thread Safety:
+ * - Not thread-safe; owned and used by a single worker thread
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+
+extern "C" {
+#include <libavutil/frame.h>
+#include <libavutil/mathematics.h>
+#include <libavutil/samplefmt.h>
+}
+
+#include "../ffmpeg_raii.h"
+#include "audio_buffer_pool.h"
+
+namespace webcodecs {
+
+class AudioGapConcealer {
+ public:
+  // Start offsets up to this are timestamp rounding, not lost audio
+  static constexpr int64_t kRepairToleranceUs = 1000;
+  // Longest fade-out of the replayed tail; silence follows
+  static constexpr int64_t kFadeUs = 20000;
+
+  AudioGapConcealer() = default;
+
+  // Non-copyable (holds the last frame)
+  AudioGapConcealer(const AudioGapConcealer&) = delete;
+  AudioGapConcealer& operator=(const AudioGapConcealer&) = delete;
+
+  /**
+   * Set the longest gap to conceal in microseconds; 0 disables concealment.
+   * Forgets the timeline. counters (may be nullptr) are charged for the
+   * buffers of concealment frames.
+   */
+  void Configure(int64_t max_gap_us, AudioBufferCounters* counters = nullptr) {
+    Reset();
+    max_gap_us_ = std::max<int64_t>(0, max_gap_us);
+    counters_ = counters;
+    concealed_samples_ = 0;
+  }
+
+  [[nodiscard]] bool enabled() const { return max_gap_us_ > 0; }
+
+  /** Samples of concealment emitted since Configure(). */
+  [[nodiscard]] int64_t concealed_samples() const { return concealed_samples_; }
+
+  /**
+   * Add a decoded frame. Concealment frames for a gap before it, then the
+   * frame itself, are appended to *ready.
+   *
+   * @return 0 on success, negative AVERROR if a concealment frame could not
+   *         be allocated (the frame is still appended, the gap left open)
+   */
+  int Push(raii::AVFramePtr frame, std::vector<raii::AVFramePtr>* ready) {
+    if (!frame) return 0;
+    if (!enabled() || frame->pts == AV_NOPTS_VALUE || frame->sample_rate <= 0) {
+      ready->push_back(std::move(frame));
+      return 0;
+    }
+
+    int ret = 0;
+    if (!last_ || !SameFormat(frame.get())) {
+      Restart(frame.get());
+    } else {
+      const int64_t expected = NextPts();
+      const int64_t offset = frame->pts - expected;
+      if (std::llabs(offset) <= kRepairToleranceUs) {
+        frame->pts = expected;
+      } else if (offset > 0 && offset <= max_gap_us_) {
+        const int64_t samples = av_rescale(offset, frame->sample_rate, 1000000);
+        ret = Conceal(samples, ready);
+        Restart(frame.get());
+      } else if (offset > 0) {
+        Restart(frame.get());
+      } else if (frame->pts + Duration(frame.get()) <= expected) {
+        // Entirely behind the timeline (duplicate or reordered packet)
+        ready->push_back(std::move(frame));
+        return 0;
+      } else {
+        Restart(frame.get());
+      }
+    }
+
+    timeline_samples_ += frame->nb_samples;
+    last_ = raii::CloneAvFrame(frame.get());
+    ready->push_back(std::move(frame));
+    return ret;
+  }
+
+  /** Forget the timeline (decoder flush, reset and configure). */
+  void Reset() {
+    last_.reset();
+    timeline_pts_ = 0;
+    timeline_samples_ = 0;
+  }
+
+ private:
+  static int Channels(const AVFrame* frame) {
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+    return frame->ch_layout.nb_channels;
+#else
+    return frame->channels;
+#endif
+  }
+
+  static int64_t Duration(const AVFrame* frame) {
+    return av_rescale(frame->nb_samples, 1000000, frame->sample_rate);
+  }
+
+  bool SameFormat(const AVFrame* frame) const {
+    return frame->format == last_->format && frame->sample_rate == last_->sample_rate &&
+           Channels(frame) == Channels(last_.get());
+  }
+
+  // Counted in samples from the timeline start, so repair never drifts
+  int64_t NextPts() const {
+    return timeline_pts_ + av_rescale(timeline_samples_, 1000000, last_->sample_rate);
+  }
+
+  void Restart(const AVFrame* frame) {
+    timeline_pts_ = frame->pts;
+    timeline_samples_ = 0;
+  }
+
+  // Append concealment frames for `samples` samples after last_
+  int Conceal(int64_t samples, std::vector<raii::AVFramePtr>* ready) {
+    const AVFrame* last = last_.get();
+    const int64_t start = NextPts();
+    const int fade = static_cast<int>(
+        std::min<int64_t>(last->nb_samples, av_rescale(kFadeUs, last->sample_rate, 1000000)));
+
+    int64_t offset = 0;
+    while (offset < samples) {
+      const int count = static_cast<int>(std::min<int64_t>(last->nb_samples, samples - offset));
+      raii::AVFramePtr out = raii::MakeAvFrame();
+      int ret = out ? av_frame_copy_props(out.get(), last) : AVERROR(ENOMEM);
+      if (ret >= 0) {
+        out->format = last->format;
+        out->sample_rate = last->sample_rate;
+        out->nb_samples = count;
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+        ret = av_channel_layout_copy(&out->ch_layout, &last->ch_layout);
+#else
+        out->channels = last->channels;
+        out->channel_layout = last->channel_layout;
+#endif
+      }
+      if (ret >= 0) ret = GlobalAudioBufferPool::Instance().GetBuffer(out.get(), counters_);
+      if (ret < 0) return ret;
+
+      FillConcealment(last, out.get(), offset, fade);
+      out->pts = start + av_rescale(offset, 1000000, last->sample_rate);
+      ready->push_back(std::move(out));
+      offset += count;
+      concealed_samples_ += count;
+    }
+    return 0;
+  }
+
+  // Samples [offset, offset + out->nb_samples) of the concealment after last
+  static void FillConcealment(const AVFrame* last, AVFrame* out, int64_t offset, int fade) {
+    switch (av_get_packed_sample_fmt(static_cast<AVSampleFormat>(last->format))) {
+      case AV_SAMPLE_FMT_U8:
+        FillConcealmentAs<uint8_t>(last, out, offset, fade, 128.0);
+        break;
+      case AV_SAMPLE_FMT_S16:
+        FillConcealmentAs<int16_t>(last, out, offset, fade, 0.0);
+        break;
+      case AV_SAMPLE_FMT_S32:
+        FillConcealmentAs<int32_t>(last, out, offset, fade, 0.0);
+        break;
+      case AV_SAMPLE_FMT_S64:
+        FillConcealmentAs<int64_t>(last, out, offset, fade, 0.0);
+        break;
+      case AV_SAMPLE_FMT_FLT:
+        FillConcealmentAs<float>(last, out, offset, fade, 0.0);
+        break;
+      case AV_SAMPLE_FMT_DBL:
+        FillConcealmentAs<double>(last, out, offset, fade, 0.0);
+        break;
+      default:
+        av_samples_set_silence(out->extended_data, 0, out->nb_samples, Channels(out),
+                               static_cast<AVSampleFormat>(out->format));
+        break;
+    }
+  }
+
+  template <typename T>
+  static void FillConcealmentAs(const AVFrame* last, AVFrame* out, int64_t offset, int fade, double center) {
+    const int channels = Channels(last);
+    const bool planar = av_sample_fmt_is_planar(static_cast<AVSampleFormat>(last->format));
+    const int step = planar ? 1 : channels;
+    const int n = last->nb_samples;
+
+    for (int ch = 0; ch < channels; ch++) {
+      const T* src = reinterpret_cast<const T*>(last->extended_data[planar ? ch : 0]) + (planar ? 0 : ch);
+      T* dst = reinterpret_cast<T*>(out->extended_data[planar ? ch : 0]) + (planar ? 0 : ch);
+      for (int i = 0; i < out->nb_samples; i++) {
+        const int64_t g = offset + i;
+        double value = center;
+        if (g < fade) {
+          const double gain = 1.0 - static_cast<double>(g + 1) / (fade + 1);
+          value = center + (static_cast<double>(src[(n - 1 - g) * step]) - center) * gain;
+        }
+        dst[i * step] = std::is_floating_point<T>::value ? static_cast<T>(value)
+                                                          : static_cast<T>(std::llround(value));
+      }
+    }
+  }
+
+  int64_t max_gap_us_ = 0;
+  AudioBufferCounters* counters_ = nullptr;  // Owned by the decoder
+  raii::AVFramePtr last_;                    // Reference to the last frame passed on
+  int64_t timeline_pts_ = 0;                 // Microseconds
+  int64_t timeline_samples_ = 0;             // Passed on since timeline_pts_
+  int64_t concealed_samples_ = 0;
+};
+
+}  // namespace webcodecs
@@ -0,0 +1,228 @@
+#pragma once
+/**
+ * audio_mix_bus.h - Timestamp-Aligned Summing of Audio Sources
+ *
+ * The mixing core of AudioMixer (non-standard). Each source pushes f32
+ * planar samples that are already at the bus rate and channel count (the
+ * worker resamples), tagged with a timestamp. The bus places them on one
+ * timeline and sums fixed-size blocks:
+ *
+ * - The first timestamp pushed becomes the origin; block timestamps are
+ *   origin + position / sample_rate
+ * - A source's samples continue contiguously while their timestamps stay
+ *   within 2 ms of where the previous push ended; larger gaps are
+ *   padded with silence and overlaps are dropped
+ * - A gap longer than 1 s (or max_latency + frame_size, if larger) is not
+ *   padded: the source restarts at the new timestamp and what it had
+ *   buffered but not yet mixed is dropped, so a timestamp jump cannot
+ *   allocate unbounded silence
+ * - Samples for a block that was already mixed are late and dropped
+ * - A block is mixed once some source has buffered max_latency frames past
+ *   its end (a fixed jitter buffer): sources that start or stall within
+ *   max_latency are mixed in time, slower ones contribute silence, and no
+ *   source can hold back the mix
+ * - Ended sources (RemoveSource) are mixed until drained, then forgotten
+ *
+ * Summing uses sample_kernels mix_add, followed by SoftClip() when enabled.
+ *
+ * Thread Safety:
+ * - Not thread-safe; owned by the AudioMixer worker thread
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "sample_kernels.h"
+
+namespace webcodecs {
+
+struct AudioMixBusConfig {
+  int sample_rate = 48000;
+  int channels = 2;
+  size_t frame_size = 960;   // Frames per mixed block
+  size_t max_latency = 960;  // Frames a source may fall behind the furthest one
+  bool soft_clip = true;
+};
+
+class AudioMixBus {
+ public:
+  /**
+   * Reset the bus for config; channels and sample_rate must be positive and
+   * frame_size non-zero.
+   */
+  void Configure(const AudioMixBusConfig& config) {
+    config_ = config;
+    Reset();
+  }
+
+  const AudioMixBusConfig& config() const { return config_; }
+
+  /**
+   * Append frames of source, config.channels f32 planes, starting at
+   * timestamp_us. A removed source that pushes again is live again.
+   */
+  void Push(const std::string& source, const float* const* planes, size_t frames,
+            int64_t timestamp_us) {
+    if (!has_origin_) {
+      origin_us_ = timestamp_us;
+      has_origin_ = true;
+    }
+    int64_t at = ToPosition(timestamp_us);
+    Source& s = sources_[source];
+    s.ended = false;
+    if (s.planes.empty()) s.planes.resize(config_.channels);
+
+    const int64_t end = s.end();
+    if (s.started && std::abs(at - end) <= JitterFrames()) at = end;
+    size_t skip = 0;
+    if (!s.started || s.size() == 0 || at - end > MaxGapFrames()) {
+      Consume(s, s.size());  // Restart: nothing buffered stays live
+      s.start = at;
+      s.started = true;
+    } else if (at > end) {
+      for (auto& plane : s.planes) plane.insert(plane.end(), static_cast<size_t>(at - end), 0.0f);
+    } else if (at < end) {
+      skip = std::min(frames, static_cast<size_t>(end - at));
+    }
+    for (int ch = 0; ch < config_.channels; ch++) {
+      s.planes[ch].insert(s.planes[ch].end(), planes[ch] + skip, planes[ch] + frames);
+    }
+
+    // Late: the bus has already mixed past these
+    if (s.start < position_) Consume(s, static_cast<size_t>(position_ - s.start));
+  }
+
+  /**
+   * Stop waiting for source; its buffered samples are still mixed.
+   */
+  void RemoveSource(const std::string& source) {
+    auto it = sources_.find(source);
+    if (it == sources_.end()) return;
+    it->second.ended = true;
+    if (it->second.size() == 0) sources_.erase(it);
+  }
+
+  /**
+   * @param drain mix what is buffered without waiting out max_latency,
+   *              possibly as a short block (flush)
+   * @return frames in the next block, or 0 if it is not ready
+   */
+  size_t Pending(bool drain = false) const {
+    int64_t furthest = position_;
+    for (const auto& [id, s] : sources_) {
+      if (s.size() > 0) furthest = std::max(furthest, s.end());
+    }
+    const size_t available = static_cast<size_t>(furthest - position_);
+    if (available >= config_.frame_size + config_.max_latency) return config_.frame_size;
+    if (drain) return std::min(available, config_.frame_size);
+    return 0;
+  }
+
+  /**
+   * Sum the next frames (from Pending()) into out, config.channels planes,
+   * and advance the timeline.
+   */
+  void Mix(float* const* out, size_t frames, const sample_kernels::Kernels& k = sample_kernels::Get()) {
+    for (int ch = 0; ch < config_.channels; ch++) std::fill(out[ch], out[ch] + frames, 0.0f);
+
+    const int64_t block_end = position_ + static_cast<int64_t>(frames);
+    for (auto& [id, s] : sources_) {
+      const int64_t from = std::max(position_, s.start);
+      const int64_t to = std::min(block_end, s.end());
+      if (from >= to) continue;
+      const size_t offset = s.read + static_cast<size_t>(from - s.start);
+      for (int ch = 0; ch < config_.channels; ch++) {
+        k.mix_add(s.planes[ch].data() + offset, 1.0f, static_cast<size_t>(to - from),
+                  out[ch] + (from - position_));
+      }
+    }
+    if (config_.soft_clip) {
+      for (int ch = 0; ch < config_.channels; ch++) k.soft_clip(out[ch], frames);
+    }
+
+    position_ = block_end;
+    for (auto it = sources_.begin(); it != sources_.end();) {
+      Source& s = it->second;
+      if (s.start < position_) Consume(s, static_cast<size_t>(position_ - s.start));
+      if (s.ended && s.size() == 0) {
+        it = sources_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  /** Timestamp (microseconds) of the next block. */
+  int64_t timestamp() const {
+    return origin_us_ + position_ * 1000000 / config_.sample_rate;
+  }
+
+  size_t source_count() const { return sources_.size(); }
+
+  /** Frames buffered for source beyond the mixed position. */
+  size_t buffered(const std::string& source) const {
+    auto it = sources_.find(source);
+    return it == sources_.end() ? 0 : it->second.size();
+  }
+
+  /** Drop all sources and the timeline origin. */
+  void Reset() {
+    sources_.clear();
+    has_origin_ = false;
+    origin_us_ = 0;
+    position_ = 0;
+  }
+
+ private:
+  struct Source {
+    std::vector<std::vector<float>> planes;  // Consumed samples precede read
+    size_t read = 0;
+    int64_t start = 0;  // Timeline position of planes[ch][read]
+    bool started = false;
+    bool ended = false;
+
+    size_t size() const { return planes.empty() ? 0 : planes[0].size() - read; }
+    int64_t end() const { return start + static_cast<int64_t>(size()); }
+  };
+
+  // 2 ms absorbs timestamp rounding and resampler output granularity
+  int64_t JitterFrames() const { return std::max<int64_t>(1, config_.sample_rate / 500); }
+
+  int64_t MaxGapFrames() const {
+    return std::max<int64_t>(config_.sample_rate,
+                             static_cast<int64_t>(config_.max_latency + config_.frame_size));
+  }
+
+  int64_t ToPosition(int64_t timestamp_us) const {
+    const int64_t delta = timestamp_us - origin_us_;
+    // Round to nearest; negative positions (before the origin) are late
+    return (delta * config_.sample_rate + (delta >= 0 ? 500000 : -500000)) / 1000000;
+  }
+
+  static void Consume(Source& s, size_t frames) {
+    frames = std::min(frames, s.size());
+    s.read += frames;
+    s.start += static_cast<int64_t>(frames);
+    Compact(s, false);
+  }
+
+  // Erase consumed samples once they outweigh the live ones (or always)
+  static void Compact(Source& s, bool always) {
+    if (s.read == 0 || (!always && s.read < s.size())) return;
+    for (auto& plane : s.planes) plane.erase(plane.begin(), plane.begin() + s.read);
+    s.read = 0;
+  }
+
+  AudioMixBusConfig config_;
+  std::unordered_map<std::string, Source> sources_;
+  bool has_origin_ = false;
+  int64_t origin_us_ = 0;
+  int64_t position_ = 0;  // Timeline position of the next block
+};
+
+}  // namespace webcodecs
@@ -0,0 +1,205 @@
+#pragma once
+/**
+ * channel_remix.h - Cached Channel Matrices for Down/Upmixing
+ *
+ * AudioData.copyTo({channelLayout}) (non-standard) converts between channel
+ * layouts, e.g. 5.1 or 7.1 decoder output to stereo, so callers copy only
+ * the channels they need. The mixing coefficients come from libswresample
+ * (swr_build_matrix2, the matrix SwrContext itself would use) and are
+ * applied with the vectorized sample_kernels::Mix(), one output channel at
+ * a time, so a planar copy computes only the requested plane.
+ *
+ * - Layouts in FFmpeg's channel order are mixed as libswresample would;
+ *   centre and surround fold in at -3 dB, LFE is dropped, and each output
+ *   is normalized so a full-scale input cannot clip
+ * - Custom orders ("FR+FL", "FL+FR+FL") reorder and duplicate the rows and
+ *   columns of the matrix for the same channels in native order, which is
+ *   how channels are remapped
+ * - Unspecified orders (AudioData built from JS) use FFmpeg's default
+ *   layout for the channel count
+ *
+ * Thread Safety:
+ * - ChannelMatrixCache is mutex-protected; matrices are immutable and
+ *   shared, so they may be used after eviction
+ *
+ * Memory Model:
+ * - LRU eviction with a maximum of 16 layout pairs
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include <libavutil/channel_layout.h>
+#include <libswresample/swresample.h>
+}
+
+#include "sample_kernels.h"
+
+namespace webcodecs {
+
+// ===========================================================================
+// MATRIX
+// ===========================================================================
+
+struct ChannelMatrix {
+  int in_channels = 0;
+  int out_channels = 0;
+  std::vector<float> gains;  // out_channels rows of in_channels
+
+  const float* row(int out_channel) const { return gains.data() + out_channel * in_channels; }
+
+  /**
+   * dst = output channel out_channel for frames of f32 input planes.
+   */
+  void Apply(const float* const* planes, size_t frames, int out_channel, float* dst) const {
+    sample_kernels::Mix(planes, row(out_channel), in_channels, frames, dst);
+  }
+};
+
+namespace channel_remix {
+
+/**
+ * Copy layout into *native as the same channels in FFmpeg's native order
+ * (default layout for unspecified orders).
+ *
+ * @return false for ambisonic layouts and channels outside the native mask
+ */
+inline bool ToNative(const AVChannelLayout* layout, AVChannelLayout* native) {
+  if (layout->order == AV_CHANNEL_ORDER_UNSPEC) {
+    av_channel_layout_default(native, layout->nb_channels);
+    return native->order == AV_CHANNEL_ORDER_NATIVE;
+  }
+  if (layout->order == AV_CHANNEL_ORDER_NATIVE) return av_channel_layout_copy(native, layout) == 0;
+  if (layout->order != AV_CHANNEL_ORDER_CUSTOM) return false;
+
+  uint64_t mask = 0;
+  for (int i = 0; i < layout->nb_channels; i++) {
+    const AVChannel channel = av_channel_layout_channel_from_index(layout, i);
+    if (channel < 0 || channel >= 64) return false;
+    mask |= 1ULL << channel;
+  }
+  return av_channel_layout_from_mask(native, mask) == 0;
+}
+
+/**
+ * Index of channel i of layout within native (identity for native and
+ * unspecified orders).
+ */
+inline int NativeIndex(const AVChannelLayout* layout, const AVChannelLayout* native, int i) {
+  if (layout->order != AV_CHANNEL_ORDER_CUSTOM) return i;
+  return av_channel_layout_index_from_channel(native, av_channel_layout_channel_from_index(layout, i));
+}
+
+/**
+ * @return the in -> out matrix, or nullptr if libswresample cannot mix
+ *         between the two layouts
+ */
+inline std::shared_ptr<const ChannelMatrix> Build(const AVChannelLayout* in, const AVChannelLayout* out) {
+  AVChannelLayout in_native = {};
+  AVChannelLayout out_native = {};
+  std::shared_ptr<ChannelMatrix> matrix;
+  if (ToNative(in, &in_native) && ToNative(out, &out_native)) {
+    const int stride = in_native.nb_channels;
+    std::vector<double> native(static_cast<size_t>(out_native.nb_channels) * stride);
+    // maxval 1.0: normalize rows so the sum of gains never exceeds unity
+    if (swr_build_matrix2(&in_native, &out_native, M_SQRT1_2, M_SQRT1_2, 0.0, 1.0, 1.0, native.data(), stride,
+                          AV_MATRIX_ENCODING_NONE, nullptr) == 0) {
+      matrix = std::make_shared<ChannelMatrix>();
+      matrix->in_channels = in->nb_channels;
+      matrix->out_channels = out->nb_channels;
+      matrix->gains.resize(static_cast<size_t>(out->nb_channels) * in->nb_channels);
+      for (int o = 0; o < out->nb_channels; o++) {
+        const int row = NativeIndex(out, &out_native, o);
+        for (int i = 0; i < in->nb_channels; i++) {
+          const int column = NativeIndex(in, &in_native, i);
+          matrix->gains[o * in->nb_channels + i] = static_cast<float>(native[row * stride + column]);
+        }
+      }
+      // A channel listed twice in a custom input order would be counted twice
+      if (in->order == AV_CHANNEL_ORDER_CUSTOM && in->nb_channels != in_native.nb_channels) matrix.reset();
+    }
+  }
+  av_channel_layout_uninit(&in_native);
+  av_channel_layout_uninit(&out_native);
+  return matrix;
+}
+
+}  // namespace channel_remix
+
+// ===========================================================================
+// CACHE
+// ===========================================================================
+
+/**
+ * Process-wide cache of channel matrices keyed by (input, output) layout.
+ */
+class ChannelMatrixCache {
+ public:
+  static constexpr size_t kMaxEntries = 16;
+
+  static ChannelMatrixCache& Instance() {
+    static ChannelMatrixCache instance;
+    return instance;
+  }
+
+  /**
+   * @return the cached or newly built matrix, or nullptr if the layouts
+   *         cannot be mixed (not cached; such requests are errors)
+   */
+  std::shared_ptr<const ChannelMatrix> Get(const AVChannelLayout* in, const AVChannelLayout* out) {
+    const Key key{Describe(in), Describe(out)};
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (it->first == key) {
+          entries_.splice(entries_.begin(), entries_, it);
+          return it->second;
+        }
+      }
+    }
+
+    // Build outside the lock; a concurrent miss for the same key builds twice
+    std::shared_ptr<const ChannelMatrix> matrix = channel_remix::Build(in, out);
+    if (!matrix) return nullptr;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.emplace_front(key, matrix);
+    if (entries_.size() > kMaxEntries) entries_.pop_back();
+    return matrix;
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+  }
+
+ private:
+  using Key = std::pair<std::string, std::string>;
+
+  ChannelMatrixCache() = default;
+
+  // Layout descriptions distinguish order, channels and the unspecified case
+  static std::string Describe(const AVChannelLayout* layout) {
+    char buf[256];
+    if (av_channel_layout_describe(layout, buf, sizeof(buf)) < 0) return {};
+    return buf;
+  }
+
+  mutable std::mutex mutex_;
+  std::list<std::pair<Key, std::shared_ptr<const ChannelMatrix>>> entries_;
+};
+
+}  // namespace webcodecs
@@ -0,0 +1,251 @@
+#pragma once
+/**
+ * codec_context_cache.h - Process-Wide Warm Decoder Context Cache
+ *
+ * Segment-based players reconfigure on every rendition switch, and each
+ * configure() allocates an AVCodecContext and runs avcodec_open2() (thread
+ * pool start-up, extradata parsing, table init). This cache keeps recently
+ * released decoder contexts, flushed, so a configure() with the same
+ * parameters can adopt one instead of opening a new context.
+ *
+ * Keying:
+ * - Codec, extradata (compared byte for byte; a hash only short-cuts
+ *   mismatches), coded dimensions or sample rate and channel count, lowres
+ *   and threading parameters - everything that is fixed once
+ *   avcodec_open2() has run
+ * - Per-configure decode hints (skip_frame etc.) are re-applied by the
+ *   worker after adoption and are not part of the key
+ *
+ * Thread Safety:
+ * - All operations are mutex-protected
+ * - Contexts are flushed and freed outside the lock
+ *
+ * Memory Model:
+ * - LRU eviction with a maximum entry count (default 4, 0 disables)
+ * - Each entry owns a full decoder context including its thread pool
+ */
+
+// Only include napi.h when not in pure C++ testing mode
+#ifndef WEBCODECS_TESTING
+#include <napi.h>
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+#include "../ffmpeg_raii.h"
+
+namespace webcodecs {
+
+// ===========================================================================
+// CACHE KEY
+// ===========================================================================
+
+/**
+ * Parameters that cannot change after avcodec_open2().
+ */
+struct CodecContextKey {
+  const AVCodec* codec = nullptr;
+  std::vector<uint8_t> extradata;  // Compared exactly: a collision must not adopt another stream's context
+  uint64_t extradata_hash = 0;     // Rejects most mismatches without comparing bytes
+  int width = 0;        // Video: coded width from config
+  int height = 0;       // Video: coded height from config
+  int sample_rate = 0;  // Audio
+  int channels = 0;     // Audio
+  int lowres = 0;
+  int thread_count = 0;
+  int thread_type = 0;
+
+  void SetExtradata(const uint8_t* data, size_t size) {
+    // FNV-1a: extradata is small (parameter sets, codec headers)
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++) {
+      hash ^= data[i];
+      hash *= 1099511628211ULL;
+    }
+    extradata_hash = hash;
+    extradata.assign(data, data + size);
+  }
+
+  bool operator==(const CodecContextKey& other) const {
+    return codec == other.codec && extradata_hash == other.extradata_hash && width == other.width &&
+           height == other.height && sample_rate == other.sample_rate && channels == other.channels &&
+           lowres == other.lowres && thread_count == other.thread_count && thread_type == other.thread_type &&
+           extradata == other.extradata;
+  }
+};
+
+// ===========================================================================
+// CACHE STATISTICS
+// ===========================================================================
+
+struct CodecContextCacheStats {
+  std::atomic<uint64_t> hits{0};       // configure() adopted a warm context
+  std::atomic<uint64_t> misses{0};     // configure() opened a new context
+  std::atomic<uint64_t> evictions{0};  // Contexts freed to respect the limit
+};
+
+// ===========================================================================
+// GLOBAL CODEC CONTEXT CACHE
+// ===========================================================================
+
+class GlobalCodecContextCache {
+ public:
+  static constexpr size_t kDefaultMaxEntries = 4;
+
+  /**
+   * Get the global cache instance.
+   * Thread-safe lazy initialization.
+   */
+  static GlobalCodecContextCache& Instance() {
+    static GlobalCodecContextCache cache;
+    return cache;
+  }
+
+  /**
+   * Set the maximum number of cached contexts. 0 disables the cache and
+   * frees every cached context.
+   */
+  void SetMaxEntries(size_t max_entries) {
+    std::vector<raii::AVCodecContextPtr> evicted;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      max_entries_ = max_entries;
+      EvictLocked(&evicted);
+    }
+  }
+
+  [[nodiscard]] size_t max_entries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_entries_;
+  }
+
+  [[nodiscard]] size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+  [[nodiscard]] const CodecContextCacheStats& stats() const { return stats_; }
+
+  /**
+   * Take a warm context matching key, most recently released first.
+   *
+   * @return Open, flushed context, or nullptr on a miss
+   */
+  [[nodiscard]] raii::AVCodecContextPtr Take(const CodecContextKey& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (it->first == key) {
+        raii::AVCodecContextPtr ctx = std::move(it->second);
+        entries_.erase(it);
+        stats_.hits.fetch_add(1, std::memory_order_relaxed);
+        return ctx;
+      }
+    }
+    stats_.misses.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  /**
+   * Hand an open decoder context to the cache. The context is flushed so
+   * its next user starts from a clean state; the least recently released
+   * contexts are freed beyond the entry limit.
+   */
+  void Put(const CodecContextKey& key, raii::AVCodecContextPtr ctx) {
+    if (!ctx || !key.codec) return;
+    avcodec_flush_buffers(ctx.get());
+
+    std::vector<raii::AVCodecContextPtr> evicted;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (max_entries_ == 0) {
+        evicted.push_back(std::move(ctx));
+        return;
+      }
+      entries_.emplace_front(key, std::move(ctx));
+      EvictLocked(&evicted);
+    }
+    // evicted contexts are freed here, outside the lock
+  }
+
+  /**
+   * Free every cached context (testing, memory pressure).
+   */
+  void Clear() {
+    std::list<std::pair<CodecContextKey, raii::AVCodecContextPtr>> entries;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      entries.swap(entries_);
+    }
+  }
+
+  void ResetStats() {
+    stats_.hits.store(0, std::memory_order_relaxed);
+    stats_.misses.store(0, std::memory_order_relaxed);
+    stats_.evictions.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  GlobalCodecContextCache() = default;
+  ~GlobalCodecContextCache() = default;
+
+  GlobalCodecContextCache(const GlobalCodecContextCache&) = delete;
+  GlobalCodecContextCache& operator=(const GlobalCodecContextCache&) = delete;
+
+  void EvictLocked(std::vector<raii::AVCodecContextPtr>* evicted) {
+    while (entries_.size() > max_entries_) {
+      evicted->push_back(std::move(entries_.back().second));
+      entries_.pop_back();
+      stats_.evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  mutable std::mutex mutex_;
+  // Most recently released first
+  std::list<std::pair<CodecContextKey, raii::AVCodecContextPtr>> entries_;
+  size_t max_entries_ = kDefaultMaxEntries;
+  CodecContextCacheStats stats_;
+};
+
+#ifndef WEBCODECS_TESTING
+/**
+ * Non-standard static codecContextCache(options?) shared by VideoDecoder and
+ * AudioDecoder: applies {maxEntries} when given and returns the cache stats.
+ */
+inline Napi::Value CodecContextCacheMethod(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  GlobalCodecContextCache& cache = GlobalCodecContextCache::Instance();
+
+  if (info.Length() > 0 && info[0].IsObject()) {
+    Napi::Object options = info[0].As<Napi::Object>();
+    if (options.Has("maxEntries") && options.Get("maxEntries").IsNumber()) {
+      int64_t max_entries = options.Get("maxEntries").As<Napi::Number>().Int64Value();
+      if (max_entries < 0 || max_entries > 64) {
+        Napi::TypeError::New(env, "maxEntries must be between 0 and 64").ThrowAsJavaScriptException();
+        return env.Undefined();
+      }
+      cache.SetMaxEntries(static_cast<size_t>(max_entries));
+    }
+  }
+
+  const CodecContextCacheStats& stats = cache.stats();
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("maxEntries", Napi::Number::New(env, static_cast<double>(cache.max_entries())));
+  result.Set("entries", Napi::Number::New(env, static_cast<double>(cache.size())));
+  result.Set("hits", Napi::Number::New(env, static_cast<double>(stats.hits.load())));
+  result.Set("misses", Napi::Number::New(env, static_cast<double>(stats.misses.load())));
+  result.Set("evictions", Napi::Number::New(env, static_cast<double>(stats.evictions.load())));
+  return result;
+}
+#endif
+
+}  // namespace webcodecs
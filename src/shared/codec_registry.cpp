@@ -7,10 +7,16 @@
 #include <climits>
 #include <cstdint>
 #include <cstdlib>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <unordered_map>
 
+extern "C" {
+#include <libavutil/pixdesc.h>
+}
+
 namespace webcodecs {
 
 namespace {
@@ -148,6 +154,121 @@ std::optional<CodecInfo> ParsePCM(const std::string& format) {
   return std::nullopt;
 }
 
+// Largest coded dimension each bitstream can signal (0 = not applicable).
+// H.264/HEVC: level 6.2 frame size limits; VP8: 14-bit size fields;
+// VP9/AV1: 16-bit size fields.
+int MaxDimension(AVCodecID codec_id) {
+  switch (codec_id) {
+    case AV_CODEC_ID_H264:
+    case AV_CODEC_ID_HEVC:
+      return 16888;
+    case AV_CODEC_ID_VP8:
+      return 16383;
+    case AV_CODEC_ID_VP9:
+    case AV_CODEC_ID_AV1:
+      return 65536;
+    default:
+      return 0;
+  }
+}
+
+// Copy a terminated FFmpeg list (AV_PIX_FMT_NONE, AV_SAMPLE_FMT_NONE, 0)
+template <typename T>
+std::vector<T> CopyList(const T* list, T terminator) {
+  std::vector<T> out;
+  for (; list && *list != terminator; list++) out.push_back(*list);
+  return out;
+}
+
+CodecCapabilities ProbeCodec(AVCodecID codec_id) {
+  CodecCapabilities caps;
+  caps.codec_id = codec_id;
+  caps.can_decode = avcodec_find_decoder(codec_id) != nullptr;
+  caps.max_width = MaxDimension(codec_id);
+  caps.max_height = caps.max_width;
+
+  const AVCodec* encoder = avcodec_find_encoder(codec_id);
+  caps.can_encode = encoder != nullptr;
+  if (!encoder) return caps;
+
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(61, 0, 0)
+  // FFmpeg 7.0+ uses avcodec_get_supported_config
+  const void* list = nullptr;
+  int count = 0;
+  if (avcodec_get_supported_config(nullptr, encoder, AV_CODEC_CONFIG_PIX_FORMAT, 0, &list,
+                                   &count) >= 0 && list) {
+    const auto* fmts = static_cast<const AVPixelFormat*>(list);
+    caps.encode_pixel_formats.assign(fmts, fmts + count);
+  }
+  list = nullptr;
+  if (avcodec_get_supported_config(nullptr, encoder, AV_CODEC_CONFIG_SAMPLE_FORMAT, 0, &list,
+                                   &count) >= 0 && list) {
+    const auto* fmts = static_cast<const AVSampleFormat*>(list);
+    caps.encode_sample_formats.assign(fmts, fmts + count);
+  }
+  list = nullptr;
+  if (avcodec_get_supported_config(nullptr, encoder, AV_CODEC_CONFIG_SAMPLE_RATE, 0, &list,
+                                   &count) >= 0 && list) {
+    const auto* rates = static_cast<const int*>(list);
+    caps.encode_sample_rates.assign(rates, rates + count);
+  }
+#else
+  // Suppress deprecated warning for older FFmpeg
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+  caps.encode_pixel_formats = CopyList(encoder->pix_fmts, AV_PIX_FMT_NONE);
+  caps.encode_sample_formats = CopyList(encoder->sample_fmts, AV_SAMPLE_FMT_NONE);
+  caps.encode_sample_rates = CopyList(encoder->supported_samplerates, 0);
+  #pragma GCC diagnostic pop
+#endif
+
+  for (AVPixelFormat fmt : caps.encode_pixel_formats) {
+    const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(fmt);
+    if (desc && desc->nb_components > 0) {
+      caps.max_encode_bit_depth = std::max(caps.max_encode_bit_depth, desc->comp[0].depth);
+    }
+  }
+  return caps;
+}
+
+// Process-wide capability table: per codec (probed on first use) and per
+// codec string (parse result). Entries are never removed, so capability
+// pointers stay valid for the process lifetime.
+class CapabilityTable {
+ public:
+  static CapabilityTable& Instance() {
+    static CapabilityTable table;
+    return table;
+  }
+
+  std::optional<CodecLookup> Lookup(const std::string& codec_string) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = strings_.find(codec_string);
+    if (it != strings_.end()) return it->second;
+
+    std::optional<CodecLookup> result;
+    if (auto info = ParseCodecString(codec_string)) {
+      result = CodecLookup{*info, CapabilitiesLocked(info->codec_id)};
+    }
+    // Bound the string cache; arbitrary strings from JS must not grow it forever
+    if (strings_.size() < kMaxCachedStrings) strings_.emplace(codec_string, result);
+    return result;
+  }
+
+ private:
+  static constexpr size_t kMaxCachedStrings = 512;
+
+  const CodecCapabilities* CapabilitiesLocked(AVCodecID codec_id) {
+    std::unique_ptr<CodecCapabilities>& caps = codecs_[codec_id];
+    if (!caps) caps = std::make_unique<CodecCapabilities>(ProbeCodec(codec_id));
+    return caps.get();
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<AVCodecID, std::unique_ptr<CodecCapabilities>> codecs_;
+  std::unordered_map<std::string, std::optional<CodecLookup>> strings_;
+};
+
 }  // namespace
 
 std::optional<CodecInfo> ParseCodecString(const std::string& codec_string) {
@@ -243,15 +364,41 @@ std::string GetCodecPrefix(AVCodecID codec_id) {
   }
 }
 
+bool CodecCapabilities::SupportsDecode(int coded_width, int coded_height) const {
+  if (!can_decode) return false;
+  if (max_width > 0 && (coded_width > max_width || coded_height > max_height)) return false;
+  return true;
+}
+
+bool CodecCapabilities::SupportsVideoEncode(int width, int height, int bit_depth) const {
+  if (!can_encode || width <= 0 || height <= 0) return false;
+  if (max_width > 0 && (width > max_width || height > max_height)) return false;
+  // A 10-bit codec string needs an encoder that accepts 10-bit input
+  if (bit_depth > 0 && max_encode_bit_depth > 0 && bit_depth > max_encode_bit_depth) {
+    return false;
+  }
+  return true;
+}
+
+bool CodecCapabilities::SupportsAudioEncode(int sample_rate, int channels) const {
+  if (!can_encode || sample_rate <= 0 || channels <= 0) return false;
+  if (encode_sample_rates.empty()) return true;
+  return std::find(encode_sample_rates.begin(), encode_sample_rates.end(), sample_rate) !=
+         encode_sample_rates.end();
+}
+
+std::optional<CodecLookup> LookupCodecString(const std::string& codec_string) {
+  return CapabilityTable::Instance().Lookup(codec_string);
+}
+
 bool IsCodecSupported(const std::string& codec_string) {
-  auto info = ParseCodecString(codec_string);
-  if (!info) {
+  auto lookup = LookupCodecString(codec_string);
+  if (!lookup) {
     return false;
   }
 
   // Check if FFmpeg has a decoder for this codec
-  const AVCodec* decoder = avcodec_find_decoder(info->codec_id);
-  return decoder != nullptr;
+  return lookup->capabilities->can_decode;
 }
 
 }  // namespace webcodecs
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <optional>
+#include <vector>
 
 extern "C" {
 #include <libavcodec/avcodec.h>
@@ -58,10 +59,58 @@ std::string GetCodecPrefix(AVCodecID codec_id);
  * Check if a codec string is supported.
  *
  * @param codec_string The W3C codec string
- * @return true if the codec is recognized and FFmpeg has a decoder/encoder
+ * @return true if the codec is recognized and FFmpeg has a decoder
  */
 bool IsCodecSupported(const std::string& codec_string);
 
+/**
+ * What this FFmpeg build can do with one codec, probed once per process.
+ *
+ * isConfigSupported() is called many times per session by compatibility
+ * shims; answering from this table avoids repeated avcodec_find_* lookups
+ * and supported-config queries.
+ */
+struct CodecCapabilities {
+  AVCodecID codec_id = AV_CODEC_ID_NONE;
+  bool can_decode = false;
+  bool can_encode = false;
+  int max_width = 0;   // Bitstream limit for coded/encoded width
+  int max_height = 0;  // Bitstream limit for coded/encoded height
+  // Encoder input formats in preference order (empty: not advertised)
+  std::vector<AVPixelFormat> encode_pixel_formats;
+  std::vector<AVSampleFormat> encode_sample_formats;
+  std::vector<int> encode_sample_rates;  // Empty: any sample rate
+  int max_encode_bit_depth = 0;          // From encode_pixel_formats; 0 if unknown
+
+  /** Decoding is possible at the given coded size (0 = unspecified). */
+  bool SupportsDecode(int coded_width, int coded_height) const;
+
+  /** Video encoding is possible at the given size and requested bit depth (-1 = any). */
+  bool SupportsVideoEncode(int width, int height, int bit_depth) const;
+
+  /** Audio encoding is possible at the given sample rate and channel count. */
+  bool SupportsAudioEncode(int sample_rate, int channels) const;
+};
+
+/**
+ * A parsed codec string and the capabilities of its codec.
+ */
+struct CodecLookup {
+  CodecInfo info;
+  const CodecCapabilities* capabilities;  // Process lifetime, never null
+};
+
+/**
+ * Parse a codec string and attach the codec's capability table.
+ *
+ * Both the parse result and the per-codec FFmpeg probe are cached, so
+ * repeated lookups of the same string are a single hash lookup.
+ *
+ * @param codec_string The W3C codec string
+ * @return Lookup result, or std::nullopt if the string is not recognized
+ */
+std::optional<CodecLookup> LookupCodecString(const std::string& codec_string);
+
 // Video codec prefixes (kPascalCase per Google C++ Style Guide)
 constexpr const char* kCodecAvc = "avc1";   // H.264/AVC
 constexpr const char* kCodecHevc = "hvc1";  // H.265/HEVC
@@ -387,6 +387,9 @@ class CodecWorker {
               },
           },
           msg);
+
+      // Outputs of this message are with the TSFNs; the queue may report idle
+      queue_.MarkDone();
     }
   }
 
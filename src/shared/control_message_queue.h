@@ -66,11 +66,13 @@ class ControlMessageQueue {
 
   /**
    * Encode message - queued work item for encoders.
-   * Contains frame to encode with optional keyframe flag.
+   * Contains frame to encode with optional keyframe flag and, for
+   * bitrateMode "quantizer", the codec-specific per-frame quantizer.
    */
   struct EncodeMessage {
     FrameType frame;
     bool key_frame = false;
+    int quantizer = -1;  // -1 = let rate control decide
   };
 
   /**
@@ -128,6 +130,28 @@ class ControlMessageQueue {
     return true;
   }
 
+  /**
+   * Enqueue several messages in order under a single lock and notify
+   * (decodeBatch/encodeBatch). Thread-safe, called from JS main thread.
+   *
+   * @param msgs Messages to enqueue; moved from on success
+   * @return true if all messages were enqueued, false if queue is closed
+   */
+  [[nodiscard]] bool EnqueueBatch(std::vector<Message>& msgs) {
+    if (msgs.empty()) return true;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closed_) {
+        return false;
+      }
+      for (auto& msg : msgs) {
+        queue_.push(std::move(msg));
+      }
+    }
+    cv_.notify_one();
+    return true;
+  }
+
   // =========================================================================
   // CONSUMER API (Worker Thread)
   // =========================================================================
@@ -149,6 +173,7 @@ class ControlMessageQueue {
 
     Message msg = std::move(queue_.front());
     queue_.pop();
+    in_flight_ = true;
     return msg;
   }
 
@@ -171,6 +196,7 @@ class ControlMessageQueue {
 
     Message msg = std::move(queue_.front());
     queue_.pop();
+    in_flight_ = true;
     return msg;
   }
 
@@ -187,9 +213,19 @@ class ControlMessageQueue {
 
     Message msg = std::move(queue_.front());
     queue_.pop();
+    in_flight_ = true;
     return msg;
   }
 
+  /**
+   * Mark the last dequeued message as fully handled (its outputs have been
+   * handed to the TSFNs). Thread-safe, called from worker thread.
+   */
+  void MarkDone() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    in_flight_ = false;
+  }
+
   // =========================================================================
   // RESET / SHUTDOWN
   // =========================================================================
@@ -236,6 +272,40 @@ class ControlMessageQueue {
     return dropped;
   }
 
+  /**
+   * Drop the oldest pending non-key encode messages until at most
+   * max_pending encode messages remain (encoder frame-drop policy).
+   * Key frames and all non-encode messages are kept in order.
+   *
+   * @param max_pending Number of encode messages allowed to stay queued
+   * @return Number of frames dropped
+   */
+  size_t DropOldestFrames(size_t max_pending) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<Message> messages;
+    messages.reserve(queue_.size());
+    size_t pending = 0;
+    while (!queue_.empty()) {
+      if (std::holds_alternative<EncodeMessage>(queue_.front())) ++pending;
+      messages.push_back(std::move(queue_.front()));
+      queue_.pop();
+    }
+
+    size_t to_drop = pending > max_pending ? pending - max_pending : 0;
+    size_t dropped = 0;
+    for (auto& msg : messages) {
+      auto* encode = std::get_if<EncodeMessage>(&msg);
+      if (encode && !encode->key_frame && dropped < to_drop) {
+        ++dropped;  // Frame released by RAII
+        continue;
+      }
+      queue_.push(std::move(msg));
+    }
+
+    return dropped;
+  }
+
   /**
    * Shutdown the queue permanently.
    * Any subsequent Enqueue() calls will return false.
@@ -270,6 +340,18 @@ class ControlMessageQueue {
     return queue_.empty();
   }
 
+  /**
+   * Check that nothing is queued and the worker is not handling a message.
+   * Called from the JS thread, the only producer, so the answer holds until
+   * its next Enqueue(): the JS thread may then act on the worker's behalf
+   * (inline PCM/G.711 coding) with every earlier output already delivered
+   * to the TSFNs.
+   */
+  [[nodiscard]] bool Idle() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.empty() && !in_flight_;
+  }
+
   /**
    * Check if the queue is closed.
    */
@@ -294,6 +376,7 @@ class ControlMessageQueue {
   std::queue<Message> queue_;
   std::atomic<bool> blocked_{false};
   bool closed_{false};
+  bool in_flight_{false};  // A dequeued message has not been MarkDone()'d
 };
 
 // ===========================================================================
@@ -336,7 +419,8 @@ using AudioControlQueue = ControlMessageQueue<raii::AVPacketPtr, raii::AVFramePt
  */
 struct ImageConfigureMessage {
   std::string type;  // MIME type (e.g., "image/jpeg")
-  std::vector<uint8_t> data;  // Encoded image data (empty if streaming)
+  std::vector<uint8_t> data;  // Encoded image data (empty if streaming or path)
+  std::string path;           // Non-standard {path} source, mapped by the worker
   bool is_streaming = false;  // true if data comes from ReadableStream
   std::string color_space_conversion;
   std::optional<uint32_t> desired_width;
@@ -0,0 +1,133 @@
+#pragma once
+/**
+ * decoded_frame_cache.h - Bounded LRU Cache of Decoded Image Frames
+ *
+ * Animated images (GIF, APNG, animated WebP) can only be decoded forward:
+ * each frame is composited onto the previous canvas inside the decoder.
+ * Scrubbing backwards therefore means decoding again from the start. This
+ * cache keeps fully composited output frames by frame index so repeated or
+ * out-of-order decode({frameIndex}) calls can be answered without decoding.
+ *
+ * Memory Model:
+ * - Entries hold AVFrame references; a hit returns av_frame_clone(), so the
+ *   pixel buffers are shared with any VideoFrame already handed to JS
+ * - Bounded by a byte budget (sum of frame buffer sizes), LRU eviction
+ *
+ * Thread Safety:
+ * - Not thread-safe; owned and used by a single worker thread
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+extern "C" {
+#include <libavutil/buffer.h>
+#include <libavutil/frame.h>
+}
+
+#include "../ffmpeg_raii.h"
+
+namespace webcodecs {
+
+class DecodedFrameCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 128 * 1024 * 1024;
+
+  struct Entry {
+    raii::AVFramePtr frame;
+    int64_t timestamp = 0;  // Microseconds
+    int64_t duration = 0;   // Microseconds
+  };
+
+  explicit DecodedFrameCache(size_t max_bytes = kDefaultMaxBytes) : max_bytes_(max_bytes) {}
+
+  // Non-copyable (owns frame references)
+  DecodedFrameCache(const DecodedFrameCache&) = delete;
+  DecodedFrameCache& operator=(const DecodedFrameCache&) = delete;
+
+  /**
+   * Look up a frame and mark it most recently used.
+   *
+   * @return New reference to the cached frame (nullptr on a miss)
+   */
+  [[nodiscard]] raii::AVFramePtr Get(uint32_t index, int64_t* timestamp, int64_t* duration) {
+    auto it = map_.find(index);
+    if (it == map_.end()) {
+      misses_++;
+      return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    const Entry& entry = it->second->second;
+    if (timestamp) *timestamp = entry.timestamp;
+    if (duration) *duration = entry.duration;
+    hits_++;
+    return raii::AVFramePtr(av_frame_clone(entry.frame.get()));
+  }
+
+  [[nodiscard]] bool Contains(uint32_t index) const { return map_.count(index) > 0; }
+
+  /**
+   * Cache a reference to frame (the caller keeps its own reference).
+   * Frames larger than the whole budget are not cached.
+   */
+  void Put(uint32_t index, const AVFrame* frame, int64_t timestamp, int64_t duration) {
+    if (!frame || max_bytes_ == 0) return;
+    const size_t bytes = FrameBytes(frame);
+    if (bytes > max_bytes_) return;
+
+    Erase(index);
+    raii::AVFramePtr ref(av_frame_clone(frame));
+    if (!ref) return;
+
+    lru_.emplace_front(index, Entry{std::move(ref), timestamp, duration});
+    map_[index] = lru_.begin();
+    bytes_ += bytes;
+
+    while (bytes_ > max_bytes_ && !lru_.empty()) {
+      Erase(lru_.back().first);
+    }
+  }
+
+  void Clear() {
+    map_.clear();
+    lru_.clear();
+    bytes_ = 0;
+  }
+
+  [[nodiscard]] size_t size() const { return map_.size(); }
+  [[nodiscard]] size_t bytes() const { return bytes_; }
+  [[nodiscard]] size_t max_bytes() const { return max_bytes_; }
+  [[nodiscard]] uint64_t hits() const { return hits_; }
+  [[nodiscard]] uint64_t misses() const { return misses_; }
+
+ private:
+  using List = std::list<std::pair<uint32_t, Entry>>;
+
+  static size_t FrameBytes(const AVFrame* frame) {
+    size_t bytes = 0;
+    for (AVBufferRef* buf : frame->buf) {
+      if (buf) bytes += buf->size;
+    }
+    return bytes;
+  }
+
+  void Erase(uint32_t index) {
+    auto it = map_.find(index);
+    if (it == map_.end()) return;
+    bytes_ -= FrameBytes(it->second->second.frame.get());
+    lru_.erase(it->second);
+    map_.erase(it);
+  }
+
+  const size_t max_bytes_;
+  List lru_;  // Most recently used first
+  std::unordered_map<uint32_t, List::iterator> map_;
+  size_t bytes_ = 0;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+};
+
+}  // namespace webcodecs
@@ -256,6 +256,100 @@ class FormatConverter {
     return dst_frame;
   }
 
+  /**
+   * Convert and scale a frame in a single swscale pass.
+   *
+   * Used where frames are converted once on a worker thread (e.g. decoder
+   * outputFormat/outputSize) instead of per copyTo() on the JS thread.
+   *
+   * @param src_frame Source frame
+   * @param dst_pix_fmt Destination pixel format
+   * @param dst_width Output width (<= 0 keeps the source width)
+   * @param dst_height Output height (<= 0 keeps the source height)
+   * @param colorSpace Target color space for RGB outputs
+   * @return New frame in destination format/size, or nullptr on error
+   */
+  raii::AVFramePtr ConvertScaled(const AVFrame* src_frame, AVPixelFormat dst_pix_fmt,
+                                 int dst_width, int dst_height,
+                                 const std::string& colorSpace = "srgb") {
+    if (!src_frame || dst_pix_fmt == AV_PIX_FMT_NONE) return nullptr;
+
+    raii::AVFramePtr dst_frame = raii::MakeAvFrame();
+    if (!dst_frame) return nullptr;
+
+    dst_frame->width = dst_width > 0 ? dst_width : src_frame->width;
+    dst_frame->height = dst_height > 0 ? dst_height : src_frame->height;
+    dst_frame->format = dst_pix_fmt;
+
+    int ret = av_frame_get_buffer(dst_frame.get(), 0);
+    if (ret < 0) return nullptr;
+
+    ret = ScaleInto(src_frame, dst_pix_fmt, dst_frame->width, dst_frame->height,
+                    dst_frame->data, dst_frame->linesize);
+    if (ret < 0) return nullptr;
+
+    CopyFrameProps(src_frame, dst_frame.get(), colorSpace);
+    return dst_frame;
+  }
+
+  /**
+   * Convert and scale a frame into caller-owned planes.
+   *
+   * @param src_frame Source frame
+   * @param dst_pix_fmt Destination pixel format
+   * @param dst_width Output width
+   * @param dst_height Output height
+   * @param dst_data Destination plane pointers
+   * @param dst_linesize Destination plane strides
+   * @return 0 on success, negative AVERROR on failure
+   */
+  int ScaleInto(const AVFrame* src_frame, AVPixelFormat dst_pix_fmt, int dst_width, int dst_height,
+                uint8_t* const dst_data[], const int dst_linesize[]) {
+    if (!src_frame || dst_width <= 0 || dst_height <= 0) return AVERROR(EINVAL);
+
+    AVPixelFormat src_pix_fmt = static_cast<AVPixelFormat>(src_frame->format);
+
+    // Get or create SwsContext (reused while input/output parameters match)
+    sws_ctx_.reset(sws_getCachedContext(
+        sws_ctx_.release(),
+        src_frame->width, src_frame->height, src_pix_fmt,
+        dst_width, dst_height, dst_pix_fmt,
+        SWS_BILINEAR, nullptr, nullptr, nullptr));
+
+    if (!sws_ctx_) return AVERROR(EINVAL);
+
+    int ret = sws_scale(sws_ctx_.get(),
+                        src_frame->data, src_frame->linesize,
+                        0, src_frame->height,
+                        dst_data, dst_linesize);
+    return ret < 0 ? ret : 0;
+  }
+
+  /**
+   * Copy timing and color metadata from src to a converted frame.
+   * RGB outputs are tagged with the target color space; others keep the source tags.
+   */
+  static void CopyFrameProps(const AVFrame* src, AVFrame* dst, const std::string& colorSpace = "srgb") {
+    dst->pts = src->pts;
+    dst->duration = src->duration;
+    dst->best_effort_timestamp = src->best_effort_timestamp;
+    // A rescaled frame is displayed at its new size
+    bool same_size = dst->width == src->width && dst->height == src->height;
+    dst->sample_aspect_ratio = same_size ? src->sample_aspect_ratio : AVRational{0, 1};
+
+    const char* dst_format = FFmpegToWebCodecs(static_cast<AVPixelFormat>(dst->format));
+    if (dst_format && IsRGBFormat(dst_format)) {
+      dst->color_range = GetColorRange(colorSpace);
+      dst->color_primaries = GetColorPrimaries(colorSpace);
+      dst->color_trc = GetTransferCharacteristics(colorSpace);
+    } else {
+      dst->color_range = src->color_range;
+      dst->color_primaries = src->color_primaries;
+      dst->color_trc = src->color_trc;
+      dst->colorspace = src->colorspace;
+    }
+  }
+
   /**
    * Convert a sub-region (rect) of the frame.
    *
@@ -0,0 +1,72 @@
+#pragma once
+/**
+ * late_frame_dropper.h - Catch-Up Policy for frameDropPolicy.dropWhenLate
+ *
+ * A realtime encoder that takes longer than the frame interval falls
+ * behind its input. The worker records how long each frame took, and this
+ * policy turns the overrun into a debt measured in microseconds:
+ *
+ * - Every encoded frame adds (encode time - frame interval) to the debt,
+ *   which never goes below zero
+ * - Skipping a frame pays back one frame interval, so a frame is dropped
+ *   only while the debt covers at least one whole interval
+ * - The debt is capped at what the backlog can pay back ((backlog - 1)
+ *   intervals; the newest frame is always encoded) and cleared when the
+ *   backlog is empty
+ *
+ * One frame that overruns by k intervals therefore drops about k queued
+ * frames, not the whole backlog; an encoder that is slower than real time
+ * drops the share of frames it cannot keep up with.
+ *
+ * Thread Safety:
+ * - Not thread-safe; owned and used by the encoder worker thread
+ */
+
+#include <algorithm>
+#include <cstdint>
+
+namespace webcodecs {
+
+class LateFrameDropper {
+ public:
+  /** Forget the debt (configure and reset). */
+  void Reset() { late_us_ = 0; }
+
+  /** Microseconds the encoder is behind its input. */
+  [[nodiscard]] int64_t late_us() const { return late_us_; }
+
+  /**
+   * Record the wall time spent encoding a frame meant to last interval_us.
+   * Ignored when the interval is unknown (<= 0).
+   */
+  void RecordEncode(int64_t encode_us, int64_t interval_us) {
+    if (interval_us <= 0) return;
+    late_us_ = std::max<int64_t>(0, late_us_ + encode_us - interval_us);
+  }
+
+  /**
+   * Decide whether to skip the next frame.
+   *
+   * @param interval_us Duration of the frame (<= 0: unknown, never dropped)
+   * @param backlog Frames waiting, this one included
+   * @return true if the frame should be dropped (its interval is paid back)
+   */
+  bool ShouldDrop(int64_t interval_us, uint32_t backlog) {
+    if (backlog <= 1) {
+      // Caught up: nothing queued is late
+      late_us_ = 0;
+      return false;
+    }
+    if (interval_us <= 0) return false;
+
+    late_us_ = std::min<int64_t>(late_us_, static_cast<int64_t>(backlog - 1) * interval_us);
+    if (late_us_ < interval_us) return false;
+    late_us_ -= interval_us;
+    return true;
+  }
+
+ private:
+  int64_t late_us_ = 0;
+};
+
+}  // namespace webcodecs
@@ -0,0 +1,140 @@
+#pragma once
+/**
+ * mapped_file.h - Read-Only Memory-Mapped File
+ *
+ * Backs the non-standard ImageDecoder `data: {path}` source: the file is
+ * mapped into memory on the worker thread and read in place by the AVIO
+ * callbacks, so a large image is never copied through JS or into a native
+ * buffer first.
+ *
+ * - POSIX: mmap(PROT_READ, MAP_PRIVATE); if mapping fails (special files,
+ *   exhausted address space) the contents are read with pread() instead
+ * - Windows: read into memory (no mapping)
+ *
+ * Thread Safety:
+ * - Immutable after Open(); the mapping may be read from any thread
+ */
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace webcodecs {
+
+class MappedFile {
+ public:
+  MappedFile() = default;
+  ~MappedFile() { Close(); }
+
+  // Non-copyable, non-movable (data() must stay stable)
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&&) = delete;
+  MappedFile& operator=(MappedFile&&) = delete;
+
+  /**
+   * Map (or read) the whole file at path.
+   *
+   * @param error Set to a description of the failure
+   * @return true on success
+   */
+  bool Open(const std::string& path, std::string* error) {
+    Close();
+#ifdef _WIN32
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return Fail(error, path, "cannot open file");
+    const std::streamoff size = in.tellg();
+    if (size <= 0) return Fail(error, path, "file is empty");
+    storage_.resize(static_cast<size_t>(size));
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(storage_.data()), size)) {
+      storage_.clear();
+      return Fail(error, path, "read failed");
+    }
+    data_ = storage_.data();
+    size_ = storage_.size();
+    return true;
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return Fail(error, path, std::strerror(errno));
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+      ::close(fd);
+      return Fail(error, path, "not a regular file");
+    }
+    if (st.st_size <= 0) {
+      ::close(fd);
+      return Fail(error, path, "file is empty");
+    }
+    const size_t size = static_cast<size_t>(st.st_size);
+
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping != MAP_FAILED) {
+      ::close(fd);  // The mapping keeps the file referenced
+      data_ = static_cast<const uint8_t*>(mapping);
+      size_ = size;
+      mapped_ = true;
+      return true;
+    }
+
+    // Fall back to reading the file
+    storage_.resize(size);
+    size_t done = 0;
+    while (done < size) {
+      const ssize_t n = ::pread(fd, storage_.data() + done, size - done, static_cast<off_t>(done));
+      if (n < 0 && errno == EINTR) continue;
+      if (n <= 0) {
+        ::close(fd);
+        storage_.clear();
+        return Fail(error, path, n < 0 ? std::strerror(errno) : "unexpected end of file");
+      }
+      done += static_cast<size_t>(n);
+    }
+    ::close(fd);
+    data_ = storage_.data();
+    size_ = size;
+    return true;
+#endif
+  }
+
+  void Close() {
+#ifndef _WIN32
+    if (mapped_) ::munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    storage_.clear();
+    storage_.shrink_to_fit();
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+  }
+
+  [[nodiscard]] const uint8_t* data() const { return data_; }
+  [[nodiscard]] size_t size() const { return size_; }
+  [[nodiscard]] bool is_mapped() const { return mapped_; }
+
+ private:
+  static bool Fail(std::string* error, const std::string& path, const std::string& reason) {
+    if (error) *error = "Failed to read '" + path + "': " + reason;
+    return false;
+  }
+
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+  bool mapped_ = false;
+  std::vector<uint8_t> storage_;  // pread()/Windows fallback
+};
+
+}  // namespace webcodecs
@@ -0,0 +1,227 @@
+#pragma once
+/**
+ * output_buffer_pool.h - Caller-Supplied Destination Buffers for Decoding
+ *
+ * Bring-your-own-buffer (BYOB) decode: JS registers a fixed set of buffers
+ * with one pixel format and size, and the decoder worker writes converted
+ * pixels straight into the next free buffer. The resulting AVFrame wraps that
+ * memory via av_buffer_create(), so the VideoFrame handed to JS references
+ * the caller's buffer and no further copy is needed.
+ *
+ * Lifecycle:
+ * - A slot is busy from Acquire() until the last AVBufferRef to it is
+ *   released (VideoFrame.close(), GC, or a dropped frame on the worker)
+ * - When every slot is busy, Acquire() blocks the worker, which bounds the
+ *   decoder's output memory to the registered buffers
+ * - Interrupt() wakes a blocked Acquire() (reset/close)
+ * - Close() retires the pool (re-registration): Acquire() fails from then
+ *   on, but slots already handed out stay valid until released
+ *
+ * Thread Safety:
+ * - Acquire() runs on the worker thread; slot release may run on any thread
+ * - The pool is shared via shared_ptr, so outstanding frames keep it alive
+ * - The pool never touches JS values; the owning codec hands it a keep-alive
+ *   (SetKeepAlive()) for the registered memory, destroyed with the pool
+ *   once nothing holds it, on whichever thread drops the last reference
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+extern "C" {
+#include <libavutil/buffer.h>
+#include <libavutil/frame.h>
+#include <libavutil/imgutils.h>
+#include <libavutil/pixfmt.h>
+}
+
+#include "../ffmpeg_raii.h"
+
+namespace webcodecs {
+
+class OutputBufferPool : public std::enable_shared_from_this<OutputBufferPool> {
+ public:
+  OutputBufferPool(AVPixelFormat format, int width, int height)
+      : format_(format), width_(width), height_(height) {}
+
+  // Non-copyable, non-movable (slots are referenced by pointer)
+  OutputBufferPool(const OutputBufferPool&) = delete;
+  OutputBufferPool& operator=(const OutputBufferPool&) = delete;
+
+  /**
+   * Bytes each registered buffer needs: planes packed back to back with
+   * no row padding (the same layout as VideoFrame.copyTo() defaults).
+   */
+  static int RequiredSize(AVPixelFormat format, int width, int height) {
+    return av_image_get_buffer_size(format, width, height, 1);
+  }
+
+  /**
+   * Register a destination buffer. Must be called before the pool is shared
+   * with the worker.
+   */
+  void AddBuffer(uint8_t* data, size_t size) { slots_.push_back(Slot{data, size, false, nullptr}); }
+
+  /**
+   * Attach the owner of the registered memory. It is destroyed with the
+   * pool, i.e. after the last frame written into any buffer is released.
+   * Must be called before the pool is shared with the worker.
+   */
+  void SetKeepAlive(std::shared_ptr<void> keep_alive) { keep_alive_ = std::move(keep_alive); }
+
+  bool Matches(AVPixelFormat format, int width, int height) const {
+    return format == format_ && width == width_ && height == height_;
+  }
+
+  size_t size() const { return slots_.size(); }
+
+  size_t InUse() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_use_;
+  }
+
+  /**
+   * Index of the registered buffer that starts at data, or -1.
+   * Used while registering to reject the same buffer passed twice.
+   */
+  int IndexOf(const uint8_t* data) const {
+    for (size_t i = 0; i < slots_.size(); i++) {
+      if (slots_[i].data == data) return static_cast<int>(i);
+    }
+    return -1;
+  }
+
+  /**
+   * Take the next free buffer and wrap it in an AVFrame with this pool's
+   * format and size. Blocks while every buffer is in use.
+   *
+   * @param should_abort Polled while waiting (e.g. worker shutdown)
+   * @return Frame backed by a registered buffer, or nullptr if the wait was
+   *         interrupted or aborted, or the pool is closed
+   */
+  raii::AVFramePtr Acquire(const std::function<bool()>& should_abort) {
+    size_t index = 0;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      const uint64_t epoch = epoch_;
+      if (closed_) return nullptr;
+      while (!FindFree(&index)) {
+        if (epoch_ != epoch || closed_ || should_abort()) return nullptr;
+        // Timed wait so worker shutdown is noticed without an explicit wakeup
+        available_.wait_for(lock, std::chrono::milliseconds(50));
+      }
+      slots_[index].in_use = true;
+      in_use_++;
+    }
+
+    raii::AVFramePtr frame = raii::MakeAvFrame();
+    auto* ref = new SlotRef{shared_from_this(), index};
+    AVBufferRef* buf = frame ? av_buffer_create(slots_[index].data, slots_[index].size,
+                                                &OutputBufferPool::ReleaseSlot, ref, 0)
+                             : nullptr;
+    if (!buf) {
+      ReleaseSlot(ref, nullptr);
+      return nullptr;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      slots_[index].ref = ref;
+    }
+
+    frame->buf[0] = buf;
+    frame->format = format_;
+    frame->width = width_;
+    frame->height = height_;
+    if (av_image_fill_arrays(frame->data, frame->linesize, buf->data, format_, width_, height_,
+                             1) < 0) {
+      return nullptr;  // Frame deleter unrefs buf, which frees the slot
+    }
+    return frame;
+  }
+
+  /**
+   * Wake a blocked Acquire() and make it return nullptr.
+   * Acquire() calls that start afterwards wait normally.
+   */
+  void Interrupt() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      epoch_++;
+    }
+    available_.notify_all();
+  }
+
+  /**
+   * Retire the pool: blocked and future Acquire() calls return nullptr.
+   * Slots already handed out are released as usual.
+   */
+  void Close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+      epoch_++;
+    }
+    available_.notify_all();
+  }
+
+ private:
+  struct SlotRef;
+
+  struct Slot {
+    uint8_t* data;
+    size_t size;
+    bool in_use;
+    SlotRef* ref;  // Opaque of the outstanding AVBufferRef, if any
+  };
+
+  // av_buffer_create() opaque: keeps the pool alive until the slot returns
+  struct SlotRef {
+    std::shared_ptr<OutputBufferPool> pool;
+    size_t index;
+  };
+
+  static void ReleaseSlot(void* opaque, uint8_t* /*data*/) {
+    auto* ref = static_cast<SlotRef*>(opaque);
+    {
+      std::lock_guard<std::mutex> lock(ref->pool->mutex_);
+      ref->pool->slots_[ref->index].in_use = false;
+      ref->pool->slots_[ref->index].ref = nullptr;
+      ref->pool->in_use_--;
+    }
+    ref->pool->available_.notify_one();
+    delete ref;
+  }
+
+  bool FindFree(size_t* index) {
+    // Round-robin from the last hand-out keeps ring-buffer order predictable
+    for (size_t n = 0; n < slots_.size(); n++) {
+      size_t i = (next_ + n) % slots_.size();
+      if (!slots_[i].in_use) {
+        *index = i;
+        next_ = i + 1;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  const AVPixelFormat format_;
+  const int width_;
+  const int height_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable available_;
+  std::vector<Slot> slots_;
+  size_t next_ = 0;
+  size_t in_use_ = 0;
+  uint64_t epoch_ = 0;
+  bool closed_ = false;
+  std::shared_ptr<void> keep_alive_;  // Owner of the registered memory (SetKeepAlive())
+};
+
+}  // namespace webcodecs
@@ -0,0 +1,300 @@
+#pragma once
+/**
+ * pcm_codec.h - PCM and G.711 Coding Without libavcodec
+ *
+ * The "pcm-*", "ulaw" and "alaw" codecs have no state between packets:
+ * decoding is a copy, a byte swap or a table lookup per sample. AudioDecoder
+ * and AudioEncoder run them through this header on the JS thread whenever
+ * their worker has nothing queued (see AudioDecoderWorker::DecodeInline and
+ * AudioEncoderWorker::EncodeInline), skipping the queue, the thread hop and
+ * the avcodec send/receive calls.
+ *
+ * Output is bit-exact with FFmpeg's pcm decoders and encoders, including the
+ * packed sample format of the frames:
+ * - u8 -> u8, s16le/s16be/ulaw/alaw -> s16, s24le/s24be/s32le/s32be -> s32
+ *   (s24 in the upper 24 bits), f32le/f32be -> flt
+ * - G.711 tables are built with the algorithm of libavcodec/pcm_tablegen.h
+ *   (256-entry decode tables; 16384-entry encode tables indexed by the top
+ *   14 bits of the s16 sample)
+ * - A trailing partial frame of a packet is dropped; a packet shorter than
+ *   one frame is invalid data
+ *
+ * Byte swap and s24 loops are plain per-sample code over contiguous
+ * buffers, written for the compiler's auto-vectorizer; the G.711 lookups
+ * stay scalar (the tables are L1-resident).
+ *
+ * Thread Safety:
+ * - Tables are built once (function-local statics); all functions are
+ *   stateless and safe to call from any thread
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+
+extern "C" {
+#include <libavcodec/codec_id.h>
+#include <libavcodec/packet.h>
+#include <libavutil/avconfig.h>
+#include <libavutil/error.h>
+#include <libavutil/frame.h>
+#include <libavutil/samplefmt.h>
+}
+
+#include "audio_buffer_pool.h"
+
+namespace webcodecs {
+namespace pcm_codec {
+
+enum class Coding {
+  kNative,  // Coded bytes are the sample format in host byte order
+  kSwap16,  // 16-bit samples in the other byte order
+  kSwap32,  // 32-bit samples (int or float) in the other byte order
+  kS24LE,   // 3-byte little-endian <-> s32
+  kS24BE,   // 3-byte big-endian <-> s32
+  kMulaw,   // G.711 mu-law <-> s16
+  kAlaw,    // G.711 A-law <-> s16
+};
+
+struct Format {
+  Coding coding;
+  AVSampleFormat sample_fmt;  // Packed format of decoded frames / encoder input
+  int coded_size;             // Bytes per coded sample
+};
+
+/**
+ * @return The inline format for codec_id, or std::nullopt when the codec
+ *         needs libavcodec
+ */
+inline std::optional<Format> Find(AVCodecID codec_id) {
+#if AV_HAVE_BIGENDIAN
+  constexpr Coding kLE16 = Coding::kSwap16, kBE16 = Coding::kNative;
+  constexpr Coding kLE32 = Coding::kSwap32, kBE32 = Coding::kNative;
+#else
+  constexpr Coding kLE16 = Coding::kNative, kBE16 = Coding::kSwap16;
+  constexpr Coding kLE32 = Coding::kNative, kBE32 = Coding::kSwap32;
+#endif
+  switch (codec_id) {
+    case AV_CODEC_ID_PCM_U8:
+      return Format{Coding::kNative, AV_SAMPLE_FMT_U8, 1};
+    case AV_CODEC_ID_PCM_S16LE:
+      return Format{kLE16, AV_SAMPLE_FMT_S16, 2};
+    case AV_CODEC_ID_PCM_S16BE:
+      return Format{kBE16, AV_SAMPLE_FMT_S16, 2};
+    case AV_CODEC_ID_PCM_S24LE:
+      return Format{Coding::kS24LE, AV_SAMPLE_FMT_S32, 3};
+    case AV_CODEC_ID_PCM_S24BE:
+      return Format{Coding::kS24BE, AV_SAMPLE_FMT_S32, 3};
+    case AV_CODEC_ID_PCM_S32LE:
+      return Format{kLE32, AV_SAMPLE_FMT_S32, 4};
+    case AV_CODEC_ID_PCM_S32BE:
+      return Format{kBE32, AV_SAMPLE_FMT_S32, 4};
+    case AV_CODEC_ID_PCM_F32LE:
+      return Format{kLE32, AV_SAMPLE_FMT_FLT, 4};
+    case AV_CODEC_ID_PCM_F32BE:
+      return Format{kBE32, AV_SAMPLE_FMT_FLT, 4};
+    case AV_CODEC_ID_PCM_MULAW:
+      return Format{Coding::kMulaw, AV_SAMPLE_FMT_S16, 1};
+    case AV_CODEC_ID_PCM_ALAW:
+      return Format{Coding::kAlaw, AV_SAMPLE_FMT_S16, 1};
+    default:
+      return std::nullopt;
+  }
+}
+
+// =============================================================================
+// G.711 TABLES
+// =============================================================================
+
+inline int AlawToLinear(uint8_t a_val) {
+  a_val ^= 0x55;
+  int t = a_val & 0x0f;
+  const int seg = (a_val & 0x70) >> 4;
+  t = seg ? (t + t + 1 + 32) << (seg + 2) : (t + t + 1) << 3;
+  return (a_val & 0x80) ? t : -t;
+}
+
+inline int UlawToLinear(uint8_t u_val) {
+  constexpr int kBias = 0x84;
+  u_val = static_cast<uint8_t>(~u_val);
+  int t = ((u_val & 0x0f) << 3) + kBias;
+  t <<= (u_val & 0x70) >> 4;
+  return (u_val & 0x80) ? (kBias - t) : (t - kBias);
+}
+
+struct G711Table {
+  int16_t decode[256];
+  uint8_t encode[16384];  // Indexed by (s16 + 32768) >> 2
+};
+
+// Midpoints between adjacent code values decide the encoding
+inline void BuildG711Table(G711Table* table, int (*to_linear)(uint8_t), int mask) {
+  for (int i = 0; i < 256; i++) table->decode[i] = static_cast<int16_t>(to_linear(static_cast<uint8_t>(i)));
+
+  uint8_t* enc = table->encode;
+  int j = 1;
+  enc[8192] = static_cast<uint8_t>(mask);
+  for (int i = 0; i < 127; i++) {
+    const int v1 = to_linear(static_cast<uint8_t>(i ^ mask));
+    const int v2 = to_linear(static_cast<uint8_t>((i + 1) ^ mask));
+    const int v = (v1 + v2 + 4) >> 3;
+    for (; j < v; j++) {
+      enc[8192 - j] = static_cast<uint8_t>(i ^ (mask ^ 0x80));
+      enc[8192 + j] = static_cast<uint8_t>(i ^ mask);
+    }
+  }
+  for (; j < 8192; j++) {
+    enc[8192 - j] = static_cast<uint8_t>(127 ^ (mask ^ 0x80));
+    enc[8192 + j] = static_cast<uint8_t>(127 ^ mask);
+  }
+  enc[0] = enc[1];
+}
+
+inline const G711Table& MulawTable() {
+  static const G711Table table = [] {
+    G711Table t;
+    BuildG711Table(&t, UlawToLinear, 0xff);
+    return t;
+  }();
+  return table;
+}
+
+inline const G711Table& AlawTable() {
+  static const G711Table table = [] {
+    G711Table t;
+    BuildG711Table(&t, AlawToLinear, 0xd5);
+    return t;
+  }();
+  return table;
+}
+
+// =============================================================================
+// SAMPLE LOOPS
+// =============================================================================
+
+inline uint16_t Swap16(uint16_t v) { return static_cast<uint16_t>((v >> 8) | (v << 8)); }
+
+inline uint32_t Swap32(uint32_t v) {
+  return (v >> 24) | ((v >> 8) & 0xff00u) | ((v << 8) & 0xff0000u) | (v << 24);
+}
+
+/**
+ * Decode count coded samples from in into count samples of
+ * format.sample_fmt at out. Buffers must not overlap.
+ */
+inline void Decode(const Format& format, const uint8_t* in, size_t count, uint8_t* out) {
+  switch (format.coding) {
+    case Coding::kNative:
+      std::memcpy(out, in, count * format.coded_size);
+      break;
+    case Coding::kSwap16:
+      for (size_t i = 0; i < count; i++) {
+        uint16_t v;
+        std::memcpy(&v, in + 2 * i, 2);
+        v = Swap16(v);
+        std::memcpy(out + 2 * i, &v, 2);
+      }
+      break;
+    case Coding::kSwap32:
+      for (size_t i = 0; i < count; i++) {
+        uint32_t v;
+        std::memcpy(&v, in + 4 * i, 4);
+        v = Swap32(v);
+        std::memcpy(out + 4 * i, &v, 4);
+      }
+      break;
+    case Coding::kS24LE:
+    case Coding::kS24BE: {
+      const bool le = format.coding == Coding::kS24LE;
+      auto* dst = reinterpret_cast<uint32_t*>(out);
+      for (size_t i = 0; i < count; i++) {
+        const uint8_t* p = in + 3 * i;
+        const uint32_t lo = le ? p[0] : p[2];
+        const uint32_t hi = le ? p[2] : p[0];
+        dst[i] = (hi << 24) | (static_cast<uint32_t>(p[1]) << 16) | (lo << 8);
+      }
+      break;
+    }
+    case Coding::kMulaw:
+    case Coding::kAlaw: {
+      const int16_t* table = (format.coding == Coding::kMulaw ? MulawTable() : AlawTable()).decode;
+      auto* dst = reinterpret_cast<int16_t*>(out);
+      for (size_t i = 0; i < count; i++) dst[i] = table[in[i]];
+      break;
+    }
+  }
+}
+
+/**
+ * Encode count samples of format.sample_fmt at in into count coded samples
+ * at out. Buffers must not overlap.
+ */
+inline void Encode(const Format& format, const uint8_t* in, size_t count, uint8_t* out) {
+  switch (format.coding) {
+    case Coding::kNative:
+    case Coding::kSwap16:
+    case Coding::kSwap32:
+      // Byte swapping is its own inverse
+      Decode(format, in, count, out);
+      break;
+    case Coding::kS24LE:
+    case Coding::kS24BE: {
+      const bool le = format.coding == Coding::kS24LE;
+      const auto* src = reinterpret_cast<const uint32_t*>(in);
+      for (size_t i = 0; i < count; i++) {
+        uint8_t* p = out + 3 * i;
+        const uint32_t v = src[i];
+        p[le ? 0 : 2] = static_cast<uint8_t>(v >> 8);
+        p[1] = static_cast<uint8_t>(v >> 16);
+        p[le ? 2 : 0] = static_cast<uint8_t>(v >> 24);
+      }
+      break;
+    }
+    case Coding::kMulaw:
+    case Coding::kAlaw: {
+      const uint8_t* table = (format.coding == Coding::kMulaw ? MulawTable() : AlawTable()).encode;
+      const auto* src = reinterpret_cast<const int16_t*>(in);
+      for (size_t i = 0; i < count; i++) out[i] = table[(src[i] + 32768) >> 2];
+      break;
+    }
+  }
+}
+
+/**
+ * Decode a packet of interleaved samples into frame, which must already
+ * carry the channel layout for channels (format, nb_samples and data are
+ * set here; sample rate and timestamps are left to the caller).
+ * Native-order packets backed by a refcounted buffer are referenced, not
+ * copied; other output goes to a GlobalAudioBufferPool buffer, counted
+ * against counters (may be nullptr).
+ *
+ * @return 0 on success, AVERROR_INVALIDDATA for a packet shorter than one
+ *         frame, or another negative AVERROR
+ */
+inline int DecodePacket(const Format& format, const AVPacket* packet, int channels, AVFrame* frame,
+                        AudioBufferCounters* counters = nullptr) {
+  if (!packet || channels <= 0) return AVERROR(EINVAL);
+  const int block = format.coded_size * channels;
+  const int nb_samples = packet->size / block;
+  if (nb_samples <= 0) return AVERROR_INVALIDDATA;
+
+  frame->format = format.sample_fmt;
+  frame->nb_samples = nb_samples;
+
+  if (format.coding == Coding::kNative && packet->buf) {
+    frame->buf[0] = av_buffer_ref(packet->buf);
+    if (!frame->buf[0]) return AVERROR(ENOMEM);
+    frame->data[0] = packet->data;
+    frame->extended_data = frame->data;
+    frame->linesize[0] = nb_samples * block;
+    return 0;
+  }
+
+  int ret = GlobalAudioBufferPool::Instance().GetBuffer(frame, counters);
+  if (ret < 0) return ret;
+  Decode(format, packet->data, static_cast<size_t>(nb_samples) * channels, frame->data[0]);
+  return 0;
+}
+
+}  // namespace pcm_codec
+}  // namespace webcodecs
@@ -0,0 +1,124 @@
+#pragma once
+/**
+ * progressive_scanner.h - Progressive Refinement Boundaries in Streamed Images
+ *
+ * Streaming ImageDecoder can resolve decode({completeFramesOnly: false})
+ * with a partial image before the whole file has arrived. FFmpeg's image
+ * decoders consume one packet at a time, so a partial image is produced by
+ * decoding a prefix of the buffered data. This scanner finds prefixes that
+ * end on a refinement boundary, so each partial decode adds a whole
+ * refinement step instead of running on every incoming chunk:
+ *
+ * - JPEG: the end of each complete scan (progressive JPEGs have ~10 scans,
+ *   each sharpening the whole image; baseline JPEGs have a single scan and
+ *   produce no partial results)
+ *
+ * Other formats are not scanned. PNG in particular cannot be refined this
+ * way: FFmpeg's PNG decoder rejects a truncated IDAT stream instead of
+ * returning the rows decoded so far.
+ *
+ * The scan is incremental: Update() resumes where the previous call
+ * stopped, so total scanning work is linear in the stream size.
+ *
+ * Thread Safety:
+ * - Not thread-safe; owned and used by a single worker thread
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "segmented_buffer.h"
+
+namespace webcodecs {
+
+class ProgressiveScanner {
+ public:
+  enum class Format { kNone, kJpeg };
+
+  explicit ProgressiveScanner(const std::string& type = "") { Reset(type); }
+
+  void Reset(const std::string& type) {
+    format_ = type == "image/jpeg" ? Format::kJpeg : Format::kNone;
+    pos_ = format_ == Format::kJpeg ? 2 : 0;
+    in_scan_ = false;
+    generation_ = 0;
+    boundary_ = 0;
+  }
+
+  /**
+   * Scan newly buffered bytes.
+   *
+   * @return true if a new refinement step became available
+   */
+  bool Update(const SegmentedBuffer& data) {
+    const int before = generation_;
+    if (format_ == Format::kJpeg) ScanJpeg(data);
+    return generation_ != before;
+  }
+
+  /** Number of refinement steps available so far (0 = none). */
+  [[nodiscard]] int generation() const { return generation_; }
+
+  /** Length of the prefix that contains every available step. */
+  [[nodiscard]] size_t boundary() const { return boundary_; }
+
+  [[nodiscard]] bool supported() const { return format_ != Format::kNone; }
+
+ private:
+  void ScanJpeg(const SegmentedBuffer& data) {
+    const size_t size = data.size();
+    while (pos_ + 1 < size) {
+      if (in_scan_) {
+        // Entropy-coded data: a marker is 0xFF followed by anything but
+        // 0x00 (stuffing), 0xFF (fill) or RSTn
+        if (data.At(pos_) != 0xFF) {
+          pos_++;
+          continue;
+        }
+        const uint8_t next = data.At(pos_ + 1);
+        if (next == 0x00 || (next >= 0xD0 && next <= 0xD7)) {
+          pos_ += 2;
+          continue;
+        }
+        if (next == 0xFF) {
+          pos_++;
+          continue;
+        }
+        // Scan complete: everything before this marker is one more step
+        in_scan_ = false;
+        generation_++;
+        boundary_ = pos_;
+        if (next == 0xD9) {  // EOI
+          pos_ = size;
+          format_ = Format::kNone;
+          return;
+        }
+        continue;
+      }
+
+      if (data.At(pos_) != 0xFF) {
+        format_ = Format::kNone;  // Not a marker: stop scanning this stream
+        return;
+      }
+      const uint8_t marker = data.At(pos_ + 1);
+      if (marker == 0xFF) {
+        pos_++;
+        continue;
+      }
+      if (pos_ + 4 > size) return;
+      const size_t length = (static_cast<size_t>(data.At(pos_ + 2)) << 8) | data.At(pos_ + 3);
+      if (pos_ + 2 + length > size) return;  // Segment not fully buffered
+      pos_ += 2 + length;
+      if (marker == 0xDA) in_scan_ = true;  // SOS header done; ECS follows
+    }
+  }
+
+  Format format_ = Format::kNone;
+  size_t pos_ = 0;        // Next byte to scan
+  bool in_scan_ = false;  // JPEG: inside entropy-coded data
+  int generation_ = 0;
+  size_t boundary_ = 0;
+};
+
+}  // namespace webcodecs
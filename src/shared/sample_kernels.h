@@ -0,0 +1,885 @@
+#pragma once
+/**
+ * sample_kernels.h - Vectorized Audio Sample Layout and Format Kernels
+ *
+ * AudioData.copyTo() moves samples between planar and interleaved layouts
+ * and between u8, s16, s32 and f32. These kernels work on contiguous runs
+ * instead of one sample at a time:
+ *
+ * - Convert(): u8/s16/s32 <-> f32 (and same-type copies), with the scaling,
+ *   rounding and clipping of libswresample: int -> f32 divides by
+ *   2^(bits-1); f32 -> int multiplies, rounds to nearest and saturates
+ * - Interleave(): one pointer per plane -> interleaved frames
+ * - Deinterleave(): one channel of interleaved frames -> a plane
+ * - Mix(): weighted sum of f32 planes (channel remixing)
+ * - SoftClip(): in-place f32 limiting for summed signals (AudioMixer);
+ *   linear up to a knee of 0.75, then a rational curve reaching 1.0 at 1.5
+ * - ToSampleType(): the kernel type of an FFmpeg sample format
+ *
+ * Implementations:
+ * - SSE2 (x86-64 baseline) and AVX2 (selected at runtime with
+ *   __builtin_cpu_supports on GCC/Clang; conversions only)
+ * - NEON (AArch64 baseline)
+ * - Scalar fallback, also used for tails shorter than a vector
+ *
+ * Get() picks the best implementation once per process. Int <-> int
+ * conversions (s16 -> s32, ...) are not covered; CanConvert() reports
+ * which pairs are.
+ *
+ * Thread Safety:
+ * - Stateless; safe to call from any thread
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include <libavutil/samplefmt.h>
+}
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WEBCODECS_KERNELS_SSE2 1
+#include <emmintrin.h>
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define WEBCODECS_KERNELS_AVX2 1
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define WEBCODECS_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace webcodecs {
+namespace sample_kernels {
+
+enum class SampleType { kU8, kS16, kS32, kF32 };
+
+inline size_t SampleSize(SampleType type) {
+  switch (type) {
+    case SampleType::kU8:
+      return 1;
+    case SampleType::kS16:
+      return 2;
+    case SampleType::kS32:
+    case SampleType::kF32:
+      return 4;
+  }
+  return 0;
+}
+
+/** Kernel type of an FFmpeg sample format, packed or planar (false if not covered). */
+inline bool ToSampleType(AVSampleFormat fmt, SampleType* type) {
+  switch (av_get_packed_sample_fmt(fmt)) {
+    case AV_SAMPLE_FMT_U8:
+      *type = SampleType::kU8;
+      return true;
+    case AV_SAMPLE_FMT_S16:
+      *type = SampleType::kS16;
+      return true;
+    case AV_SAMPLE_FMT_S32:
+      *type = SampleType::kS32;
+      return true;
+    case AV_SAMPLE_FMT_FLT:
+      *type = SampleType::kF32;
+      return true;
+    default:
+      return false;
+  }
+}
+
+/** One implementation; counts are in samples (conversions) or frames. */
+struct Kernels {
+  const char* name;
+  void (*u8_to_f32)(const uint8_t* src, float* dst, size_t count);
+  void (*s16_to_f32)(const int16_t* src, float* dst, size_t count);
+  void (*s32_to_f32)(const int32_t* src, float* dst, size_t count);
+  void (*f32_to_u8)(const float* src, uint8_t* dst, size_t count);
+  void (*f32_to_s16)(const float* src, int16_t* dst, size_t count);
+  void (*f32_to_s32)(const float* src, int32_t* dst, size_t count);
+  // 4-byte samples (f32, s32)
+  void (*interleave32)(const uint32_t* const* planes, int channels, size_t frames, uint32_t* dst);
+  void (*deinterleave32)(const uint32_t* src, int channels, int channel, size_t frames,
+                         uint32_t* dst);
+  // dst[i] += gain * src[i]
+  void (*mix_add)(const float* src, float gain, size_t count, float* dst);
+  // In place; |samples[i]| <= 1 afterwards
+  void (*soft_clip)(float* samples, size_t count);
+};
+
+// =============================================================================
+// SCALAR
+// =============================================================================
+
+namespace detail {
+
+constexpr float kU8Scale = 1.0f / (1 << 7);
+constexpr float kS16Scale = 1.0f / (1 << 15);
+constexpr float kS32Scale = 1.0f / (1U << 31);
+
+inline void ScalarU8ToF32(const uint8_t* src, float* dst, size_t count) {
+  for (size_t i = 0; i < count; i++) dst[i] = (static_cast<int>(src[i]) - 0x80) * kU8Scale;
+}
+
+inline void ScalarS16ToF32(const int16_t* src, float* dst, size_t count) {
+  for (size_t i = 0; i < count; i++) dst[i] = src[i] * kS16Scale;
+}
+
+inline void ScalarS32ToF32(const int32_t* src, float* dst, size_t count) {
+  for (size_t i = 0; i < count; i++) dst[i] = static_cast<float>(src[i]) * kS32Scale;
+}
+
+inline void ScalarF32ToU8(const float* src, uint8_t* dst, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    const float v = std::min(std::max(src[i] * 128.0f, -128.0f), 127.0f);
+    dst[i] = static_cast<uint8_t>(std::lrintf(v) + 0x80);
+  }
+}
+
+inline void ScalarF32ToS16(const float* src, int16_t* dst, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    const float v = std::min(std::max(src[i] * 32768.0f, -32768.0f), 32767.0f);
+    dst[i] = static_cast<int16_t>(std::lrintf(v));
+  }
+}
+
+inline void ScalarF32ToS32(const float* src, int32_t* dst, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    // 2^31 itself does not fit; every float below it does
+    const float v = src[i] * 2147483648.0f;
+    dst[i] = v >= 2147483648.0f    ? INT32_MAX
+             : v <= -2147483648.0f ? INT32_MIN
+                                   : static_cast<int32_t>(std::llrintf(v));
+  }
+}
+
+inline void ScalarInterleave32(const uint32_t* const* planes, int channels, size_t frames,
+                               uint32_t* dst) {
+  for (int ch = 0; ch < channels; ch++) {
+    const uint32_t* plane = planes[ch];
+    uint32_t* out = dst + ch;
+    for (size_t i = 0; i < frames; i++) out[i * channels] = plane[i];
+  }
+}
+
+inline void ScalarDeinterleave32(const uint32_t* src, int channels, int channel, size_t frames,
+                                 uint32_t* dst) {
+  src += channel;
+  for (size_t i = 0; i < frames; i++) dst[i] = src[i * channels];
+}
+
+inline void ScalarMixAdd(const float* src, float gain, size_t count, float* dst) {
+  for (size_t i = 0; i < count; i++) dst[i] += gain * src[i];
+}
+
+// Above the knee, z = (|x| - knee) / (1 - knee) is shaped by
+// z * (27 + z^2) / (27 + 9 z^2): slope 1 at the knee (no kink), monotonic,
+// and exactly 1 at z = 3, where it is capped.
+constexpr float kSoftClipKnee = 0.75f;
+constexpr float kSoftClipRange = 1.0f - kSoftClipKnee;
+constexpr float kSoftClipInvRange = 1.0f / kSoftClipRange;
+
+inline void ScalarSoftClip(float* samples, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    const float a = std::fabs(samples[i]);
+    if (a <= kSoftClipKnee) continue;
+    const float z = std::min((a - kSoftClipKnee) * kSoftClipInvRange, 3.0f);
+    const float z2 = z * z;
+    const float shaped = kSoftClipKnee + kSoftClipRange * (z * (27.0f + z2) / (27.0f + 9.0f * z2));
+    samples[i] = std::copysign(shaped, samples[i]);
+  }
+}
+
+}  // namespace detail
+
+inline const Kernels& ScalarKernels() {
+  static const Kernels kernels{"scalar",
+                               detail::ScalarU8ToF32,
+                               detail::ScalarS16ToF32,
+                               detail::ScalarS32ToF32,
+                               detail::ScalarF32ToU8,
+                               detail::ScalarF32ToS16,
+                               detail::ScalarF32ToS32,
+                               detail::ScalarInterleave32,
+                               detail::ScalarDeinterleave32,
+                               detail::ScalarMixAdd,
+                               detail::ScalarSoftClip};
+  return kernels;
+}
+
+// =============================================================================
+// SSE2
+// =============================================================================
+
+#ifdef WEBCODECS_KERNELS_SSE2
+namespace detail {
+
+inline void Transpose4(__m128i& r0, __m128i& r1, __m128i& r2, __m128i& r3) {
+  const __m128i t0 = _mm_unpacklo_epi32(r0, r1);  // a0 b0 a1 b1
+  const __m128i t1 = _mm_unpacklo_epi32(r2, r3);  // c0 d0 c1 d1
+  const __m128i t2 = _mm_unpackhi_epi32(r0, r1);  // a2 b2 a3 b3
+  const __m128i t3 = _mm_unpackhi_epi32(r2, r3);  // c2 d2 c3 d3
+  r0 = _mm_unpacklo_epi64(t0, t1);
+  r1 = _mm_unpackhi_epi64(t0, t1);
+  r2 = _mm_unpacklo_epi64(t2, t3);
+  r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+// Sign-extend the low/high four int16 lanes to int32
+inline __m128i Sse2WidenLo16(__m128i v) { return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16); }
+inline __m128i Sse2WidenHi16(__m128i v) { return _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16); }
+
+inline void Sse2U8ToF32(const uint8_t* src, float* dst, size_t count) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i bias = _mm_set1_epi16(0x80);
+  const __m128 scale = _mm_set1_ps(kU8Scale);
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i lo = _mm_sub_epi16(_mm_unpacklo_epi8(v, zero), bias);
+    const __m128i hi = _mm_sub_epi16(_mm_unpackhi_epi8(v, zero), bias);
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(Sse2WidenLo16(lo)), scale));
+    _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(Sse2WidenHi16(lo)), scale));
+    _mm_storeu_ps(dst + i + 8, _mm_mul_ps(_mm_cvtepi32_ps(Sse2WidenLo16(hi)), scale));
+    _mm_storeu_ps(dst + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(Sse2WidenHi16(hi)), scale));
+  }
+  ScalarU8ToF32(src + i, dst + i, count - i);
+}
+
+inline void Sse2S16ToF32(const int16_t* src, float* dst, size_t count) {
+  const __m128 scale = _mm_set1_ps(kS16Scale);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(Sse2WidenLo16(v)), scale));
+    _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(Sse2WidenHi16(v)), scale));
+  }
+  ScalarS16ToF32(src + i, dst + i, count - i);
+}
+
+inline void Sse2S32ToF32(const int32_t* src, float* dst, size_t count) {
+  const __m128 scale = _mm_set1_ps(kS32Scale);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+  }
+  ScalarS32ToF32(src + i, dst + i, count - i);
+}
+
+// Scale, clamp to [lo, hi] and round to nearest (cvtps uses MXCSR, like lrintf)
+inline __m128i Sse2ScaleRound(const float* src, __m128 scale, __m128 lo, __m128 hi) {
+  const __m128 v = _mm_mul_ps(_mm_loadu_ps(src), scale);
+  return _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(v, lo), hi));
+}
+
+inline void Sse2F32ToU8(const float* src, uint8_t* dst, size_t count) {
+  const __m128 scale = _mm_set1_ps(128.0f);
+  const __m128 lo = _mm_set1_ps(-128.0f);
+  const __m128 hi = _mm_set1_ps(127.0f);
+  const __m128i bias = _mm_set1_epi16(0x80);
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m128i a = _mm_packs_epi32(Sse2ScaleRound(src + i, scale, lo, hi),
+                                      Sse2ScaleRound(src + i + 4, scale, lo, hi));
+    const __m128i b = _mm_packs_epi32(Sse2ScaleRound(src + i + 8, scale, lo, hi),
+                                      Sse2ScaleRound(src + i + 12, scale, lo, hi));
+    const __m128i v = _mm_packus_epi16(_mm_add_epi16(a, bias), _mm_add_epi16(b, bias));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+  }
+  ScalarF32ToU8(src + i, dst + i, count - i);
+}
+
+inline void Sse2F32ToS16(const float* src, int16_t* dst, size_t count) {
+  const __m128 scale = _mm_set1_ps(32768.0f);
+  const __m128 lo = _mm_set1_ps(-32768.0f);
+  const __m128 hi = _mm_set1_ps(32767.0f);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m128i v = _mm_packs_epi32(Sse2ScaleRound(src + i, scale, lo, hi),
+                                      Sse2ScaleRound(src + i + 4, scale, lo, hi));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+  }
+  ScalarF32ToS16(src + i, dst + i, count - i);
+}
+
+inline void Sse2F32ToS32(const float* src, int32_t* dst, size_t count) {
+  const __m128 scale = _mm_set1_ps(2147483648.0f);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128 v = _mm_mul_ps(_mm_loadu_ps(src + i), scale);
+    // Out-of-range lanes convert to INT32_MIN; flip the positive ones to INT32_MAX
+    const __m128i overflow = _mm_castps_si128(_mm_cmpge_ps(v, scale));
+    const __m128i r = _mm_xor_si128(_mm_cvtps_epi32(v), overflow);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), r);
+  }
+  ScalarF32ToS32(src + i, dst + i, count - i);
+}
+
+inline void Sse2Interleave32(const uint32_t* const* planes, int channels, size_t frames,
+                             uint32_t* dst) {
+  size_t i = 0;
+  if (channels == 2) {
+    for (; i + 4 <= frames; i += 4) {
+      const __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[0] + i));
+      const __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[1] + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), _mm_unpacklo_epi32(l, r));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2 + 4), _mm_unpackhi_epi32(l, r));
+    }
+  } else if (channels % 4 == 0) {
+    for (; i + 4 <= frames; i += 4) {
+      for (int g = 0; g < channels; g += 4) {
+        __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[g] + i));
+        __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[g + 1] + i));
+        __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[g + 2] + i));
+        __m128i r3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[g + 3] + i));
+        Transpose4(r0, r1, r2, r3);
+        uint32_t* out = dst + i * channels + g;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), r0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + channels), r1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + channels * 2), r2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + channels * 3), r3);
+      }
+    }
+  }
+  if (i == frames) return;
+  std::vector<const uint32_t*> rest(planes, planes + channels);
+  for (auto& plane : rest) plane += i;
+  ScalarInterleave32(rest.data(), channels, frames - i, dst + i * channels);
+}
+
+inline void Sse2Deinterleave32(const uint32_t* src, int channels, int channel, size_t frames,
+                               uint32_t* dst) {
+  size_t i = 0;
+  if (channels == 2) {
+    for (; i + 4 <= frames; i += 4) {
+      const __m128 a = _mm_loadu_ps(reinterpret_cast<const float*>(src + i * 2));
+      const __m128 b = _mm_loadu_ps(reinterpret_cast<const float*>(src + i * 2 + 4));
+      const __m128 v = channel == 0 ? _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))
+                                    : _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+      _mm_storeu_ps(reinterpret_cast<float*>(dst + i), v);
+    }
+  } else if (channels % 4 == 0) {
+    const int g = channel & ~3;
+    const uint32_t* base = src + g;
+    for (; i + 4 <= frames; i += 4) {
+      const uint32_t* in = base + i * channels;
+      __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+      __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + channels));
+      __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + channels * 2));
+      __m128i r3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + channels * 3));
+      Transpose4(r0, r1, r2, r3);
+      const __m128i columns[4] = {r0, r1, r2, r3};
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), columns[channel - g]);
+    }
+  }
+  ScalarDeinterleave32(src + i * channels, channels, channel, frames - i, dst + i);
+}
+
+inline void Sse2MixAdd(const float* src, float gain, size_t count, float* dst) {
+  const __m128 g = _mm_set1_ps(gain);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m128 a = _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g));
+    const __m128 b =
+        _mm_add_ps(_mm_loadu_ps(dst + i + 4), _mm_mul_ps(_mm_loadu_ps(src + i + 4), g));
+    _mm_storeu_ps(dst + i, a);
+    _mm_storeu_ps(dst + i + 4, b);
+  }
+  ScalarMixAdd(src + i, gain, count - i, dst + i);
+}
+
+// Same operations in the same order as ScalarSoftClip; both branches are
+// computed and the knee mask selects
+inline void Sse2SoftClip(float* samples, size_t count) {
+  const __m128 sign_mask = _mm_set1_ps(-0.0f);
+  const __m128 knee = _mm_set1_ps(kSoftClipKnee);
+  const __m128 range = _mm_set1_ps(kSoftClipRange);
+  const __m128 inv_range = _mm_set1_ps(kSoftClipInvRange);
+  const __m128 z_max = _mm_set1_ps(3.0f);
+  const __m128 c27 = _mm_set1_ps(27.0f);
+  const __m128 c9 = _mm_set1_ps(9.0f);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128 x = _mm_loadu_ps(samples + i);
+    const __m128 a = _mm_andnot_ps(sign_mask, x);
+    const __m128 z = _mm_min_ps(_mm_mul_ps(_mm_sub_ps(a, knee), inv_range), z_max);
+    const __m128 z2 = _mm_mul_ps(z, z);
+    const __m128 curve =
+        _mm_div_ps(_mm_mul_ps(z, _mm_add_ps(c27, z2)), _mm_add_ps(c27, _mm_mul_ps(c9, z2)));
+    const __m128 shaped = _mm_add_ps(knee, _mm_mul_ps(range, curve));
+    const __m128 linear = _mm_cmple_ps(a, knee);
+    const __m128 r = _mm_or_ps(_mm_and_ps(linear, a), _mm_andnot_ps(linear, shaped));
+    _mm_storeu_ps(samples + i, _mm_or_ps(r, _mm_and_ps(sign_mask, x)));
+  }
+  ScalarSoftClip(samples + i, count - i);
+}
+
+}  // namespace detail
+
+inline const Kernels& Sse2Kernels() {
+  static const Kernels kernels{"sse2",
+                               detail::Sse2U8ToF32,
+                               detail::Sse2S16ToF32,
+                               detail::Sse2S32ToF32,
+                               detail::Sse2F32ToU8,
+                               detail::Sse2F32ToS16,
+                               detail::Sse2F32ToS32,
+                               detail::Sse2Interleave32,
+                               detail::Sse2Deinterleave32,
+                               detail::Sse2MixAdd,
+                               detail::Sse2SoftClip};
+  return kernels;
+}
+#endif  // WEBCODECS_KERNELS_SSE2
+
+// =============================================================================
+// AVX2 (conversions and mixing; layout kernels stay SSE2)
+// =============================================================================
+
+#ifdef WEBCODECS_KERNELS_AVX2
+namespace detail {
+
+__attribute__((target("avx2"))) inline void Avx2U8ToF32(const uint8_t* src, float* dst,
+                                                        size_t count) {
+  const __m256i bias = _mm256_set1_epi32(0x80);
+  const __m256 scale = _mm256_set1_ps(kU8Scale);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+    const __m256i w = _mm256_sub_epi32(_mm256_cvtepu8_epi32(v), bias);
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(w), scale));
+  }
+  ScalarU8ToF32(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx2"))) inline void Avx2S16ToF32(const int16_t* src, float* dst,
+                                                         size_t count) {
+  const __m256 scale = _mm256_set1_ps(kS16Scale);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(v)), scale));
+  }
+  ScalarS16ToF32(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx2"))) inline void Avx2S32ToF32(const int32_t* src, float* dst,
+                                                         size_t count) {
+  const __m256 scale = _mm256_set1_ps(kS32Scale);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+  }
+  ScalarS32ToF32(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx2"))) inline __m256i Avx2ScaleRound(const float* src, __m256 scale,
+                                                              __m256 lo, __m256 hi) {
+  const __m256 v = _mm256_mul_ps(_mm256_loadu_ps(src), scale);
+  return _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(v, lo), hi));
+}
+
+// 16 floats -> 16 int16 in order (packs works per 128-bit lane)
+__attribute__((target("avx2"))) inline __m256i Avx2PackS16(__m256i a, __m256i b) {
+  return _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+__attribute__((target("avx2"))) inline void Avx2F32ToU8(const float* src, uint8_t* dst,
+                                                        size_t count) {
+  const __m256 scale = _mm256_set1_ps(128.0f);
+  const __m256 lo = _mm256_set1_ps(-128.0f);
+  const __m256 hi = _mm256_set1_ps(127.0f);
+  const __m256i bias = _mm256_set1_epi16(0x80);
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m256i s16 = _mm256_add_epi16(Avx2PackS16(Avx2ScaleRound(src + i, scale, lo, hi),
+                                                     Avx2ScaleRound(src + i + 8, scale, lo, hi)),
+                                         bias);
+    const __m128i v =
+        _mm_packus_epi16(_mm256_castsi256_si128(s16), _mm256_extracti128_si256(s16, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+  }
+  ScalarF32ToU8(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx2"))) inline void Avx2F32ToS16(const float* src, int16_t* dst,
+                                                         size_t count) {
+  const __m256 scale = _mm256_set1_ps(32768.0f);
+  const __m256 lo = _mm256_set1_ps(-32768.0f);
+  const __m256 hi = _mm256_set1_ps(32767.0f);
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m256i v = Avx2PackS16(Avx2ScaleRound(src + i, scale, lo, hi),
+                                  Avx2ScaleRound(src + i + 8, scale, lo, hi));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+  }
+  ScalarF32ToS16(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx2"))) inline void Avx2F32ToS32(const float* src, int32_t* dst,
+                                                         size_t count) {
+  const __m256 scale = _mm256_set1_ps(2147483648.0f);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 v = _mm256_mul_ps(_mm256_loadu_ps(src + i), scale);
+    const __m256i overflow = _mm256_castps_si256(_mm256_cmp_ps(v, scale, _CMP_GE_OQ));
+    const __m256i r = _mm256_xor_si256(_mm256_cvtps_epi32(v), overflow);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+  }
+  ScalarF32ToS32(src + i, dst + i, count - i);
+}
+
+// Multiply then add (no FMA) so every implementation rounds alike
+__attribute__((target("avx2"))) inline void Avx2MixAdd(const float* src, float gain, size_t count,
+                                                       float* dst) {
+  const __m256 g = _mm256_set1_ps(gain);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 v = _mm256_mul_ps(_mm256_loadu_ps(src + i), g);
+    _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), v));
+  }
+  ScalarMixAdd(src + i, gain, count - i, dst + i);
+}
+
+}  // namespace detail
+
+inline const Kernels& Avx2Kernels() {
+  static const Kernels kernels{"avx2",
+                               detail::Avx2U8ToF32,
+                               detail::Avx2S16ToF32,
+                               detail::Avx2S32ToF32,
+                               detail::Avx2F32ToU8,
+                               detail::Avx2F32ToS16,
+                               detail::Avx2F32ToS32,
+                               detail::Sse2Interleave32,
+                               detail::Sse2Deinterleave32,
+                               detail::Avx2MixAdd,
+                               detail::Sse2SoftClip};
+  return kernels;
+}
+
+inline bool CpuHasAvx2() { return __builtin_cpu_supports("avx2") != 0; }
+#endif  // WEBCODECS_KERNELS_AVX2
+
+// =============================================================================
+// NEON
+// =============================================================================
+
+#ifdef WEBCODECS_KERNELS_NEON
+namespace detail {
+
+inline void NeonTranspose4(uint32x4_t& r0, uint32x4_t& r1, uint32x4_t& r2, uint32x4_t& r3) {
+  const uint32x4x2_t t01 = vtrnq_u32(r0, r1);  // a0 b0 a2 b2 | a1 b1 a3 b3
+  const uint32x4x2_t t23 = vtrnq_u32(r2, r3);  // c0 d0 c2 d2 | c1 d1 c3 d3
+  r0 = vcombine_u32(vget_low_u32(t01.val[0]), vget_low_u32(t23.val[0]));
+  r1 = vcombine_u32(vget_low_u32(t01.val[1]), vget_low_u32(t23.val[1]));
+  r2 = vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0]));
+  r3 = vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1]));
+}
+
+inline void NeonU8ToF32(const uint8_t* src, float* dst, size_t count) {
+  const int16x8_t bias = vdupq_n_s16(0x80);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const int16x8_t w = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(src + i))), bias);
+    vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(w))), kU8Scale));
+    vst1q_f32(dst + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(w))), kU8Scale));
+  }
+  ScalarU8ToF32(src + i, dst + i, count - i);
+}
+
+inline void NeonS16ToF32(const int16_t* src, float* dst, size_t count) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const int16x8_t v = vld1q_s16(src + i);
+    vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), kS16Scale));
+    vst1q_f32(dst + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), kS16Scale));
+  }
+  ScalarS16ToF32(src + i, dst + i, count - i);
+}
+
+inline void NeonS32ToF32(const int32_t* src, float* dst, size_t count) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(src + i)), kS32Scale));
+  }
+  ScalarS32ToF32(src + i, dst + i, count - i);
+}
+
+// vcvtnq rounds to nearest even and saturates, like lrintf + clip
+inline void NeonF32ToU8(const float* src, uint8_t* dst, size_t count) {
+  // Clamp before adding the bias: saturating to s16 alone lets it overflow
+  const float32x4_t lo = vdupq_n_f32(-128.0f);
+  const float32x4_t hi = vdupq_n_f32(127.0f);
+  const int16x8_t bias = vdupq_n_s16(0x80);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const float32x4_t fa = vminq_f32(vmaxq_f32(vmulq_n_f32(vld1q_f32(src + i), 128.0f), lo), hi);
+    const float32x4_t fb = vminq_f32(vmaxq_f32(vmulq_n_f32(vld1q_f32(src + i + 4), 128.0f), lo), hi);
+    const int16x8_t w = vaddq_s16(vcombine_s16(vmovn_s32(vcvtnq_s32_f32(fa)), vmovn_s32(vcvtnq_s32_f32(fb))), bias);
+    vst1_u8(dst + i, vqmovun_s16(w));
+  }
+  ScalarF32ToU8(src + i, dst + i, count - i);
+}
+
+inline void NeonF32ToS16(const float* src, int16_t* dst, size_t count) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const int32x4_t a = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(src + i), 32768.0f));
+    const int32x4_t b = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(src + i + 4), 32768.0f));
+    vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(a), vqmovn_s32(b)));
+  }
+  ScalarF32ToS16(src + i, dst + i, count - i);
+}
+
+inline void NeonF32ToS32(const float* src, int32_t* dst, size_t count) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    vst1q_s32(dst + i, vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(src + i), 2147483648.0f)));
+  }
+  ScalarF32ToS32(src + i, dst + i, count - i);
+}
+
+inline void NeonInterleave32(const uint32_t* const* planes, int channels, size_t frames,
+                             uint32_t* dst) {
+  size_t i = 0;
+  if (channels == 2) {
+    for (; i + 4 <= frames; i += 4) {
+      const uint32x4x2_t lr = {{vld1q_u32(planes[0] + i), vld1q_u32(planes[1] + i)}};
+      vst2q_u32(dst + i * 2, lr);
+    }
+  } else if (channels % 4 == 0) {
+    for (; i + 4 <= frames; i += 4) {
+      for (int g = 0; g < channels; g += 4) {
+        uint32x4_t r0 = vld1q_u32(planes[g] + i);
+        uint32x4_t r1 = vld1q_u32(planes[g + 1] + i);
+        uint32x4_t r2 = vld1q_u32(planes[g + 2] + i);
+        uint32x4_t r3 = vld1q_u32(planes[g + 3] + i);
+        NeonTranspose4(r0, r1, r2, r3);
+        uint32_t* out = dst + i * channels + g;
+        vst1q_u32(out, r0);
+        vst1q_u32(out + channels, r1);
+        vst1q_u32(out + channels * 2, r2);
+        vst1q_u32(out + channels * 3, r3);
+      }
+    }
+  }
+  if (i == frames) return;
+  std::vector<const uint32_t*> rest(planes, planes + channels);
+  for (auto& plane : rest) plane += i;
+  ScalarInterleave32(rest.data(), channels, frames - i, dst + i * channels);
+}
+
+inline void NeonDeinterleave32(const uint32_t* src, int channels, int channel, size_t frames,
+                               uint32_t* dst) {
+  size_t i = 0;
+  if (channels == 2) {
+    for (; i + 4 <= frames; i += 4) vst1q_u32(dst + i, vld2q_u32(src + i * 2).val[channel]);
+  } else if (channels == 4) {
+    for (; i + 4 <= frames; i += 4) vst1q_u32(dst + i, vld4q_u32(src + i * 4).val[channel]);
+  } else if (channels % 4 == 0) {
+    const int g = channel & ~3;
+    const uint32_t* base = src + g;
+    for (; i + 4 <= frames; i += 4) {
+      const uint32_t* in = base + i * channels;
+      uint32x4_t r[4] = {vld1q_u32(in), vld1q_u32(in + channels), vld1q_u32(in + channels * 2),
+                         vld1q_u32(in + channels * 3)};
+      NeonTranspose4(r[0], r[1], r[2], r[3]);
+      vst1q_u32(dst + i, r[channel - g]);
+    }
+  }
+  ScalarDeinterleave32(src + i * channels, channels, channel, frames - i, dst + i);
+}
+
+inline void NeonMixAdd(const float* src, float gain, size_t count, float* dst) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vmulq_n_f32(vld1q_f32(src + i), gain)));
+  }
+  ScalarMixAdd(src + i, gain, count - i, dst + i);
+}
+
+inline void NeonSoftClip(float* samples, size_t count) {
+  const float32x4_t knee = vdupq_n_f32(kSoftClipKnee);
+  const float32x4_t c27 = vdupq_n_f32(27.0f);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const float32x4_t x = vld1q_f32(samples + i);
+    const float32x4_t a = vabsq_f32(x);
+    const float32x4_t z =
+        vminq_f32(vmulq_n_f32(vsubq_f32(a, knee), kSoftClipInvRange), vdupq_n_f32(3.0f));
+    const float32x4_t z2 = vmulq_f32(z, z);
+    const float32x4_t curve =
+        vdivq_f32(vmulq_f32(z, vaddq_f32(c27, z2)), vaddq_f32(c27, vmulq_n_f32(z2, 9.0f)));
+    const float32x4_t shaped = vaddq_f32(knee, vmulq_n_f32(curve, kSoftClipRange));
+    const float32x4_t r = vbslq_f32(vcleq_f32(a, knee), a, shaped);
+    // Copy the sign bit of x onto r
+    vst1q_f32(samples + i, vbslq_f32(vdupq_n_u32(0x80000000u), x, r));
+  }
+  ScalarSoftClip(samples + i, count - i);
+}
+
+}  // namespace detail
+
+inline const Kernels& NeonKernels() {
+  static const Kernels kernels{"neon",
+                               detail::NeonU8ToF32,
+                               detail::NeonS16ToF32,
+                               detail::NeonS32ToF32,
+                               detail::NeonF32ToU8,
+                               detail::NeonF32ToS16,
+                               detail::NeonF32ToS32,
+                               detail::NeonInterleave32,
+                               detail::NeonDeinterleave32,
+                               detail::NeonMixAdd,
+                               detail::NeonSoftClip};
+  return kernels;
+}
+#endif  // WEBCODECS_KERNELS_NEON
+
+// =============================================================================
+// DISPATCH
+// =============================================================================
+
+/** Every implementation this CPU can run, best last. */
+inline std::vector<const Kernels*> Available() {
+  std::vector<const Kernels*> all{&ScalarKernels()};
+#ifdef WEBCODECS_KERNELS_SSE2
+  all.push_back(&Sse2Kernels());
+#endif
+#ifdef WEBCODECS_KERNELS_AVX2
+  if (CpuHasAvx2()) all.push_back(&Avx2Kernels());
+#endif
+#ifdef WEBCODECS_KERNELS_NEON
+  all.push_back(&NeonKernels());
+#endif
+  return all;
+}
+
+/** Best implementation for this CPU (selected once). */
+inline const Kernels& Get() {
+  static const Kernels* best = Available().back();
+  return *best;
+}
+
+/** true if Convert() handles from -> to. */
+inline bool CanConvert(SampleType from, SampleType to) {
+  return from == to || from == SampleType::kF32 || to == SampleType::kF32;
+}
+
+/**
+ * Convert count samples; from -> to must satisfy CanConvert().
+ */
+inline void Convert(SampleType from, const void* src, SampleType to, void* dst, size_t count,
+                    const Kernels& k = Get()) {
+  if (from == to) {
+    std::memcpy(dst, src, count * SampleSize(from));
+    return;
+  }
+  auto* f32_out = static_cast<float*>(dst);
+  const auto* f32_in = static_cast<const float*>(src);
+  switch (from == SampleType::kF32 ? to : from) {
+    case SampleType::kU8:
+      if (to == SampleType::kF32) {
+        k.u8_to_f32(static_cast<const uint8_t*>(src), f32_out, count);
+      } else {
+        k.f32_to_u8(f32_in, static_cast<uint8_t*>(dst), count);
+      }
+      break;
+    case SampleType::kS16:
+      if (to == SampleType::kF32) {
+        k.s16_to_f32(static_cast<const int16_t*>(src), f32_out, count);
+      } else {
+        k.f32_to_s16(f32_in, static_cast<int16_t*>(dst), count);
+      }
+      break;
+    case SampleType::kS32:
+      if (to == SampleType::kF32) {
+        k.s32_to_f32(static_cast<const int32_t*>(src), f32_out, count);
+      } else {
+        k.f32_to_s32(f32_in, static_cast<int32_t*>(dst), count);
+      }
+      break;
+    case SampleType::kF32:
+      break;
+  }
+}
+
+/**
+ * Interleave frames of channels planes (sample_size bytes per sample).
+ */
+inline void Interleave(const uint8_t* const* planes, int channels, size_t frames,
+                       size_t sample_size, uint8_t* dst, const Kernels& k = Get()) {
+  if (channels == 1) {
+    std::memcpy(dst, planes[0], frames * sample_size);
+    return;
+  }
+  if (sample_size == 4) {
+    k.interleave32(reinterpret_cast<const uint32_t* const*>(planes), channels, frames,
+                   reinterpret_cast<uint32_t*>(dst));
+    return;
+  }
+  for (int ch = 0; ch < channels; ch++) {
+    const uint8_t* plane = planes[ch];
+    uint8_t* out = dst + ch * sample_size;
+    for (size_t i = 0; i < frames; i++) {
+      std::memcpy(out + i * channels * sample_size, plane + i * sample_size, sample_size);
+    }
+  }
+}
+
+/**
+ * Copy one channel of interleaved frames into a plane.
+ */
+inline void Deinterleave(const uint8_t* src, int channels, int channel, size_t frames,
+                         size_t sample_size, uint8_t* dst, const Kernels& k = Get()) {
+  if (channels == 1) {
+    std::memcpy(dst, src, frames * sample_size);
+    return;
+  }
+  if (sample_size == 4) {
+    k.deinterleave32(reinterpret_cast<const uint32_t*>(src), channels, channel, frames,
+                     reinterpret_cast<uint32_t*>(dst));
+    return;
+  }
+  const uint8_t* in = src + channel * sample_size;
+  for (size_t i = 0; i < frames; i++) {
+    std::memcpy(dst + i * sample_size, in + i * channels * sample_size, sample_size);
+  }
+}
+
+/**
+ * dst = sum over channels of gains[ch] * planes[ch], frames f32 samples per
+ * plane. Channels with a zero gain are not read.
+ */
+inline void Mix(const float* const* planes, const float* gains, int channels, size_t frames,
+                float* dst, const Kernels& k = Get()) {
+  int ch = 0;
+  while (ch < channels && gains[ch] == 0.0f) ch++;
+  if (ch < channels && gains[ch] == 1.0f) {
+    std::memcpy(dst, planes[ch++], frames * sizeof(float));
+  } else {
+    std::fill(dst, dst + frames, 0.0f);
+  }
+  for (; ch < channels; ch++) {
+    if (gains[ch] != 0.0f) k.mix_add(planes[ch], gains[ch], frames, dst);
+  }
+}
+
+/**
+ * Limit count f32 samples in place to [-1, 1]; samples within the knee
+ * (|x| <= 0.75) are unchanged.
+ */
+inline void SoftClip(float* samples, size_t count, const Kernels& k = Get()) {
+  k.soft_clip(samples, count);
+}
+
+}  // namespace sample_kernels
+}  // namespace webcodecs
@@ -0,0 +1,137 @@
+#pragma once
+/**
+ * segmented_buffer.h - Append-Only Chunk List for Streamed Input
+ *
+ * Streaming ImageDecoder input arrives as many small chunks (often 16-64KB).
+ * Appending them to one contiguous std::vector reallocates and copies the
+ * accumulated data again and again, and invalidates any pointer into it.
+ * This buffer keeps each chunk as its own segment (a simple rope):
+ *
+ * - Append() moves the chunk in; existing segments never move
+ * - AppendView() adds memory owned elsewhere (a mapped file) without copying
+ * - Read() copies an arbitrary byte range out, spanning segments as needed
+ * - A cursor remembers the last segment read, so sequential reads (the AVIO
+ *   read callback) find their segment in O(1); random access is O(log n)
+ *
+ * Thread Safety:
+ * - Not thread-safe; owned and used by a single worker thread
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace webcodecs {
+
+class SegmentedBuffer {
+ public:
+  SegmentedBuffer() = default;
+
+  // Non-copyable (may hold a whole encoded image), movable
+  SegmentedBuffer(const SegmentedBuffer&) = delete;
+  SegmentedBuffer& operator=(const SegmentedBuffer&) = delete;
+  SegmentedBuffer(SegmentedBuffer&&) = default;
+  SegmentedBuffer& operator=(SegmentedBuffer&&) = default;
+
+  /**
+   * Append a chunk, taking ownership of its storage. Empty chunks are ignored.
+   */
+  void Append(std::vector<uint8_t>&& chunk) {
+    if (chunk.empty()) return;
+    Segment segment;
+    segment.storage = std::move(chunk);
+    segment.data = segment.storage.data();
+    segment.size = segment.storage.size();
+    Push(std::move(segment));
+  }
+
+  /**
+   * Append size bytes at data without copying them. owner keeps the memory
+   * alive for as long as the segment exists.
+   */
+  void AppendView(const uint8_t* data, size_t size, std::shared_ptr<const void> owner) {
+    if (!data || size == 0) return;
+    Segment segment;
+    segment.data = data;
+    segment.size = size;
+    segment.owner = std::move(owner);
+    Push(std::move(segment));
+  }
+
+  /**
+   * Copy up to size bytes starting at position into dst.
+   *
+   * @return Bytes copied (0 at or past the end)
+   */
+  size_t Read(size_t position, uint8_t* dst, size_t size) const {
+    if (position >= size_ || size == 0) return 0;
+
+    size_t segment = FindSegment(position);
+    size_t copied = 0;
+    while (copied < size && segment < segments_.size()) {
+      const Segment& data = segments_[segment];
+      const size_t offset = position + copied - offsets_[segment];
+      const size_t n = std::min(size - copied, data.size - offset);
+      std::memcpy(dst + copied, data.data + offset, n);
+      copied += n;
+      if (offset + n == data.size) segment++;
+    }
+    cursor_ = std::min(segment, segments_.size() - 1);
+    return copied;
+  }
+
+  /**
+   * Byte at position (position must be < size()).
+   */
+  uint8_t At(size_t position) const {
+    const size_t segment = FindSegment(position);
+    cursor_ = segment;
+    return segments_[segment].data[position - offsets_[segment]];
+  }
+
+  void Clear() {
+    segments_.clear();
+    offsets_.clear();
+    size_ = 0;
+    cursor_ = 0;
+  }
+
+  [[nodiscard]] size_t size() const { return size_; }
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  [[nodiscard]] size_t segment_count() const { return segments_.size(); }
+
+ private:
+  struct Segment {
+    std::vector<uint8_t> storage;        // Owned chunk (empty for views)
+    const uint8_t* data = nullptr;       // storage.data() or the viewed memory
+    size_t size = 0;
+    std::shared_ptr<const void> owner;   // Keeps viewed memory alive
+  };
+
+  void Push(Segment&& segment) {
+    offsets_.push_back(size_);
+    size_ += segment.size;
+    segments_.push_back(std::move(segment));
+  }
+
+  // Index of the segment containing position (position < size_)
+  size_t FindSegment(size_t position) const {
+    if (cursor_ < segments_.size() && position >= offsets_[cursor_] &&
+        position < offsets_[cursor_] + segments_[cursor_].size) {
+      return cursor_;
+    }
+    auto it = std::upper_bound(offsets_.begin(), offsets_.end(), position);
+    return static_cast<size_t>(it - offsets_.begin()) - 1;
+  }
+
+  std::vector<Segment> segments_;
+  std::vector<size_t> offsets_;  // Start offset of each segment
+  size_t size_ = 0;
+  mutable size_t cursor_ = 0;  // Segment of the last access
+};
+
+}  // namespace webcodecs
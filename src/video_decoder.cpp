@@ -1,6 +1,8 @@
 #include "video_decoder.h"
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "video_frame.h"
 #include "encoded_video_chunk.h"
@@ -12,6 +14,57 @@ namespace webcodecs {
 
 Napi::FunctionReference VideoDecoder::constructor;
 
+namespace {
+
+// A detached buffer has no memory left to decode into
+bool IsDetachedBuffer(const Napi::Value& value) {
+  if (value.IsArrayBuffer()) return value.As<Napi::ArrayBuffer>().IsDetached();
+  if (value.IsTypedArray()) return value.As<Napi::TypedArray>().ArrayBuffer().IsDetached();
+  if (value.IsDataView()) return value.As<Napi::DataView>().ArrayBuffer().IsDetached();
+  return false;
+}
+
+/**
+ * References to registered JS buffers, owned by their OutputBufferPool.
+ * The pool dies when the last frame written into it is released, which may
+ * happen on any thread (an encoder worker, a decoder that was already
+ * closed, ...), but references may only be deleted on the JS thread: the
+ * destructor hands them over through a TSFN.
+ */
+class OutputBufferRefs {
+ public:
+  using Refs = std::vector<Napi::Reference<Napi::Value>>;
+
+  OutputBufferRefs(Napi::Env env, Refs refs) : refs_(new Refs(std::move(refs))) {
+    Napi::Function noop = Napi::Function::New(env, [](const Napi::CallbackInfo&) {});
+    tsfn_ = ReleaseTSFN::New(env, noop, "VideoDecoder::outputBuffers", 0, 1);
+    tsfn_.Unref(env);  // Must not keep the process alive
+  }
+
+  ~OutputBufferRefs() {
+    // If the call fails the environment is shutting down and takes the
+    // references with it, so they are leaked rather than deleted here
+    tsfn_.NonBlockingCall(refs_.release());
+    tsfn_.Release();
+  }
+
+  OutputBufferRefs(const OutputBufferRefs&) = delete;
+  OutputBufferRefs& operator=(const OutputBufferRefs&) = delete;
+
+ private:
+  static void DeleteRefs(Napi::Env env, Napi::Function /*callback*/, std::nullptr_t* /*context*/, Refs* refs) {
+    // Without an env (TSFN finalized first) the references are already gone
+    if (static_cast<napi_env>(env) != nullptr) delete refs;
+  }
+
+  using ReleaseTSFN = Napi::TypedThreadSafeFunction<std::nullptr_t, Refs, &OutputBufferRefs::DeleteRefs>;
+
+  std::unique_ptr<Refs> refs_;
+  ReleaseTSFN tsfn_;
+};
+
+}  // namespace
+
 // =============================================================================
 // VIDEODECODER IMPLEMENTATION
 // =============================================================================
@@ -25,10 +78,13 @@ Napi::Object VideoDecoder::Init(Napi::Env env, Napi::Object exports) {
                       InstanceAccessor<&VideoDecoder::GetOndequeue, &VideoDecoder::SetOndequeue>("ondequeue"),
                       InstanceMethod<&VideoDecoder::Configure>("configure"),
                       InstanceMethod<&VideoDecoder::Decode>("decode"),
+                      InstanceMethod<&VideoDecoder::DecodeBatch>("decodeBatch"),
                       InstanceMethod<&VideoDecoder::Flush>("flush"),
                       InstanceMethod<&VideoDecoder::Reset>("reset"),
                       InstanceMethod<&VideoDecoder::Close>("close"),
+                      InstanceMethod<&VideoDecoder::RegisterOutputBuffers>("registerOutputBuffers"),
                       StaticMethod<&VideoDecoder::IsConfigSupported>("isConfigSupported"),
+                      StaticMethod<&CodecContextCacheMethod>("codecContextCache"),
                   });
 
   constructor = Napi::Persistent(func);
@@ -82,10 +138,17 @@ void VideoDecoder::Release() {
   // Thread-safe close: transition to Closed state
   state_.Close();
 
-  // Stop the worker thread first
+  // Wake a worker waiting for a free output buffer, then stop it
+  {
+    std::lock_guard<std::mutex> lock(output_buffers_mutex_);
+    if (output_buffers_) output_buffers_->Interrupt();
+  }
   if (worker_) {
     worker_->Stop();
   }
+  // Frames already handed out (to JS, or queued in an encoder) keep the
+  // pool, and with it the buffer references, alive after this
+  ClearOutputBuffers();
 
   // Shutdown the queue
   queue_.Shutdown();
@@ -343,6 +406,67 @@ Napi::Value VideoDecoder::Configure(const Napi::CallbackInfo& info) {
     active_config_.optimize_for_latency = config.Get("optimizeForLatency").As<Napi::Boolean>().Value();
   }
 
+  // Non-standard fast-decode hints
+  active_config_.skip_frames = "none";
+  active_config_.skip_loop_filter = false;
+  active_config_.lowres = 0;
+  if (config.Has("skipFrames") && config.Get("skipFrames").IsString()) {
+    std::string skip = config.Get("skipFrames").As<Napi::String>().Utf8Value();
+    if (skip != "none" && skip != "nonref" && skip != "nonkey") {
+      errors::ThrowTypeError(env, "skipFrames must be \"none\", \"nonref\" or \"nonkey\"");
+      return env.Undefined();
+    }
+    active_config_.skip_frames = skip;
+  }
+  if (config.Has("skipLoopFilter") && config.Get("skipLoopFilter").IsBoolean()) {
+    active_config_.skip_loop_filter = config.Get("skipLoopFilter").As<Napi::Boolean>().Value();
+  }
+  if (config.Has("lowres") && config.Get("lowres").IsNumber()) {
+    int lowres = config.Get("lowres").As<Napi::Number>().Int32Value();
+    if (lowres < 0 || lowres > 3) {
+      errors::ThrowTypeError(env, "lowres must be between 0 and 3");
+      return env.Undefined();
+    }
+    active_config_.lowres = lowres;
+  }
+
+  // Non-standard: convert/scale on the worker (outputFormat, outputSize)
+  active_config_.output_format.clear();
+  active_config_.output_width = 0;
+  active_config_.output_height = 0;
+  if (config.Has("outputFormat") && config.Get("outputFormat").IsString()) {
+    std::string format = config.Get("outputFormat").As<Napi::String>().Utf8Value();
+    if (format_converter::WebCodecsToFFmpeg(format) == AV_PIX_FMT_NONE) {
+      errors::ThrowTypeError(env, "Unsupported outputFormat: " + format);
+      return env.Undefined();
+    }
+    active_config_.output_format = format;
+  }
+  if (config.Has("outputSize") && config.Get("outputSize").IsObject()) {
+    Napi::Object size = config.Get("outputSize").As<Napi::Object>();
+    if (!size.Get("width").IsNumber() || !size.Get("height").IsNumber()) {
+      errors::ThrowTypeError(env, "outputSize requires numeric width and height");
+      return env.Undefined();
+    }
+    int width = size.Get("width").As<Napi::Number>().Int32Value();
+    int height = size.Get("height").As<Napi::Number>().Int32Value();
+    if (width <= 0 || height <= 0 || width > 16384 || height > 16384) {
+      errors::ThrowTypeError(env, "outputSize width and height must be between 1 and 16384");
+      return env.Undefined();
+    }
+    active_config_.output_width = width;
+    active_config_.output_height = height;
+  }
+
+  // Registered output buffers only survive a reconfigure with the same layout
+  if (output_buffers_ &&
+      (active_config_.output_format.empty() || active_config_.output_width == 0 ||
+       active_config_.output_height == 0 ||
+       !output_buffers_->Matches(format_converter::WebCodecsToFFmpeg(active_config_.output_format),
+                                 active_config_.output_width, active_config_.output_height))) {
+    ClearOutputBuffers();
+  }
+
   // Validate codec string before queuing (fail fast)
   auto codec_info = ParseCodecString(active_config_.codec);
   if (!codec_info) {
@@ -396,62 +520,135 @@ Napi::Value VideoDecoder::Decode(const Napi::CallbackInfo& info) {
     return env.Undefined();
   }
 
+  VideoControlQueue::DecodeMessage msg;
+  if (!BuildDecodeMessage(env, info.Length() > 0 ? info[0] : env.Undefined(), &msg)) {
+    return env.Undefined();
+  }
+
+  // [SPEC] 3. Increment decodeQueueSize
+  decode_queue_size_.fetch_add(1, std::memory_order_relaxed);
+
+  // Enqueue decode message
+  if (!queue_.Enqueue(std::move(msg))) {
+    decode_queue_size_.fetch_sub(1, std::memory_order_relaxed);
+    errors::ThrowInvalidStateError(env, "Failed to enqueue decode");
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value VideoDecoder::DecodeBatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  // Non-standard: decode() for each element, enqueued under one lock/notify
+  if (!state_.IsConfigured()) {
+    errors::ThrowInvalidStateError(env, "decodeBatch called on " + std::string(state_.ToString()) + " decoder");
+    return env.Undefined();
+  }
+
+  if (info.Length() < 1 || !info[0].IsArray()) {
+    errors::ThrowTypeError(env, "decodeBatch requires an array of EncodedVideoChunk");
+    return env.Undefined();
+  }
+
+  Napi::Array chunks = info[0].As<Napi::Array>();
+  uint32_t length = chunks.Length();
+  std::vector<VideoControlQueue::Message> messages;
+  messages.reserve(length);
+  for (uint32_t i = 0; i < length; i++) {
+    VideoControlQueue::DecodeMessage msg;
+    if (!BuildDecodeMessage(env, chunks.Get(i), &msg)) {
+      // Same as decode() in a loop: earlier chunks stay queued, the error propagates
+      break;
+    }
+    messages.emplace_back(std::move(msg));
+  }
+
+  uint32_t count = static_cast<uint32_t>(messages.size());
+  decode_queue_size_.fetch_add(count, std::memory_order_relaxed);
+  if (!queue_.EnqueueBatch(messages)) {
+    decode_queue_size_.fetch_sub(count, std::memory_order_relaxed);
+    if (!env.IsExceptionPending()) {
+      errors::ThrowInvalidStateError(env, "Failed to enqueue decode");
+    }
+  }
+
+  return env.Undefined();
+}
+
+bool VideoDecoder::BuildDecodeMessage(Napi::Env env, const Napi::Value& value,
+                                      VideoControlQueue::DecodeMessage* msg) {
   // Validate chunk argument
-  if (info.Length() < 1 || !info[0].IsObject()) {
+  if (!value.IsObject()) {
     errors::ThrowTypeError(env, "EncodedVideoChunk is required");
-    return env.Undefined();
+    return false;
   }
 
-  Napi::Object chunk = info[0].As<Napi::Object>();
+  Napi::Object chunk = value.As<Napi::Object>();
+
+  // Native chunks carry type, timestamp and a refcounted packet, so they skip
+  // the property lookups and the data copy that plain objects need
+  EncodedVideoChunk* enc = nullptr;
+  if (chunk.InstanceOf(EncodedVideoChunk::constructor.Value())) {
+    enc = Napi::ObjectWrap<EncodedVideoChunk>::Unwrap(chunk);
+  }
 
   // Get chunk type
-  std::string chunk_type;
-  if (chunk.Has("type") && chunk.Get("type").IsString()) {
-    chunk_type = chunk.Get("type").As<Napi::String>().Utf8Value();
+  bool is_key = false;
+  if (enc) {
+    is_key = enc->is_key();
+  } else if (chunk.Has("type") && chunk.Get("type").IsString()) {
+    is_key = chunk.Get("type").As<Napi::String>().Utf8Value() == "key";
   }
 
   // [SPEC] 2. If key chunk required is true, check for key frame
   if (key_chunk_required_.load(std::memory_order_acquire)) {
-    if (chunk_type != "key") {
+    if (!is_key) {
       errors::ThrowDataError(env, "A key frame is required");
-      return env.Undefined();
+      return false;
     }
     key_chunk_required_.store(false, std::memory_order_release);
   }
 
-  // Get chunk data - support both EncodedVideoChunk wrapper and plain objects
-  const uint8_t* data = nullptr;
-  size_t size = 0;
-
-  // Try to get data from EncodedVideoChunk wrapper
-  if (chunk.InstanceOf(EncodedVideoChunk::constructor.Value())) {
-    EncodedVideoChunk* enc = Napi::ObjectWrap<EncodedVideoChunk>::Unwrap(chunk);
+  raii::AVPacketPtr packet;
+  int64_t timestamp = 0;
+  if (enc) {
     const AVPacket* pkt = enc->packet();
     if (pkt && pkt->data && pkt->size > 0) {
-      data = pkt->data;
-      size = static_cast<size_t>(pkt->size);
+      // Chunks are immutable, so the decode message can share the buffer
+      packet = raii::CloneAvPacket(pkt);
+      if (!packet) {
+        errors::ThrowEncodingError(env, "Failed to create packet");
+        return false;
+      }
     }
-  } else if (chunk.Has("data")) {
+    timestamp = enc->timestamp();
+  } else {
     // Plain object with data property
-    buffer_utils::ExtractBufferData(chunk.Get("data"), &data, &size);
-  }
-
-  if (!data || size == 0) {
-    errors::ThrowTypeError(env, "Chunk data is required");
-    return env.Undefined();
-  }
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    if (chunk.Has("data")) {
+      buffer_utils::ExtractBufferData(chunk.Get("data"), &data, &size);
+    }
+    if (data && size > 0) {
+      // Create AVPacket from data (deep copy for async processing)
+      packet = buffer_utils::CreatePacketFromBuffer(data, size);
+      if (!packet) {
+        errors::ThrowEncodingError(env, "Failed to create packet");
+        return false;
+      }
+    }
 
-  // Get timestamp (microseconds)
-  int64_t timestamp = 0;
-  if (chunk.Has("timestamp") && chunk.Get("timestamp").IsNumber()) {
-    timestamp = chunk.Get("timestamp").As<Napi::Number>().Int64Value();
+    // Get timestamp (microseconds)
+    if (chunk.Has("timestamp") && chunk.Get("timestamp").IsNumber()) {
+      timestamp = chunk.Get("timestamp").As<Napi::Number>().Int64Value();
+    }
   }
 
-  // Create AVPacket from data (deep copy for async processing)
-  raii::AVPacketPtr packet = buffer_utils::CreatePacketFromBuffer(data, size);
   if (!packet) {
-    errors::ThrowEncodingError(env, "Failed to create packet");
-    return env.Undefined();
+    errors::ThrowTypeError(env, "Chunk data is required");
+    return false;
   }
 
   // Set packet timestamp
@@ -459,22 +656,14 @@ Napi::Value VideoDecoder::Decode(const Napi::CallbackInfo& info) {
   packet->dts = timestamp;
 
   // Set key frame flag
-  if (chunk_type == "key") {
+  if (is_key) {
     packet->flags |= AV_PKT_FLAG_KEY;
+  } else {
+    packet->flags &= ~AV_PKT_FLAG_KEY;
   }
 
-  // [SPEC] 3. Increment decodeQueueSize
-  decode_queue_size_.fetch_add(1, std::memory_order_relaxed);
-
-  // Enqueue decode message
-  VideoControlQueue::DecodeMessage msg{std::move(packet)};
-  if (!queue_.Enqueue(std::move(msg))) {
-    decode_queue_size_.fetch_sub(1, std::memory_order_relaxed);
-    errors::ThrowInvalidStateError(env, "Failed to enqueue decode");
-    return env.Undefined();
-  }
-
-  return env.Undefined();
+  msg->packet = std::move(packet);
+  return true;
 }
 
 Napi::Value VideoDecoder::Flush(const Napi::CallbackInfo& info) {
@@ -552,6 +741,12 @@ Napi::Value VideoDecoder::Reset(const Napi::CallbackInfo& info) {
   // Reset key chunk requirement
   key_chunk_required_.store(true, std::memory_order_release);
 
+  // Abort a decode that is waiting for a free output buffer
+  {
+    std::lock_guard<std::mutex> lock(output_buffers_mutex_);
+    if (output_buffers_) output_buffers_->Interrupt();
+  }
+
   // Reject all pending flush promises
   {
     std::lock_guard<std::mutex> lock(flush_mutex_);
@@ -581,6 +776,113 @@ Napi::Value VideoDecoder::Close(const Napi::CallbackInfo& info) {
   return env.Undefined();
 }
 
+Napi::Value VideoDecoder::RegisterOutputBuffers(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (state_.IsClosed()) {
+    errors::ThrowInvalidStateError(env, "registerOutputBuffers called on closed decoder");
+    return env.Undefined();
+  }
+  if (info.Length() < 1 || !info[0].IsArray()) {
+    errors::ThrowTypeError(env, "registerOutputBuffers requires an array of buffers");
+    return env.Undefined();
+  }
+
+  Napi::Array buffers = info[0].As<Napi::Array>();
+  if (buffers.Length() == 0) {
+    // Empty array unregisters; frames already output keep their buffers
+    ClearOutputBuffers();
+    return env.Undefined();
+  }
+
+  // The buffer layout is the configured worker-side output
+  if (!state_.IsConfigured() || active_config_.output_format.empty() ||
+      active_config_.output_width == 0 || active_config_.output_height == 0) {
+    errors::ThrowInvalidStateError(
+        env, "registerOutputBuffers requires a decoder configured with outputFormat and outputSize");
+    return env.Undefined();
+  }
+
+  AVPixelFormat format = format_converter::WebCodecsToFFmpeg(active_config_.output_format);
+  int width = active_config_.output_width;
+  int height = active_config_.output_height;
+  int required = OutputBufferPool::RequiredSize(format, width, height);
+  if (required < 0) {
+    errors::ThrowNotSupportedError(env, "Unsupported output buffer layout");
+    return env.Undefined();
+  }
+
+  auto pool = std::make_shared<OutputBufferPool>(format, width, height);
+  std::vector<Napi::Reference<Napi::Value>> refs;
+  refs.reserve(buffers.Length());
+  for (uint32_t i = 0; i < buffers.Length(); i++) {
+    Napi::Value value = buffers.Get(i);
+    uint8_t* data = nullptr;
+    size_t size = 0;
+    // Views also cover SharedArrayBuffer-backed memory
+    if (IsDetachedBuffer(value)) {
+      errors::ThrowTypeError(env, "registerOutputBuffers: buffer " + std::to_string(i) + " is detached");
+      return env.Undefined();
+    }
+    if (value.IsArrayBuffer()) {
+      Napi::ArrayBuffer buffer = value.As<Napi::ArrayBuffer>();
+      data = static_cast<uint8_t*>(buffer.Data());
+      size = buffer.ByteLength();
+    } else if (value.IsTypedArray()) {
+      Napi::TypedArray view = value.As<Napi::TypedArray>();
+      data = static_cast<uint8_t*>(view.ArrayBuffer().Data()) + view.ByteOffset();
+      size = view.ByteLength();
+    } else if (value.IsDataView()) {
+      Napi::DataView view = value.As<Napi::DataView>();
+      data = static_cast<uint8_t*>(view.ArrayBuffer().Data()) + view.ByteOffset();
+      size = view.ByteLength();
+    } else {
+      errors::ThrowTypeError(env, "registerOutputBuffers: buffer " + std::to_string(i) +
+                                      " must be an ArrayBuffer or ArrayBufferView");
+      return env.Undefined();
+    }
+    if (!data || size < static_cast<size_t>(required)) {
+      errors::ThrowTypeError(env, "registerOutputBuffers: buffer " + std::to_string(i) +
+                                      " is smaller than the " + std::to_string(required) +
+                                      " bytes required per frame");
+      return env.Undefined();
+    }
+    if (pool->IndexOf(data) >= 0) {
+      errors::ThrowTypeError(env, "registerOutputBuffers: buffer " + std::to_string(i) +
+                                      " is registered twice");
+      return env.Undefined();
+    }
+    pool->AddBuffer(data, static_cast<size_t>(required));
+    refs.push_back(Napi::Persistent(value));
+  }
+  // Every frame written into these buffers holds the pool, so the buffers
+  // stay reachable until the last of them is released, wherever it went
+  pool->SetKeepAlive(std::make_shared<OutputBufferRefs>(env, std::move(refs)));
+
+  ClearOutputBuffers();
+  {
+    std::lock_guard<std::mutex> lock(output_buffers_mutex_);
+    output_buffers_ = std::move(pool);
+  }
+  return env.Undefined();
+}
+
+std::shared_ptr<OutputBufferPool> VideoDecoder::GetOutputBuffers() {
+  std::lock_guard<std::mutex> lock(output_buffers_mutex_);
+  return output_buffers_;
+}
+
+void VideoDecoder::ClearOutputBuffers() {
+  std::shared_ptr<OutputBufferPool> pool;
+  {
+    std::lock_guard<std::mutex> lock(output_buffers_mutex_);
+    pool = std::move(output_buffers_);
+  }
+  // Frames still queued for output, and a worker mid-conversion, share the
+  // pool: it (and its buffer references) is freed when the last one lets go
+  if (pool) pool->Close();
+}
+
 Napi::Value VideoDecoder::IsConfigSupported(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
 
@@ -605,8 +907,18 @@ Napi::Value VideoDecoder::IsConfigSupported(const Napi::CallbackInfo& info) {
   // [SPEC] 2. Create promise
   Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
 
-  // Check if codec is supported
-  bool supported = IsCodecSupported(codec_string);
+  // Answer from the process-wide capability table (no libavcodec calls after
+  // the first lookup of a codec)
+  int coded_width = 0;
+  int coded_height = 0;
+  if (config.Has("codedWidth") && config.Get("codedWidth").IsNumber()) {
+    coded_width = config.Get("codedWidth").As<Napi::Number>().Int32Value();
+  }
+  if (config.Has("codedHeight") && config.Get("codedHeight").IsNumber()) {
+    coded_height = config.Get("codedHeight").As<Napi::Number>().Int32Value();
+  }
+  auto lookup = LookupCodecString(codec_string);
+  bool supported = lookup && lookup->capabilities->SupportsDecode(coded_width, coded_height);
 
   // [SPEC] Create VideoDecoderSupport object
   Napi::Object result = Napi::Object::New(env);
@@ -631,6 +943,21 @@ Napi::Value VideoDecoder::IsConfigSupported(const Napi::CallbackInfo& info) {
   if (config.Has("optimizeForLatency") && config.Get("optimizeForLatency").IsBoolean()) {
     clonedConfig.Set("optimizeForLatency", config.Get("optimizeForLatency"));
   }
+  if (config.Has("skipFrames") && config.Get("skipFrames").IsString()) {
+    clonedConfig.Set("skipFrames", config.Get("skipFrames"));
+  }
+  if (config.Has("skipLoopFilter") && config.Get("skipLoopFilter").IsBoolean()) {
+    clonedConfig.Set("skipLoopFilter", config.Get("skipLoopFilter"));
+  }
+  if (config.Has("lowres") && config.Get("lowres").IsNumber()) {
+    clonedConfig.Set("lowres", config.Get("lowres"));
+  }
+  if (config.Has("outputFormat") && config.Get("outputFormat").IsString()) {
+    clonedConfig.Set("outputFormat", config.Get("outputFormat"));
+  }
+  if (config.Has("outputSize") && config.Get("outputSize").IsObject()) {
+    clonedConfig.Set("outputSize", config.Get("outputSize"));
+  }
 
   result.Set("config", clonedConfig);
 
@@ -700,6 +1027,13 @@ VideoDecoderWorker::VideoDecoderWorker(VideoControlQueue& queue, VideoDecoder* d
 
 VideoDecoderWorker::~VideoDecoderWorker() {
   Stop();
+  ReleaseCodecContext();
+}
+
+void VideoDecoderWorker::ReleaseCodecContext() {
+  if (codec_ctx_) {
+    GlobalCodecContextCache::Instance().Put(codec_key_, std::move(codec_ctx_));
+  }
 }
 
 bool VideoDecoderWorker::OnConfigure(const ConfigureMessage& msg) {
@@ -728,44 +1062,84 @@ bool VideoDecoderWorker::OnConfigure(const ConfigureMessage& msg) {
     return false;
   }
 
-  // Allocate codec context
-  codec_ctx_ = raii::MakeAvCodecContext(decoder);
-  if (!codec_ctx_) {
-    OutputError(AVERROR(ENOMEM), "Failed to allocate codec context");
-    return false;
-  }
+  // Return the previous context to the warm cache before replacing it
+  ReleaseCodecContext();
+
+  // Everything fixed by avcodec_open2() identifies a reusable context
+  CodecContextKey key;
+  key.codec = decoder;
+  key.width = config.coded_width;
+  key.height = config.coded_height;
+  // Decoders without lowres support (max_lowres == 0) decode at full size
+  key.lowres = std::min(config.lowres, static_cast<int>(decoder->max_lowres));
+  key.thread_count = 0;  // Auto-detect
+  key.thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+  key.SetExtradata(config.description.data(), config.description.size());
+
+  if (config.coded_width > 0) width_ = config.coded_width;
+  if (config.coded_height > 0) height_ = config.coded_height;
+
+  // Adopt a flushed context from an earlier configure() when one matches
+  codec_ctx_ = GlobalCodecContextCache::Instance().Take(key);
+  const bool warm = codec_ctx_ != nullptr;
+
+  if (!warm) {
+    // Allocate codec context
+    codec_ctx_ = raii::MakeAvCodecContext(decoder);
+    if (!codec_ctx_) {
+      OutputError(AVERROR(ENOMEM), "Failed to allocate codec context");
+      return false;
+    }
 
-  // Set codec parameters
-  if (config.coded_width > 0) {
-    codec_ctx_->width = config.coded_width;
-    width_ = config.coded_width;
-  }
-  if (config.coded_height > 0) {
-    codec_ctx_->height = config.coded_height;
-    height_ = config.coded_height;
+    // Set codec parameters
+    if (config.coded_width > 0) codec_ctx_->width = config.coded_width;
+    if (config.coded_height > 0) codec_ctx_->height = config.coded_height;
+
+    // Handle description (extradata)
+    if (!config.description.empty()) {
+      codec_ctx_->extradata = static_cast<uint8_t*>(
+          av_mallocz(config.description.size() + AV_INPUT_BUFFER_PADDING_SIZE));
+      if (codec_ctx_->extradata) {
+        std::memcpy(codec_ctx_->extradata, config.description.data(), config.description.size());
+        codec_ctx_->extradata_size = static_cast<int>(config.description.size());
+      }
+    }
+
+    // Set threading model
+    codec_ctx_->thread_count = key.thread_count;
+    codec_ctx_->thread_type = key.thread_type;
+    codec_ctx_->lowres = key.lowres;
   }
 
-  // Handle description (extradata)
-  if (!config.description.empty()) {
-    codec_ctx_->extradata = static_cast<uint8_t*>(
-        av_mallocz(config.description.size() + AV_INPUT_BUFFER_PADDING_SIZE));
-    if (codec_ctx_->extradata) {
-      std::memcpy(codec_ctx_->extradata, config.description.data(), config.description.size());
-      codec_ctx_->extradata_size = static_cast<int>(config.description.size());
-    }
+  // Fast-decode hints: discarded frames never reach the output callback, the
+  // rest keep their packet timestamps. Always assigned, since a warm context
+  // still carries the previous configuration's values.
+  skip_non_key_ = config.skip_frames == "nonkey";
+  if (skip_non_key_) {
+    codec_ctx_->skip_frame = AVDISCARD_NONKEY;
+  } else if (config.skip_frames == "nonref") {
+    codec_ctx_->skip_frame = AVDISCARD_NONREF;
+  } else {
+    codec_ctx_->skip_frame = AVDISCARD_DEFAULT;
   }
+  codec_ctx_->skip_loop_filter = config.skip_loop_filter ? AVDISCARD_ALL : AVDISCARD_DEFAULT;
 
-  // Set threading model
-  codec_ctx_->thread_count = 0;  // Auto-detect
-  codec_ctx_->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+  // Worker-side output conversion
+  output_format_ = config.output_format.empty() ? AV_PIX_FMT_NONE
+                                                : format_converter::WebCodecsToFFmpeg(config.output_format);
+  output_width_ = config.output_width;
+  output_height_ = config.output_height;
 
   // Open codec
-  int ret = avcodec_open2(codec_ctx_.get(), decoder, nullptr);
-  if (ret < 0) {
-    OutputError(ret, "Failed to open decoder");
-    codec_ctx_.reset();
-    return false;
+  if (!warm) {
+    int ret = avcodec_open2(codec_ctx_.get(), decoder, nullptr);
+    if (ret < 0) {
+      OutputError(ret, "Failed to open decoder");
+      codec_ctx_.reset();
+      return false;
+    }
   }
+  codec_key_ = key;
 
   // Set key chunk required
   key_chunk_required_.store(true, std::memory_order_release);
@@ -777,6 +1151,16 @@ bool VideoDecoderWorker::OnConfigure(const ConfigureMessage& msg) {
 void VideoDecoderWorker::OnDecode(const DecodeMessage& msg) {
   if (!codec_ctx_ || ShouldExit()) return;
 
+  // skipFrames "nonkey": delta packets would be discarded by the decoder
+  // anyway, so skip sending them (saves bitstream parsing and thread hand-off)
+  if (skip_non_key_ && msg.packet && !(msg.packet->flags & AV_PKT_FLAG_KEY)) {
+    if (decoder_) {
+      uint32_t new_size = decoder_->decode_queue_size_.fetch_sub(1, std::memory_order_relaxed) - 1;
+      SignalDequeue(new_size);
+    }
+    return;
+  }
+
   // Send packet to decoder
   int ret = avcodec_send_packet(codec_ctx_.get(), msg.packet.get());
 
@@ -822,8 +1206,8 @@ void VideoDecoderWorker::OnDecode(const DecodeMessage& msg) {
       height_ = frame->height;
     }
 
-    // Clone frame for output (original stays in decoder)
-    raii::AVFramePtr output_frame = raii::CloneAvFrame(frame.get());
+    // Clone (or convert) frame for output (original stays in decoder)
+    raii::AVFramePtr output_frame = PrepareOutputFrame(frame.get());
     if (output_frame) {
       OutputFrame(std::move(output_frame));
     }
@@ -878,8 +1262,8 @@ void VideoDecoderWorker::OnFlush(const FlushMessage& msg) {
       return;
     }
 
-    // Clone and output frame
-    raii::AVFramePtr output_frame = raii::CloneAvFrame(frame.get());
+    // Clone (or convert) and output frame
+    raii::AVFramePtr output_frame = PrepareOutputFrame(frame.get());
     if (output_frame) {
       OutputFrame(std::move(output_frame));
     }
@@ -894,6 +1278,49 @@ void VideoDecoderWorker::OnFlush(const FlushMessage& msg) {
   FlushComplete(msg.promise_id, true, "");
 }
 
+raii::AVFramePtr VideoDecoderWorker::PrepareOutputFrame(const AVFrame* frame) {
+  AVPixelFormat dst_format = output_format_ != AV_PIX_FMT_NONE ? output_format_
+                                                               : static_cast<AVPixelFormat>(frame->format);
+  int dst_width = output_width_ > 0 ? output_width_ : frame->width;
+  int dst_height = output_height_ > 0 ? output_height_ : frame->height;
+
+  // BYOB decode: write straight into the next free registered buffer
+  std::shared_ptr<OutputBufferPool> pool = decoder_->GetOutputBuffers();
+  while (pool && pool->Matches(dst_format, dst_width, dst_height)) {
+    raii::AVFramePtr output = pool->Acquire([this] { return ShouldExit(); });
+    if (!output) {
+      // Re-registration retired this pool: continue with its replacement
+      std::shared_ptr<OutputBufferPool> current = decoder_->GetOutputBuffers();
+      if (current == pool || ShouldExit()) {
+        return nullptr;  // Interrupted by reset/close - drop frame
+      }
+      pool = std::move(current);
+      continue;
+    }
+    int ret = output_converter_.ScaleInto(frame, dst_format, dst_width, dst_height, output->data,
+                                          output->linesize);
+    if (ret < 0) {
+      OutputError(ret, "Failed to write decoded frame into output buffer: " +
+                           errors::FfmpegErrorString(ret));
+      return nullptr;
+    }
+    format_converter::FormatConverter::CopyFrameProps(frame, output.get());
+    return output;
+  }
+
+  if (dst_format == frame->format && dst_width == frame->width && dst_height == frame->height) {
+    return raii::CloneAvFrame(frame);
+  }
+
+  // Convert/scale here so the JS thread receives ready-to-use pixels
+  raii::AVFramePtr converted =
+      output_converter_.ConvertScaled(frame, dst_format, output_width_, output_height_);
+  if (!converted) {
+    OutputError(AVERROR(EINVAL), "Failed to convert decoded frame to requested output format");
+  }
+  return converted;
+}
+
 void VideoDecoderWorker::OnReset() {
   if (codec_ctx_) {
     avcodec_flush_buffers(codec_ctx_.get());
@@ -902,7 +1329,7 @@ void VideoDecoderWorker::OnReset() {
 }
 
 void VideoDecoderWorker::OnClose() {
-  codec_ctx_.reset();
+  ReleaseCodecContext();
 }
 
 }  // namespace webcodecs
@@ -8,6 +8,9 @@
 #include "shared/codec_worker.h"
 #include "shared/safe_tsfn.h"
 #include "shared/frame_pool.h"
+#include "shared/codec_context_cache.h"
+#include "shared/format_converter.h"
+#include "shared/output_buffer_pool.h"
 #include "ffmpeg_raii.h"
 
 namespace webcodecs {
@@ -131,9 +134,28 @@ class VideoDecoder : public Napi::ObjectWrap<VideoDecoder> {
     std::vector<uint8_t> description;
     std::string hardware_acceleration;
     bool optimize_for_latency = false;
+    // Non-standard fast-decode hints (thumbnailing / scene detection)
+    std::string skip_frames;        // "none", "nonref" or "nonkey"
+    bool skip_loop_filter = false;  // Skip deblocking on decoded frames
+    int lowres = 0;                 // Downscale by 2^lowres where the decoder supports it
+    // Non-standard worker-side conversion before output
+    std::string output_format;      // VideoPixelFormat, empty = decoder native
+    int output_width = 0;           // 0 = decoded width
+    int output_height = 0;          // 0 = decoded height
   };
   DecoderConfig active_config_;
 
+  // --- Registered Output Buffers (BYOB decode) ---
+  // Pool is shared with the worker and every frame written into it; it owns
+  // the references to the JS buffers (released on the JS thread)
+  std::shared_ptr<OutputBufferPool> output_buffers_;
+  std::mutex output_buffers_mutex_;
+
+  // Worker-side access to the current pool (may be null)
+  std::shared_ptr<OutputBufferPool> GetOutputBuffers();
+  // Retire the current pool (JS thread)
+  void ClearOutputBuffers();
+
   // Attributes
   Napi::Value GetState(const Napi::CallbackInfo& info);
   Napi::Value GetDecodeQueueSize(const Napi::CallbackInfo& info);
@@ -143,14 +165,18 @@ class VideoDecoder : public Napi::ObjectWrap<VideoDecoder> {
   // Methods
   Napi::Value Configure(const Napi::CallbackInfo& info);
   Napi::Value Decode(const Napi::CallbackInfo& info);
+  Napi::Value DecodeBatch(const Napi::CallbackInfo& info);
   Napi::Value Flush(const Napi::CallbackInfo& info);
   Napi::Value Reset(const Napi::CallbackInfo& info);
   Napi::Value Close(const Napi::CallbackInfo& info);
+  Napi::Value RegisterOutputBuffers(const Napi::CallbackInfo& info);
   static Napi::Value IsConfigSupported(const Napi::CallbackInfo& info);
 
   // --- Internal Helpers ---
   void InitializeTSFNs(Napi::Env env);
   void ReleaseTSFNs();
+  // Validate one chunk and build its decode message; throws and returns false on error
+  bool BuildDecodeMessage(Napi::Env env, const Napi::Value& value, VideoControlQueue::DecodeMessage* msg);
 
   // Friend class for worker access
   friend class VideoDecoderWorker;
@@ -186,6 +212,10 @@ class VideoDecoderWorker : public CodecWorker<VideoControlQueue> {
 
   // --- FFmpeg Resources (owned by worker thread) ---
   raii::AVCodecContextPtr codec_ctx_;
+  CodecContextKey codec_key_;  // Identifies codec_ctx_ in the warm context cache
+
+  // Hand codec_ctx_ to the warm context cache (configure/close/destruction)
+  void ReleaseCodecContext();
 
   // --- Frame Pool Handle ---
   FramePoolHandle frame_pool_;
@@ -197,6 +227,17 @@ class VideoDecoderWorker : public CodecWorker<VideoControlQueue> {
   int width_ = 0;
   int height_ = 0;
   AVPixelFormat format_ = AV_PIX_FMT_NONE;
+  bool skip_non_key_ = false;  // skipFrames "nonkey": drop delta packets before decoding
+
+  // --- Output Conversion (outputFormat / outputSize) ---
+  format_converter::FormatConverter output_converter_;  // Cached SwsContext
+  AVPixelFormat output_format_ = AV_PIX_FMT_NONE;       // NONE = keep decoder format
+  int output_width_ = 0;
+  int output_height_ = 0;
+
+  // Clone or convert a decoded frame for delivery to JS; writes into a
+  // registered output buffer when one matches the output layout
+  raii::AVFramePtr PrepareOutputFrame(const AVFrame* frame);
 };
 
 }  // namespace webcodecs
@@ -1,7 +1,13 @@
 #include "video_encoder.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <cstring>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "video_frame.h"
 #include "encoded_video_chunk.h"
@@ -13,6 +19,37 @@ namespace webcodecs {
 
 Napi::FunctionReference VideoEncoder::constructor;
 
+// Upper bound of the non-standard encoderSpeed hint
+static constexpr int kMaxEncoderSpeed = 10;
+
+// Quantizer used until the first per-frame value arrives in bitrateMode "quantizer"
+static constexpr int kDefaultQuantizer = 28;
+
+/**
+ * Codec registry encode-options key carrying the per-frame quantizer.
+ *
+ * Only codecs whose encoders can change the quantizer between frames have
+ * one: libvpx and libaom read their quantizer range once at open, so the
+ * av1/vp9 extensions are not offered and bitrateMode "quantizer" is
+ * unsupported for them.
+ *
+ * @param codec_id Configured codec
+ * @param[out] max_quantizer Largest valid quantizer for the codec
+ * @return "avc", "hevc", or nullptr if bitrateMode "quantizer" is unsupported
+ */
+static const char* QuantizerExtensionKey(AVCodecID codec_id, int* max_quantizer) {
+  switch (codec_id) {
+    case AV_CODEC_ID_H264:
+      *max_quantizer = 51;
+      return "avc";
+    case AV_CODEC_ID_HEVC:
+      *max_quantizer = 51;
+      return "hevc";
+    default:
+      return nullptr;
+  }
+}
+
 // =============================================================================
 // VIDEOENCODER IMPLEMENTATION
 // =============================================================================
@@ -23,9 +60,11 @@ Napi::Object VideoEncoder::Init(Napi::Env env, Napi::Object exports) {
                   {
                       InstanceAccessor<&VideoEncoder::GetState>("state"),
                       InstanceAccessor<&VideoEncoder::GetEncodeQueueSize>("encodeQueueSize"),
+                      InstanceAccessor<&VideoEncoder::GetStats>("stats"),
                       InstanceAccessor<&VideoEncoder::GetOndequeue, &VideoEncoder::SetOndequeue>("ondequeue"),
                       InstanceMethod<&VideoEncoder::Configure>("configure"),
                       InstanceMethod<&VideoEncoder::Encode>("encode"),
+                      InstanceMethod<&VideoEncoder::EncodeBatch>("encodeBatch"),
                       InstanceMethod<&VideoEncoder::Flush>("flush"),
                       InstanceMethod<&VideoEncoder::Reset>("reset"),
                       InstanceMethod<&VideoEncoder::Close>("close"),
@@ -303,6 +342,21 @@ Napi::Value VideoEncoder::GetEncodeQueueSize(const Napi::CallbackInfo& info) {
   return Napi::Number::New(info.Env(), static_cast<double>(encode_queue_size_.load(std::memory_order_acquire)));
 }
 
+Napi::Value VideoEncoder::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  // Non-standard: frame counters since the last configure()
+  uint64_t dropped_queue = dropped_frames_queue_.load(std::memory_order_relaxed);
+  uint64_t dropped_late = dropped_frames_late_.load(std::memory_order_relaxed);
+  Napi::Object stats = Napi::Object::New(env);
+  stats.Set("encodedFrames",
+            Napi::Number::New(env, static_cast<double>(encoded_frames_.load(std::memory_order_relaxed))));
+  stats.Set("droppedFrames", Napi::Number::New(env, static_cast<double>(dropped_queue + dropped_late)));
+  stats.Set("droppedFramesQueue", Napi::Number::New(env, static_cast<double>(dropped_queue)));
+  stats.Set("droppedFramesLate", Napi::Number::New(env, static_cast<double>(dropped_late)));
+  return stats;
+}
+
 Napi::Value VideoEncoder::GetOndequeue(const Napi::CallbackInfo& info) {
   if (ondequeue_callback_.IsEmpty()) {
     return info.Env().Null();
@@ -395,6 +449,50 @@ Napi::Value VideoEncoder::Configure(const Napi::CallbackInfo& info) {
     active_config_.latency_mode = config.Get("latencyMode").As<Napi::String>().Utf8Value();
   }
 
+  // Non-standard: encoderSpeed hint (0 = best quality, 10 = fastest)
+  active_config_.encoder_speed = -1;
+  if (config.Has("encoderSpeed") && config.Get("encoderSpeed").IsNumber()) {
+    int speed = config.Get("encoderSpeed").As<Napi::Number>().Int32Value();
+    if (speed < 0 || speed > kMaxEncoderSpeed) {
+      errors::ThrowTypeError(env, "encoderSpeed must be between 0 and 10");
+      return env.Undefined();
+    }
+    active_config_.encoder_speed = speed;
+  }
+
+  // Non-standard: frameDropPolicy { maxQueueSize, dropWhenLate }
+  active_config_.max_queue_size = 0;
+  active_config_.drop_when_late = false;
+  if (config.Has("frameDropPolicy") && config.Get("frameDropPolicy").IsObject()) {
+    Napi::Object policy = config.Get("frameDropPolicy").As<Napi::Object>();
+    if (policy.Has("maxQueueSize") && policy.Get("maxQueueSize").IsNumber()) {
+      int64_t max_queue_size = policy.Get("maxQueueSize").As<Napi::Number>().Int64Value();
+      if (max_queue_size < 1) {
+        errors::ThrowTypeError(env, "frameDropPolicy.maxQueueSize must be at least 1");
+        return env.Undefined();
+      }
+      active_config_.max_queue_size = static_cast<uint32_t>(std::min<int64_t>(max_queue_size, UINT32_MAX));
+    }
+    if (policy.Has("dropWhenLate") && policy.Get("dropWhenLate").IsBoolean()) {
+      active_config_.drop_when_late = policy.Get("dropWhenLate").As<Napi::Boolean>().Value();
+    }
+  }
+
+  // Non-standard: parallelSegments (offline closed-GOP split-and-stitch)
+  active_config_.parallel_segments = 0;
+  if (config.Has("parallelSegments") && config.Get("parallelSegments").IsNumber()) {
+    int segments = config.Get("parallelSegments").As<Napi::Number>().Int32Value();
+    if (segments < 1 || segments > 64) {
+      errors::ThrowTypeError(env, "parallelSegments must be between 1 and 64");
+      return env.Undefined();
+    }
+    if (segments > 1 && active_config_.latency_mode == "realtime") {
+      errors::ThrowTypeError(env, "parallelSegments requires latencyMode \"quality\"");
+      return env.Undefined();
+    }
+    active_config_.parallel_segments = segments;
+  }
+
   // Validate codec string before queuing (fail fast)
   auto codec_info = ParseCodecString(active_config_.codec);
   if (!codec_info) {
@@ -407,6 +505,13 @@ Napi::Value VideoEncoder::Configure(const Napi::CallbackInfo& info) {
     errors::ThrowNotSupportedError(env, "No encoder available for: " + active_config_.codec);
     return env.Undefined();
   }
+  active_config_.codec_id = codec_info->codec_id;
+
+  int max_quantizer = 0;
+  if (active_config_.bitrate_mode == "quantizer" && !QuantizerExtensionKey(active_config_.codec_id, &max_quantizer)) {
+    errors::ThrowNotSupportedError(env, "bitrateMode \"quantizer\" is not supported for: " + active_config_.codec);
+    return env.Undefined();
+  }
 
   // [SPEC] 4. Set active orientation to null
   {
@@ -435,6 +540,11 @@ Napi::Value VideoEncoder::Configure(const Napi::CallbackInfo& info) {
     return env.Undefined();
   }
 
+  // Stats cover the current configuration only
+  encoded_frames_.store(0, std::memory_order_relaxed);
+  dropped_frames_queue_.store(0, std::memory_order_relaxed);
+  dropped_frames_late_.store(0, std::memory_order_relaxed);
+
   // [SPEC] 3. Set state to "configured"
   state_.transition(raii::AtomicCodecState::State::Unconfigured, raii::AtomicCodecState::State::Configured);
 
@@ -450,13 +560,91 @@ Napi::Value VideoEncoder::Encode(const Napi::CallbackInfo& info) {
     return env.Undefined();
   }
 
+  VideoControlQueue::EncodeMessage msg;
+  if (!BuildEncodeMessage(env, info.Length() > 0 ? info[0] : env.Undefined(),
+                          info.Length() > 1 ? info[1] : env.Undefined(), &msg)) {
+    return env.Undefined();
+  }
+
+  // [SPEC] 6. Increment encodeQueueSize
+  encode_queue_size_.fetch_add(1, std::memory_order_relaxed);
+
+  // [SPEC] 7. Queue encode message
+  if (!queue_.Enqueue(std::move(msg))) {
+    encode_queue_size_.fetch_sub(1, std::memory_order_relaxed);
+    errors::ThrowInvalidStateError(env, "Failed to enqueue encode");
+    return env.Undefined();
+  }
+
+  DropQueuedFrames();
+  return env.Undefined();
+}
+
+Napi::Value VideoEncoder::EncodeBatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  // Non-standard: encode() for each element, enqueued under one lock/notify
+  if (!state_.IsConfigured()) {
+    errors::ThrowInvalidStateError(env, "encodeBatch called on " + std::string(state_.ToString()) + " encoder");
+    return env.Undefined();
+  }
+
+  if (info.Length() < 1 || !info[0].IsArray()) {
+    errors::ThrowTypeError(env, "encodeBatch requires an array of VideoFrame");
+    return env.Undefined();
+  }
+
+  // Options: one VideoEncoderEncodeOptions for every frame, or an array with one per frame
+  Napi::Array frames = info[0].As<Napi::Array>();
+  uint32_t length = frames.Length();
+  Napi::Value shared_options = env.Undefined();
+  Napi::Array per_frame_options;
+  if (info.Length() > 1 && info[1].IsArray()) {
+    per_frame_options = info[1].As<Napi::Array>();
+    if (per_frame_options.Length() != length) {
+      errors::ThrowTypeError(env, "encodeBatch options array must match the frames array length");
+      return env.Undefined();
+    }
+  } else if (info.Length() > 1) {
+    shared_options = info[1];
+  }
+
+  std::vector<VideoControlQueue::Message> messages;
+  messages.reserve(length);
+  for (uint32_t i = 0; i < length; i++) {
+    VideoControlQueue::EncodeMessage msg;
+    Napi::Value options = per_frame_options.IsEmpty() ? shared_options : per_frame_options.Get(i);
+    if (!BuildEncodeMessage(env, frames.Get(i), options, &msg)) {
+      // Same as encode() in a loop: earlier frames stay queued, the error propagates
+      break;
+    }
+    messages.emplace_back(std::move(msg));
+  }
+
+  uint32_t count = static_cast<uint32_t>(messages.size());
+  encode_queue_size_.fetch_add(count, std::memory_order_relaxed);
+  if (!queue_.EnqueueBatch(messages)) {
+    encode_queue_size_.fetch_sub(count, std::memory_order_relaxed);
+    if (!env.IsExceptionPending()) {
+      errors::ThrowInvalidStateError(env, "Failed to enqueue encode");
+    }
+    return env.Undefined();
+  }
+
+  DropQueuedFrames();
+  return env.Undefined();
+}
+
+bool VideoEncoder::BuildEncodeMessage(Napi::Env env, const Napi::Value& frame_value,
+                                      const Napi::Value& options_value,
+                                      VideoControlQueue::EncodeMessage* msg) {
   // [SPEC] 1. Validate frame is not detached
-  if (info.Length() < 1 || !info[0].IsObject()) {
+  if (!frame_value.IsObject()) {
     errors::ThrowTypeError(env, "VideoFrame is required");
-    return env.Undefined();
+    return false;
   }
 
-  Napi::Object frameObj = info[0].As<Napi::Object>();
+  Napi::Object frameObj = frame_value.As<Napi::Object>();
 
   // Get VideoFrame wrapper
   VideoFrame* frameWrapper = nullptr;
@@ -466,13 +654,13 @@ Napi::Value VideoEncoder::Encode(const Napi::CallbackInfo& info) {
 
   if (!frameWrapper) {
     errors::ThrowTypeError(env, "VideoFrame is required");
-    return env.Undefined();
+    return false;
   }
 
   AVFrame* srcFrame = frameWrapper->GetAVFrame();
   if (!srcFrame) {
     errors::ThrowTypeError(env, "VideoFrame is closed or invalid");
-    return env.Undefined();
+    return false;
   }
 
   // [SPEC] 3-4. Check and set active orientation
@@ -486,7 +674,7 @@ Napi::Value VideoEncoder::Encode(const Napi::CallbackInfo& info) {
       if (active_orientation_->rotation != frameOrientation.rotation ||
           active_orientation_->flip != frameOrientation.flip) {
         errors::ThrowDataError(env, "Frame orientation does not match active orientation");
-        return env.Undefined();
+        return false;
       }
     } else {
       active_orientation_ = frameOrientation;
@@ -495,32 +683,74 @@ Napi::Value VideoEncoder::Encode(const Napi::CallbackInfo& info) {
 
   // Parse encode options
   bool keyFrame = false;
-  if (info.Length() >= 2 && info[1].IsObject()) {
-    Napi::Object options = info[1].As<Napi::Object>();
+  int quantizer = -1;
+  if (options_value.IsObject()) {
+    Napi::Object options = options_value.As<Napi::Object>();
     if (options.Has("keyFrame") && options.Get("keyFrame").IsBoolean()) {
       keyFrame = options.Get("keyFrame").As<Napi::Boolean>().Value();
     }
+
+    // [SPEC] Codec registry extensions: {avc,hevc}.quantizer, only used when
+    // bitrateMode is "quantizer" (rejected at configure for av1/vp9)
+    int max_quantizer = 0;
+    const char* extension = QuantizerExtensionKey(active_config_.codec_id, &max_quantizer);
+    if (extension && active_config_.bitrate_mode == "quantizer" && options.Has(extension) &&
+        options.Get(extension).IsObject()) {
+      Napi::Object codec_options = options.Get(extension).As<Napi::Object>();
+      if (codec_options.Has("quantizer") && codec_options.Get("quantizer").IsNumber()) {
+        quantizer = codec_options.Get("quantizer").As<Napi::Number>().Int32Value();
+        if (quantizer < 0 || quantizer > max_quantizer) {
+          errors::ThrowTypeError(env, std::string(extension) + ".quantizer must be between 0 and " +
+                                          std::to_string(max_quantizer));
+          return false;
+        }
+      }
+    }
   }
 
   // [SPEC] 5. Clone frame for async processing
   raii::AVFramePtr frameClone = raii::CloneAvFrame(srcFrame);
   if (!frameClone) {
     errors::ThrowEncodingError(env, "Failed to clone frame");
-    return env.Undefined();
+    return false;
   }
 
-  // [SPEC] 6. Increment encodeQueueSize
-  encode_queue_size_.fetch_add(1, std::memory_order_relaxed);
+  msg->frame = std::move(frameClone);
+  msg->key_frame = keyFrame;
+  msg->quantizer = quantizer;
+  return true;
+}
 
-  // [SPEC] 7. Queue encode message
-  VideoControlQueue::EncodeMessage msg{std::move(frameClone), keyFrame};
-  if (!queue_.Enqueue(std::move(msg))) {
-    encode_queue_size_.fetch_sub(1, std::memory_order_relaxed);
-    errors::ThrowInvalidStateError(env, "Failed to enqueue encode");
-    return env.Undefined();
+void VideoEncoder::DropQueuedFrames() {
+  // Non-standard frame drop policy: bound latency by discarding the oldest
+  // pending non-key frames. Timestamps travel with each frame, so the frames
+  // that remain are encoded with their original timestamps.
+  if (active_config_.max_queue_size > 0 &&
+      encode_queue_size_.load(std::memory_order_relaxed) > active_config_.max_queue_size) {
+    size_t dropped = queue_.DropOldestFrames(active_config_.max_queue_size);
+    if (dropped > 0) {
+      uint32_t new_size =
+          encode_queue_size_.fetch_sub(static_cast<uint32_t>(dropped), std::memory_order_relaxed) -
+          static_cast<uint32_t>(dropped);
+      dropped_frames_queue_.fetch_add(dropped, std::memory_order_relaxed);
+      ScheduleDequeueEvent(new_size);
+    }
   }
+}
 
-  return env.Undefined();
+void VideoEncoder::ScheduleDequeueEvent(uint32_t new_size) {
+  // [SPEC] [[dequeue event scheduled]] - same coalescing as the worker's SignalDequeue
+  bool expected = false;
+  if (!dequeue_event_scheduled_.compare_exchange_strong(expected, true, std::memory_order_acq_rel,
+                                                        std::memory_order_acquire)) {
+    return;
+  }
+
+  auto* data = new DequeueData{new_size};
+  if (!dequeue_tsfn_.Call(data)) {
+    delete data;
+    dequeue_event_scheduled_.store(false, std::memory_order_release);
+  }
 }
 
 Napi::Value VideoEncoder::Flush(const Napi::CallbackInfo& info) {
@@ -652,18 +882,32 @@ Napi::Value VideoEncoder::IsConfigSupported(const Napi::CallbackInfo& info) {
     deferred.Reject(Napi::TypeError::New(env, "height is required and must be a number").Value());
     return deferred.Promise();
   }
+  // Non-standard options are range-checked as in configure()
+  if (config.Has("encoderSpeed") && config.Get("encoderSpeed").IsNumber()) {
+    int speed = config.Get("encoderSpeed").As<Napi::Number>().Int32Value();
+    if (speed < 0 || speed > kMaxEncoderSpeed) {
+      Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+      deferred.Reject(Napi::TypeError::New(env, "encoderSpeed must be between 0 and 10").Value());
+      return deferred.Promise();
+    }
+  }
 
   std::string codec_string = config.Get("codec").As<Napi::String>().Utf8Value();
 
   // [SPEC] 2. Create promise
   Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
 
-  // Check if codec is supported for encoding
-  auto codec_info = ParseCodecString(codec_string);
-  bool supported = false;
-  if (codec_info) {
-    const AVCodec* encoder = avcodec_find_encoder(codec_info->codec_id);
-    supported = (encoder != nullptr);
+  // Answer from the process-wide capability table (no libavcodec calls after
+  // the first lookup of a codec)
+  int width = config.Get("width").As<Napi::Number>().Int32Value();
+  int height = config.Get("height").As<Napi::Number>().Int32Value();
+  auto lookup = LookupCodecString(codec_string);
+  bool supported = lookup && lookup->capabilities->SupportsVideoEncode(width, height,
+                                                                       lookup->info.bit_depth);
+  int max_quantizer = 0;
+  if (supported && config.Has("bitrateMode") && config.Get("bitrateMode").IsString() &&
+      config.Get("bitrateMode").As<Napi::String>().Utf8Value() == "quantizer") {
+    supported = QuantizerExtensionKey(lookup->info.codec_id, &max_quantizer) != nullptr;
   }
 
   // [SPEC] Create VideoEncoderSupport object
@@ -703,6 +947,12 @@ Napi::Value VideoEncoder::IsConfigSupported(const Napi::CallbackInfo& info) {
   if (config.Has("latencyMode") && config.Get("latencyMode").IsString()) {
     clonedConfig.Set("latencyMode", config.Get("latencyMode"));
   }
+  if (config.Has("encoderSpeed") && config.Get("encoderSpeed").IsNumber()) {
+    clonedConfig.Set("encoderSpeed", config.Get("encoderSpeed"));
+  }
+  if (config.Has("parallelSegments") && config.Get("parallelSegments").IsNumber()) {
+    clonedConfig.Set("parallelSegments", config.Get("parallelSegments"));
+  }
 
   result.Set("config", clonedConfig);
 
@@ -827,6 +1077,148 @@ static bool ApplyScalabilityMode(AVCodecContext* ctx, const std::string& mode,
   return true;
 }
 
+// =============================================================================
+// SPEED PRESET HELPERS
+// =============================================================================
+
+/**
+ * Per-encoder speed preset table.
+ *
+ * Maps the normalized encoderSpeed hint (0-10) onto each library's native
+ * speed knob, and provides the speed used when latencyMode is "realtime" and
+ * no explicit hint is given. quality_speed of -1 keeps the library default.
+ */
+struct SpeedPresetEntry {
+  const char* encoder_name;
+  int realtime_speed;  // Default hint for latencyMode "realtime"
+  int quality_speed;   // Default hint for latencyMode "quality" (-1 = untouched)
+};
+
+static constexpr SpeedPresetEntry kSpeedPresets[] = {
+    {"libx264", 8, -1},
+    {"libx265", 8, -1},
+    {"libvpx", 10, -1},
+    {"libvpx-vp9", 10, -1},
+    {"libaom-av1", 10, 5},  // libaom defaults to cpu-used=1, far too slow for general use
+    {"libsvtav1", 8, -1},
+};
+
+// x264/x265 presets ordered from slowest to fastest
+static constexpr const char* kX26xPresets[] = {
+    "veryslow", "slower", "slow", "medium", "fast", "faster", "veryfast", "superfast", "ultrafast",
+};
+
+/** Scale a 0-10 speed hint onto [min_value, max_value]. */
+static int ScaleSpeed(int speed, int min_value, int max_value) {
+  return min_value + (speed * (max_value - min_value) + kMaxEncoderSpeed / 2) / kMaxEncoderSpeed;
+}
+
+/**
+ * Apply codec-specific speed/latency options before avcodec_open2.
+ *
+ * LOW_DELAY and max_b_frames alone do not make software encoders fast:
+ * libx264 still runs its default preset with a 40-frame lookahead, libvpx
+ * defaults to the "good" deadline and libaom to cpu-used=1. This selects
+ * the library's own realtime mode and a speed level from kSpeedPresets.
+ *
+ * Options are hints: a library build that lacks one keeps its default.
+ *
+ * @param ctx Allocated (not yet opened) encoder context
+ * @param latency_mode "quality" or "realtime"
+ * @param encoder_speed Non-standard speed hint (0-10), or -1 for the table default
+ */
+static void ApplySpeedPreset(AVCodecContext* ctx, const std::string& latency_mode, int encoder_speed) {
+  const char* codec_name = ctx->codec ? ctx->codec->name : nullptr;
+  if (!codec_name || !ctx->priv_data) return;
+
+  const SpeedPresetEntry* entry = nullptr;
+  for (const auto& candidate : kSpeedPresets) {
+    if (strcmp(codec_name, candidate.encoder_name) == 0) {
+      entry = &candidate;
+      break;
+    }
+  }
+  if (!entry) return;
+
+  const bool realtime = latency_mode == "realtime";
+  int speed = encoder_speed;
+  if (speed < 0) {
+    speed = realtime ? entry->realtime_speed : entry->quality_speed;
+  }
+
+  if (strcmp(codec_name, "libx264") == 0 || strcmp(codec_name, "libx265") == 0) {
+    if (speed >= 0) {
+      constexpr int kLastPreset = static_cast<int>(sizeof(kX26xPresets) / sizeof(kX26xPresets[0])) - 1;
+      av_opt_set(ctx->priv_data, "preset", kX26xPresets[ScaleSpeed(speed, 0, kLastPreset)], 0);
+    }
+    if (realtime) {
+      // zerolatency disables lookahead, B-frames and frame threading
+      av_opt_set(ctx->priv_data, "tune", "zerolatency", 0);
+    }
+  } else if (strncmp(codec_name, "libvpx", 6) == 0) {
+    av_opt_set(ctx->priv_data, "deadline", realtime ? "realtime" : "good", 0);
+    if (speed >= 0) {
+      av_opt_set_int(ctx->priv_data, "cpu-used", ScaleSpeed(speed, 0, 8), 0);
+    }
+    if (realtime) {
+      av_opt_set_int(ctx->priv_data, "lag-in-frames", 0, 0);
+    }
+  } else if (strcmp(codec_name, "libaom-av1") == 0) {
+    if (realtime) {
+      av_opt_set(ctx->priv_data, "usage", "realtime", 0);
+      av_opt_set_int(ctx->priv_data, "lag-in-frames", 0, 0);
+    }
+    if (speed >= 0) {
+      av_opt_set_int(ctx->priv_data, "cpu-used", ScaleSpeed(speed, 0, 8), 0);
+    }
+  } else if (strcmp(codec_name, "libsvtav1") == 0) {
+    if (speed >= 0) {
+      av_opt_set_int(ctx->priv_data, "preset", ScaleSpeed(speed, 0, 13), 0);
+    }
+  }
+}
+
+// =============================================================================
+// QUANTIZER HELPERS
+// =============================================================================
+
+/**
+ * Switch an unopened encoder context to constant-quantizer rate control.
+ *
+ * Bitrate-driven RC (and its lookahead) is disabled; each frame then carries
+ * its own quantizer via ApplyFrameQuantizer().
+ */
+static void ApplyQuantizerMode(AVCodecContext* ctx) {
+  ctx->bit_rate = 0;
+  ctx->rc_max_rate = 0;
+  ctx->rc_buffer_size = 0;
+  ctx->flags |= AV_CODEC_FLAG_QSCALE;
+  ctx->global_quality = kDefaultQuantizer * FF_QP2LAMBDA;
+
+  const char* codec_name = ctx->codec ? ctx->codec->name : nullptr;
+  if (!codec_name || !ctx->priv_data) return;
+
+  if (strcmp(codec_name, "libx264") == 0 || strcmp(codec_name, "libx265") == 0) {
+    av_opt_set_int(ctx->priv_data, "qp", kDefaultQuantizer, 0);
+  }
+}
+
+/**
+ * Attach a per-frame quantizer before avcodec_send_frame.
+ *
+ * frame->quality is honored by encoders that implement AV_CODEC_FLAG_QSCALE.
+ * libx264 ignores it but re-reads its "qp" option on every frame and calls
+ * x264_encoder_reconfig when it changed, so the option is updated as well.
+ */
+static void ApplyFrameQuantizer(AVCodecContext* ctx, AVFrame* frame, int quantizer) {
+  frame->quality = quantizer * FF_QP2LAMBDA;
+
+  const char* codec_name = ctx->codec ? ctx->codec->name : nullptr;
+  if (codec_name && ctx->priv_data && strcmp(codec_name, "libx264") == 0) {
+    av_opt_set_int(ctx->priv_data, "qp", quantizer, 0);
+  }
+}
+
 // =============================================================================
 // VIDEOENCODERWORKER IMPLEMENTATION
 // =============================================================================
@@ -840,64 +1232,52 @@ VideoEncoderWorker::~VideoEncoderWorker() {
   Stop();
 }
 
-bool VideoEncoderWorker::OnConfigure(const ConfigureMessage& msg) {
-  // Get config from parent encoder
-  if (!encoder_) return false;
-
-  // Helper to unblock queue on exit (RAII pattern)
-  struct ScopeGuard {
-    VideoEncoder* e;
-    ~ScopeGuard() { if (e) e->queue_.SetBlocked(false); }
-  } guard{encoder_};
-
-  // Thread-safe: copy config at start to avoid race with main thread
-  // The main thread may call Configure() again while we're processing
-  const VideoEncoder::EncoderConfig config = encoder_->active_config_;
-
+raii::AVCodecContextPtr VideoEncoderWorker::OpenEncoderContext(const VideoEncoder::EncoderConfig& config,
+                                                                int thread_count, int* error_code,
+                                                                std::string* error_msg) {
   // Parse codec string
   auto codec_info = ParseCodecString(config.codec);
   if (!codec_info) {
-    OutputError(AVERROR_ENCODER_NOT_FOUND, "Unsupported codec: " + config.codec);
-    return false;
+    *error_code = AVERROR_ENCODER_NOT_FOUND;
+    *error_msg = "Unsupported codec: " + config.codec;
+    return nullptr;
   }
 
   // Find FFmpeg encoder
   const AVCodec* encoder = avcodec_find_encoder(codec_info->codec_id);
   if (!encoder) {
-    OutputError(AVERROR_ENCODER_NOT_FOUND, "No encoder available for: " + config.codec);
-    return false;
+    *error_code = AVERROR_ENCODER_NOT_FOUND;
+    *error_msg = "No encoder available for: " + config.codec;
+    return nullptr;
   }
 
   // Allocate codec context
-  codec_ctx_ = raii::MakeAvCodecContext(encoder);
-  if (!codec_ctx_) {
-    OutputError(AVERROR(ENOMEM), "Failed to allocate encoder context");
-    return false;
+  raii::AVCodecContextPtr ctx = raii::MakeAvCodecContext(encoder);
+  if (!ctx) {
+    *error_code = AVERROR(ENOMEM);
+    *error_msg = "Failed to allocate encoder context";
+    return nullptr;
   }
 
   // Set encoder parameters
-  codec_ctx_->width = config.width;
-  codec_ctx_->height = config.height;
-  width_ = config.width;
-  height_ = config.height;
+  ctx->width = config.width;
+  ctx->height = config.height;
 
   // Time base in microseconds (WebCodecs uses microseconds)
-  codec_ctx_->time_base = AVRational{1, 1000000};
+  ctx->time_base = AVRational{1, 1000000};
 
   // Set pixel format (default to YUV420P, most compatible)
-  codec_ctx_->pix_fmt = AV_PIX_FMT_YUV420P;
-  format_ = AV_PIX_FMT_YUV420P;
+  ctx->pix_fmt = AV_PIX_FMT_YUV420P;
 
   // Use encoder's preferred format if available
 #if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(61, 0, 0)
   // FFmpeg 7.0+ uses avcodec_get_supported_config
   const AVPixelFormat* pix_fmts = nullptr;
   int num_fmts = 0;
-  if (avcodec_get_supported_config(codec_ctx_.get(), encoder, AV_CODEC_CONFIG_PIX_FORMAT,
+  if (avcodec_get_supported_config(ctx.get(), encoder, AV_CODEC_CONFIG_PIX_FORMAT,
                                     0, reinterpret_cast<const void**>(&pix_fmts), &num_fmts) >= 0) {
     if (pix_fmts && num_fmts > 0) {
-      codec_ctx_->pix_fmt = pix_fmts[0];
-      format_ = pix_fmts[0];
+      ctx->pix_fmt = pix_fmts[0];
     }
   }
 #else
@@ -905,63 +1285,119 @@ bool VideoEncoderWorker::OnConfigure(const ConfigureMessage& msg) {
   #pragma GCC diagnostic push
   #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
   if (encoder->pix_fmts) {
-    codec_ctx_->pix_fmt = encoder->pix_fmts[0];
-    format_ = encoder->pix_fmts[0];
+    ctx->pix_fmt = encoder->pix_fmts[0];
   }
   #pragma GCC diagnostic pop
 #endif
 
   // Bitrate
   if (config.bitrate > 0) {
-    codec_ctx_->bit_rate = config.bitrate;
+    ctx->bit_rate = config.bitrate;
   }
 
   // Framerate
   if (config.framerate > 0) {
-    codec_ctx_->framerate = AVRational{static_cast<int>(config.framerate * 1000), 1000};
+    ctx->framerate = AVRational{static_cast<int>(config.framerate * 1000), 1000};
   }
 
   // GOP size (keyframe interval)
-  codec_ctx_->gop_size = config.framerate > 0 ? static_cast<int>(config.framerate) : 30;
+  ctx->gop_size = config.framerate > 0 ? static_cast<int>(config.framerate) : 30;
 
   // Bitrate mode
   if (config.bitrate_mode == "constant") {
-    codec_ctx_->rc_max_rate = codec_ctx_->bit_rate;
-    codec_ctx_->rc_buffer_size = static_cast<int>(codec_ctx_->bit_rate);
+    ctx->rc_max_rate = ctx->bit_rate;
+    ctx->rc_buffer_size = static_cast<int>(ctx->bit_rate);
+  } else if (config.bitrate_mode == "quantizer") {
+    ApplyQuantizerMode(ctx.get());
   }
 
   // Latency mode
   if (config.latency_mode == "realtime") {
-    codec_ctx_->flags |= AV_CODEC_FLAG_LOW_DELAY;
-    codec_ctx_->max_b_frames = 0;
+    ctx->flags |= AV_CODEC_FLAG_LOW_DELAY;
+    ctx->max_b_frames = 0;
+  }
+
+  // Parallel segments are independently decodable closed GOPs
+  if (config.parallel_segments > 1) {
+    ctx->flags |= AV_CODEC_FLAG_CLOSED_GOP;
   }
 
   // Threading
-  codec_ctx_->thread_count = 0;  // Auto-detect
-  codec_ctx_->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+  ctx->thread_count = thread_count;  // 0 = auto-detect
+  ctx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
+  // Codec-specific speed preset (realtime mode and encoderSpeed hint)
+  ApplySpeedPreset(ctx.get(), config.latency_mode, config.encoder_speed);
 
   // Apply scalability mode (SVC) for VP9 temporal layers
   if (!config.scalability_mode.empty()) {
     std::string svc_error;
-    if (!ApplyScalabilityMode(codec_ctx_.get(), config.scalability_mode, &svc_error)) {
-      std::string msg = "Unsupported scalabilityMode '" + config.scalability_mode + "'";
+    if (!ApplyScalabilityMode(ctx.get(), config.scalability_mode, &svc_error)) {
+      *error_code = AVERROR(EINVAL);
+      *error_msg = "Unsupported scalabilityMode '" + config.scalability_mode + "'";
       if (!svc_error.empty()) {
-        msg += ": " + svc_error;
+        *error_msg += ": " + svc_error;
       }
-      OutputError(AVERROR(EINVAL), msg);
-      codec_ctx_.reset();
-      return false;
+      return nullptr;
     }
   }
 
   // Open encoder
-  int ret = avcodec_open2(codec_ctx_.get(), encoder, nullptr);
+  int ret = avcodec_open2(ctx.get(), encoder, nullptr);
   if (ret < 0) {
-    OutputError(ret, "Failed to open encoder");
-    codec_ctx_.reset();
+    *error_code = ret;
+    *error_msg = "Failed to open encoder";
+    return nullptr;
+  }
+
+  return ctx;
+}
+
+bool VideoEncoderWorker::OnConfigure(const ConfigureMessage& msg) {
+  // Get config from parent encoder
+  if (!encoder_) return false;
+
+  // Helper to unblock queue on exit (RAII pattern)
+  struct ScopeGuard {
+    VideoEncoder* e;
+    ~ScopeGuard() { if (e) e->queue_.SetBlocked(false); }
+  } guard{encoder_};
+
+  // Segments from a previous configuration are discarded
+  AbortSegments();
+
+  // Thread-safe: copy config at start to avoid race with main thread
+  // The main thread may call Configure() again while we're processing
+  const VideoEncoder::EncoderConfig config = encoder_->active_config_;
+
+  int error_code = 0;
+  std::string error_msg;
+  codec_ctx_ = OpenEncoderContext(config, 0, &error_code, &error_msg);
+  if (!codec_ctx_) {
+    OutputError(error_code, error_msg);
     return false;
   }
 
+  width_ = config.width;
+  height_ = config.height;
+  format_ = codec_ctx_->pix_fmt;
+  quantizer_mode_ = config.bitrate_mode == "quantizer";
+
+  // Frame drop policy (late frames are judged against the frame interval)
+  drop_when_late_ = config.drop_when_late;
+  frame_interval_us_ = config.framerate > 0 ? static_cast<int64_t>(1000000.0 / config.framerate) : 0;
+  late_frames_.Reset();
+
+  // Split-and-stitch: codec_ctx_ stays open as the decoderConfig reference,
+  // segments are encoded on their own contexts with a share of the cores
+  parallel_segments_ = config.parallel_segments > 1 ? config.parallel_segments : 0;
+  if (parallel_segments_ > 0) {
+    segment_config_ = config;
+    segment_length_ = codec_ctx_->gop_size > 0 ? codec_ctx_->gop_size : 30;
+    unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+    segment_thread_count_ = static_cast<int>(std::max(1u, cores / static_cast<unsigned int>(parallel_segments_)));
+  }
+
   // Store codec string for thread-safe access in OutputChunk
   codec_ = config.codec;
 
@@ -981,6 +1417,11 @@ void VideoEncoderWorker::OnEncode(const EncodeMessage& msg) {
     return;
   }
 
+  if (parallel_segments_ > 0) {
+    EncodeParallel(msg);
+    return;
+  }
+
   // Force keyframe if requested
   if (msg.key_frame) {
     frame->pict_type = AV_PICTURE_TYPE_I;
@@ -994,6 +1435,22 @@ void VideoEncoderWorker::OnEncode(const EncodeMessage& msg) {
 #endif
   }
 
+  // Non-standard frame drop policy: skip this frame if the encoder is behind
+  if (ShouldDropLateFrame(msg)) {
+    frame_count_++;
+    if (encoder_) {
+      encoder_->dropped_frames_late_.fetch_add(1, std::memory_order_relaxed);
+      uint32_t new_size = encoder_->encode_queue_size_.fetch_sub(1, std::memory_order_relaxed) - 1;
+      SignalDequeue(new_size);
+    }
+    return;
+  }
+
+  // Per-frame quantizer (bitrateMode "quantizer")
+  if (quantizer_mode_ && msg.quantizer >= 0) {
+    ApplyFrameQuantizer(codec_ctx_.get(), frame, msg.quantizer);
+  }
+
   // Set frame PTS
   if (frame->pts == AV_NOPTS_VALUE) {
     frame->pts = frame_count_;
@@ -1001,6 +1458,7 @@ void VideoEncoderWorker::OnEncode(const EncodeMessage& msg) {
   frame_count_++;
 
   // Send frame to encoder
+  const auto encode_start = std::chrono::steady_clock::now();
   int ret = avcodec_send_frame(codec_ctx_.get(), frame);
 
   // [SPEC] [[codec saturated]] - track when codec cannot accept more input
@@ -1065,6 +1523,14 @@ void VideoEncoderWorker::OnEncode(const EncodeMessage& msg) {
     encoder_->codec_saturated_.store(false, std::memory_order_release);
   }
 
+  late_frames_.RecordEncode(std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now() - encode_start)
+                                .count(),
+                            FrameIntervalUs(frame));
+  if (encoder_) {
+    encoder_->encoded_frames_.fetch_add(1, std::memory_order_relaxed);
+  }
+
   // Decrement queue size and signal dequeue
   if (encoder_) {
     uint32_t new_size = encoder_->encode_queue_size_.fetch_sub(1, std::memory_order_relaxed) - 1;
@@ -1072,12 +1538,34 @@ void VideoEncoderWorker::OnEncode(const EncodeMessage& msg) {
   }
 }
 
+int64_t VideoEncoderWorker::FrameIntervalUs(const AVFrame* frame) const {
+  if (frame_interval_us_ > 0) return frame_interval_us_;
+  return frame && frame->duration > 0 ? frame->duration : 0;  // time_base is microseconds
+}
+
+bool VideoEncoderWorker::ShouldDropLateFrame(const EncodeMessage& msg) {
+  if (!drop_when_late_ || msg.key_frame || !encoder_) return false;
+
+  // Drop only as many queued frames as the encoder's overrun costs; the
+  // newest frame is always encoded
+  return late_frames_.ShouldDrop(FrameIntervalUs(msg.frame.get()),
+                                 encoder_->encode_queue_size_.load(std::memory_order_relaxed));
+}
+
 void VideoEncoderWorker::OnFlush(const FlushMessage& msg) {
   if (!codec_ctx_) {
     FlushComplete(msg.promise_id, true, "");
     return;
   }
 
+  if (parallel_segments_ > 0) {
+    // Encode the partial tail segment and emit everything in order
+    DispatchSegment();
+    EmitSegments(0);
+    FlushComplete(msg.promise_id, true, "");
+    return;
+  }
+
   // Send NULL frame to trigger drain
   int ret = avcodec_send_frame(codec_ctx_.get(), nullptr);
   if (ret < 0 && ret != AVERROR_EOF) {
@@ -1123,17 +1611,177 @@ void VideoEncoderWorker::OnFlush(const FlushMessage& msg) {
 }
 
 void VideoEncoderWorker::OnReset() {
+  AbortSegments();
   if (codec_ctx_) {
     avcodec_flush_buffers(codec_ctx_.get());
   }
   first_output_after_configure_ = true;
   frame_count_ = 0;
+  late_frames_.Reset();
 }
 
 void VideoEncoderWorker::OnClose() {
+  AbortSegments();
   codec_ctx_.reset();
 }
 
+// =============================================================================
+// PARALLEL SEGMENT ENCODING
+// =============================================================================
+
+void VideoEncoderWorker::EncodeParallel(const EncodeMessage& msg) {
+  // Frames are buffered by reference; the queue slot is released immediately
+  raii::AVFramePtr frame = raii::CloneAvFrame(msg.frame.get());
+  if (encoder_) {
+    uint32_t new_size = encoder_->encode_queue_size_.fetch_sub(1, std::memory_order_relaxed) - 1;
+    SignalDequeue(new_size);
+  }
+  if (!frame) {
+    OutputError(AVERROR(ENOMEM), "Failed to clone frame");
+    return;
+  }
+
+  if (frame->pts == AV_NOPTS_VALUE) {
+    frame->pts = frame_count_;
+  }
+  frame_count_++;
+
+  // A requested key frame starts a new closed GOP
+  if (msg.key_frame && !pending_segment_.empty()) {
+    DispatchSegment();
+  }
+
+  pending_segment_.push_back(SegmentFrame{std::move(frame), msg.quantizer});
+  if (static_cast<int>(pending_segment_.size()) >= segment_length_) {
+    DispatchSegment();
+  }
+
+  // Emit whatever finished meanwhile without blocking
+  EmitSegments(static_cast<size_t>(parallel_segments_));
+}
+
+void VideoEncoderWorker::DispatchSegment() {
+  if (pending_segment_.empty()) return;
+
+  // Bound memory: at most parallel_segments_ segments in flight
+  EmitSegments(static_cast<size_t>(parallel_segments_) - 1);
+
+  segments_in_flight_.push_back(std::async(std::launch::async, &VideoEncoderWorker::EncodeSegment,
+                                           segment_config_, std::move(pending_segment_),
+                                           segment_thread_count_, &abort_segments_));
+  pending_segment_.clear();
+}
+
+void VideoEncoderWorker::EmitSegments(size_t max_in_flight) {
+  while (!segments_in_flight_.empty()) {
+    auto& front = segments_in_flight_.front();
+    if (segments_in_flight_.size() <= max_in_flight &&
+        front.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      break;  // Oldest segment still encoding; keep output in order
+    }
+
+    SegmentResult result = front.get();
+    segments_in_flight_.pop_front();
+
+    if (result.error_code != 0) {
+      OutputError(result.error_code, result.error_message);
+      continue;
+    }
+    if (encoder_) {
+      encoder_->encoded_frames_.fetch_add(result.packets.size(), std::memory_order_relaxed);
+    }
+    for (auto& out : result.packets) {
+      // Single decoderConfig: only the first key frame after configure carries it
+      bool include_config = first_output_after_configure_ && out.is_key;
+      if (include_config) {
+        first_output_after_configure_ = false;
+      }
+      OutputChunk(std::move(out.packet), out.is_key, out.timestamp, out.duration, include_config);
+    }
+  }
+}
+
+void VideoEncoderWorker::AbortSegments() {
+  abort_segments_.store(true, std::memory_order_release);
+  segments_in_flight_.clear();  // std::async futures join on destruction
+  pending_segment_.clear();
+  abort_segments_.store(false, std::memory_order_release);
+}
+
+VideoEncoderWorker::SegmentResult VideoEncoderWorker::EncodeSegment(VideoEncoder::EncoderConfig config,
+                                                                   std::vector<SegmentFrame> frames,
+                                                                   int thread_count,
+                                                                   const std::atomic<bool>* abort) {
+  SegmentResult result;
+
+  // Each segment is a closed GOP on its own context; same config means the
+  // same stream parameters, so the reference context's decoderConfig holds
+  raii::AVCodecContextPtr ctx =
+      OpenEncoderContext(config, thread_count, &result.error_code, &result.error_message);
+  if (!ctx) return result;
+
+  raii::AVPacketPtr packet = raii::MakeAvPacket();
+  if (!packet) {
+    result.error_code = AVERROR(ENOMEM);
+    result.error_message = "Failed to allocate packet";
+    return result;
+  }
+
+  auto drain = [&]() -> int {
+    int ret = 0;
+    while ((ret = avcodec_receive_packet(ctx.get(), packet.get())) >= 0) {
+      result.packets.push_back(SegmentPacket{
+          raii::CloneAvPacket(packet.get()),
+          (packet->flags & AV_PKT_FLAG_KEY) != 0,
+          packet->pts != AV_NOPTS_VALUE ? packet->pts : 0,
+          packet->duration > 0 ? packet->duration : 0,
+      });
+      av_packet_unref(packet.get());
+    }
+    return (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) ? 0 : ret;
+  };
+
+  for (size_t i = 0; i < frames.size(); ++i) {
+    if (abort->load(std::memory_order_acquire)) return SegmentResult{};
+
+    AVFrame* frame = frames[i].frame.get();
+    frame->pict_type = i == 0 ? AV_PICTURE_TYPE_I : AV_PICTURE_TYPE_NONE;
+#if LIBAVUTIL_VERSION_INT >= AV_VERSION_INT(58, 0, 0)
+    if (i == 0) {
+      frame->flags |= AV_FRAME_FLAG_KEY;
+    } else {
+      frame->flags &= ~AV_FRAME_FLAG_KEY;
+    }
+#endif
+    if (config.bitrate_mode == "quantizer" && frames[i].quantizer >= 0) {
+      ApplyFrameQuantizer(ctx.get(), frame, frames[i].quantizer);
+    }
+
+    int ret = avcodec_send_frame(ctx.get(), frame);
+    if (ret == AVERROR(EAGAIN)) {
+      // Output must be drained before the encoder accepts more input
+      ret = drain();
+      if (ret == 0) ret = avcodec_send_frame(ctx.get(), frame);
+    }
+    if (ret < 0 || (ret = drain()) < 0) {
+      result.error_code = ret;
+      result.error_message = "Failed to encode segment: " + errors::FfmpegErrorString(ret);
+      result.packets.clear();
+      return result;
+    }
+  }
+
+  // Drain the segment's tail (B-frames/lookahead)
+  int ret = avcodec_send_frame(ctx.get(), nullptr);
+  if (ret >= 0 || ret == AVERROR_EOF) ret = drain();
+  if (ret < 0) {
+    result.error_code = ret;
+    result.error_message = "Failed to drain segment: " + errors::FfmpegErrorString(ret);
+    result.packets.clear();
+  }
+  return result;
+}
+
 void VideoEncoderWorker::OutputChunk(raii::AVPacketPtr packet, bool is_key,
                                       int64_t ts, int64_t dur, bool include_config) {
   if (!encoder_ || encoder_->state_.IsClosed()) return;
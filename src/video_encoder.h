@@ -17,14 +17,20 @@
  */
 
 #include <napi.h>
+#include <atomic>
+#include <deque>
+#include <future>
 #include <memory>
 #include <optional>
 #include <queue>
+#include <string>
 #include <unordered_map>
+#include <vector>
 #include "shared/utils.h"
 #include "shared/control_message_queue.h"
 #include "shared/codec_worker.h"
 #include "shared/safe_tsfn.h"
+#include "shared/late_frame_dropper.h"
 #include "ffmpeg_raii.h"
 
 namespace webcodecs {
@@ -78,6 +84,11 @@ class VideoEncoder : public Napi::ObjectWrap<VideoEncoder> {
   // Cleared after successfully receiving output packets
   std::atomic<bool> codec_saturated_{false};
 
+  // --- Non-standard encoder statistics (exposed via `stats`) ---
+  std::atomic<uint64_t> encoded_frames_{0};
+  std::atomic<uint64_t> dropped_frames_queue_{0};  // Dropped by maxQueueSize
+  std::atomic<uint64_t> dropped_frames_late_{0};   // Dropped by dropWhenLate
+
   // --- Active Orientation Tracking (per spec) ---
   struct Orientation {
     int rotation = 0;    // 0, 90, 180, 270 degrees
@@ -158,6 +169,7 @@ class VideoEncoder : public Napi::ObjectWrap<VideoEncoder> {
   // --- Encoder Configuration (deep copy for async processing) ---
   struct EncoderConfig {
     std::string codec;
+    AVCodecID codec_id = AV_CODEC_ID_NONE;  // Parsed from codec at configure
     int width = 0;
     int height = 0;
     int display_width = 0;
@@ -169,18 +181,25 @@ class VideoEncoder : public Napi::ObjectWrap<VideoEncoder> {
     std::string scalability_mode;       // SVC mode (e.g., "L1T1")
     std::string bitrate_mode;           // "constant", "variable", "quantizer"
     std::string latency_mode;           // "quality" or "realtime"
+    int encoder_speed = -1;             // Non-standard: 0 (slowest) to 10 (fastest), -1 = unset
+    // Non-standard frameDropPolicy (realtime ingest): drop oldest non-key frames
+    uint32_t max_queue_size = 0;        // Drop when encodeQueueSize exceeds this (0 = never)
+    bool drop_when_late = false;        // Drop when encoding falls behind the frame interval
+    int parallel_segments = 0;          // Non-standard: >1 encodes closed-GOP segments concurrently
   };
   EncoderConfig active_config_;
 
   // Attributes
   Napi::Value GetState(const Napi::CallbackInfo& info);
   Napi::Value GetEncodeQueueSize(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
   Napi::Value GetOndequeue(const Napi::CallbackInfo& info);
   void SetOndequeue(const Napi::CallbackInfo& info, const Napi::Value& value);
 
   // Methods
   Napi::Value Configure(const Napi::CallbackInfo& info);
   Napi::Value Encode(const Napi::CallbackInfo& info);
+  Napi::Value EncodeBatch(const Napi::CallbackInfo& info);
   Napi::Value Flush(const Napi::CallbackInfo& info);
   Napi::Value Reset(const Napi::CallbackInfo& info);
   Napi::Value Close(const Napi::CallbackInfo& info);
@@ -189,6 +208,13 @@ class VideoEncoder : public Napi::ObjectWrap<VideoEncoder> {
   // --- Internal Helpers ---
   void InitializeTSFNs(Napi::Env env);
   void ReleaseTSFNs();
+  // Validate one frame + options and build its encode message; throws and returns false on error
+  bool BuildEncodeMessage(Napi::Env env, const Napi::Value& frame_value,
+                          const Napi::Value& options_value, VideoControlQueue::EncodeMessage* msg);
+  // Apply the frameDropPolicy queue limit after enqueueing
+  void DropQueuedFrames();
+  // Fire ondequeue for a queue size change made on the JS thread
+  void ScheduleDequeueEvent(uint32_t new_size);
 
   // Friend class for worker access
   friend class VideoEncoderWorker;
@@ -235,10 +261,56 @@ class VideoEncoderWorker : public CodecWorker<VideoControlQueue> {
   // --- Codec Parameters (thread-local copies from config) ---
   // These are copied from active_config_ during OnConfigure to avoid cross-thread access
   std::string codec_;  // Codec string for decoderConfig metadata
+  bool quantizer_mode_ = false;  // bitrateMode "quantizer": per-frame QP from EncodeMessage
+  bool drop_when_late_ = false;  // frameDropPolicy.dropWhenLate
+  int64_t frame_interval_us_ = 0;  // From framerate (0 = use frame duration)
   int width_ = 0;
   int height_ = 0;
   AVPixelFormat format_ = AV_PIX_FMT_NONE;
 
+  // --- Frame Drop Policy ---
+  LateFrameDropper late_frames_;
+  int64_t FrameIntervalUs(const AVFrame* frame) const;
+  bool ShouldDropLateFrame(const EncodeMessage& msg);
+
+  // --- Parallel Segment Encoding (non-standard parallelSegments) ---
+  // Offline split-and-stitch: frames are cut into closed GOPs that are
+  // encoded concurrently on separate contexts and emitted in order.
+  struct SegmentFrame {
+    raii::AVFramePtr frame;
+    int quantizer;
+  };
+  struct SegmentPacket {
+    raii::AVPacketPtr packet;
+    bool is_key;
+    int64_t timestamp;
+    int64_t duration;
+  };
+  struct SegmentResult {
+    std::vector<SegmentPacket> packets;
+    int error_code = 0;
+    std::string error_message;
+  };
+
+  int parallel_segments_ = 0;       // 0 = single context (default)
+  int segment_length_ = 0;          // Frames per closed GOP
+  int segment_thread_count_ = 0;    // Codec threads per segment context
+  VideoEncoder::EncoderConfig segment_config_;
+  std::vector<SegmentFrame> pending_segment_;
+  std::deque<std::future<SegmentResult>> segments_in_flight_;
+  std::atomic<bool> abort_segments_{false};
+
+  void EncodeParallel(const EncodeMessage& msg);
+  void DispatchSegment();
+  void EmitSegments(size_t max_in_flight);  // Emit finished segments in order, block while above limit
+  void AbortSegments();
+  static SegmentResult EncodeSegment(VideoEncoder::EncoderConfig config, std::vector<SegmentFrame> frames,
+                                     int thread_count, const std::atomic<bool>* abort);
+
+  // Create and open an encoder context for config (shared by configure and segments)
+  static raii::AVCodecContextPtr OpenEncoderContext(const VideoEncoder::EncoderConfig& config, int thread_count,
+                                                    int* error_code, std::string* error_msg);
+
   // --- Output Helpers ---
   void OutputChunk(raii::AVPacketPtr packet, bool is_key, int64_t ts, int64_t dur, bool include_config);
   void OutputError(int code, const std::string& message);
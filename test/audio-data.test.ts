@@ -417,4 +417,152 @@ describe('AudioData', () => {
       expect(audioData.format).toBeNull();
     });
   });
+
+  describe('copyTo() channelLayout (non-standard)', () => {
+    // 5.1 (FL FR FC LFE BL BR) planar, each channel a constant
+    const LEVELS = [0.1, 0.2, 0.3, 0.4, 0.5, 0.6];
+    function create51(format: 'f32-planar' | 's16' = 'f32-planar', frames = 3000) {
+      const planes = new Float32Array(frames * 6);
+      LEVELS.forEach((level, ch) => planes.fill(level, ch * frames, (ch + 1) * frames));
+      const surround = new AudioData({
+        format: 'f32-planar',
+        sampleRate: 48000,
+        numberOfFrames: frames,
+        numberOfChannels: 6,
+        timestamp: 0,
+        data: planes,
+      });
+      if (format === 'f32-planar') return surround;
+
+      const interleaved = new Int16Array(frames * 6);
+      surround.copyTo(interleaved, { planeIndex: 0, format: 's16' });
+      surround.close();
+      return new AudioData({
+        format: 's16',
+        sampleRate: 48000,
+        numberOfFrames: frames,
+        numberOfChannels: 6,
+        timestamp: 0,
+        data: interleaved,
+      });
+    }
+
+    it('should size the destination for the target layout', () => {
+      const audioData = create51();
+      const stereo = { channelLayout: 'stereo' };
+      expect(audioData.allocationSize({ ...stereo, planeIndex: 0, format: 'f32' })).toBe(3000 * 8);
+      expect(audioData.allocationSize({ planeIndex: 0, channelLayout: 'mono' })).toBe(3000 * 4);
+      expect(() => audioData.allocationSize({ ...stereo, planeIndex: 2 })).toThrow(RangeError);
+      audioData.close();
+    });
+
+    it('should downmix 5.1 to stereo without LFE or the opposite side', () => {
+      const audioData = create51();
+      const left = new Float32Array(3000);
+      const right = new Float32Array(3000);
+      audioData.copyTo(left, { planeIndex: 0, channelLayout: 'stereo' });
+      audioData.copyTo(right, { planeIndex: 1, channelLayout: 'stereo' });
+
+      // FL + FC/sqrt2 + BL/sqrt2, normalized by the row sum 1 + 2/sqrt2
+      const norm = 1 + Math.SQRT2;
+      expect(left[0]).toBeCloseTo((0.1 + (0.3 + 0.5) * Math.SQRT1_2) / norm, 5);
+      expect(right[2999]).toBeCloseTo((0.2 + (0.3 + 0.6) * Math.SQRT1_2) / norm, 5);
+      audioData.close();
+    });
+
+    it('should match planar output when interleaving and converting', () => {
+      const audioData = create51('s16');
+      const stereo = { channelLayout: 'stereo' };
+      const planar = new Float32Array(3000 * 2);
+      for (const planeIndex of [0, 1]) {
+        const plane = planar.subarray(planeIndex * 3000, (planeIndex + 1) * 3000);
+        audioData.copyTo(plane, { ...stereo, planeIndex, format: 'f32-planar' });
+      }
+
+      const interleaved = new Float32Array(3000 * 2);
+      audioData.copyTo(interleaved, { ...stereo, planeIndex: 0, format: 'f32' });
+      const s16 = new Int16Array(3000 * 2);
+      audioData.copyTo(s16, { ...stereo, planeIndex: 0, format: 's16' });
+      for (const i of [0, 1023, 1024, 2999]) {
+        expect(interleaved[i * 2]).toBe(planar[i]);
+        expect(interleaved[i * 2 + 1]).toBe(planar[3000 + i]);
+        expect(s16[i * 2]).toBe(Math.round(planar[i] * 32768));
+      }
+      audioData.close();
+    });
+
+    it('should honour frameOffset and frameCount', () => {
+      const audioData = create51();
+      const full = new Float32Array(3000);
+      audioData.copyTo(full, { planeIndex: 0, channelLayout: 'mono' });
+      const part = new Float32Array(10);
+      audioData.copyTo(part, {
+        planeIndex: 0,
+        channelLayout: 'mono',
+        frameOffset: 1500,
+        frameCount: 10,
+      });
+      expect(Array.from(part)).toEqual(Array.from(full.subarray(1500, 1510)));
+      audioData.close();
+    });
+
+    it('should reorder channels with a channel list', () => {
+      const audioData = createTestAudioData({ format: 'f32-planar', numberOfFrames: 16 });
+      const right = new Float32Array(16);
+      const swapped = new Float32Array(16);
+      audioData.copyTo(right, { planeIndex: 1 });
+      audioData.copyTo(swapped, { planeIndex: 0, channelLayout: 'FR+FL' });
+      expect(Array.from(swapped)).toEqual(Array.from(right));
+      audioData.close();
+    });
+
+    it('should copy unchanged when the layout already matches', () => {
+      const audioData = createTestAudioData({ format: 'f32', numberOfFrames: 16 });
+      const plain = new Float32Array(32);
+      const same = new Float32Array(32);
+      audioData.copyTo(plain, { planeIndex: 0 });
+      audioData.copyTo(same, { planeIndex: 0, channelLayout: 'stereo' });
+      expect(Array.from(same)).toEqual(Array.from(plain));
+      audioData.close();
+    });
+
+    it('should reject invalid layouts', () => {
+      const audioData = createTestAudioData();
+      const dest = new Float32Array(2048);
+      const invalid = ['not-a-layout', 42 as unknown as string];
+      for (const channelLayout of invalid) {
+        expect(() => audioData.copyTo(dest, { planeIndex: 0, channelLayout })).toThrow(TypeError);
+      }
+      audioData.close();
+    });
+  });
+
+  describe('bufferPool (non-standard)', () => {
+    it('should recycle the buffer of a closed AudioData of the same shape', () => {
+      const before = AudioData.bufferPool();
+      for (let i = 0; i < 20; i++) {
+        createTestAudioData({ format: 'f32-planar', numberOfFrames: 960 }).close();
+      }
+      const after = AudioData.bufferPool();
+      expect(after.acquired - before.acquired).toBe(20);
+      expect(after.allocated - before.allocated).toBeLessThanOrEqual(1);
+    });
+
+    it('should free every pool when disabled', () => {
+      createTestAudioData().close();
+      expect(AudioData.bufferPool({ maxPools: 0 }).pools).toBe(0);
+
+      // Still works without pooling
+      const audioData = createTestAudioData();
+      expect(audioData.numberOfFrames).toBe(1024);
+      audioData.close();
+
+      expect(AudioData.bufferPool({ maxPools: 32 }).maxPools).toBe(32);
+    });
+
+    it('should reject an out-of-range maxPools', () => {
+      expect(() => AudioData.bufferPool({ maxPools: -1 })).toThrow(TypeError);
+      expect(() => AudioData.bufferPool({ maxPools: 1025 })).toThrow(TypeError);
+    });
+  });
 });
@@ -1,6 +1,7 @@
 // test/audio-decoder.test.ts
 import { describe, it, expect, beforeEach } from 'vitest';
-import { AudioDecoder, EncodedAudioChunk } from '@pproenca/node-webcodecs';
+import { AudioData, AudioDecoder, AudioEncoder, EncodedAudioChunk } from '@pproenca/node-webcodecs';
+import type { AudioDecoderConfig, NodeAudioDecoderConfig } from '@pproenca/node-webcodecs';
 
 describe('AudioDecoder', () => {
   describe('Constructor', () => {
@@ -513,4 +514,209 @@ describe('AudioDecoder', () => {
       decoder.close();
     });
   });
+  describe('minOutputDuration (non-standard)', () => {
+    // One second of 20 ms Opus packets
+    async function encodeOpus(): Promise<{
+      chunks: EncodedAudioChunk[];
+      config: AudioDecoderConfig;
+    }> {
+      const chunks: EncodedAudioChunk[] = [];
+      let config: AudioDecoderConfig | undefined;
+      const encoder = new AudioEncoder({
+        output: (chunk, metadata) => {
+          chunks.push(chunk);
+          config ??= metadata?.decoderConfig;
+        },
+        error: (e) => {
+          throw e;
+        },
+      });
+      encoder.configure({ codec: 'opus', sampleRate: 48000, numberOfChannels: 2 });
+      for (let i = 0; i < 50; i++) {
+        const data = new AudioData({
+          format: 's16',
+          sampleRate: 48000,
+          numberOfFrames: 960,
+          numberOfChannels: 2,
+          timestamp: i * 20_000,
+          data: new Int16Array(960 * 2).fill(1000),
+        });
+        encoder.encode(data);
+        data.close();
+      }
+      await encoder.flush();
+      encoder.close();
+      config ??= { codec: 'opus', sampleRate: 48000, numberOfChannels: 2 };
+      return { chunks, config };
+    }
+
+    async function decodeAll(
+      chunks: EncodedAudioChunk[],
+      config: NodeAudioDecoderConfig
+    ): Promise<Array<{ timestamp: number; frames: number }>> {
+      const outputs: Array<{ timestamp: number; frames: number }> = [];
+      const decoder = new AudioDecoder({
+        output: (data) => {
+          outputs.push({ timestamp: data.timestamp, frames: data.numberOfFrames });
+          data.close();
+        },
+        error: (e) => {
+          throw e;
+        },
+      });
+      decoder.configure(config);
+      for (const chunk of chunks) decoder.decode(chunk);
+      await decoder.flush();
+      decoder.close();
+      return outputs;
+    }
+
+    it('should merge contiguous frames into fewer, longer AudioData', async () => {
+      const { chunks, config } = await encodeOpus();
+      const single = await decodeAll(chunks, config);
+      const merged = await decodeAll(chunks, { ...config, minOutputDuration: 100_000 });
+
+      const total = (outputs: Array<{ frames: number }>) =>
+        outputs.reduce((sum, o) => sum + o.frames, 0);
+      expect(total(merged)).toBe(total(single));
+      expect(merged.length).toBeLessThan(single.length / 3);
+      for (let i = 1; i < merged.length; i++) {
+        expect(merged[i].timestamp).toBeGreaterThan(merged[i - 1].timestamp);
+      }
+      // Everything but the flushed remainder covers at least 100 ms
+      for (const output of merged.slice(1, -1)) {
+        expect(output.frames).toBeGreaterThanOrEqual(4800);
+      }
+    });
+
+    it('should reject a negative duration', () => {
+      const decoder = new AudioDecoder({ output: () => {}, error: () => {} });
+      expect(() =>
+        decoder.configure({
+          codec: 'opus',
+          sampleRate: 48000,
+          numberOfChannels: 2,
+          minOutputDuration: -1,
+        })
+      ).toThrow(TypeError);
+      decoder.close();
+    });
+
+    it('should be echoed by isConfigSupported', async () => {
+      const support = await AudioDecoder.isConfigSupported({
+        codec: 'opus',
+        sampleRate: 48000,
+        numberOfChannels: 2,
+        minOutputDuration: 50_000,
+      } as NodeAudioDecoderConfig);
+      expect((support.config as { minOutputDuration?: number }).minOutputDuration).toBe(50_000);
+    });
+  });
+
+  describe('maxConcealedGap (non-standard)', () => {
+    const config = { codec: 'ulaw', sampleRate: 8000, numberOfChannels: 1 };
+
+    // 20 ms ulaw packets at the given timestamps, decoded to s16 samples
+    async function decodeAt(
+      timestamps: number[],
+      options: NodeAudioDecoderConfig
+    ): Promise<Array<{ timestamp: number; samples: Int16Array }>> {
+      const outputs: Array<{ timestamp: number; samples: Int16Array }> = [];
+      const decoder = new AudioDecoder({
+        output: (data) => {
+          const samples = new Int16Array(data.numberOfFrames);
+          data.copyTo(samples, { planeIndex: 0 });
+          outputs.push({ timestamp: data.timestamp, samples });
+          data.close();
+        },
+        error: (e) => {
+          throw e;
+        },
+      });
+      decoder.configure(options);
+      for (const timestamp of timestamps) {
+        decoder.decode(
+          new EncodedAudioChunk({ type: 'key', timestamp, data: new Uint8Array(160).fill(0x90) })
+        );
+      }
+      await decoder.flush();
+      decoder.close();
+      return outputs;
+    }
+
+    it('should fill gaps with faded concealment frames', async () => {
+      const outputs = await decodeAt([0, 20_000, 80_000], { ...config, maxConcealedGap: 100_000 });
+
+      expect(outputs.map((o) => o.timestamp)).toEqual([0, 20_000, 40_000, 60_000, 80_000]);
+      const level = outputs[1].samples[159];
+      const faded = outputs[2].samples;
+      expect(faded.length).toBe(160);
+      expect(Math.abs(faded[0] - level)).toBeLessThan(Math.abs(level) / 100);
+      expect(Math.abs(faded[80])).toBeLessThan(Math.abs(level) / 2 + 1);
+      expect(Math.abs(faded[159])).toBeLessThan(Math.abs(level) / 100);
+      expect(outputs[3].samples.every((v) => v === 0)).toBe(true);
+      expect(outputs[4].samples[0]).toBe(level);
+    });
+
+    it('should leave gaps open by default and above the limit', async () => {
+      const timestamps = [0, 20_000, 80_000];
+      for (const options of [config, { ...config, maxConcealedGap: 40_000 }]) {
+        const outputs = await decodeAt(timestamps, options);
+        expect(outputs.map((o) => o.timestamp)).toEqual(timestamps);
+      }
+    });
+
+    it('should snap jittered timestamps to the sample timeline', async () => {
+      const outputs = await decodeAt([0, 20_400, 39_700, 60_900], {
+        ...config,
+        maxConcealedGap: 100_000,
+      });
+      expect(outputs.map((o) => o.timestamp)).toEqual([0, 20_000, 40_000, 60_000]);
+    });
+
+    it('should reject a negative gap and be echoed by isConfigSupported', async () => {
+      const decoder = new AudioDecoder({ output: () => {}, error: () => {} });
+      expect(() => decoder.configure({ ...config, maxConcealedGap: -1 })).toThrow(TypeError);
+      decoder.close();
+
+      const support = await AudioDecoder.isConfigSupported({
+        ...config,
+        maxConcealedGap: 60_000,
+      } as NodeAudioDecoderConfig);
+      expect((support.config as { maxConcealedGap?: number }).maxConcealedGap).toBe(60_000);
+    });
+  });
+
+  describe('stats (non-standard)', () => {
+    it('should count pooled sample buffers since configure()', async () => {
+      const decoder = new AudioDecoder({
+        output: (data) => data.close(),
+        error: (e) => {
+          throw e;
+        },
+      });
+      const config = { codec: 'ulaw', sampleRate: 8000, numberOfChannels: 1 };
+      decoder.configure(config);
+      for (let i = 0; i < 10; i++) {
+        decoder.decode(
+          new EncodedAudioChunk({
+            type: 'key',
+            timestamp: i * 20_000,
+            data: new Uint8Array(160).fill(0xff),
+          })
+        );
+        await decoder.flush();
+      }
+
+      // Each AudioData is closed before the next packet: one buffer goes round
+      const stats = decoder.stats;
+      expect(stats.bufferAcquisitions).toBe(10);
+      expect(stats.bufferAllocations).toBeLessThanOrEqual(1);
+      expect(stats.bufferAllocationsPerSecond).toBeGreaterThanOrEqual(0);
+
+      decoder.configure(config);
+      expect(decoder.stats.bufferAcquisitions).toBe(0);
+      decoder.close();
+    });
+  });
 });
@@ -3,7 +3,8 @@
 // AudioData constructor from AudioDataInit is fully implemented (2026-01-03)
 // Tests cover configure/flush/lifecycle cycles
 import { describe, it, expect } from 'vitest';
-import { AudioEncoder, EncodedAudioChunk } from '@pproenca/node-webcodecs';
+import { AudioData, AudioDecoder, AudioEncoder, EncodedAudioChunk } from '@pproenca/node-webcodecs';
+import type { AudioDecoderConfig, NodeAudioEncoderConfig } from '@pproenca/node-webcodecs';
 
 describe('AudioEncoder Integration', () => {
   describe('Encode lifecycle (configure → flush cycle)', () => {
@@ -70,6 +71,332 @@ describe('AudioEncoder Integration', () => {
     });
   });
 
+  describe('Frame size re-chunking', () => {
+    it('should encode AudioData of any size into full AAC frames', async () => {
+      const chunks: EncodedAudioChunk[] = [];
+      const errors: Error[] = [];
+      const encoder = new AudioEncoder({
+        output: (chunk) => chunks.push(chunk),
+        error: (e) => errors.push(e),
+      });
+      encoder.configure({ codec: 'mp4a.40.2', sampleRate: 48000, numberOfChannels: 2 });
+
+      // 10 ms inputs (480 samples) against the 1024-sample AAC frame
+      const frames = 480;
+      for (let i = 0; i < 20; i++) {
+        const data = new AudioData({
+          format: 'f32-planar',
+          sampleRate: 48000,
+          numberOfFrames: frames,
+          numberOfChannels: 2,
+          timestamp: 1_000_000 + i * 10_000,
+          data: new Float32Array(frames * 2).fill(0.1),
+        });
+        encoder.encode(data);
+        data.close();
+      }
+      await encoder.flush();
+      encoder.close();
+
+      expect(errors).toEqual([]);
+      // 9600 samples: 9 full frames plus a padded tail
+      expect(chunks.length).toBeGreaterThanOrEqual(9);
+      // Timestamps are microseconds, one 1024-sample frame apart
+      const step = chunks[2].timestamp - chunks[1].timestamp;
+      expect(Math.abs(step - (1024 * 1_000_000) / 48000)).toBeLessThanOrEqual(1);
+      expect(chunks[1].timestamp).toBeGreaterThan(900_000);
+    });
+  });
+
+  describe('Codec registry opus and aac options', () => {
+    // 200 ms of a 440 Hz tone, encoded and collected with the first metadata
+    async function encodeTone(config: NodeAudioEncoderConfig): Promise<{
+      chunks: EncodedAudioChunk[];
+      decoderConfig?: AudioDecoderConfig;
+    }> {
+      const chunks: EncodedAudioChunk[] = [];
+      let decoderConfig: AudioDecoderConfig | undefined;
+      let error: Error | null = null;
+      const encoder = new AudioEncoder({
+        output: (chunk, metadata) => {
+          chunks.push(chunk);
+          decoderConfig ??= metadata?.decoderConfig;
+        },
+        error: (e) => {
+          error = e;
+        },
+      });
+      encoder.configure(config);
+      const frames = 9600;
+      const samples = new Float32Array(frames * 2);
+      for (let i = 0; i < frames; i++) {
+        samples[i] = samples[frames + i] = 0.5 * Math.sin((2 * Math.PI * 440 * i) / 48000);
+      }
+      const data = new AudioData({
+        format: 'f32-planar',
+        sampleRate: 48000,
+        numberOfFrames: frames,
+        numberOfChannels: 2,
+        timestamp: 0,
+        data: samples,
+      });
+      encoder.encode(data);
+      data.close();
+      await encoder.flush();
+      encoder.close();
+      if (error) throw error;
+      return { chunks, decoderConfig };
+    }
+
+    it('should encode Opus with the configured frame duration', async () => {
+      const { chunks } = await encodeTone({
+        codec: 'opus',
+        sampleRate: 48000,
+        numberOfChannels: 2,
+        opus: { application: 'lowdelay', frameDuration: 10_000, complexity: 0 },
+      });
+      expect(chunks.length).toBeGreaterThanOrEqual(20);
+      expect(chunks[1].timestamp - chunks[0].timestamp).toBe(10_000);
+    });
+
+    it('should frame AAC as ADTS without a description', async () => {
+      const { chunks, decoderConfig } = await encodeTone({
+        codec: 'mp4a.40.2',
+        sampleRate: 48000,
+        numberOfChannels: 2,
+        aac: { format: 'adts' },
+      });
+      expect(decoderConfig?.description).toBeUndefined();
+
+      const header = new Uint8Array(chunks[0].byteLength);
+      chunks[0].copyTo(header);
+      expect(header[0]).toBe(0xff);
+      expect(header[1] & 0xf6).toBe(0xf0);
+      // frame_length covers header and payload
+      const length = ((header[3] & 0x03) << 11) | (header[4] << 3) | (header[5] >> 5);
+      expect(length).toBe(chunks[0].byteLength);
+
+      // In-band headers are enough for the decoder
+      let decoded = 0;
+      const decoder = new AudioDecoder({
+        output: (audio) => {
+          decoded += audio.numberOfFrames;
+          audio.close();
+        },
+        error: (e) => {
+          throw e;
+        },
+      });
+      decoder.configure({ codec: 'mp4a.40.2', sampleRate: 48000, numberOfChannels: 2 });
+      for (const chunk of chunks) decoder.decode(chunk);
+      await decoder.flush();
+      decoder.close();
+      expect(decoded).toBeGreaterThan(0);
+    });
+
+    it('should reject invalid option values with TypeError', () => {
+      const encoder = new AudioEncoder({ output: () => {}, error: () => {} });
+      const base = { codec: 'opus', sampleRate: 48000, numberOfChannels: 2 };
+      for (const opus of [{ complexity: 11 }, { frameDuration: 15_000 }, { packetlossperc: 101 }]) {
+        expect(() => encoder.configure({ ...base, opus })).toThrow(TypeError);
+      }
+      encoder.close();
+    });
+
+    it('should report Ogg framing as unsupported', async () => {
+      const config = {
+        codec: 'opus',
+        sampleRate: 48000,
+        numberOfChannels: 2,
+        opus: { format: 'ogg' as const },
+      };
+      const result = await AudioEncoder.isConfigSupported(config);
+      expect(result.supported).toBe(false);
+
+      const encoder = new AudioEncoder({ output: () => {}, error: () => {} });
+      expect(() => encoder.configure(config)).toThrow(/not supported/);
+      encoder.close();
+    });
+
+    it('should echo opus and aac members from isConfigSupported', async () => {
+      const result = await AudioEncoder.isConfigSupported({
+        codec: 'opus',
+        sampleRate: 48000,
+        numberOfChannels: 2,
+        opus: { complexity: 3, usedtx: true, unknown: 1 },
+      } as NodeAudioEncoderConfig);
+      expect(result.config?.opus).toEqual({ complexity: 3, usedtx: true });
+    });
+  });
+
+  describe('Input conversion', () => {
+    it('should convert sample format and rate to the encoder configuration', async () => {
+      const chunks: EncodedAudioChunk[] = [];
+      const errors: Error[] = [];
+      const encoder = new AudioEncoder({
+        output: (chunk) => chunks.push(chunk),
+        error: (e) => errors.push(e),
+      });
+      encoder.configure({ codec: 'opus', sampleRate: 48000, numberOfChannels: 2 });
+
+      // f32 interleaved 44.1 kHz input to an s16 48 kHz Opus encoder
+      const frames = 441;
+      for (let i = 0; i < 50; i++) {
+        const data = new AudioData({
+          format: 'f32',
+          sampleRate: 44100,
+          numberOfFrames: frames,
+          numberOfChannels: 2,
+          timestamp: i * 10_000,
+          data: new Float32Array(frames * 2).fill(0.1),
+        });
+        encoder.encode(data);
+        data.close();
+      }
+      await encoder.flush();
+      encoder.close();
+
+      expect(errors).toEqual([]);
+      // 500 ms of audio in 20 ms Opus frames
+      expect(chunks.length).toBeGreaterThanOrEqual(24);
+      for (let i = 1; i < chunks.length; i++) {
+        expect(chunks[i].timestamp).toBeGreaterThan(chunks[i - 1].timestamp);
+      }
+      expect(chunks[1].timestamp - chunks[0].timestamp).toBe(20_000);
+    });
+
+    it('should upmix mono input to the configured channel count', async () => {
+      const chunks: EncodedAudioChunk[] = [];
+      const errors: Error[] = [];
+      const encoder = new AudioEncoder({
+        output: (chunk) => chunks.push(chunk),
+        error: (e) => errors.push(e),
+      });
+      encoder.configure({ codec: 'mp4a.40.2', sampleRate: 48000, numberOfChannels: 2 });
+
+      const data = new AudioData({
+        format: 's16',
+        sampleRate: 48000,
+        numberOfFrames: 4800,
+        numberOfChannels: 1,
+        timestamp: 0,
+        data: new Int16Array(4800).fill(1000),
+      });
+      encoder.encode(data);
+      data.close();
+      await encoder.flush();
+      encoder.close();
+
+      expect(errors).toEqual([]);
+      expect(chunks.length).toBeGreaterThanOrEqual(4);
+    });
+  });
+
+  describe('PCM and G.711 (inline coding)', () => {
+    // 20 ms of 8 kHz mono speech-band telephony audio per AudioData
+    const FRAMES = 160;
+
+    function ramp(index: number): Int16Array {
+      return new Int16Array(FRAMES).map((_, i) => ((index * FRAMES + i) * 97) % 30000 - 15000);
+    }
+
+    it('should round-trip ulaw with asynchronous, ordered callbacks', async () => {
+      const chunks: EncodedAudioChunk[] = [];
+      const metadata: unknown[] = [];
+      const errors: Error[] = [];
+      const encoder = new AudioEncoder({
+        output: (chunk, meta) => {
+          chunks.push(chunk);
+          metadata.push(meta);
+        },
+        error: (e) => errors.push(e),
+      });
+      encoder.configure({ codec: 'ulaw', sampleRate: 8000, numberOfChannels: 1 });
+
+      const inputs = Array.from({ length: 10 }, (_, i) => ramp(i));
+      inputs.forEach((samples, i) => {
+        const data = new AudioData({
+          format: 's16',
+          sampleRate: 8000,
+          numberOfFrames: FRAMES,
+          numberOfChannels: 1,
+          timestamp: i * 20_000,
+          data: samples,
+        });
+        encoder.encode(data);
+        data.close();
+        // Outputs are never delivered from inside encode()
+        expect(chunks.length).toBe(0);
+      });
+      await encoder.flush();
+      encoder.close();
+
+      expect(errors).toEqual([]);
+      expect(chunks.map((c) => c.timestamp)).toEqual(inputs.map((_, i) => i * 20_000));
+      expect(chunks.every((c) => c.byteLength === FRAMES && c.duration === 20_000)).toBe(true);
+      expect(metadata[0]).toMatchObject({ decoderConfig: { codec: 'ulaw', sampleRate: 8000 } });
+      expect(metadata[1]).toBeUndefined();
+
+      const decoded: AudioData[] = [];
+      const decoder = new AudioDecoder({
+        output: (data) => decoded.push(data),
+        error: (e) => errors.push(e),
+      });
+      decoder.configure({ codec: 'ulaw', sampleRate: 8000, numberOfChannels: 1 });
+      for (const chunk of chunks) decoder.decode(chunk);
+      expect(decoded.length).toBe(0);
+      await decoder.flush();
+      decoder.close();
+
+      expect(errors).toEqual([]);
+      expect(decoded.map((d) => d.timestamp)).toEqual(chunks.map((c) => c.timestamp));
+      decoded.forEach((data, i) => {
+        const samples = new Int16Array(FRAMES);
+        data.copyTo(samples, { planeIndex: 0, format: 's16' });
+        data.close();
+        // Logarithmic quantization: error within 1/16 of the magnitude
+        samples.forEach((value, n) => {
+          const expected = inputs[i][n];
+          const tolerance = Math.max(16, Math.abs(expected) / 16);
+          expect(Math.abs(value - expected)).toBeLessThanOrEqual(tolerance);
+        });
+      });
+    });
+
+    it('should encode planar float input to interleaved s16be', async () => {
+      const chunks: EncodedAudioChunk[] = [];
+      const encoder = new AudioEncoder({
+        output: (chunk) => chunks.push(chunk),
+        error: (e) => {
+          throw e;
+        },
+      });
+      encoder.configure({ codec: 'pcm-s16be', sampleRate: 48000, numberOfChannels: 2 });
+
+      const planes = new Float32Array([0.5, -0.5, 0.25, -0.25]); // L: 0.5, -0.5  R: 0.25, -0.25
+      const data = new AudioData({
+        format: 'f32-planar',
+        sampleRate: 48000,
+        numberOfFrames: 2,
+        numberOfChannels: 2,
+        timestamp: 0,
+        data: planes,
+      });
+      encoder.encode(data);
+      data.close();
+      await encoder.flush();
+      encoder.close();
+
+      expect(chunks.length).toBe(1);
+      const bytes = new Uint8Array(chunks[0].byteLength);
+      chunks[0].copyTo(bytes);
+      const view = new DataView(bytes.buffer);
+      expect([0, 2, 4, 6].map((offset) => view.getInt16(offset, false))).toEqual([
+        16384, 8192, -16384, -8192,
+      ]);
+    });
+  });
+
   describe('Error Handling', () => {
     it('should call error callback on encoding errors', async () => {
       const encoder = new AudioEncoder({
@@ -343,6 +343,17 @@ describe('AudioEncoder', () => {
       expect(result.config.numberOfChannels).toBe(2);
     });
 
+    it('should return supported=false for a sample rate the encoder cannot take', async () => {
+      // Opus encoders only accept 48 kHz (and libopus its integer divisors)
+      const result = await AudioEncoder.isConfigSupported({
+        codec: 'opus',
+        sampleRate: 44100,
+        numberOfChannels: 2,
+      });
+      expect(result.supported).toBe(false);
+      expect(result.config.sampleRate).toBe(44100);
+    });
+
     it('should return a promise with supported=false for invalid codec', async () => {
       const result = await AudioEncoder.isConfigSupported({
         codec: 'not-a-codec',
@@ -0,0 +1,265 @@
+// test/audio-mixer.test.ts
+import { describe, it, expect } from 'vitest';
+import { AudioData, AudioEncoder, AudioMixer } from '@pproenca/node-webcodecs';
+import type { EncodedAudioChunk } from '@pproenca/node-webcodecs';
+
+type MixerOutput = InstanceType<typeof AudioData>;
+
+function constant(
+  value: number,
+  options: { frames: number; timestamp: number; channels?: number }
+): MixerOutput {
+  const channels = options.channels ?? 1;
+  return new AudioData({
+    format: 'f32-planar',
+    sampleRate: 48000,
+    numberOfFrames: options.frames,
+    numberOfChannels: channels,
+    timestamp: options.timestamp,
+    data: new Float32Array(options.frames * channels).fill(value),
+  });
+}
+
+function plane(data: MixerOutput, planeIndex = 0): Float32Array {
+  const out = new Float32Array(data.numberOfFrames);
+  data.copyTo(out, { planeIndex, format: 'f32-planar' });
+  return out;
+}
+
+function createMixer(outputs: MixerOutput[], errors: unknown[] = []) {
+  return new AudioMixer({
+    output: (data) => outputs.push(data),
+    error: (e) => errors.push(e),
+  });
+}
+
+describe('AudioMixer (non-standard)', () => {
+  describe('Constructor and configure', () => {
+    it('requires an error callback and one output', () => {
+      // @ts-ignore - Testing missing required field
+      expect(() => new AudioMixer({ output: () => {} })).toThrow();
+      // @ts-ignore - Testing missing required field
+      expect(() => new AudioMixer({ error: () => {} })).toThrow();
+      const encoder = { encode: () => {} };
+      expect(() => new AudioMixer({ output: () => {}, encoder, error: () => {} })).toThrow(
+        TypeError
+      );
+    });
+
+    it('validates the config', () => {
+      const mixer = createMixer([]);
+      expect(mixer.state).toBe('unconfigured');
+      // @ts-ignore - Testing missing required field
+      expect(() => mixer.configure({ numberOfChannels: 2 })).toThrow(TypeError);
+      expect(() => mixer.configure({ sampleRate: 48000, numberOfChannels: 0 })).toThrow(TypeError);
+      expect(() =>
+        mixer.configure({ sampleRate: 48000, numberOfChannels: 2, frameDuration: -1 })
+      ).toThrow(TypeError);
+      expect(() =>
+        mixer.configure({ sampleRate: 8000, numberOfChannels: 1, frameDuration: 100 })
+      ).toThrow(TypeError);
+
+      mixer.configure({ sampleRate: 48000, numberOfChannels: 2 });
+      expect(mixer.state).toBe('configured');
+      mixer.close();
+      expect(mixer.state).toBe('closed');
+    });
+
+    it('rejects push before configure and after close', () => {
+      const mixer = createMixer([]);
+      const data = constant(0.1, { frames: 480, timestamp: 0 });
+      expect(() => mixer.push('a', data)).toThrow(/InvalidStateError|unconfigured/);
+      mixer.configure({ sampleRate: 48000, numberOfChannels: 1 });
+      expect(() => mixer.push('a', {} as MixerOutput)).toThrow(TypeError);
+      mixer.close();
+      expect(() => mixer.push('a', data)).toThrow();
+      data.close();
+    });
+  });
+
+  describe('Mixing', () => {
+    // A large maxLatency holds every block until flush(), whatever the push order
+    const held = {
+      sampleRate: 48000,
+      numberOfChannels: 1,
+      frameDuration: 10000,
+      maxLatency: 100000,
+    };
+
+    it('sums aligned sources into frameDuration blocks', async () => {
+      const outputs: MixerOutput[] = [];
+      const mixer = createMixer(outputs);
+      mixer.configure(held);
+
+      for (const [source, value] of [['a', 0.25], ['b', 0.125]] as const) {
+        const data = constant(value, { frames: 960, timestamp: 1000000 });
+        mixer.push(source, data);
+        data.close();
+      }
+      await mixer.flush();
+
+      expect(outputs.map((o) => o.timestamp)).toEqual([1000000, 1010000]);
+      for (const output of outputs) {
+        expect(output.format).toBe('f32-planar');
+        expect(output.numberOfFrames).toBe(480);
+        expect(plane(output).every((v) => Math.abs(v - 0.375) < 1e-6)).toBe(true);
+        output.close();
+      }
+      mixer.close();
+    });
+
+    it('aligns sources by timestamp', async () => {
+      const outputs: MixerOutput[] = [];
+      const mixer = createMixer(outputs);
+      mixer.configure(held);
+
+      const a = constant(0.5, { frames: 960, timestamp: 0 });
+      const b = constant(0.25, { frames: 240, timestamp: 5000 }); // 5 ms later
+      mixer.push('a', a);
+      mixer.push('b', b);
+      a.close();
+      b.close();
+      await mixer.flush();
+
+      const first = plane(outputs[0]);
+      expect(first[239]).toBeCloseTo(0.5);
+      expect(first[240]).toBeCloseTo(0.75);
+      expect(first[479]).toBeCloseTo(0.75);
+      expect(plane(outputs[1])[0]).toBeCloseTo(0.5);
+      for (const output of outputs) output.close();
+      mixer.close();
+    });
+
+    it('resamples and remixes inputs to the mixer format', async () => {
+      const outputs: MixerOutput[] = [];
+      const mixer = createMixer(outputs);
+      mixer.configure({ sampleRate: 48000, numberOfChannels: 2, frameDuration: 20000 });
+
+      // One second of mono 44.1 kHz s16 in 1024-frame chunks
+      const chunk = 1024;
+      const chunks = Math.floor(44100 / chunk);
+      for (let i = 0; i < chunks; i++) {
+        const data = new AudioData({
+          format: 's16',
+          sampleRate: 44100,
+          numberOfFrames: chunk,
+          numberOfChannels: 1,
+          timestamp: Math.round((i * chunk * 1e6) / 44100),
+          data: new Int16Array(chunk).fill(8192),
+        });
+        mixer.push('voice', data);
+        data.close();
+      }
+      await mixer.flush();
+
+      const total = outputs.reduce((sum, o) => sum + o.numberOfFrames, 0);
+      expect(Math.abs(total - (chunks * chunk * 48000) / 44100)).toBeLessThan(64);
+      const middle = outputs[Math.floor(outputs.length / 2)];
+      expect(middle.sampleRate).toBe(48000);
+      expect(middle.numberOfChannels).toBe(2);
+      // Mono is copied to both channels at its level
+      expect(plane(middle, 0)[100]).toBeCloseTo(0.25, 2);
+      expect(plane(middle, 1)[100]).toBeCloseTo(0.25, 2);
+      for (const output of outputs) output.close();
+      mixer.close();
+    });
+
+    it('soft clips the sum unless disabled', async () => {
+      for (const softClip of [true, false]) {
+        const outputs: MixerOutput[] = [];
+        const mixer = createMixer(outputs);
+        mixer.configure({ sampleRate: 48000, numberOfChannels: 1, frameDuration: 10000, softClip });
+        mixer.push('a', constant(0.9, { frames: 480, timestamp: 0 }));
+        mixer.push('b', constant(0.9, { frames: 480, timestamp: 0 }));
+        await mixer.flush();
+        expect(plane(outputs[0])[0]).toBeCloseTo(softClip ? 1.0 : 1.8);
+        outputs[0].close();
+        mixer.close();
+      }
+    });
+
+    it('mixes a lagging source as silence after maxLatency', async () => {
+      const outputs: MixerOutput[] = [];
+      const mixer = createMixer(outputs);
+      mixer.configure({
+        sampleRate: 48000,
+        numberOfChannels: 1,
+        frameDuration: 10000,
+        maxLatency: 10000,
+      });
+
+      mixer.push('slow', constant(0.5, { frames: 480, timestamp: 0 }));
+      for (let t = 0; t < 40000; t += 10000) {
+        mixer.push('fast', constant(0.25, { frames: 480, timestamp: t }));
+      }
+      // Mixed without waiting for a flush: 'fast' ran a block ahead of 'slow'
+      await new Promise((resolve) => setTimeout(resolve, 50));
+      expect(outputs.length).toBeGreaterThanOrEqual(2);
+      expect(plane(outputs[0])[0]).toBeCloseTo(0.75);
+      expect(plane(outputs[1])[0]).toBeCloseTo(0.25);
+
+      await mixer.flush();
+      for (const output of outputs) output.close();
+      mixer.close();
+    });
+
+    it('mixes what a removed source has buffered', async () => {
+      const outputs: MixerOutput[] = [];
+      const mixer = createMixer(outputs);
+      mixer.configure({ sampleRate: 48000, numberOfChannels: 1, frameDuration: 10000 });
+
+      mixer.push('b', constant(0.25, { frames: 480, timestamp: 0 }));
+      mixer.removeSource('b');
+      mixer.push('a', constant(0.5, { frames: 960, timestamp: 0 }));
+      await mixer.flush();
+
+      expect(outputs.length).toBe(2);
+      expect(plane(outputs[0])[0]).toBeCloseTo(0.75);
+      expect(plane(outputs[1])[0]).toBeCloseTo(0.5);
+      for (const output of outputs) output.close();
+      mixer.close();
+    });
+  });
+
+  describe('Lifecycle', () => {
+    it('reset aborts pending flushes and requires configure', async () => {
+      const mixer = createMixer([]);
+      mixer.configure({ sampleRate: 48000, numberOfChannels: 1 });
+      mixer.push('a', constant(0.5, { frames: 480, timestamp: 0 }));
+      const flushed = mixer.flush();
+      mixer.reset();
+      await expect(flushed).rejects.toMatchObject({ name: 'AbortError' });
+      expect(mixer.state).toBe('unconfigured');
+      expect(() => mixer.removeSource('a')).toThrow();
+      mixer.close();
+    });
+
+    it('feeds an AudioEncoder directly', async () => {
+      const chunks: EncodedAudioChunk[] = [];
+      const errors: unknown[] = [];
+      const encoder = new AudioEncoder({
+        output: (chunk) => chunks.push(chunk),
+        error: (e) => errors.push(e),
+      });
+      encoder.configure({ codec: 'opus', sampleRate: 48000, numberOfChannels: 2, bitrate: 64000 });
+
+      const mixer = new AudioMixer({ encoder, error: (e) => errors.push(e) });
+      mixer.configure({ sampleRate: 48000, numberOfChannels: 2, frameDuration: 20000 });
+      for (let t = 0; t < 200000; t += 20000) {
+        for (const source of ['a', 'b']) {
+          const data = constant(0.1, { frames: 960, timestamp: t, channels: 2 });
+          mixer.push(source, data);
+          data.close();
+        }
+      }
+      await mixer.flush();
+      await encoder.flush();
+
+      expect(errors).toEqual([]);
+      expect(chunks.length).toBeGreaterThanOrEqual(9);
+      expect(chunks[0].timestamp).toBe(0);
+      mixer.close();
+      encoder.close();
+    });
+  });
+});
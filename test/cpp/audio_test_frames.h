@@ -0,0 +1,80 @@
+#pragma once
+/**
+ * audio_test_frames.h - Audio AVFrame factories for unit tests
+ *
+ * Shared by the audio buffer pool, FIFO, coalescer and gap concealer tests:
+ *
+ * - MakeUnallocatedAudioFrame(): format, layout and size only, for code
+ *   under test that allocates the sample buffers itself
+ * - MakeAudioFrame(): allocated frame holding a ramp (sample i of every
+ *   channel is first_sample + i) for s16/flt, packed or planar; other
+ *   sample formats are silent
+ * - AudioSampleAt(): reads one sample back, packed or planar
+ */
+
+#include <cstdint>
+
+#include "../../src/ffmpeg_raii.h"
+
+namespace webcodecs::testing {
+
+inline int AudioFrameChannels(const AVFrame* frame) {
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+  return frame->ch_layout.nb_channels;
+#else
+  return frame->channels;
+#endif
+}
+
+inline raii::AVFramePtr MakeUnallocatedAudioFrame(AVSampleFormat format, int channels, int nb_samples,
+                                                  int64_t pts = AV_NOPTS_VALUE, int sample_rate = 48000) {
+  raii::AVFramePtr frame = raii::MakeAvFrame();
+  frame->format = format;
+  frame->sample_rate = sample_rate;
+  frame->nb_samples = nb_samples;
+  frame->pts = pts;
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+  av_channel_layout_default(&frame->ch_layout, channels);
+#else
+  frame->channels = channels;
+  frame->channel_layout = av_get_default_channel_layout(channels);
+#endif
+  return frame;
+}
+
+/** Address of sample index of channel ch, packed or planar. */
+template <typename T>
+T* AudioSamplePtr(const AVFrame* frame, int ch, int index) {
+  const auto format = static_cast<AVSampleFormat>(frame->format);
+  if (av_sample_fmt_is_planar(format)) return reinterpret_cast<T*>(frame->extended_data[ch]) + index;
+  return reinterpret_cast<T*>(frame->extended_data[0]) + index * AudioFrameChannels(frame) + ch;
+}
+
+template <typename T>
+T AudioSampleAt(const AVFrame* frame, int ch, int index) {
+  return *AudioSamplePtr<T>(frame, ch, index);
+}
+
+inline raii::AVFramePtr MakeAudioFrame(AVSampleFormat format, int channels, int nb_samples, int first_sample = 0,
+                                       int64_t pts = AV_NOPTS_VALUE, int sample_rate = 48000) {
+  raii::AVFramePtr frame = MakeUnallocatedAudioFrame(format, channels, nb_samples, pts, sample_rate);
+  if (av_frame_get_buffer(frame.get(), 0) < 0) return nullptr;
+
+  const AVSampleFormat packed = av_get_packed_sample_fmt(format);
+  if (packed != AV_SAMPLE_FMT_S16 && packed != AV_SAMPLE_FMT_FLT) {
+    av_samples_set_silence(frame->extended_data, 0, nb_samples, channels, format);
+    return frame;
+  }
+  for (int ch = 0; ch < channels; ch++) {
+    for (int i = 0; i < nb_samples; i++) {
+      if (packed == AV_SAMPLE_FMT_S16) {
+        *AudioSamplePtr<int16_t>(frame.get(), ch, i) = static_cast<int16_t>(first_sample + i);
+      } else {
+        *AudioSamplePtr<float>(frame.get(), ch, i) = static_cast<float>(first_sample + i);
+      }
+    }
+  }
+  return frame;
+}
+
+}  // namespace webcodecs::testing
@@ -0,0 +1,72 @@
+/**
+ * test_aac_adts.cpp - Unit tests for ADTS framing
+ *
+ * Tests AudioSpecificConfig parsing (including implicit HE-AAC signalling
+ * and unsupported configurations) and header bit layout.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "../../src/shared/aac_adts.h"
+
+namespace adts = webcodecs::adts;
+
+TEST(AacAdtsTest, ParsesAacLcConfig) {
+  // AAC-LC, 48 kHz (index 3), stereo
+  const uint8_t asc[] = {0x11, 0x90};
+  auto config = adts::ParseAudioSpecificConfig(asc, sizeof(asc));
+  ASSERT_TRUE(config);
+  EXPECT_EQ(config->object_type, 2);
+  EXPECT_EQ(config->sampling_index, 3);
+  EXPECT_EQ(config->channel_config, 2);
+}
+
+TEST(AacAdtsTest, SignalsHeAacAsCoreLc) {
+  // SBR (5), core 24 kHz (index 6), stereo, extension 48 kHz (index 3), core AAC-LC
+  const uint8_t asc[] = {0x2b, 0x11, 0x88, 0x00};
+  auto config = adts::ParseAudioSpecificConfig(asc, sizeof(asc));
+  ASSERT_TRUE(config);
+  EXPECT_EQ(config->object_type, 2);
+  EXPECT_EQ(config->sampling_index, 6);
+  EXPECT_EQ(config->channel_config, 2);
+}
+
+TEST(AacAdtsTest, RejectsUnrepresentableConfigs) {
+  const uint8_t explicit_rate[] = {0x17, 0x80, 0x00, 0x00, 0x00};  // index 15
+  const uint8_t pce[] = {0x11, 0x80};                               // channelConfiguration 0
+  const uint8_t escaped[] = {0xf8, 0x00, 0x00};                     // object type 31
+  EXPECT_FALSE(adts::ParseAudioSpecificConfig(explicit_rate, sizeof(explicit_rate)));
+  EXPECT_FALSE(adts::ParseAudioSpecificConfig(pce, sizeof(pce)));
+  EXPECT_FALSE(adts::ParseAudioSpecificConfig(escaped, sizeof(escaped)));
+  EXPECT_FALSE(adts::ParseAudioSpecificConfig(nullptr, 0));
+}
+
+TEST(AacAdtsTest, WritesHeaderFields) {
+  const adts::Config config{2, 3, 2};
+  uint8_t header[adts::kHeaderSize];
+  ASSERT_TRUE(adts::WriteHeader(config, 371, header));
+
+  // Same bytes as FFmpeg's ADTS muxer for a 378-byte AAC-LC 48 kHz stereo frame
+  const uint8_t expected[] = {0xff, 0xf1, 0x4c, 0x80, 0x2f, 0x5f, 0xfc};
+  for (size_t i = 0; i < adts::kHeaderSize; i++) {
+    EXPECT_EQ(header[i], expected[i]) << "byte " << i;
+  }
+
+  const int frame_size = ((header[3] & 0x03) << 11) | (header[4] << 3) | (header[5] >> 5);
+  EXPECT_EQ(frame_size, 378);
+}
+
+TEST(AacAdtsTest, CarriesChannelConfigAcrossBytes) {
+  uint8_t header[adts::kHeaderSize];
+  ASSERT_TRUE(adts::WriteHeader(adts::Config{2, 4, 7}, 10, header));
+  EXPECT_EQ(((header[2] & 0x01) << 2) | (header[3] >> 6), 7);
+  EXPECT_EQ((header[2] >> 2) & 0x0f, 4);
+}
+
+TEST(AacAdtsTest, RejectsOversizedFrames) {
+  uint8_t header[adts::kHeaderSize];
+  EXPECT_TRUE(adts::WriteHeader(adts::Config{2, 3, 2}, adts::kMaxFrameSize - adts::kHeaderSize, header));
+  EXPECT_FALSE(adts::WriteHeader(adts::Config{2, 3, 2}, adts::kMaxFrameSize, header));
+}
@@ -0,0 +1,195 @@
+/**
+ * test_audio_buffer_pool.cpp - Unit tests for GlobalAudioBufferPool
+ *
+ * Tests buffer reuse per (format, channels, nb_samples), plane layout,
+ * per-stream counters, LRU eviction, the disabled (pass-through) mode and
+ * the get_buffer2 fallback for decoders without DR1.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "../../src/shared/audio_buffer_pool.h"
+#include "../../src/ffmpeg_raii.h"
+#include "audio_test_frames.h"
+
+using webcodecs::AudioBufferCounters;
+using webcodecs::GlobalAudioBufferPool;
+using webcodecs::raii::AVFramePtr;
+using webcodecs::testing::MakeUnallocatedAudioFrame;
+
+namespace {
+
+class AudioBufferPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    pool_.SetMaxPools(GlobalAudioBufferPool::kDefaultMaxPools);
+    pool_.Clear();
+    pool_.ResetStats();
+  }
+
+  void TearDown() override {
+    pool_.SetMaxPools(GlobalAudioBufferPool::kDefaultMaxPools);
+    pool_.Clear();
+  }
+
+  GlobalAudioBufferPool& pool_ = GlobalAudioBufferPool::Instance();
+};
+
+}  // namespace
+
+TEST_F(AudioBufferPoolTest, ReusesReleasedBuffers) {
+  AVFramePtr first = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_FLTP, 2, 960);
+  ASSERT_EQ(pool_.GetBuffer(first.get()), 0);
+  const uint8_t* data = first->data[0];
+  first.reset();
+
+  AVFramePtr second = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_FLTP, 2, 960);
+  ASSERT_EQ(pool_.GetBuffer(second.get()), 0);
+  EXPECT_EQ(second->data[0], data);
+  EXPECT_EQ(pool_.stats().acquired.load(), 2u);
+  EXPECT_EQ(pool_.stats().allocated.load(), 1u);
+}
+
+TEST_F(AudioBufferPoolTest, KeysBySampleFormatChannelsAndFrames) {
+  AVFramePtr a = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_FLTP, 2, 960);
+  ASSERT_EQ(pool_.GetBuffer(a.get()), 0);
+  a.reset();
+
+  AVFramePtr b = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_FLTP, 2, 480);
+  AVFramePtr c = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_FLTP, 1, 960);
+  AVFramePtr d = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_S16, 2, 960);
+  ASSERT_EQ(pool_.GetBuffer(b.get()), 0);
+  ASSERT_EQ(pool_.GetBuffer(c.get()), 0);
+  ASSERT_EQ(pool_.GetBuffer(d.get()), 0);
+  EXPECT_EQ(pool_.size(), 4u);
+  EXPECT_EQ(pool_.stats().allocated.load(), 4u);
+}
+
+TEST_F(AudioBufferPoolTest, LaysOutPlanesLikeFrameGetBuffer) {
+  AVFramePtr pooled = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_S16P, 3, 1000);
+  AVFramePtr reference = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_S16P, 3, 1000);
+  ASSERT_EQ(pool_.GetBuffer(pooled.get()), 0);
+  ASSERT_EQ(av_frame_get_buffer(reference.get(), 0), 0);
+
+  EXPECT_EQ(pooled->linesize[0], reference->linesize[0]);
+  for (int ch = 0; ch < 3; ch++) {
+    EXPECT_EQ(pooled->extended_data[ch], pooled->buf[0]->data + ch * pooled->linesize[0]);
+    std::memset(pooled->extended_data[ch], ch, 1000 * sizeof(int16_t));
+  }
+  EXPECT_TRUE(av_frame_is_writable(pooled.get()));
+
+  // Copies and references work as with any refcounted frame
+  AVFramePtr copy = webcodecs::raii::CloneAvFrame(pooled.get());
+  ASSERT_NE(copy, nullptr);
+  EXPECT_EQ(copy->extended_data[2][0], 2);
+}
+
+TEST_F(AudioBufferPoolTest, SupportsMoreChannelsThanDataPointers) {
+  AVFramePtr frame = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_FLTP, 12, 256);
+  ASSERT_EQ(pool_.GetBuffer(frame.get()), 0);
+  ASSERT_NE(frame->extended_data, frame->data);
+  for (int ch = 0; ch < AV_NUM_DATA_POINTERS; ch++) {
+    EXPECT_EQ(frame->data[ch], frame->extended_data[ch]);
+  }
+  EXPECT_EQ(frame->extended_data[11], frame->buf[0]->data + 11 * frame->linesize[0]);
+}
+
+TEST_F(AudioBufferPoolTest, CountsPerStream) {
+  AudioBufferCounters counters;
+  counters.Reset();
+
+  for (int i = 0; i < 10; i++) {
+    AVFramePtr frame = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_S16, 1, 160);
+    ASSERT_EQ(pool_.GetBuffer(frame.get(), &counters), 0);
+  }
+  AVFramePtr other = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_S16, 1, 160);
+  ASSERT_EQ(pool_.GetBuffer(other.get()), 0);
+
+  EXPECT_EQ(counters.acquired.load(), 10u);
+  EXPECT_EQ(counters.allocated.load(), 1u);
+  EXPECT_GT(counters.AllocationsPerSecond(), 0.0);
+
+  counters.Reset();
+  EXPECT_EQ(counters.allocated.load(), 0u);
+  EXPECT_EQ(counters.AllocationsPerSecond(), 0.0);
+}
+
+TEST_F(AudioBufferPoolTest, EvictsLeastRecentlyUsedKeys) {
+  pool_.SetMaxPools(2);
+  for (int nb_samples : {100, 200, 100, 300}) {
+    AVFramePtr frame = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_FLT, 2, nb_samples);
+    ASSERT_EQ(pool_.GetBuffer(frame.get()), 0);
+  }
+  // 200 was the least recently used when 300 arrived
+  EXPECT_EQ(pool_.size(), 2u);
+  EXPECT_EQ(pool_.stats().evictions.load(), 1u);
+
+  AVFramePtr frame = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_FLT, 2, 100);
+  ASSERT_EQ(pool_.GetBuffer(frame.get()), 0);
+  EXPECT_EQ(pool_.stats().allocated.load(), 3u);
+}
+
+TEST_F(AudioBufferPoolTest, BufferOutlivesEvictedPool) {
+  AVFramePtr frame = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_FLT, 2, 1024);
+  ASSERT_EQ(pool_.GetBuffer(frame.get()), 0);
+  pool_.Clear();
+  EXPECT_EQ(pool_.size(), 0u);
+
+  // Still valid; freed with its pool when released
+  std::memset(frame->data[0], 0, 1024 * 2 * sizeof(float));
+  frame.reset();
+}
+
+TEST_F(AudioBufferPoolTest, DisabledFallsBackToFrameGetBuffer) {
+  pool_.SetMaxPools(0);
+  AudioBufferCounters counters;
+  AVFramePtr frame = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_FLTP, 2, 960);
+  ASSERT_EQ(pool_.GetBuffer(frame.get(), &counters), 0);
+  EXPECT_NE(frame->data[1], nullptr);
+  EXPECT_EQ(pool_.size(), 0u);
+  EXPECT_EQ(counters.allocated.load(), 1u);
+}
+
+TEST_F(AudioBufferPoolTest, GetBuffer2PoolsOnlyDr1Decoders) {
+  const AVCodec* codec = avcodec_find_decoder(AV_CODEC_ID_PCM_S16LE);
+  ASSERT_NE(codec, nullptr);
+  ASSERT_TRUE(codec->capabilities & AV_CODEC_CAP_DR1);
+  webcodecs::raii::AVCodecContextPtr ctx = webcodecs::raii::MakeAvCodecContext(codec);
+  ASSERT_NE(ctx, nullptr);
+  ctx->sample_rate = 48000;
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+  av_channel_layout_default(&ctx->ch_layout, 2);
+#else
+  ctx->channels = 2;
+  ctx->channel_layout = av_get_default_channel_layout(2);
+#endif
+  ASSERT_EQ(avcodec_open2(ctx.get(), codec, nullptr), 0);
+  AudioBufferCounters counters;
+  ctx->opaque = &counters;
+
+  AVFramePtr pooled = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_S16, 2, 480);
+  ASSERT_EQ(webcodecs::AudioBufferPoolGetBuffer2(ctx.get(), pooled.get(), 0), 0);
+  EXPECT_EQ(counters.acquired.load(), 1u);
+
+  // Same decoder without DR1: the default allocator, not the pool
+  AVCodec no_dr1 = *codec;
+  no_dr1.capabilities &= ~AV_CODEC_CAP_DR1;
+  ctx->codec = &no_dr1;
+  AVFramePtr fallback = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_S16, 2, 480);
+  const int ret = webcodecs::AudioBufferPoolGetBuffer2(ctx.get(), fallback.get(), 0);
+  ctx->codec = codec;  // Restored before the context is freed
+  ASSERT_EQ(ret, 0);
+  EXPECT_NE(fallback->buf[0], nullptr);
+  EXPECT_EQ(counters.acquired.load(), 1u);
+}
+
+TEST_F(AudioBufferPoolTest, RejectsIncompleteFrames) {
+  AVFramePtr frame = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_FLTP, 2, 0);
+  EXPECT_EQ(pool_.GetBuffer(frame.get()), AVERROR(EINVAL));
+
+  AVFramePtr allocated = MakeUnallocatedAudioFrame(AV_SAMPLE_FMT_FLTP, 2, 16);
+  ASSERT_EQ(pool_.GetBuffer(allocated.get()), 0);
+  EXPECT_EQ(pool_.GetBuffer(allocated.get()), AVERROR(EINVAL));
+}
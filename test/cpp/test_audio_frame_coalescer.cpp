@@ -0,0 +1,135 @@
+/**
+ * test_audio_frame_coalescer.cpp - Unit tests for AudioFrameCoalescer
+ *
+ * Tests merging of contiguous frames up to the minimum duration, emission
+ * on discontinuities and parameter changes, and flush/reset behaviour.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "../../src/shared/audio_frame_coalescer.h"
+#include "audio_test_frames.h"
+
+using webcodecs::AudioFrameCoalescer;
+using webcodecs::raii::AVFramePtr;
+using webcodecs::testing::AudioSampleAt;
+using webcodecs::testing::MakeAudioFrame;
+
+namespace {
+
+constexpr int kRate = 48000;
+constexpr int kFrame = 120;          // 2.5 ms Opus frame
+constexpr int64_t kFrameUs = 2500;
+
+// 48 kHz fltp frame whose samples continue a ramp starting at first_sample
+AVFramePtr MakeFrame(int64_t pts, int first_sample, int channels = 2, int nb_samples = kFrame) {
+  return MakeAudioFrame(AV_SAMPLE_FMT_FLTP, channels, nb_samples, first_sample, pts, kRate);
+}
+
+}  // namespace
+
+TEST(AudioFrameCoalescerTest, DisabledPassesFramesThrough) {
+  AudioFrameCoalescer coalescer;
+  std::vector<AVFramePtr> ready;
+  ASSERT_EQ(coalescer.Push(MakeFrame(0, 0), &ready), 0);
+  ASSERT_EQ(ready.size(), 1u);
+  EXPECT_EQ(ready[0]->nb_samples, kFrame);
+  EXPECT_EQ(coalescer.pending(), 0u);
+}
+
+TEST(AudioFrameCoalescerTest, MergesContiguousFramesToMinimumDuration) {
+  AudioFrameCoalescer coalescer;
+  coalescer.Configure(10000);  // 4 frames of 2.5 ms
+
+  std::vector<AVFramePtr> ready;
+  for (int i = 0; i < 8; i++) {
+    ASSERT_EQ(coalescer.Push(MakeFrame(1000000 + i * kFrameUs, i * kFrame), &ready), 0);
+  }
+
+  ASSERT_EQ(ready.size(), 2u);
+  for (int n = 0; n < 2; n++) {
+    EXPECT_EQ(ready[n]->nb_samples, 4 * kFrame);
+    EXPECT_EQ(ready[n]->pts, 1000000 + n * 4 * kFrameUs);
+    // Samples are the concatenation of the inputs, on every channel
+    for (int i = 0; i < 4 * kFrame; i++) {
+      ASSERT_EQ(AudioSampleAt<float>(ready[n].get(), 0, i), static_cast<float>(n * 4 * kFrame + i));
+      ASSERT_EQ(AudioSampleAt<float>(ready[n].get(), 1, i), static_cast<float>(n * 4 * kFrame + i));
+    }
+  }
+  EXPECT_EQ(coalescer.pending(), 0u);
+}
+
+TEST(AudioFrameCoalescerTest, TimestampGapEmitsPending) {
+  AudioFrameCoalescer coalescer;
+  coalescer.Configure(10000);
+
+  std::vector<AVFramePtr> ready;
+  coalescer.Push(MakeFrame(0, 0), &ready);
+  coalescer.Push(MakeFrame(kFrameUs, kFrame), &ready);
+  EXPECT_TRUE(ready.empty());
+
+  // Packet loss: the next frame starts 2.5 ms late
+  coalescer.Push(MakeFrame(3 * kFrameUs, 3 * kFrame), &ready);
+  ASSERT_EQ(ready.size(), 1u);
+  EXPECT_EQ(ready[0]->pts, 0);
+  EXPECT_EQ(ready[0]->nb_samples, 2 * kFrame);
+  EXPECT_EQ(coalescer.pending(), 1u);
+}
+
+TEST(AudioFrameCoalescerTest, ToleratesMicrosecondRounding) {
+  AudioFrameCoalescer coalescer;
+  coalescer.Configure(100000);
+
+  // 1024 samples at 48 kHz is 21333.3 us; chunk timestamps are rounded
+  std::vector<AVFramePtr> ready;
+  coalescer.Push(MakeFrame(0, 0, 2, 1024), &ready);
+  coalescer.Push(MakeFrame(21333, 1024, 2, 1024), &ready);
+  coalescer.Push(MakeFrame(42667, 2048, 2, 1024), &ready);
+  EXPECT_TRUE(ready.empty());
+  EXPECT_EQ(coalescer.pending(), 3u);
+}
+
+TEST(AudioFrameCoalescerTest, ChannelChangeEmitsPending) {
+  AudioFrameCoalescer coalescer;
+  coalescer.Configure(10000);
+
+  std::vector<AVFramePtr> ready;
+  coalescer.Push(MakeFrame(0, 0, 2), &ready);
+  coalescer.Push(MakeFrame(kFrameUs, kFrame, 1), &ready);
+  ASSERT_EQ(ready.size(), 1u);
+  EXPECT_EQ(ready[0]->nb_samples, kFrame);
+  EXPECT_EQ(coalescer.pending(), 1u);
+}
+
+TEST(AudioFrameCoalescerTest, FramesWithoutTimestampPassThrough) {
+  AudioFrameCoalescer coalescer;
+  coalescer.Configure(10000);
+
+  std::vector<AVFramePtr> ready;
+  coalescer.Push(MakeFrame(0, 0), &ready);
+  coalescer.Push(MakeFrame(AV_NOPTS_VALUE, kFrame), &ready);
+  ASSERT_EQ(ready.size(), 2u);
+  EXPECT_EQ(ready[0]->pts, 0);
+  EXPECT_EQ(ready[1]->pts, AV_NOPTS_VALUE);
+}
+
+TEST(AudioFrameCoalescerTest, FlushEmitsRemainderAndResetDropsIt) {
+  AudioFrameCoalescer coalescer;
+  coalescer.Configure(10000);
+
+  std::vector<AVFramePtr> ready;
+  coalescer.Push(MakeFrame(0, 0), &ready);
+  coalescer.Push(MakeFrame(kFrameUs, kFrame), &ready);
+  AVFramePtr rest = coalescer.Flush();
+  ASSERT_NE(rest, nullptr);
+  EXPECT_EQ(rest->nb_samples, 2 * kFrame);
+  EXPECT_EQ(coalescer.Flush(), nullptr);
+
+  coalescer.Push(MakeFrame(10 * kFrameUs, 0), &ready);
+  coalescer.Reset();
+  EXPECT_EQ(coalescer.pending(), 0u);
+  EXPECT_EQ(coalescer.Flush(), nullptr);
+  EXPECT_TRUE(ready.empty());
+}
@@ -0,0 +1,132 @@
+/**
+ * test_audio_frame_fifo.cpp - Unit tests for AudioFrameFifo
+ *
+ * Tests re-chunking to the encoder frame size, sample-accurate PTS,
+ * silence-padded tails and pooled output buffers.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "../../src/shared/audio_frame_fifo.h"
+#include "audio_test_frames.h"
+
+using webcodecs::AudioFrameFifo;
+using webcodecs::raii::AVCodecContextPtr;
+using webcodecs::raii::AVFramePtr;
+using webcodecs::testing::AudioSampleAt;
+using webcodecs::testing::MakeAudioFrame;
+
+namespace {
+
+constexpr int kChannels = 2;
+constexpr int kFrameSize = 1024;
+
+// Encoder-like context without a codec: fltp stereo, fixed frame size
+AVCodecContextPtr MakeContext(int frame_size) {
+  AVCodecContextPtr ctx = webcodecs::raii::MakeAvCodecContext(nullptr);
+  ctx->sample_fmt = AV_SAMPLE_FMT_FLTP;
+  ctx->sample_rate = 48000;
+  ctx->frame_size = frame_size;
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+  av_channel_layout_default(&ctx->ch_layout, kChannels);
+#else
+  ctx->channels = kChannels;
+  ctx->channel_layout = av_get_default_channel_layout(kChannels);
+#endif
+  return ctx;
+}
+
+}  // namespace
+
+TEST(AudioFrameFifoTest, DisabledWithoutFixedFrameSize) {
+  AVCodecContextPtr ctx = MakeContext(0);
+  AudioFrameFifo fifo;
+  ASSERT_TRUE(fifo.Init(ctx.get()));
+  EXPECT_FALSE(fifo.enabled());
+}
+
+TEST(AudioFrameFifoTest, RechunksToFrameSizeWithContinuousPts) {
+  AVCodecContextPtr ctx = MakeContext(kFrameSize);
+  AudioFrameFifo fifo;
+  ASSERT_TRUE(fifo.Init(ctx.get()));
+  ASSERT_TRUE(fifo.enabled());
+
+  std::vector<AVFramePtr> out;
+  int written = 0;
+  for (int i = 0; i < 3; i++) {
+    AVFramePtr input = MakeAudioFrame(AV_SAMPLE_FMT_FLTP, kChannels, 700, written);
+    ASSERT_EQ(fifo.Write(input.get(), 5000 + written), 0);
+    written += 700;
+    while (AVFramePtr frame = fifo.ReadFrame()) out.push_back(std::move(frame));
+  }
+
+  ASSERT_EQ(out.size(), 2u);
+  EXPECT_EQ(fifo.buffered(), 3 * 700 - 2 * kFrameSize);
+  for (size_t i = 0; i < out.size(); i++) {
+    EXPECT_EQ(out[i]->nb_samples, kFrameSize);
+    EXPECT_EQ(out[i]->pts, 5000 + static_cast<int64_t>(i) * kFrameSize);
+    // Samples arrive in order across input boundaries, on every channel
+    EXPECT_EQ(AudioSampleAt<float>(out[i].get(), 0, 0), static_cast<float>(i * kFrameSize));
+    EXPECT_EQ(AudioSampleAt<float>(out[i].get(), 1, kFrameSize - 1),
+              static_cast<float>((i + 1) * kFrameSize - 1));
+  }
+}
+
+TEST(AudioFrameFifoTest, TailIsPaddedWithSilence) {
+  AVCodecContextPtr ctx = MakeContext(kFrameSize);
+  AudioFrameFifo fifo;
+  ASSERT_TRUE(fifo.Init(ctx.get()));
+
+  AVFramePtr input = MakeAudioFrame(AV_SAMPLE_FMT_FLTP, kChannels, kFrameSize + 100, 1);
+  ASSERT_EQ(fifo.Write(input.get(), 0), 0);
+  AVFramePtr full = fifo.ReadFrame();
+  ASSERT_NE(full, nullptr);
+  EXPECT_EQ(fifo.ReadFrame(), nullptr);
+
+  AVFramePtr tail = fifo.ReadTail();
+  ASSERT_NE(tail, nullptr);
+  EXPECT_EQ(tail->nb_samples, kFrameSize);  // No small-last-frame capability
+  EXPECT_EQ(tail->pts, kFrameSize);
+  EXPECT_EQ(AudioSampleAt<float>(tail.get(), 0, 99), static_cast<float>(kFrameSize + 100));
+  EXPECT_EQ(AudioSampleAt<float>(tail.get(), 0, 100), 0.0f);
+  EXPECT_EQ(AudioSampleAt<float>(tail.get(), 1, kFrameSize - 1), 0.0f);
+  EXPECT_EQ(fifo.buffered(), 0);
+  EXPECT_EQ(fifo.ReadTail(), nullptr);
+}
+
+TEST(AudioFrameFifoTest, ResetDropsSamplesAndReanchors) {
+  AVCodecContextPtr ctx = MakeContext(kFrameSize);
+  AudioFrameFifo fifo;
+  ASSERT_TRUE(fifo.Init(ctx.get()));
+
+  AVFramePtr input = MakeAudioFrame(AV_SAMPLE_FMT_FLTP, kChannels, 500, 0);
+  ASSERT_EQ(fifo.Write(input.get(), 100), 0);
+  fifo.Reset();
+  EXPECT_EQ(fifo.buffered(), 0);
+
+  AVFramePtr next = MakeAudioFrame(AV_SAMPLE_FMT_FLTP, kChannels, kFrameSize, 0);
+  ASSERT_EQ(fifo.Write(next.get(), 90000), 0);
+  AVFramePtr frame = fifo.ReadFrame();
+  ASSERT_NE(frame, nullptr);
+  EXPECT_EQ(frame->pts, 90000);
+}
+
+TEST(AudioFrameFifoTest, OutputBuffersAreReused) {
+  AVCodecContextPtr ctx = MakeContext(kFrameSize);
+  AudioFrameFifo fifo;
+  ASSERT_TRUE(fifo.Init(ctx.get()));
+
+  AVFramePtr input = MakeAudioFrame(AV_SAMPLE_FMT_FLTP, kChannels, kFrameSize * 2, 0);
+  ASSERT_EQ(fifo.Write(input.get(), 0), 0);
+
+  AVFramePtr first = fifo.ReadFrame();
+  ASSERT_NE(first, nullptr);
+  const uint8_t* first_data = first->data[0];
+  first.reset();  // Encoder done with it: buffer returns to the pool
+
+  AVFramePtr second = fifo.ReadFrame();
+  ASSERT_NE(second, nullptr);
+  EXPECT_EQ(second->data[0], first_data);
+}
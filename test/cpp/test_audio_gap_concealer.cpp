@@ -0,0 +1,163 @@
+/**
+ * test_audio_gap_concealer.cpp - Unit tests for AudioGapConcealer
+ *
+ * Tests timestamp repair, concealment frames for gaps (timestamps, sizes
+ * and the faded replay of the last frame), gaps over the limit, frames
+ * behind the timeline and format changes.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "../../src/shared/audio_gap_concealer.h"
+#include "audio_test_frames.h"
+
+using webcodecs::AudioGapConcealer;
+using webcodecs::raii::AVFramePtr;
+using webcodecs::testing::AudioSampleAt;
+using webcodecs::testing::MakeAudioFrame;
+
+namespace {
+
+constexpr int kRate = 48000;
+constexpr int kFrame = 480;  // 10 ms
+constexpr int64_t kFrameUs = 10000;
+
+// 48 kHz frame holding value + i at sample i on every channel
+AVFramePtr MakeFrame(int64_t pts, int16_t value = 1000, int channels = 1, int nb_samples = kFrame,
+                     AVSampleFormat format = AV_SAMPLE_FMT_S16) {
+  return MakeAudioFrame(format, channels, nb_samples, value, pts, kRate);
+}
+
+std::vector<int64_t> Timestamps(const std::vector<AVFramePtr>& frames) {
+  std::vector<int64_t> out;
+  for (const AVFramePtr& frame : frames) out.push_back(frame->pts);
+  return out;
+}
+
+}  // namespace
+
+TEST(AudioGapConcealerTest, DisabledPassesFramesThrough) {
+  AudioGapConcealer concealer;
+  std::vector<AVFramePtr> ready;
+  ASSERT_EQ(concealer.Push(MakeFrame(0), &ready), 0);
+  ASSERT_EQ(concealer.Push(MakeFrame(3 * kFrameUs + 400), &ready), 0);
+  EXPECT_EQ(Timestamps(ready), (std::vector<int64_t>{0, 3 * kFrameUs + 400}));
+  EXPECT_EQ(concealer.concealed_samples(), 0);
+}
+
+TEST(AudioGapConcealerTest, RepairsJitterWithinTolerance) {
+  AudioGapConcealer concealer;
+  concealer.Configure(100000);
+  std::vector<AVFramePtr> ready;
+  ASSERT_EQ(concealer.Push(MakeFrame(0), &ready), 0);
+  ASSERT_EQ(concealer.Push(MakeFrame(kFrameUs + 700), &ready), 0);
+  ASSERT_EQ(concealer.Push(MakeFrame(2 * kFrameUs - 900), &ready), 0);
+  EXPECT_EQ(Timestamps(ready), (std::vector<int64_t>{0, kFrameUs, 2 * kFrameUs}));
+  EXPECT_EQ(concealer.concealed_samples(), 0);
+}
+
+TEST(AudioGapConcealerTest, ConcealsGapsWithFramesOfTheLastSize) {
+  AudioGapConcealer concealer;
+  concealer.Configure(100000);
+  std::vector<AVFramePtr> ready;
+  ASSERT_EQ(concealer.Push(MakeFrame(0), &ready), 0);
+  // 25 ms lost: two full concealment frames and a 5 ms one
+  ASSERT_EQ(concealer.Push(MakeFrame(35000), &ready), 0);
+
+  EXPECT_EQ(Timestamps(ready), (std::vector<int64_t>{0, 10000, 20000, 30000, 35000}));
+  ASSERT_EQ(ready.size(), 5u);
+  EXPECT_EQ(ready[1]->nb_samples, kFrame);
+  EXPECT_EQ(ready[2]->nb_samples, kFrame);
+  EXPECT_EQ(ready[3]->nb_samples, 240);
+  EXPECT_EQ(ready[4]->nb_samples, kFrame);
+  EXPECT_EQ(concealer.concealed_samples(), 2 * kFrame + 240);
+
+  // The timeline continues from the frame after the gap
+  ASSERT_EQ(concealer.Push(MakeFrame(45000 + 300), &ready), 0);
+  EXPECT_EQ(ready.back()->pts, 45000);
+}
+
+TEST(AudioGapConcealerTest, ReplaysTheLastFrameBackwardsFadingOut) {
+  AudioGapConcealer concealer;
+  concealer.Configure(100000);
+  std::vector<AVFramePtr> ready;
+  ASSERT_EQ(concealer.Push(MakeFrame(0, 1000), &ready), 0);
+  ASSERT_EQ(concealer.Push(MakeFrame(30000), &ready), 0);
+  ASSERT_EQ(ready.size(), 4u);
+
+  // Continues from the last sample (1000 + 479), fading over the 10 ms frame
+  const AVFrame* first = ready[1].get();
+  EXPECT_NEAR(AudioSampleAt<int16_t>(first, 0, 0), 1479.0 * 480 / 481, 1);
+  EXPECT_NEAR(AudioSampleAt<int16_t>(first, 0, 1), 1478.0 * 479 / 481, 1);
+  EXPECT_NEAR(AudioSampleAt<int16_t>(first, 0, 240), 1239.0 * 240 / 481, 1);
+  EXPECT_LT(AudioSampleAt<int16_t>(first, 0, kFrame - 1), 5);
+  for (int i = 0; i < kFrame; i++) EXPECT_EQ(AudioSampleAt<int16_t>(ready[2].get(), 0, i), 0);
+}
+
+TEST(AudioGapConcealerTest, ConcealsEveryChannel) {
+  AudioGapConcealer concealer;
+  concealer.Configure(100000);
+  std::vector<AVFramePtr> ready;
+  ASSERT_EQ(concealer.Push(MakeFrame(0, 1000, 2), &ready), 0);
+  ASSERT_EQ(concealer.Push(MakeFrame(20000, 1000, 2), &ready), 0);
+  ASSERT_EQ(ready.size(), 3u);
+  EXPECT_EQ(AudioSampleAt<int16_t>(ready[1].get(), 0, 0), AudioSampleAt<int16_t>(ready[1].get(), 1, 0));
+  EXPECT_GT(AudioSampleAt<int16_t>(ready[1].get(), 1, 0), 1400);
+}
+
+TEST(AudioGapConcealerTest, RestartsOnLongGapsAndFormatChanges) {
+  AudioGapConcealer concealer;
+  concealer.Configure(20000);
+  std::vector<AVFramePtr> ready;
+  ASSERT_EQ(concealer.Push(MakeFrame(0), &ready), 0);
+  ASSERT_EQ(concealer.Push(MakeFrame(500000), &ready), 0);  // Over the limit
+  ASSERT_EQ(concealer.Push(MakeFrame(520000, 0, 2), &ready), 0);  // Stereo now
+  ASSERT_EQ(concealer.Push(MakeFrame(530000 + 200, 0, 2), &ready), 0);
+  EXPECT_EQ(Timestamps(ready), (std::vector<int64_t>{0, 500000, 520000, 530000}));
+  EXPECT_EQ(concealer.concealed_samples(), 0);
+}
+
+TEST(AudioGapConcealerTest, PassesFramesBehindTheTimeline) {
+  AudioGapConcealer concealer;
+  concealer.Configure(100000);
+  std::vector<AVFramePtr> ready;
+  ASSERT_EQ(concealer.Push(MakeFrame(0), &ready), 0);
+  ASSERT_EQ(concealer.Push(MakeFrame(kFrameUs), &ready), 0);
+  ASSERT_EQ(concealer.Push(MakeFrame(0), &ready), 0);  // Duplicate
+  // The duplicate did not move the timeline
+  ASSERT_EQ(concealer.Push(MakeFrame(2 * kFrameUs), &ready), 0);
+  EXPECT_EQ(Timestamps(ready), (std::vector<int64_t>{0, kFrameUs, 0, 2 * kFrameUs}));
+  EXPECT_EQ(concealer.concealed_samples(), 0);
+}
+
+TEST(AudioGapConcealerTest, ConcealsFloatFramesWithSilenceAfterTheFade) {
+  AudioGapConcealer concealer;
+  concealer.Configure(100000);
+  std::vector<AVFramePtr> ready;
+  AVFramePtr frame = MakeFrame(0, 0, 2, kFrame, AV_SAMPLE_FMT_FLTP);
+  for (int ch = 0; ch < 2; ch++) {
+    auto* plane = reinterpret_cast<float*>(frame->extended_data[ch]);
+    for (int i = 0; i < kFrame; i++) plane[i] = ch ? -0.5f : 0.5f;
+  }
+  ASSERT_EQ(concealer.Push(std::move(frame), &ready), 0);
+  ASSERT_EQ(concealer.Push(MakeFrame(30000, 0, 2, kFrame, AV_SAMPLE_FMT_FLTP), &ready), 0);
+  ASSERT_EQ(ready.size(), 4u);
+
+  const auto* left = reinterpret_cast<const float*>(ready[1]->extended_data[0]);
+  const auto* right = reinterpret_cast<const float*>(ready[1]->extended_data[1]);
+  EXPECT_NEAR(left[0], 0.5f * 480 / 481, 1e-6);
+  EXPECT_NEAR(right[0], -0.5f * 480 / 481, 1e-6);
+  EXPECT_EQ(reinterpret_cast<const float*>(ready[2]->extended_data[1])[0], 0.0f);
+}
+
+TEST(AudioGapConcealerTest, ResetForgetsTheTimeline) {
+  AudioGapConcealer concealer;
+  concealer.Configure(100000);
+  std::vector<AVFramePtr> ready;
+  ASSERT_EQ(concealer.Push(MakeFrame(0), &ready), 0);
+  concealer.Reset();
+  ASSERT_EQ(concealer.Push(MakeFrame(50000), &ready), 0);
+  EXPECT_EQ(Timestamps(ready), (std::vector<int64_t>{0, 50000}));
+}
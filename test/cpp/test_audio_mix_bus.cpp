@@ -0,0 +1,211 @@
+/**
+ * test_audio_mix_bus.cpp - Unit tests for AudioMixBus
+ *
+ * Tests timeline alignment (origin, contiguity, gaps, restarts after long
+ * gaps, overlaps, late samples), block readiness with lagging sources,
+ * draining removed sources, flush-style draining and soft clipping of the
+ * sum.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "../../src/shared/audio_mix_bus.h"
+
+using webcodecs::AudioMixBus;
+using webcodecs::AudioMixBusConfig;
+
+namespace {
+
+// Mono, 1 kHz so 1 frame = 1 ms, 4-frame blocks mixed as soon as buffered
+AudioMixBusConfig TestConfig() {
+  AudioMixBusConfig config;
+  config.sample_rate = 1000;
+  config.channels = 1;
+  config.frame_size = 4;
+  config.max_latency = 0;
+  config.soft_clip = false;
+  return config;
+}
+
+void Push(AudioMixBus& bus, const std::string& source, std::vector<float> samples, int64_t timestamp_ms) {
+  const float* planes[] = {samples.data()};
+  bus.Push(source, planes, samples.size(), timestamp_ms * 1000);
+}
+
+std::vector<float> Mix(AudioMixBus& bus, bool drain = false) {
+  std::vector<float> out(bus.config().frame_size, -1.0f);
+  const size_t frames = bus.Pending(drain);
+  float* planes[] = {out.data()};
+  if (frames) bus.Mix(planes, frames);
+  out.resize(frames);
+  return out;
+}
+
+class AudioMixBusTest : public ::testing::Test {
+ protected:
+  void SetUp() override { bus_.Configure(TestConfig()); }
+
+  AudioMixBus bus_;
+};
+
+}  // namespace
+
+TEST_F(AudioMixBusTest, SumsAlignedSources) {
+  Push(bus_, "a", {1, 2, 3, 4}, 100);
+  EXPECT_EQ(bus_.timestamp(), 100000);
+  Push(bus_, "b", {10, 20, 30, 40}, 100);
+  EXPECT_EQ(Mix(bus_), (std::vector<float>{11, 22, 33, 44}));
+  EXPECT_EQ(bus_.timestamp(), 104000);
+  EXPECT_TRUE(Mix(bus_).empty());
+}
+
+TEST_F(AudioMixBusTest, AlignsSourcesByTimestamp) {
+  Push(bus_, "a", {1, 1, 1, 1, 1, 1, 1, 1}, 0);
+  Push(bus_, "b", {5, 5, 5, 5, 5, 5}, 2);
+  EXPECT_EQ(Mix(bus_), (std::vector<float>{1, 1, 6, 6}));
+  EXPECT_EQ(Mix(bus_), (std::vector<float>{6, 6, 6, 6}));
+}
+
+TEST_F(AudioMixBusTest, HoldsBlocksForMaxLatency) {
+  AudioMixBusConfig config = TestConfig();
+  config.max_latency = 4;
+  bus_.Configure(config);
+
+  Push(bus_, "a", {1, 1, 1, 1}, 0);
+  Push(bus_, "b", {1, 1}, 0);
+  EXPECT_TRUE(Mix(bus_).empty());
+
+  // a is now a full block plus max_latency ahead of the mix position
+  Push(bus_, "a", {1, 1, 1, 1}, 4);
+  EXPECT_EQ(Mix(bus_), (std::vector<float>{2, 2, 1, 1}));
+
+  // b's missing samples were mixed as silence; late ones are dropped
+  Push(bus_, "b", {7, 7, 7, 7, 7, 7}, 2);
+  EXPECT_EQ(bus_.buffered("b"), 4u);
+  EXPECT_TRUE(Mix(bus_).empty());
+  EXPECT_EQ(Mix(bus_, true), (std::vector<float>{8, 8, 8, 8}));
+}
+
+TEST_F(AudioMixBusTest, ContinuesThroughTimestampJitter) {
+  AudioMixBusConfig config = TestConfig();
+  config.sample_rate = 2000;  // 0.5 ms frames; tolerance of 4 frames
+  bus_.Configure(config);
+
+  Push(bus_, "a", {1, 1, 1, 1}, 0);
+  Push(bus_, "a", {2, 2, 2, 2}, 3);  // 2 frames after the end, still contiguous
+  EXPECT_EQ(bus_.buffered("a"), 8u);
+  EXPECT_EQ(Mix(bus_), (std::vector<float>{1, 1, 1, 1}));
+  EXPECT_EQ(Mix(bus_), (std::vector<float>{2, 2, 2, 2}));
+}
+
+TEST_F(AudioMixBusTest, PadsGapsAndDropsOverlaps) {
+  AudioMixBusConfig config = TestConfig();
+  config.sample_rate = 100;  // 10 ms frames; tolerance of 1 frame
+  bus_.Configure(config);
+
+  const float ones[] = {1, 1};
+  const float* planes[] = {ones};
+  bus_.Push("a", planes, 2, 0);
+  bus_.Push("a", planes, 2, 50000);  // 3 frames after the end
+  EXPECT_EQ(bus_.buffered("a"), 7u);
+
+  const float twos[] = {2, 2, 2, 2};
+  const float* overlap[] = {twos};
+  bus_.Push("a", overlap, 4, 30000);  // 4 frames before the end
+  EXPECT_EQ(bus_.buffered("a"), 7u);
+  bus_.Push("a", overlap, 4, 40000);  // 3 frames before the end: one is new
+  EXPECT_EQ(bus_.buffered("a"), 8u);
+
+  EXPECT_EQ(Mix(bus_), (std::vector<float>{1, 1, 0, 0}));
+  EXPECT_EQ(Mix(bus_), (std::vector<float>{0, 1, 1, 2}));
+}
+
+TEST_F(AudioMixBusTest, RestartsSourcesAfterLongGaps) {
+  Push(bus_, "a", {1, 1}, 0);
+  Push(bus_, "b", {2, 2}, 0);
+  // 1 s at 1 kHz is the longest gap padded with silence
+  Push(bus_, "b", {3, 3}, 1002);
+  EXPECT_EQ(bus_.buffered("b"), 1004u);
+
+  // Longer: a restarts at the new timestamp instead of buffering the gap
+  Push(bus_, "a", {4, 4, 4, 4}, 5000);
+  EXPECT_EQ(bus_.buffered("a"), 4u);
+  EXPECT_EQ(Mix(bus_), (std::vector<float>{2, 2, 0, 0}));  // a's unmixed 1s were dropped
+}
+
+TEST_F(AudioMixBusTest, DrainsRemovedSources) {
+  Push(bus_, "a", {1, 1, 1, 1, 1, 1}, 0);
+  Push(bus_, "b", {2, 2, 2, 2, 2, 2, 2, 2}, 0);
+  bus_.RemoveSource("a");
+  EXPECT_EQ(bus_.source_count(), 2u);
+
+  EXPECT_EQ(Mix(bus_), (std::vector<float>{3, 3, 3, 3}));
+  EXPECT_EQ(Mix(bus_), (std::vector<float>{3, 3, 2, 2}));
+  EXPECT_EQ(bus_.source_count(), 1u);
+
+  bus_.RemoveSource("b");
+  bus_.RemoveSource("unknown");
+  EXPECT_EQ(bus_.source_count(), 0u);
+}
+
+TEST_F(AudioMixBusTest, DrainEmitsShortBlocks) {
+  AudioMixBusConfig config = TestConfig();
+  config.max_latency = 4;
+  bus_.Configure(config);
+
+  Push(bus_, "a", {1, 1, 1, 1, 1, 1}, 0);
+  Push(bus_, "b", {1}, 0);
+  EXPECT_TRUE(Mix(bus_).empty());
+
+  EXPECT_EQ(Mix(bus_, true), (std::vector<float>{2, 1, 1, 1}));
+  EXPECT_EQ(Mix(bus_, true), (std::vector<float>{1, 1}));
+  EXPECT_EQ(bus_.timestamp(), 6000);
+  EXPECT_TRUE(Mix(bus_, true).empty());
+}
+
+TEST_F(AudioMixBusTest, SoftClipsTheSum) {
+  AudioMixBusConfig config = TestConfig();
+  config.soft_clip = true;
+  bus_.Configure(config);
+
+  Push(bus_, "a", {0.25f, 0.5f, 0.9f, -0.9f}, 0);
+  Push(bus_, "b", {0.25f, 0.5f, 0.9f, -0.9f}, 0);
+  const std::vector<float> out = Mix(bus_);
+  ASSERT_EQ(out.size(), 4u);
+  EXPECT_EQ(out[0], 0.5f);
+  EXPECT_GT(out[1], 0.75f);
+  EXPECT_LT(out[1], 1.0f);
+  EXPECT_EQ(out[2], 1.0f);
+  EXPECT_EQ(out[3], -1.0f);
+}
+
+TEST_F(AudioMixBusTest, MixesEveryChannel) {
+  AudioMixBusConfig config = TestConfig();
+  config.channels = 2;
+  bus_.Configure(config);
+
+  const float left[] = {1, 2, 3, 4};
+  const float right[] = {-1, -2, -3, -4};
+  const float* planes[] = {left, right};
+  bus_.Push("a", planes, 4, 0);
+  bus_.Push("b", planes, 4, 0);
+
+  std::vector<float> out_left(4), out_right(4);
+  float* out[] = {out_left.data(), out_right.data()};
+  ASSERT_EQ(bus_.Pending(), 4u);
+  bus_.Mix(out, 4);
+  EXPECT_EQ(out_left, (std::vector<float>{2, 4, 6, 8}));
+  EXPECT_EQ(out_right, (std::vector<float>{-2, -4, -6, -8}));
+}
+
+TEST_F(AudioMixBusTest, ResetForgetsTheOrigin) {
+  Push(bus_, "a", {1, 1, 1, 1}, 100);
+  bus_.Reset();
+  EXPECT_EQ(bus_.source_count(), 0u);
+  Push(bus_, "a", {1, 1, 1, 1}, 5);
+  EXPECT_EQ(bus_.timestamp(), 5000);
+  EXPECT_EQ(Mix(bus_), (std::vector<float>{1, 1, 1, 1}));
+}
@@ -0,0 +1,106 @@
+/**
+ * test_channel_remix.cpp - Unit tests for channel matrices
+ *
+ * Tests down/upmix coefficients from libswresample, custom channel orders
+ * (remapping), unspecified input layouts and the matrix cache.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "../../src/shared/channel_remix.h"
+
+using webcodecs::ChannelMatrix;
+using webcodecs::ChannelMatrixCache;
+
+namespace {
+
+struct Layout {
+  explicit Layout(const char* name) { EXPECT_EQ(av_channel_layout_from_string(&layout, name), 0) << name; }
+  ~Layout() { av_channel_layout_uninit(&layout); }
+  const AVChannelLayout* get() const { return &layout; }
+
+  AVChannelLayout layout = {};
+};
+
+float RowSum(const ChannelMatrix& matrix, int out_channel) {
+  float sum = 0.0f;
+  for (int i = 0; i < matrix.in_channels; i++) sum += matrix.row(out_channel)[i];
+  return sum;
+}
+
+}  // namespace
+
+TEST(ChannelRemixTest, DownmixesStereoToMono) {
+  auto matrix = webcodecs::channel_remix::Build(Layout("stereo").get(), Layout("mono").get());
+  ASSERT_NE(matrix, nullptr);
+  EXPECT_EQ(matrix->in_channels, 2);
+  EXPECT_EQ(matrix->out_channels, 1);
+  EXPECT_FLOAT_EQ(matrix->row(0)[0], 0.5f);
+  EXPECT_FLOAT_EQ(matrix->row(0)[1], 0.5f);
+}
+
+TEST(ChannelRemixTest, Downmixes51ToStereoWithoutClipping) {
+  // 5.1: FL FR FC LFE BL BR
+  auto matrix = webcodecs::channel_remix::Build(Layout("5.1").get(), Layout("stereo").get());
+  ASSERT_NE(matrix, nullptr);
+  ASSERT_EQ(matrix->in_channels, 6);
+  const float* left = matrix->row(0);
+  EXPECT_GT(left[0], 0.0f);
+  EXPECT_EQ(left[1], 0.0f);
+  EXPECT_GT(left[2], 0.0f);
+  EXPECT_EQ(left[3], 0.0f);  // LFE dropped
+  EXPECT_GT(left[4], 0.0f);
+  EXPECT_EQ(left[5], 0.0f);
+  EXPECT_FLOAT_EQ(left[2], left[0] * static_cast<float>(M_SQRT1_2));
+  EXPECT_LE(RowSum(*matrix, 0), 1.0f + 1e-6f);
+  EXPECT_FLOAT_EQ(RowSum(*matrix, 0), RowSum(*matrix, 1));
+}
+
+TEST(ChannelRemixTest, CustomOrderRemapsChannels) {
+  auto matrix = webcodecs::channel_remix::Build(Layout("stereo").get(), Layout("FR+FL").get());
+  ASSERT_NE(matrix, nullptr);
+  EXPECT_EQ(std::vector<float>(matrix->gains), (std::vector<float>{0.0f, 1.0f, 1.0f, 0.0f}));
+
+  const float left[] = {1.0f, 2.0f};
+  const float right[] = {3.0f, 4.0f};
+  const float* planes[] = {left, right};
+  float out[2] = {};
+  matrix->Apply(planes, 2, 0, out);
+  EXPECT_EQ(std::vector<float>(out, out + 2), (std::vector<float>{3.0f, 4.0f}));
+}
+
+TEST(ChannelRemixTest, UnspecifiedInputUsesDefaultLayout) {
+  AVChannelLayout unspec = {};
+  unspec.order = AV_CHANNEL_ORDER_UNSPEC;
+  unspec.nb_channels = 2;
+  auto matrix = webcodecs::channel_remix::Build(&unspec, Layout("mono").get());
+  ASSERT_NE(matrix, nullptr);
+  EXPECT_FLOAT_EQ(matrix->row(0)[0], 0.5f);
+}
+
+TEST(ChannelRemixTest, RejectsDuplicatedInputChannels) {
+  EXPECT_EQ(webcodecs::channel_remix::Build(Layout("FL+FL").get(), Layout("mono").get()), nullptr);
+}
+
+TEST(ChannelRemixTest, CacheSharesMatrices) {
+  ChannelMatrixCache& cache = ChannelMatrixCache::Instance();
+  cache.Clear();
+  auto first = cache.Get(Layout("7.1").get(), Layout("stereo").get());
+  auto second = cache.Get(Layout("7.1").get(), Layout("stereo").get());
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(cache.size(), 1u);
+
+  EXPECT_EQ(cache.Get(Layout("FL+FL").get(), Layout("mono").get()), nullptr);
+  EXPECT_EQ(cache.size(), 1u);
+
+  for (const char* out : {"mono", "2.1", "3.0", "3.0(back)", "4.0", "quad", "quad(side)", "3.1", "5.0",
+                          "5.0(side)", "4.1", "5.1", "5.1(side)", "6.0", "hexagonal", "6.1", "7.0"}) {
+    ASSERT_NE(cache.Get(Layout("7.1").get(), Layout(out).get()), nullptr) << out;
+  }
+  EXPECT_EQ(cache.size(), ChannelMatrixCache::kMaxEntries);
+  EXPECT_NE(first, nullptr);  // Still usable after eviction
+  cache.Clear();
+}
@@ -0,0 +1,126 @@
+/**
+ * test_codec_context_cache.cpp - Unit tests for GlobalCodecContextCache
+ *
+ * Tests key matching (including exact extradata comparison), hit/miss
+ * accounting, LRU eviction and disabling.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../../src/shared/codec_context_cache.h"
+
+using webcodecs::CodecContextKey;
+using webcodecs::GlobalCodecContextCache;
+using webcodecs::raii::AVCodecContextPtr;
+using webcodecs::raii::MakeAvCodecContext;
+
+class CodecContextCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    codec_ = avcodec_find_decoder(AV_CODEC_ID_H264);
+    if (!codec_) {
+      GTEST_SKIP() << "H264 decoder not available";
+    }
+    cache().Clear();
+    cache().SetMaxEntries(GlobalCodecContextCache::kDefaultMaxEntries);
+    cache().ResetStats();
+  }
+
+  void TearDown() override {
+    cache().Clear();
+    cache().SetMaxEntries(GlobalCodecContextCache::kDefaultMaxEntries);
+    cache().ResetStats();
+  }
+
+  static GlobalCodecContextCache& cache() { return GlobalCodecContextCache::Instance(); }
+
+  CodecContextKey Key(int width, int height) const {
+    CodecContextKey key;
+    key.codec = codec_;
+    key.width = width;
+    key.height = height;
+    return key;
+  }
+
+  AVCodecContextPtr Open() const {
+    AVCodecContextPtr ctx = MakeAvCodecContext(codec_);
+    if (ctx && avcodec_open2(ctx.get(), codec_, nullptr) < 0) return nullptr;
+    return ctx;
+  }
+
+  const AVCodec* codec_ = nullptr;
+};
+
+TEST_F(CodecContextCacheTest, TakeOnEmptyCacheIsMiss) {
+  EXPECT_EQ(cache().Take(Key(640, 360)), nullptr);
+  EXPECT_EQ(cache().stats().misses.load(), 1u);
+  EXPECT_EQ(cache().stats().hits.load(), 0u);
+}
+
+TEST_F(CodecContextCacheTest, PutThenTakeReturnsSameContext) {
+  AVCodecContextPtr ctx = Open();
+  ASSERT_NE(ctx, nullptr);
+  AVCodecContext* raw = ctx.get();
+
+  cache().Put(Key(640, 360), std::move(ctx));
+  EXPECT_EQ(cache().size(), 1u);
+
+  AVCodecContextPtr taken = cache().Take(Key(640, 360));
+  EXPECT_EQ(taken.get(), raw);
+  EXPECT_EQ(cache().size(), 0u);
+  EXPECT_EQ(cache().stats().hits.load(), 1u);
+}
+
+TEST_F(CodecContextCacheTest, KeyMismatchIsMiss) {
+  cache().Put(Key(640, 360), Open());
+
+  EXPECT_EQ(cache().Take(Key(1280, 720)), nullptr);
+
+  CodecContextKey with_extradata = Key(640, 360);
+  const uint8_t extradata[] = {1, 2, 3, 4};
+  with_extradata.SetExtradata(extradata, sizeof(extradata));
+  EXPECT_EQ(cache().Take(with_extradata), nullptr);
+
+  EXPECT_EQ(cache().size(), 1u);
+  EXPECT_EQ(cache().stats().misses.load(), 2u);
+}
+
+TEST_F(CodecContextCacheTest, ExtradataHashCollisionIsMiss) {
+  CodecContextKey stored = Key(640, 360);
+  const uint8_t sps_a[] = {0x67, 0x42, 0x00, 0x1e};
+  stored.SetExtradata(sps_a, sizeof(sps_a));
+  cache().Put(stored, Open());
+
+  // Same size and (forced) same hash, different bytes
+  CodecContextKey other = Key(640, 360);
+  const uint8_t sps_b[] = {0x67, 0x64, 0x00, 0x1f};
+  other.SetExtradata(sps_b, sizeof(sps_b));
+  other.extradata_hash = stored.extradata_hash;
+  EXPECT_EQ(cache().Take(other), nullptr);
+  EXPECT_NE(cache().Take(stored), nullptr);
+}
+
+TEST_F(CodecContextCacheTest, EvictsLeastRecentlyReleased) {
+  cache().SetMaxEntries(2);
+  cache().Put(Key(320, 180), Open());
+  cache().Put(Key(640, 360), Open());
+  cache().Put(Key(1280, 720), Open());
+
+  EXPECT_EQ(cache().size(), 2u);
+  EXPECT_EQ(cache().stats().evictions.load(), 1u);
+  EXPECT_EQ(cache().Take(Key(320, 180)), nullptr);
+  EXPECT_NE(cache().Take(Key(640, 360)), nullptr);
+  EXPECT_NE(cache().Take(Key(1280, 720)), nullptr);
+}
+
+TEST_F(CodecContextCacheTest, ZeroMaxEntriesDisablesCache) {
+  cache().Put(Key(640, 360), Open());
+  ASSERT_EQ(cache().size(), 1u);
+
+  cache().SetMaxEntries(0);
+  EXPECT_EQ(cache().size(), 0u);
+
+  cache().Put(Key(640, 360), Open());
+  EXPECT_EQ(cache().size(), 0u);
+  EXPECT_EQ(cache().Take(Key(640, 360)), nullptr);
+}
@@ -14,7 +14,9 @@
 #include "../../src/shared/codec_registry.h"
 
 using webcodecs::GetCodecPrefix;
+using webcodecs::CodecCapabilities;
 using webcodecs::IsCodecSupported;
+using webcodecs::LookupCodecString;
 using webcodecs::ParseCodecString;
 
 // =============================================================================
@@ -312,6 +314,71 @@ TEST(CodecRegistryTest, IsCodecSupported_InvalidInput_NoThrow) {
   EXPECT_FALSE(IsCodecSupported("!@#$%^&*()"));
 }
 
+// =============================================================================
+// CAPABILITY TABLE TESTS
+// =============================================================================
+
+TEST(CodecRegistryTest, LookupCodecString_UnknownReturnsNullopt) {
+  EXPECT_FALSE(LookupCodecString("unknown.codec").has_value());
+  // Cached negative answer
+  EXPECT_FALSE(LookupCodecString("unknown.codec").has_value());
+}
+
+TEST(CodecRegistryTest, LookupCodecString_SharesCapabilitiesPerCodec) {
+  auto baseline = LookupCodecString("avc1.42E01E");
+  auto high = LookupCodecString("avc1.64001F");
+  ASSERT_TRUE(baseline.has_value());
+  ASSERT_TRUE(high.has_value());
+  EXPECT_EQ(baseline->capabilities, high->capabilities);
+  EXPECT_EQ(baseline->info.profile, 0x42);
+  EXPECT_EQ(high->info.profile, 0x64);
+}
+
+TEST(CodecRegistryTest, LookupCodecString_RepeatedLookupIsStable) {
+  auto first = LookupCodecString("vp09.00.10.08");
+  auto second = LookupCodecString("vp09.00.10.08");
+  ASSERT_TRUE(first.has_value());
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(first->capabilities, second->capabilities);
+  EXPECT_EQ(second->info.bit_depth, 8);
+}
+
+TEST(CodecRegistryTest, Capabilities_DecodeRejectsOversizedVP8) {
+  auto vp8 = LookupCodecString("vp8");
+  ASSERT_TRUE(vp8.has_value());
+  if (!vp8->capabilities->can_decode) {
+    GTEST_SKIP() << "VP8 decoder not available";
+  }
+  EXPECT_TRUE(vp8->capabilities->SupportsDecode(0, 0));
+  EXPECT_TRUE(vp8->capabilities->SupportsDecode(1920, 1080));
+  EXPECT_FALSE(vp8->capabilities->SupportsDecode(16384, 1080));
+}
+
+TEST(CodecRegistryTest, Capabilities_AudioEncodeHonorsSampleRates) {
+  CodecCapabilities caps;
+  caps.can_encode = true;
+  EXPECT_TRUE(caps.SupportsAudioEncode(44100, 2));
+  EXPECT_FALSE(caps.SupportsAudioEncode(0, 2));
+  EXPECT_FALSE(caps.SupportsAudioEncode(48000, 0));
+
+  caps.encode_sample_rates = {48000, 24000};
+  EXPECT_TRUE(caps.SupportsAudioEncode(48000, 2));
+  EXPECT_FALSE(caps.SupportsAudioEncode(44100, 2));
+}
+
+TEST(CodecRegistryTest, Capabilities_VideoEncodeHonorsBitDepth) {
+  CodecCapabilities caps;
+  caps.can_encode = true;
+  caps.max_width = 16383;
+  caps.max_height = 16383;
+  caps.max_encode_bit_depth = 8;
+  EXPECT_TRUE(caps.SupportsVideoEncode(1920, 1080, -1));
+  EXPECT_TRUE(caps.SupportsVideoEncode(1920, 1080, 8));
+  EXPECT_FALSE(caps.SupportsVideoEncode(1920, 1080, 10));
+  EXPECT_FALSE(caps.SupportsVideoEncode(0, 1080, 8));
+  EXPECT_FALSE(caps.SupportsVideoEncode(16384, 1080, 8));
+}
+
 // =============================================================================
 // GetCodecPrefix TESTS
 // =============================================================================
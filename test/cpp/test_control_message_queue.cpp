@@ -206,6 +206,58 @@ TEST_F(ControlMessageQueueTest, ClearPreservesPacketOwnership) {
   EXPECT_EQ(*dropped[0], 42);  // Ownership transferred to dropped vector
 }
 
+TEST_F(ControlMessageQueueTest, DropOldestFramesKeepsKeyFramesAndOrder) {
+  queue_->Enqueue(TestQueue::EncodeMessage{std::make_unique<int>(0), true});
+  queue_->Enqueue(TestQueue::EncodeMessage{std::make_unique<int>(1), false});
+  queue_->Enqueue(TestQueue::FlushMessage{7});
+  queue_->Enqueue(TestQueue::EncodeMessage{std::make_unique<int>(2), false});
+  queue_->Enqueue(TestQueue::EncodeMessage{std::make_unique<int>(3), false});
+
+  // 4 encodes pending, allow 2: frames 1 and 2 are the oldest non-key frames
+  EXPECT_EQ(queue_->DropOldestFrames(2), 2);
+  ASSERT_EQ(queue_->size(), 3);
+
+  auto first = queue_->TryDequeue();
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(*std::get<TestQueue::EncodeMessage>(*first).frame, 0);
+  auto second = queue_->TryDequeue();
+  ASSERT_TRUE(second.has_value());
+  EXPECT_TRUE(std::holds_alternative<TestQueue::FlushMessage>(*second));
+  auto third = queue_->TryDequeue();
+  ASSERT_TRUE(third.has_value());
+  EXPECT_EQ(*std::get<TestQueue::EncodeMessage>(*third).frame, 3);
+}
+
+TEST_F(ControlMessageQueueTest, DropOldestFramesNoopWithinLimit) {
+  queue_->Enqueue(TestQueue::EncodeMessage{std::make_unique<int>(1), false});
+  EXPECT_EQ(queue_->DropOldestFrames(1), 0);
+  EXPECT_EQ(queue_->size(), 1);
+}
+
+TEST_F(ControlMessageQueueTest, EnqueueBatchPreservesOrder) {
+  queue_->Enqueue(TestQueue::DecodeMessage{std::make_unique<int>(0)});
+  std::vector<TestQueue::Message> batch;
+  for (int i = 1; i <= 3; i++) {
+    batch.emplace_back(TestQueue::DecodeMessage{std::make_unique<int>(i)});
+  }
+  EXPECT_TRUE(queue_->EnqueueBatch(batch));
+  ASSERT_EQ(queue_->size(), 4);
+
+  for (int i = 0; i <= 3; i++) {
+    auto msg = queue_->TryDequeue();
+    ASSERT_TRUE(msg.has_value());
+    EXPECT_EQ(*std::get<TestQueue::DecodeMessage>(*msg).packet, i);
+  }
+}
+
+TEST_F(ControlMessageQueueTest, EnqueueBatchFailsAfterShutdown) {
+  queue_->Shutdown();
+  std::vector<TestQueue::Message> batch;
+  batch.emplace_back(TestQueue::DecodeMessage{std::make_unique<int>(1)});
+  EXPECT_FALSE(queue_->EnqueueBatch(batch));
+  EXPECT_EQ(queue_->size(), 0);
+}
+
 // =============================================================================
 // BLOCKED STATE
 // =============================================================================
@@ -218,6 +270,38 @@ TEST_F(ControlMessageQueueTest, BlockedStateCanBeSet) {
   EXPECT_FALSE(queue_->IsBlocked());
 }
 
+// =============================================================================
+// IDLE TRACKING
+// =============================================================================
+
+TEST_F(ControlMessageQueueTest, IdleUntilDequeuedMessageIsDone) {
+  EXPECT_TRUE(queue_->Idle());
+
+  queue_->Enqueue(TestQueue::DecodeMessage{std::make_unique<int>(1)});
+  EXPECT_FALSE(queue_->Idle());
+
+  // Empty but still being handled
+  auto msg = queue_->TryDequeue();
+  ASSERT_TRUE(msg.has_value());
+  EXPECT_TRUE(queue_->empty());
+  EXPECT_FALSE(queue_->Idle());
+
+  queue_->MarkDone();
+  EXPECT_TRUE(queue_->Idle());
+}
+
+TEST_F(ControlMessageQueueTest, ClearKeepsMessageInFlight) {
+  queue_->Enqueue(TestQueue::DecodeMessage{std::make_unique<int>(1)});
+  queue_->Enqueue(TestQueue::DecodeMessage{std::make_unique<int>(2)});
+  auto msg = queue_->TryDequeue();
+  ASSERT_TRUE(msg.has_value());
+
+  queue_->Clear();
+  EXPECT_FALSE(queue_->Idle());
+  queue_->MarkDone();
+  EXPECT_TRUE(queue_->Idle());
+}
+
 // =============================================================================
 // BLOCKING DEQUEUE
 // =============================================================================
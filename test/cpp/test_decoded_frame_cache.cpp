@@ -0,0 +1,108 @@
+/**
+ * test_decoded_frame_cache.cpp - Unit tests for DecodedFrameCache
+ *
+ * Tests hit/miss behavior, shared frame references and byte-budget LRU eviction.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../../src/shared/decoded_frame_cache.h"
+
+using webcodecs::DecodedFrameCache;
+using webcodecs::raii::AVFramePtr;
+using webcodecs::raii::MakeAvFrame;
+
+namespace {
+
+AVFramePtr MakeRgbaFrame(int width, int height) {
+  AVFramePtr frame = MakeAvFrame();
+  if (!frame) return nullptr;
+  frame->format = AV_PIX_FMT_RGBA;
+  frame->width = width;
+  frame->height = height;
+  if (av_frame_get_buffer(frame.get(), 0) < 0) return nullptr;
+  return frame;
+}
+
+size_t FrameBytes(const AVFrame* frame) {
+  size_t bytes = 0;
+  for (AVBufferRef* buf : frame->buf) {
+    if (buf) bytes += buf->size;
+  }
+  return bytes;
+}
+
+}  // namespace
+
+TEST(DecodedFrameCacheTest, MissOnEmptyCache) {
+  DecodedFrameCache cache;
+  EXPECT_EQ(cache.Get(0, nullptr, nullptr), nullptr);
+  EXPECT_EQ(cache.misses(), 1u);
+}
+
+TEST(DecodedFrameCacheTest, HitSharesBuffersAndReturnsTiming) {
+  DecodedFrameCache cache;
+  AVFramePtr frame = MakeRgbaFrame(16, 16);
+  ASSERT_NE(frame, nullptr);
+
+  cache.Put(3, frame.get(), 300000, 100000);
+  int64_t timestamp = 0;
+  int64_t duration = 0;
+  AVFramePtr hit = cache.Get(3, &timestamp, &duration);
+
+  ASSERT_NE(hit, nullptr);
+  EXPECT_EQ(hit->data[0], frame->data[0]);  // Reference, not a copy
+  EXPECT_EQ(timestamp, 300000);
+  EXPECT_EQ(duration, 100000);
+  EXPECT_EQ(cache.hits(), 1u);
+}
+
+TEST(DecodedFrameCacheTest, EvictsLeastRecentlyUsedOverBudget) {
+  AVFramePtr probe = MakeRgbaFrame(16, 16);
+  ASSERT_NE(probe, nullptr);
+  const size_t frame_bytes = FrameBytes(probe.get());
+
+  DecodedFrameCache cache(frame_bytes * 2);
+  AVFramePtr a = MakeRgbaFrame(16, 16);
+  AVFramePtr b = MakeRgbaFrame(16, 16);
+  AVFramePtr c = MakeRgbaFrame(16, 16);
+  cache.Put(0, a.get(), 0, 0);
+  cache.Put(1, b.get(), 0, 0);
+  ASSERT_NE(cache.Get(0, nullptr, nullptr), nullptr);  // 0 becomes most recent
+  cache.Put(2, c.get(), 0, 0);
+
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_LE(cache.bytes(), cache.max_bytes());
+  EXPECT_TRUE(cache.Contains(0));
+  EXPECT_FALSE(cache.Contains(1));
+  EXPECT_TRUE(cache.Contains(2));
+}
+
+TEST(DecodedFrameCacheTest, ReplacingAnIndexKeepsByteCount) {
+  DecodedFrameCache cache;
+  AVFramePtr a = MakeRgbaFrame(16, 16);
+  AVFramePtr b = MakeRgbaFrame(16, 16);
+  cache.Put(0, a.get(), 0, 0);
+  const size_t bytes = cache.bytes();
+  cache.Put(0, b.get(), 0, 0);
+
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.bytes(), bytes);
+}
+
+TEST(DecodedFrameCacheTest, FrameLargerThanBudgetIsNotCached) {
+  DecodedFrameCache cache(64);
+  AVFramePtr frame = MakeRgbaFrame(64, 64);
+  cache.Put(0, frame.get(), 0, 0);
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(DecodedFrameCacheTest, ClearDropsEverything) {
+  DecodedFrameCache cache;
+  AVFramePtr frame = MakeRgbaFrame(16, 16);
+  cache.Put(0, frame.get(), 0, 0);
+  cache.Put(1, frame.get(), 0, 0);
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_EQ(cache.bytes(), 0u);
+}
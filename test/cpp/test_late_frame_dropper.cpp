@@ -0,0 +1,83 @@
+/**
+ * test_late_frame_dropper.cpp - Unit tests for LateFrameDropper
+ *
+ * Tests that a single overrun drops about as many frames as it costs, that
+ * a slower-than-realtime encoder drops its share of frames, and the backlog
+ * limits on the debt.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "../../src/shared/late_frame_dropper.h"
+
+using webcodecs::LateFrameDropper;
+
+namespace {
+
+constexpr int64_t kInterval = 33333;  // 30 fps
+
+// Run frames through the policy like the encoder worker: each frame either
+// drops or takes encode_us[i], with `backlog` frames queued behind it
+int EncodeQueued(LateFrameDropper& dropper, const std::vector<int64_t>& encode_us, uint32_t backlog) {
+  int dropped = 0;
+  for (int64_t us : encode_us) {
+    if (dropper.ShouldDrop(kInterval, backlog)) {
+      dropped++;
+    } else {
+      dropper.RecordEncode(us, kInterval);
+    }
+  }
+  return dropped;
+}
+
+}  // namespace
+
+TEST(LateFrameDropperTest, OnTimeFramesAreNeverDropped) {
+  LateFrameDropper dropper;
+  EXPECT_EQ(EncodeQueued(dropper, std::vector<int64_t>(100, kInterval - 1000), 10), 0);
+  EXPECT_EQ(dropper.late_us(), 0);
+}
+
+TEST(LateFrameDropperTest, OneSlowFrameDropsOnlyItsOverrun) {
+  LateFrameDropper dropper;
+  // One frame takes five intervals, then 20 frames encode in real time
+  std::vector<int64_t> encode_us(21, kInterval);
+  encode_us[0] = 5 * kInterval;
+  EXPECT_EQ(EncodeQueued(dropper, encode_us, 30), 4);
+  EXPECT_EQ(dropper.late_us(), 0);
+}
+
+TEST(LateFrameDropperTest, SlowEncoderDropsItsShareOfFrames) {
+  LateFrameDropper dropper;
+  // 1.5x real time: one frame in three has to go
+  const int dropped = EncodeQueued(dropper, std::vector<int64_t>(300, kInterval * 3 / 2), 10);
+  EXPECT_NEAR(dropped, 100, 2);
+}
+
+TEST(LateFrameDropperTest, DebtIsBoundedByTheBacklog) {
+  LateFrameDropper dropper;
+  dropper.RecordEncode(100 * kInterval, kInterval);
+  // Only two frames are queued behind this one: at most two can be skipped
+  EXPECT_TRUE(dropper.ShouldDrop(kInterval, 3));
+  EXPECT_LT(dropper.late_us(), 2 * kInterval);
+  EXPECT_TRUE(dropper.ShouldDrop(kInterval, 2));
+  EXPECT_FALSE(dropper.ShouldDrop(kInterval, 2));
+}
+
+TEST(LateFrameDropperTest, CatchingUpClearsTheDebt) {
+  LateFrameDropper dropper;
+  dropper.RecordEncode(10 * kInterval, kInterval);
+  EXPECT_FALSE(dropper.ShouldDrop(kInterval, 1));  // The newest frame is always encoded
+  EXPECT_EQ(dropper.late_us(), 0);
+  EXPECT_FALSE(dropper.ShouldDrop(kInterval, 5));
+}
+
+TEST(LateFrameDropperTest, UnknownIntervalNeverDrops) {
+  LateFrameDropper dropper;
+  dropper.RecordEncode(10 * kInterval, 0);
+  EXPECT_EQ(dropper.late_us(), 0);
+  dropper.RecordEncode(10 * kInterval, kInterval);
+  EXPECT_FALSE(dropper.ShouldDrop(0, 5));
+}
@@ -0,0 +1,79 @@
+/**
+ * test_mapped_file.cpp - Unit tests for MappedFile
+ *
+ * Tests mapping a regular file and the failures reported for missing,
+ * empty and non-regular paths.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../../src/shared/mapped_file.h"
+
+using webcodecs::MappedFile;
+
+#ifndef _WIN32
+#include <unistd.h>
+
+namespace {
+
+std::string WriteTempFile(const std::vector<uint8_t>& contents) {
+  char path[] = "/tmp/webcodecs_mapped_XXXXXX";
+  const int fd = mkstemp(path);
+  EXPECT_GE(fd, 0);
+  if (!contents.empty()) {
+    EXPECT_EQ(write(fd, contents.data(), contents.size()),
+              static_cast<ssize_t>(contents.size()));
+  }
+  close(fd);
+  return path;
+}
+
+}  // namespace
+
+TEST(MappedFileTest, MapsWholeFile) {
+  std::vector<uint8_t> contents(100000);
+  for (size_t i = 0; i < contents.size(); i++) contents[i] = static_cast<uint8_t>(i * 7);
+  const std::string path = WriteTempFile(contents);
+
+  MappedFile file;
+  std::string error;
+  ASSERT_TRUE(file.Open(path, &error)) << error;
+  EXPECT_TRUE(file.is_mapped());
+  ASSERT_EQ(file.size(), contents.size());
+  EXPECT_EQ(std::vector<uint8_t>(file.data(), file.data() + file.size()), contents);
+
+  file.Close();
+  EXPECT_EQ(file.data(), nullptr);
+  std::remove(path.c_str());
+}
+
+TEST(MappedFileTest, MissingFileFails) {
+  MappedFile file;
+  std::string error;
+  EXPECT_FALSE(file.Open("/nonexistent/webcodecs/image.png", &error));
+  EXPECT_NE(error.find("/nonexistent/webcodecs/image.png"), std::string::npos);
+  EXPECT_EQ(file.data(), nullptr);
+}
+
+TEST(MappedFileTest, EmptyFileFails) {
+  const std::string path = WriteTempFile({});
+  MappedFile file;
+  std::string error;
+  EXPECT_FALSE(file.Open(path, &error));
+  EXPECT_NE(error.find("empty"), std::string::npos);
+  std::remove(path.c_str());
+}
+
+TEST(MappedFileTest, DirectoryFails) {
+  MappedFile file;
+  std::string error;
+  EXPECT_FALSE(file.Open("/tmp", &error));
+  EXPECT_NE(error.find("not a regular file"), std::string::npos);
+}
+
+#endif  // _WIN32
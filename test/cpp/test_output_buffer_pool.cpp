@@ -0,0 +1,150 @@
+/**
+ * test_output_buffer_pool.cpp - Unit tests for OutputBufferPool
+ *
+ * Tests slot hand-out, release via AVBufferRef, blocking, interruption,
+ * retiring a pool with frames still outstanding and the keep-alive for the
+ * registered memory.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../../src/shared/output_buffer_pool.h"
+
+using webcodecs::OutputBufferPool;
+using std::chrono_literals::operator""ms;
+
+class OutputBufferPoolTest : public ::testing::Test {
+ protected:
+  static constexpr int kWidth = 16;
+  static constexpr int kHeight = 8;
+
+  void SetUp() override {
+    size_ = OutputBufferPool::RequiredSize(AV_PIX_FMT_YUV420P, kWidth, kHeight);
+    ASSERT_GT(size_, 0);
+    storage_.assign(2, std::vector<uint8_t>(size_));
+    pool_ = std::make_shared<OutputBufferPool>(AV_PIX_FMT_YUV420P, kWidth, kHeight);
+    for (auto& buffer : storage_) pool_->AddBuffer(buffer.data(), buffer.size());
+  }
+
+  static bool Never() { return false; }
+
+  int size_ = 0;
+  std::vector<std::vector<uint8_t>> storage_;
+  std::shared_ptr<OutputBufferPool> pool_;
+};
+
+TEST_F(OutputBufferPoolTest, AcquireWrapsRegisteredMemoryWithPackedLayout) {
+  auto frame = pool_->Acquire(Never);
+  ASSERT_NE(frame, nullptr);
+  EXPECT_EQ(frame->format, AV_PIX_FMT_YUV420P);
+  EXPECT_EQ(frame->width, kWidth);
+  EXPECT_EQ(frame->height, kHeight);
+  EXPECT_EQ(frame->data[0], storage_[0].data());
+  EXPECT_EQ(frame->linesize[0], kWidth);
+  EXPECT_EQ(frame->data[1], storage_[0].data() + kWidth * kHeight);
+  EXPECT_EQ(pool_->IndexOf(frame->buf[0]->data), 0);
+  EXPECT_EQ(pool_->InUse(), 1u);
+}
+
+TEST_F(OutputBufferPoolTest, SlotReturnsWhenLastReferenceIsReleased) {
+  auto first = pool_->Acquire(Never);
+  auto second = pool_->Acquire(Never);
+  ASSERT_NE(second, nullptr);
+  EXPECT_EQ(pool_->InUse(), 2u);
+
+  // A clone shares the buffer, so the slot stays busy until both are gone
+  AVFrame* clone = av_frame_clone(first.get());
+  first.reset();
+  EXPECT_EQ(pool_->InUse(), 2u);
+  av_frame_free(&clone);
+  EXPECT_EQ(pool_->InUse(), 1u);
+
+  auto third = pool_->Acquire(Never);
+  ASSERT_NE(third, nullptr);
+  EXPECT_EQ(third->data[0], storage_[0].data());
+}
+
+TEST_F(OutputBufferPoolTest, AcquireBlocksUntilASlotIsReleased) {
+  auto first = pool_->Acquire(Never);
+  auto second = pool_->Acquire(Never);
+
+  auto waiter = std::async(std::launch::async, [this] { return pool_->Acquire(Never); });
+  EXPECT_EQ(waiter.wait_for(100ms), std::future_status::timeout);
+
+  second.reset();
+  auto third = waiter.get();
+  ASSERT_NE(third, nullptr);
+  EXPECT_EQ(third->data[0], storage_[1].data());
+}
+
+TEST_F(OutputBufferPoolTest, InterruptWakesBlockedAcquire) {
+  auto first = pool_->Acquire(Never);
+  auto second = pool_->Acquire(Never);
+
+  auto waiter = std::async(std::launch::async, [this] { return pool_->Acquire(Never); });
+  std::this_thread::sleep_for(20ms);
+  pool_->Interrupt();
+  EXPECT_EQ(waiter.get(), nullptr);
+}
+
+TEST_F(OutputBufferPoolTest, AbortPredicateStopsWaiting) {
+  auto first = pool_->Acquire(Never);
+  auto second = pool_->Acquire(Never);
+
+  std::atomic<bool> abort{false};
+  auto waiter =
+      std::async(std::launch::async, [&] { return pool_->Acquire([&] { return abort.load(); }); });
+  abort.store(true);
+  EXPECT_EQ(waiter.get(), nullptr);
+}
+
+TEST_F(OutputBufferPoolTest, OutstandingFramesKeepPoolAlive) {
+  auto frame = pool_->Acquire(Never);
+  pool_.reset();
+  // Releasing after the owner dropped the pool must not touch freed memory
+  frame.reset();
+  SUCCEED();
+}
+
+TEST_F(OutputBufferPoolTest, KeepAliveOutlivesTheLastOutstandingFrame) {
+  auto keep_alive = std::make_shared<int>(0);
+  std::weak_ptr<int> watched = keep_alive;
+  pool_->SetKeepAlive(std::move(keep_alive));
+
+  auto frame = pool_->Acquire(Never);
+  ASSERT_NE(frame, nullptr);
+  AVFrame* clone = av_frame_clone(frame.get());
+  pool_->Close();
+  pool_.reset();
+  frame.reset();
+  // The clone still points into the registered memory
+  EXPECT_FALSE(watched.expired());
+  av_frame_free(&clone);
+  EXPECT_TRUE(watched.expired());
+}
+
+TEST_F(OutputBufferPoolTest, CloseFailsAcquireButKeepsOutstandingSlots) {
+  auto first = pool_->Acquire(Never);
+  auto second = pool_->Acquire(Never);
+  auto waiter = std::async(std::launch::async, [this] { return pool_->Acquire(Never); });
+  std::this_thread::sleep_for(20ms);
+
+  pool_->Close();
+  EXPECT_EQ(waiter.get(), nullptr);
+  first.reset();
+  EXPECT_EQ(pool_->Acquire(Never), nullptr);
+
+  // The closed pool still owns what it handed out until it is released
+  std::weak_ptr<OutputBufferPool> weak = pool_;
+  pool_.reset();
+  EXPECT_FALSE(weak.expired());
+  EXPECT_EQ(weak.lock()->InUse(), 1u);
+  second.reset();
+  EXPECT_TRUE(weak.expired());
+}
@@ -0,0 +1,153 @@
+/**
+ * test_pcm_codec.cpp - Unit tests for the inline PCM/G.711 codecs
+ *
+ * Tests G.711 table values against the reference code points, coded
+ * round trips, byte order handling and packet-to-frame decoding.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "../../src/ffmpeg_raii.h"
+#include "../../src/shared/pcm_codec.h"
+
+namespace pcm = webcodecs::pcm_codec;
+
+namespace {
+
+std::vector<uint8_t> EncodeS16(const pcm::Format& format, std::vector<int16_t> samples) {
+  std::vector<uint8_t> out(samples.size() * format.coded_size);
+  pcm::Encode(format, reinterpret_cast<const uint8_t*>(samples.data()), samples.size(), out.data());
+  return out;
+}
+
+std::vector<int16_t> DecodeS16(const pcm::Format& format, std::vector<uint8_t> coded) {
+  std::vector<int16_t> out(coded.size() / format.coded_size);
+  pcm::Decode(format, coded.data(), out.size(), reinterpret_cast<uint8_t*>(out.data()));
+  return out;
+}
+
+}  // namespace
+
+TEST(PcmCodecTest, FindsStatelessCodecsOnly) {
+  EXPECT_TRUE(pcm::Find(AV_CODEC_ID_PCM_MULAW));
+  EXPECT_TRUE(pcm::Find(AV_CODEC_ID_PCM_S24BE));
+  EXPECT_EQ(pcm::Find(AV_CODEC_ID_PCM_S24LE)->sample_fmt, AV_SAMPLE_FMT_S32);
+  EXPECT_EQ(pcm::Find(AV_CODEC_ID_PCM_ALAW)->sample_fmt, AV_SAMPLE_FMT_S16);
+  EXPECT_FALSE(pcm::Find(AV_CODEC_ID_OPUS));
+  EXPECT_FALSE(pcm::Find(AV_CODEC_ID_FLAC));
+}
+
+TEST(PcmCodecTest, G711DecodesReferenceCodePoints) {
+  const pcm::Format ulaw = *pcm::Find(AV_CODEC_ID_PCM_MULAW);
+  const pcm::Format alaw = *pcm::Find(AV_CODEC_ID_PCM_ALAW);
+  EXPECT_EQ(DecodeS16(ulaw, {0xff, 0x7f, 0x00, 0x80}), (std::vector<int16_t>{0, 0, -32124, 32124}));
+  EXPECT_EQ(DecodeS16(alaw, {0xd5, 0x55, 0xaa, 0x2a}), (std::vector<int16_t>{8, -8, 32256, -32256}));
+}
+
+TEST(PcmCodecTest, G711EncodesSilenceAndFullScale) {
+  const pcm::Format ulaw = *pcm::Find(AV_CODEC_ID_PCM_MULAW);
+  const pcm::Format alaw = *pcm::Find(AV_CODEC_ID_PCM_ALAW);
+  EXPECT_EQ(EncodeS16(ulaw, {0, 32767, -32768}), (std::vector<uint8_t>{0xff, 0x80, 0x00}));
+  EXPECT_EQ(EncodeS16(alaw, {0, 32767, -32768}), (std::vector<uint8_t>{0xd5, 0xaa, 0x2a}));
+}
+
+TEST(PcmCodecTest, G711CodesRoundTrip) {
+  for (AVCodecID id : {AV_CODEC_ID_PCM_MULAW, AV_CODEC_ID_PCM_ALAW}) {
+    const pcm::Format format = *pcm::Find(id);
+    std::vector<uint8_t> codes;
+    for (int code = 0; code < 256; code++) {
+      // mu-law has two zeros; 0x7f encodes back as 0xff
+      if (id == AV_CODEC_ID_PCM_MULAW && code == 0x7f) continue;
+      codes.push_back(static_cast<uint8_t>(code));
+    }
+    EXPECT_EQ(EncodeS16(format, DecodeS16(format, codes)), codes) << avcodec_get_name(id);
+  }
+}
+
+TEST(PcmCodecTest, G711EncodesToNearestCode) {
+  const pcm::Format ulaw = *pcm::Find(AV_CODEC_ID_PCM_MULAW);
+  const std::vector<int16_t> levels = DecodeS16(ulaw, {0x80, 0x81, 0x82, 0x83});
+  // Between two levels the encoder switches at the midpoint (4-sample index granularity)
+  for (size_t i = 0; i + 1 < levels.size(); i++) {
+    const int16_t near_upper = static_cast<int16_t>(levels[i] - 8);
+    const int16_t near_lower = static_cast<int16_t>(levels[i + 1] + 8);
+    EXPECT_EQ(EncodeS16(ulaw, {near_upper})[0], 0x80 + i);
+    EXPECT_EQ(EncodeS16(ulaw, {near_lower})[0], 0x81 + i);
+  }
+}
+
+TEST(PcmCodecTest, HandlesByteOrder) {
+  const uint8_t coded[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06};
+
+  int16_t s16[3];
+  pcm::Decode(*pcm::Find(AV_CODEC_ID_PCM_S16BE), coded, 3, reinterpret_cast<uint8_t*>(s16));
+  EXPECT_EQ(s16[0], 0x0102);
+  pcm::Decode(*pcm::Find(AV_CODEC_ID_PCM_S16LE), coded, 3, reinterpret_cast<uint8_t*>(s16));
+  EXPECT_EQ(s16[2], 0x0605);
+
+  int32_t s32[2];
+  pcm::Decode(*pcm::Find(AV_CODEC_ID_PCM_S24LE), coded, 2, reinterpret_cast<uint8_t*>(s32));
+  EXPECT_EQ(s32[0], 0x03020100);
+  EXPECT_EQ(s32[1], 0x06050400);
+  pcm::Decode(*pcm::Find(AV_CODEC_ID_PCM_S24BE), coded, 2, reinterpret_cast<uint8_t*>(s32));
+  EXPECT_EQ(s32[0], 0x01020300);
+
+  const float value = -0.25f;
+  const uint8_t f32be[] = {0xbe, 0x80, 0x00, 0x00};
+  float decoded = 0;
+  pcm::Decode(*pcm::Find(AV_CODEC_ID_PCM_F32BE), f32be, 1, reinterpret_cast<uint8_t*>(&decoded));
+  EXPECT_EQ(decoded, value);
+}
+
+TEST(PcmCodecTest, EncodeInvertsDecode) {
+  const std::vector<uint8_t> coded = {0x10, 0x80, 0xff, 0x7f, 0x00, 0x01, 0xfe, 0x42, 0x99, 0x24, 0x31, 0xc8};
+  for (AVCodecID id : {AV_CODEC_ID_PCM_S16LE, AV_CODEC_ID_PCM_S16BE, AV_CODEC_ID_PCM_S24LE, AV_CODEC_ID_PCM_S24BE,
+                       AV_CODEC_ID_PCM_S32BE, AV_CODEC_ID_PCM_F32BE, AV_CODEC_ID_PCM_U8}) {
+    const pcm::Format format = *pcm::Find(id);
+    const size_t count = coded.size() / format.coded_size;
+    std::vector<uint8_t> samples(count * av_get_bytes_per_sample(format.sample_fmt));
+    std::vector<uint8_t> encoded(coded.size());
+    pcm::Decode(format, coded.data(), count, samples.data());
+    pcm::Encode(format, samples.data(), count, encoded.data());
+    EXPECT_EQ(encoded, coded) << avcodec_get_name(id);
+  }
+}
+
+TEST(PcmCodecTest, DecodePacketDropsPartialFrameAndRejectsShortPacket) {
+  const pcm::Format format = *pcm::Find(AV_CODEC_ID_PCM_MULAW);
+  webcodecs::raii::AVPacketPtr packet = webcodecs::raii::MakeAvPacket();
+  ASSERT_EQ(av_new_packet(packet.get(), 7), 0);
+  std::memset(packet->data, 0xff, 7);
+
+  webcodecs::raii::AVFramePtr frame = webcodecs::raii::MakeAvFrame();
+  av_channel_layout_default(&frame->ch_layout, 2);
+  ASSERT_EQ(pcm::DecodePacket(format, packet.get(), 2, frame.get()), 0);
+  EXPECT_EQ(frame->format, AV_SAMPLE_FMT_S16);
+  EXPECT_EQ(frame->nb_samples, 3);
+  EXPECT_EQ(reinterpret_cast<int16_t*>(frame->data[0])[5], 0);
+
+  packet->size = 1;
+  webcodecs::raii::AVFramePtr short_frame = webcodecs::raii::MakeAvFrame();
+  av_channel_layout_default(&short_frame->ch_layout, 2);
+  EXPECT_EQ(pcm::DecodePacket(format, packet.get(), 2, short_frame.get()), AVERROR_INVALIDDATA);
+}
+
+TEST(PcmCodecTest, DecodePacketReferencesNativeOrderPayload) {
+#if AV_HAVE_BIGENDIAN
+  const pcm::Format format = *pcm::Find(AV_CODEC_ID_PCM_S16BE);
+#else
+  const pcm::Format format = *pcm::Find(AV_CODEC_ID_PCM_S16LE);
+#endif
+  webcodecs::raii::AVPacketPtr packet = webcodecs::raii::MakeAvPacket();
+  ASSERT_EQ(av_new_packet(packet.get(), 8), 0);
+
+  webcodecs::raii::AVFramePtr frame = webcodecs::raii::MakeAvFrame();
+  av_channel_layout_default(&frame->ch_layout, 1);
+  ASSERT_EQ(pcm::DecodePacket(format, packet.get(), 1, frame.get()), 0);
+  EXPECT_EQ(frame->nb_samples, 4);
+  EXPECT_EQ(frame->data[0], packet->data);
+  EXPECT_EQ(frame->buf[0]->buffer, packet->buf->buffer);
+}
@@ -0,0 +1,101 @@
+/**
+ * test_progressive_scanner.cpp - Unit tests for ProgressiveScanner
+ *
+ * Tests JPEG scan boundaries, incremental updates over byte-at-a-time
+ * input, and that PNG is not scanned.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+#include "../../src/shared/progressive_scanner.h"
+
+using webcodecs::ProgressiveScanner;
+using webcodecs::SegmentedBuffer;
+
+namespace {
+
+void AppendSegment(std::vector<uint8_t>* out, uint8_t marker, size_t payload) {
+  const size_t length = payload + 2;
+  out->insert(out->end(), {0xFF, marker, static_cast<uint8_t>(length >> 8),
+                           static_cast<uint8_t>(length & 0xFF)});
+  out->insert(out->end(), payload, 0x11);
+}
+
+// SOI, DQT, SOF2, then `scans` x (SOS + entropy-coded data), then EOI.
+// The entropy-coded data contains stuffed bytes and a restart marker.
+std::vector<uint8_t> ProgressiveJpeg(int scans, std::vector<size_t>* scan_ends) {
+  std::vector<uint8_t> jpeg = {0xFF, 0xD8};
+  AppendSegment(&jpeg, 0xDB, 65);
+  AppendSegment(&jpeg, 0xC2, 15);
+  for (int i = 0; i < scans; i++) {
+    AppendSegment(&jpeg, 0xDA, 10);
+    jpeg.insert(jpeg.end(), {0x12, 0xFF, 0x00, 0x34, 0xFF, 0xD0, 0x56, 0x78});
+    scan_ends->push_back(jpeg.size());
+  }
+  jpeg.insert(jpeg.end(), {0xFF, 0xD9});
+  return jpeg;
+}
+
+}  // namespace
+
+TEST(ProgressiveScannerTest, UnsupportedTypesNeverRefine) {
+  for (const char* type : {"image/gif", "image/png"}) {
+    ProgressiveScanner scanner(type);
+    SegmentedBuffer data;
+    data.Append(std::vector<uint8_t>(1024, 0xFF));
+    EXPECT_FALSE(scanner.supported()) << type;
+    EXPECT_FALSE(scanner.Update(data)) << type;
+    EXPECT_EQ(scanner.generation(), 0) << type;
+  }
+}
+
+TEST(ProgressiveScannerTest, JpegReportsEachCompleteScan) {
+  std::vector<size_t> scan_ends;
+  std::vector<uint8_t> jpeg = ProgressiveJpeg(3, &scan_ends);
+
+  ProgressiveScanner scanner("image/jpeg");
+  SegmentedBuffer data;
+  data.Append(std::vector<uint8_t>(jpeg.begin(), jpeg.begin() + scan_ends[1] + 1));
+  EXPECT_TRUE(scanner.Update(data));
+  EXPECT_EQ(scanner.generation(), 1);  // Second scan not terminated yet
+  EXPECT_EQ(scanner.boundary(), scan_ends[0]);
+
+  data.Append(std::vector<uint8_t>(jpeg.begin() + scan_ends[1] + 1, jpeg.end()));
+  EXPECT_TRUE(scanner.Update(data));
+  EXPECT_EQ(scanner.generation(), 3);
+  EXPECT_EQ(scanner.boundary(), scan_ends[2]);
+}
+
+TEST(ProgressiveScannerTest, JpegByteAtATimeMatchesWholeBuffer) {
+  std::vector<size_t> scan_ends;
+  std::vector<uint8_t> jpeg = ProgressiveJpeg(5, &scan_ends);
+
+  ProgressiveScanner scanner("image/jpeg");
+  SegmentedBuffer data;
+  int steps = 0;
+  for (uint8_t byte : jpeg) {
+    data.Append(std::vector<uint8_t>{byte});
+    if (scanner.Update(data)) steps++;
+  }
+  EXPECT_EQ(steps, 5);
+  EXPECT_EQ(scanner.boundary(), scan_ends[4]);
+}
+
+TEST(ProgressiveScannerTest, ResetStartsOver) {
+  std::vector<size_t> scan_ends;
+  std::vector<uint8_t> jpeg = ProgressiveJpeg(2, &scan_ends);
+
+  ProgressiveScanner scanner("image/jpeg");
+  SegmentedBuffer data;
+  data.Append(std::vector<uint8_t>(jpeg.begin(), jpeg.end()));
+  scanner.Update(data);
+  ASSERT_EQ(scanner.generation(), 2);
+
+  scanner.Reset("image/jpeg");
+  EXPECT_EQ(scanner.generation(), 0);
+  EXPECT_EQ(scanner.boundary(), 0u);
+  EXPECT_TRUE(scanner.Update(data));
+  EXPECT_EQ(scanner.generation(), 2);
+}
@@ -0,0 +1,242 @@
+/**
+ * test_sample_kernels.cpp - Unit tests for the audio sample kernels
+ *
+ * Every implementation this CPU can run is checked against the
+ * libswresample formulas (conversions) and a per-sample reference
+ * (interleave/deinterleave, mixing), including tails shorter than a vector.
+ */
+
+#include <gtest/gtest.h>
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../../src/shared/sample_kernels.h"
+
+namespace sk = webcodecs::sample_kernels;
+
+namespace {
+
+// Values around the clipping points, far out of range (300 * 128 overflows
+// int16) and rounding ties, then noise
+std::vector<float> TestFloats(size_t count) {
+  std::vector<float> values{0.0f,         -0.0f,         1.0f,       -1.0f,      300.0f,
+                            -300.0f,      1.5f,          -1.5f,      100.0f,     -100.0f,
+                            0.5f,         -0.5f,         0.999999f,  -0.999999f, 0.5f / 32768,
+                            1.5f / 32768, -2.5f / 32768, 0.5f / 128, 1.5f / 128, -0.5f / 128};
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(-1.2f, 1.2f);
+  while (values.size() < count) values.push_back(dist(rng));
+  values.resize(count);
+  return values;
+}
+
+// libswresample reference conversions (audioconvert.c)
+uint8_t RefF32ToU8(float v) {
+  return static_cast<uint8_t>(std::min(std::max(std::lrintf(v * 128.0f) + 0x80, 0L), 255L));
+}
+int16_t RefF32ToS16(float v) {
+  return static_cast<int16_t>(std::min(std::max(std::lrintf(v * 32768.0f), -32768L), 32767L));
+}
+int32_t RefF32ToS32(float v) {
+  const long long r = std::llrintf(v * 2147483648.0f);
+  return static_cast<int32_t>(std::min<long long>(std::max<long long>(r, INT32_MIN), INT32_MAX));
+}
+
+}  // namespace
+
+class SampleKernelsTest : public ::testing::TestWithParam<const sk::Kernels*> {
+ protected:
+  const sk::Kernels& k() const { return *GetParam(); }
+};
+
+TEST_P(SampleKernelsTest, IntToFloat) {
+  for (size_t count : {0, 1, 7, 31, 257}) {
+    std::vector<uint8_t> u8(count);
+    std::vector<int16_t> s16(count);
+    std::vector<int32_t> s32(count);
+    for (size_t i = 0; i < count; i++) {
+      u8[i] = static_cast<uint8_t>(i * 37);
+      s16[i] = static_cast<int16_t>(i * 2731 - 32768);
+      s32[i] = i == 0 ? INT32_MIN : i == 1 ? INT32_MAX : static_cast<int32_t>(i * 16777259u);
+    }
+
+    std::vector<float> out(count);
+    sk::Convert(sk::SampleType::kU8, u8.data(), sk::SampleType::kF32, out.data(), count, k());
+    for (size_t i = 0; i < count; i++) EXPECT_EQ(out[i], (u8[i] - 0x80) * (1.0f / 128)) << i;
+
+    sk::Convert(sk::SampleType::kS16, s16.data(), sk::SampleType::kF32, out.data(), count, k());
+    for (size_t i = 0; i < count; i++) EXPECT_EQ(out[i], s16[i] * (1.0f / 32768)) << i;
+
+    sk::Convert(sk::SampleType::kS32, s32.data(), sk::SampleType::kF32, out.data(), count, k());
+    for (size_t i = 0; i < count; i++) EXPECT_EQ(out[i], s32[i] * (1.0f / (1U << 31))) << i;
+  }
+}
+
+TEST_P(SampleKernelsTest, FloatToIntRoundsAndSaturates) {
+  for (size_t count : {0, 1, 15, 33, 259}) {
+    const std::vector<float> in = TestFloats(count);
+    std::vector<uint8_t> u8(count);
+    std::vector<int16_t> s16(count);
+    std::vector<int32_t> s32(count);
+
+    sk::Convert(sk::SampleType::kF32, in.data(), sk::SampleType::kU8, u8.data(), count, k());
+    sk::Convert(sk::SampleType::kF32, in.data(), sk::SampleType::kS16, s16.data(), count, k());
+    sk::Convert(sk::SampleType::kF32, in.data(), sk::SampleType::kS32, s32.data(), count, k());
+    for (size_t i = 0; i < count; i++) {
+      EXPECT_EQ(u8[i], RefF32ToU8(in[i])) << in[i];
+      EXPECT_EQ(s16[i], RefF32ToS16(in[i])) << in[i];
+      EXPECT_EQ(s32[i], RefF32ToS32(in[i])) << in[i];
+    }
+  }
+}
+
+TEST_P(SampleKernelsTest, InterleaveMatchesReference) {
+  for (int channels : {1, 2, 3, 4, 6, 8}) {
+    for (size_t frames : {0, 1, 5, 37}) {
+      std::vector<std::vector<uint32_t>> planes(channels, std::vector<uint32_t>(frames));
+      std::vector<const uint8_t*> pointers;
+      for (int ch = 0; ch < channels; ch++) {
+        for (size_t i = 0; i < frames; i++) planes[ch][i] = static_cast<uint32_t>(ch * 1000 + i);
+        pointers.push_back(reinterpret_cast<const uint8_t*>(planes[ch].data()));
+      }
+
+      std::vector<uint32_t> out(frames * channels + 1, 0xDEADBEEF);
+      sk::Interleave(pointers.data(), channels, frames, 4,
+                     reinterpret_cast<uint8_t*>(out.data()), k());
+      for (size_t i = 0; i < frames; i++) {
+        for (int ch = 0; ch < channels; ch++) {
+          ASSERT_EQ(out[i * channels + ch], planes[ch][i]) << channels << "ch frame " << i;
+        }
+      }
+      EXPECT_EQ(out.back(), 0xDEADBEEF);  // No write past the end
+    }
+  }
+}
+
+TEST_P(SampleKernelsTest, DeinterleaveMatchesReference) {
+  for (int channels : {1, 2, 3, 4, 6, 8}) {
+    for (size_t frames : {0, 1, 5, 37}) {
+      std::vector<uint32_t> in(frames * channels);
+      for (size_t i = 0; i < in.size(); i++) in[i] = static_cast<uint32_t>(i);
+
+      for (int channel = 0; channel < channels; channel++) {
+        std::vector<uint32_t> out(frames + 1, 0xDEADBEEF);
+        sk::Deinterleave(reinterpret_cast<const uint8_t*>(in.data()), channels, channel, frames, 4,
+                         reinterpret_cast<uint8_t*>(out.data()), k());
+        for (size_t i = 0; i < frames; i++) {
+          ASSERT_EQ(out[i], in[i * channels + channel]) << channels << "ch " << channel;
+        }
+        EXPECT_EQ(out.back(), 0xDEADBEEF);
+      }
+    }
+  }
+}
+
+TEST_P(SampleKernelsTest, MixMatchesReference) {
+  for (int channels : {1, 2, 6}) {
+    for (size_t frames : {0, 1, 7, 61}) {
+      std::vector<std::vector<float>> planes;
+      std::vector<const float*> pointers;
+      for (int ch = 0; ch < channels; ch++) {
+        planes.push_back(TestFloats(frames + ch));
+        pointers.push_back(planes.back().data() + ch);
+      }
+      const float gains[] = {0.5f, 0.0f, -0.25f, 1.0f, 0.707f, 0.125f};
+
+      std::vector<float> out(frames + 1, 42.0f);
+      sk::Mix(pointers.data(), gains, channels, frames, out.data(), k());
+      for (size_t i = 0; i < frames; i++) {
+        float expected = 0.0f;
+        for (int ch = 0; ch < channels; ch++) expected += gains[ch] * pointers[ch][i];
+        ASSERT_NEAR(out[i], expected, 1e-6f) << channels << "ch frame " << i;
+      }
+      EXPECT_EQ(out.back(), 42.0f);
+    }
+  }
+}
+
+TEST_P(SampleKernelsTest, SoftClipMatchesScalar) {
+  std::vector<float> samples;
+  for (int i = -40; i <= 40; i++) samples.push_back(i * 0.05f);  // -2.0 .. 2.0
+  samples.push_back(1e6f);
+  samples.push_back(-1e6f);
+
+  std::vector<float> expected = samples;
+  std::vector<float> out = samples;
+  sk::ScalarKernels().soft_clip(expected.data(), expected.size());
+  k().soft_clip(out.data(), out.size());
+  for (size_t i = 0; i < out.size(); i++) {
+    ASSERT_NEAR(out[i], expected[i], 1e-6f) << "input " << samples[i];
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Implementations, SampleKernelsTest,
+                         ::testing::ValuesIn(sk::Available()),
+                         [](const ::testing::TestParamInfo<const sk::Kernels*>& info) {
+                           return std::string(info.param->name);
+                         });
+
+TEST(SampleKernels, NarrowSamplesUseGenericLayout) {
+  const int16_t left[] = {1, 2, 3};
+  const int16_t right[] = {-1, -2, -3};
+  const uint8_t* planes[] = {reinterpret_cast<const uint8_t*>(left),
+                             reinterpret_cast<const uint8_t*>(right)};
+  int16_t interleaved[6] = {};
+  sk::Interleave(planes, 2, 3, sizeof(int16_t), reinterpret_cast<uint8_t*>(interleaved));
+  EXPECT_EQ(std::vector<int16_t>(interleaved, interleaved + 6),
+            (std::vector<int16_t>{1, -1, 2, -2, 3, -3}));
+
+  int16_t plane[3] = {};
+  sk::Deinterleave(reinterpret_cast<const uint8_t*>(interleaved), 2, 1, 3, sizeof(int16_t),
+                   reinterpret_cast<uint8_t*>(plane));
+  EXPECT_EQ(std::vector<int16_t>(plane, plane + 3), (std::vector<int16_t>{-1, -2, -3}));
+}
+
+TEST(SampleKernels, MixCopiesUnitGainAndSkipsSilentChannels) {
+  const float left[] = {1.0f, 2.0f, 3.0f};
+  const float right[] = {4.0f, 5.0f, 6.0f};
+  const float* planes[] = {left, right, nullptr};  // A zero gain channel is never read
+
+  float out[3] = {};
+  const float swap[] = {0.0f, 1.0f, 0.0f};
+  sk::Mix(planes, swap, 3, 3, out);
+  EXPECT_EQ(std::vector<float>(out, out + 3), (std::vector<float>{4.0f, 5.0f, 6.0f}));
+
+  const float silent[] = {0.0f, 0.0f, 0.0f};
+  sk::Mix(planes, silent, 3, 3, out);
+  EXPECT_EQ(std::vector<float>(out, out + 3), (std::vector<float>{0.0f, 0.0f, 0.0f}));
+}
+
+TEST(SampleKernels, SoftClipIsLinearBelowTheKneeAndBounded) {
+  float samples[] = {0.0f, 0.5f, -0.75f, 0.8f, 1.0f, 1.4f, 1.5f, -100.0f};
+  sk::SoftClip(samples, 8);
+  EXPECT_EQ(samples[0], 0.0f);
+  EXPECT_EQ(samples[1], 0.5f);
+  EXPECT_EQ(samples[2], -0.75f);
+  for (int i = 3; i < 8; i++) {
+    EXPECT_GT(samples[i] > 0 ? samples[i] : -samples[i], 0.75f);
+    EXPECT_LE(samples[i] > 0 ? samples[i] : -samples[i], 1.0f);
+  }
+  // Monotonic, reaching full scale at 1.5
+  EXPECT_LT(samples[3], samples[4]);
+  EXPECT_LT(samples[4], samples[5]);
+  EXPECT_LT(samples[5], 1.0f);
+  EXPECT_EQ(samples[6], 1.0f);
+  EXPECT_EQ(samples[7], -1.0f);
+}
+
+TEST(SampleKernels, CanConvertOnlyThroughFloat) {
+  EXPECT_TRUE(sk::CanConvert(sk::SampleType::kS16, sk::SampleType::kS16));
+  EXPECT_TRUE(sk::CanConvert(sk::SampleType::kS16, sk::SampleType::kF32));
+  EXPECT_TRUE(sk::CanConvert(sk::SampleType::kF32, sk::SampleType::kU8));
+  EXPECT_FALSE(sk::CanConvert(sk::SampleType::kS16, sk::SampleType::kS32));
+  EXPECT_FALSE(sk::CanConvert(sk::SampleType::kU8, sk::SampleType::kS16));
+}
+
+TEST(SampleKernels, GetPicksTheBestAvailable) {
+  EXPECT_EQ(&sk::Get(), sk::Available().back());
+}
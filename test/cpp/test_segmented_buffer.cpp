@@ -0,0 +1,120 @@
+/**
+ * test_segmented_buffer.cpp - Unit tests for SegmentedBuffer
+ *
+ * Tests appends, views, reads spanning segments, random access and clearing.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../../src/shared/segmented_buffer.h"
+
+using webcodecs::SegmentedBuffer;
+
+namespace {
+
+// Appends `count` chunks of `chunk_size` bytes holding 0, 1, 2, ... (mod 256)
+void Fill(SegmentedBuffer* buffer, size_t count, size_t chunk_size) {
+  uint8_t value = 0;
+  for (size_t i = 0; i < count; i++) {
+    std::vector<uint8_t> chunk(chunk_size);
+    for (uint8_t& byte : chunk) byte = value++;
+    buffer->Append(std::move(chunk));
+  }
+}
+
+}  // namespace
+
+TEST(SegmentedBufferTest, StartsEmpty) {
+  SegmentedBuffer buffer;
+  uint8_t byte = 0;
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.Read(0, &byte, 1), 0u);
+}
+
+TEST(SegmentedBufferTest, AppendTracksSizeAndIgnoresEmptyChunks) {
+  SegmentedBuffer buffer;
+  buffer.Append(std::vector<uint8_t>(10));
+  buffer.Append(std::vector<uint8_t>());
+  buffer.Append(std::vector<uint8_t>(5));
+  EXPECT_EQ(buffer.size(), 15u);
+  EXPECT_EQ(buffer.segment_count(), 2u);
+}
+
+TEST(SegmentedBufferTest, ReadSpansSegments) {
+  SegmentedBuffer buffer;
+  Fill(&buffer, 4, 16);
+
+  std::vector<uint8_t> out(40);
+  ASSERT_EQ(buffer.Read(10, out.data(), out.size()), 40u);
+  for (size_t i = 0; i < out.size(); i++) {
+    EXPECT_EQ(out[i], static_cast<uint8_t>(10 + i));
+  }
+}
+
+TEST(SegmentedBufferTest, ReadIsClampedAtEnd) {
+  SegmentedBuffer buffer;
+  Fill(&buffer, 2, 16);
+
+  std::vector<uint8_t> out(64);
+  EXPECT_EQ(buffer.Read(20, out.data(), out.size()), 12u);
+  EXPECT_EQ(out[0], 20);
+  EXPECT_EQ(out[11], 31);
+  EXPECT_EQ(buffer.Read(32, out.data(), out.size()), 0u);
+}
+
+TEST(SegmentedBufferTest, RandomAccessAfterSequentialReads) {
+  SegmentedBuffer buffer;
+  Fill(&buffer, 8, 7);
+
+  uint8_t byte = 0;
+  for (size_t pos = 0; pos < buffer.size(); pos++) {
+    ASSERT_EQ(buffer.Read(pos, &byte, 1), 1u);
+    EXPECT_EQ(byte, static_cast<uint8_t>(pos));
+  }
+  EXPECT_EQ(buffer.At(3), 3);
+  EXPECT_EQ(buffer.At(50), 50);
+  EXPECT_EQ(buffer.At(0), 0);
+}
+
+TEST(SegmentedBufferTest, DataAppendedAfterReadsIsVisible) {
+  SegmentedBuffer buffer;
+  Fill(&buffer, 1, 8);
+  uint8_t out[8];
+  ASSERT_EQ(buffer.Read(0, out, 8), 8u);
+
+  buffer.Append(std::vector<uint8_t>{100, 101});
+  ASSERT_EQ(buffer.Read(8, out, 8), 2u);
+  EXPECT_EQ(out[0], 100);
+  EXPECT_EQ(out[1], 101);
+}
+
+TEST(SegmentedBufferTest, ClearResets) {
+  SegmentedBuffer buffer;
+  Fill(&buffer, 3, 4);
+  buffer.Clear();
+  EXPECT_EQ(buffer.size(), 0u);
+  EXPECT_EQ(buffer.segment_count(), 0u);
+}
+
+TEST(SegmentedBufferTest, ViewsAreReadInPlaceAndKeepTheirOwnerAlive) {
+  auto owner = std::make_shared<std::vector<uint8_t>>(std::vector<uint8_t>{7, 8, 9});
+  std::weak_ptr<std::vector<uint8_t>> weak = owner;
+
+  SegmentedBuffer buffer;
+  Fill(&buffer, 1, 2);
+  buffer.AppendView(owner->data(), owner->size(), owner);
+  owner.reset();
+  ASSERT_FALSE(weak.expired());
+
+  uint8_t out[5];
+  ASSERT_EQ(buffer.Read(0, out, 5), 5u);
+  EXPECT_EQ(out[1], 1);
+  EXPECT_EQ(out[2], 7);
+  EXPECT_EQ(buffer.At(4), 9);
+
+  buffer.Clear();
+  EXPECT_TRUE(weak.expired());
+}
@@ -1,7 +1,46 @@
 // test/image-decoder.test.ts
+import { readFileSync, writeFileSync, rmSync } from 'node:fs';
+import { tmpdir } from 'node:os';
+import { join } from 'node:path';
 import { describe, it, expect } from 'vitest';
 import { ImageDecoder } from '@pproenca/node-webcodecs';
 
+/** Uncompressed 24-bit BMP with a horizontal gradient. */
+function createBmp(width: number, height: number): Uint8Array {
+  const rowSize = Math.ceil((width * 3) / 4) * 4;
+  const data = new Uint8Array(54 + rowSize * height);
+  const view = new DataView(data.buffer);
+  data.set([0x42, 0x4d]); // "BM"
+  view.setUint32(2, data.length, true);
+  view.setUint32(10, 54, true); // Pixel data offset
+  view.setUint32(14, 40, true); // BITMAPINFOHEADER
+  view.setInt32(18, width, true);
+  view.setInt32(22, height, true);
+  view.setUint16(26, 1, true); // Planes
+  view.setUint16(28, 24, true); // Bits per pixel
+  view.setUint32(34, rowSize * height, true);
+  for (let y = 0; y < height; y++) {
+    for (let x = 0; x < width; x++) {
+      data.fill((x * 255) / width, 54 + y * rowSize + x * 3, 54 + y * rowSize + x * 3 + 3);
+    }
+  }
+  return data;
+}
+
+/** 64x48 progressive JPEG with 10 scans (libjpeg simple progression). */
+function loadProgressiveJpeg(): Uint8Array {
+  return new Uint8Array(readFileSync(new URL('./fixtures/progressive.jpg', import.meta.url)));
+}
+
+/** Offsets of the SOS markers that start each JPEG scan. */
+function scanStarts(jpeg: Uint8Array): number[] {
+  const starts: number[] = [];
+  for (let i = 0; i + 1 < jpeg.length; i++) {
+    if (jpeg[i] === 0xff && jpeg[i + 1] === 0xda) starts.push(i);
+  }
+  return starts;
+}
+
 describe('ImageDecoder', () => {
   describe('isTypeSupported()', () => {
     it('should return a Promise', () => {
@@ -148,6 +187,76 @@ describe('ImageDecoder', () => {
     });
   });
 
+  describe('desiredWidth / desiredHeight', () => {
+    it('should decode at the desired size', async () => {
+      const decoder = new ImageDecoder({
+        data: createBmp(64, 32),
+        type: 'image/bmp',
+        desiredWidth: 16,
+        desiredHeight: 8,
+      });
+      const { image } = await decoder.decode();
+      expect(image.codedWidth).toBe(16);
+      expect(image.codedHeight).toBe(8);
+      image.close();
+      decoder.close();
+    });
+
+    it('should keep the aspect ratio when only one dimension is given', async () => {
+      const decoder = new ImageDecoder({
+        data: createBmp(64, 32),
+        type: 'image/bmp',
+        desiredWidth: 32,
+      });
+      const { image } = await decoder.decode();
+      expect(image.codedWidth).toBe(32);
+      expect(image.codedHeight).toBe(16);
+      image.close();
+      decoder.close();
+    });
+
+    it('should decode at full size without a desired size', async () => {
+      const decoder = new ImageDecoder({ data: createBmp(64, 32), type: 'image/bmp' });
+      const { image } = await decoder.decode();
+      expect(image.codedWidth).toBe(64);
+      expect(image.codedHeight).toBe(32);
+      image.close();
+      decoder.close();
+    });
+  });
+
+  describe('file source {path} (non-standard)', () => {
+    it('should decode a file given by path', async () => {
+      const path = join(tmpdir(), `webcodecs-test-${process.pid}.bmp`);
+      writeFileSync(path, createBmp(48, 32));
+      try {
+        const decoder = new ImageDecoder({ data: { path }, type: 'image/bmp' });
+        await decoder.completed;
+        const { image, complete } = await decoder.decode();
+        expect(complete).toBe(true);
+        expect(image.codedWidth).toBe(48);
+        expect(image.codedHeight).toBe(32);
+        image.close();
+        decoder.close();
+      } finally {
+        rmSync(path, { force: true });
+      }
+    });
+
+    it('should reject completed for a missing file', async () => {
+      const decoder = new ImageDecoder({
+        data: { path: join(tmpdir(), 'webcodecs-missing.bmp') },
+        type: 'image/bmp',
+      });
+      await expect(decoder.completed).rejects.toThrow(/webcodecs-missing\.bmp/);
+      decoder.close();
+    });
+
+    it('should throw TypeError for an empty path', () => {
+      expect(() => new ImageDecoder({ data: { path: '' }, type: 'image/bmp' })).toThrow(TypeError);
+    });
+  });
+
   describe('ReadableStream support', () => {
     it('should accept ReadableStream as data source', async () => {
       // Minimal JPEG: SOI, APP0 JFIF, EOI
@@ -256,6 +365,86 @@ describe('ImageDecoder', () => {
 
       decoder.close();
     });
+
+    it('should hold a decode until the streamed frame is complete', async () => {
+      const bmp = createBmp(64, 64);
+      let controller!: ReadableStreamDefaultController<Uint8Array>;
+      const stream = new ReadableStream<Uint8Array>({
+        start(c) {
+          controller = c;
+        },
+      });
+      controller.enqueue(bmp.slice(0, 1024));
+
+      const decoder = new ImageDecoder({
+        data: stream as unknown as BufferSource,
+        type: 'image/bmp',
+      });
+      const pending = decoder.decode({ completeFramesOnly: false });
+
+      controller.enqueue(bmp.slice(1024));
+      controller.close();
+
+      // BMP has no progressive steps: the only result is the complete frame
+      const result = await pending;
+      expect(result.complete).toBe(true);
+      expect(result.image.codedWidth).toBe(64);
+      result.image.close();
+      decoder.close();
+    });
+
+    it('should resolve partial images for a streamed progressive JPEG', async () => {
+      const jpeg = loadProgressiveJpeg();
+      const starts = scanStarts(jpeg);
+      expect(starts.length).toBeGreaterThan(2);
+      let controller!: ReadableStreamDefaultController<Uint8Array>;
+      const stream = new ReadableStream<Uint8Array>({
+        start(c) {
+          controller = c;
+        },
+      });
+      // Headers and the first two scans, up to the marker that starts the third
+      controller.enqueue(jpeg.slice(0, starts[2] + 2));
+
+      const decoder = new ImageDecoder({
+        data: stream as unknown as BufferSource,
+        type: 'image/jpeg',
+      });
+      const partial = await decoder.decode({ completeFramesOnly: false });
+      expect(partial.complete).toBe(false);
+      expect(partial.image.codedWidth).toBe(64);
+      expect(partial.image.codedHeight).toBe(48);
+      partial.image.close();
+
+      controller.enqueue(jpeg.slice(starts[2] + 2));
+      controller.close();
+      await decoder.completed;
+
+      const final = await decoder.decode({ completeFramesOnly: false });
+      expect(final.complete).toBe(true);
+      expect(final.image.codedWidth).toBe(64);
+      final.image.close();
+      decoder.close();
+    });
+
+    it('should abort a decode waiting for stream data on reset()', async () => {
+      const bmp = createBmp(64, 64);
+      const stream = new ReadableStream<Uint8Array>({
+        start(controller) {
+          controller.enqueue(bmp.slice(0, 1024)); // Never completed
+        },
+      });
+
+      const decoder = new ImageDecoder({
+        data: stream as unknown as BufferSource,
+        type: 'image/bmp',
+      });
+      const pending = decoder.decode();
+      decoder.reset();
+
+      await expect(pending).rejects.toMatchObject({ name: 'AbortError' });
+      decoder.close();
+    });
   });
 
   // Note: Full constructor tests with actual image decoding are in integration tests
@@ -31,6 +31,12 @@ describe('Module Loading', () => {
     expect(typeof AudioEncoder).toBe('function');
   });
 
+  it('should export AudioMixer class', async () => {
+    const { AudioMixer } = await import('@pproenca/node-webcodecs');
+    expect(AudioMixer).toBeDefined();
+    expect(typeof AudioMixer).toBe('function');
+  });
+
   it('should export VideoFrame class', async () => {
     const { VideoFrame } = await import('@pproenca/node-webcodecs');
     expect(VideoFrame).toBeDefined();
@@ -1,5 +1,5 @@
 // test/video-decoder.test.ts
-import { describe, it, expect, beforeEach } from 'vitest';
+import { describe, it, expect, beforeEach, afterEach } from 'vitest';
 import { VideoDecoder } from '@pproenca/node-webcodecs';
 
 describe('VideoDecoder', () => {
@@ -282,6 +282,347 @@ describe('VideoDecoder', () => {
     });
   });
 
+  // Encode a small AVC stream (GOP of 5 frames) to feed decoder tests
+  async function encodeTestStream(width = 64, height = 64, count = 20) {
+    const { VideoEncoder, VideoFrame } = await import('@pproenca/node-webcodecs');
+    const chunks: any[] = [];
+    let decoderConfig: any;
+    const encoder = new VideoEncoder({
+      output: (chunk, metadata) => {
+        chunks.push(chunk);
+        decoderConfig ??= metadata?.decoderConfig;
+      },
+      error: () => {},
+    });
+    encoder.configure({ codec: 'avc1.42E01E', width, height, framerate: 5 });
+    for (let i = 0; i < count; i++) {
+      const frame = new VideoFrame(new Uint8Array(width * height * 1.5).fill(i * 10), {
+        format: 'I420',
+        codedWidth: width,
+        codedHeight: height,
+        timestamp: i * 200000,
+      });
+      encoder.encode(frame, { keyFrame: i === 0 });
+      frame.close();
+    }
+    await encoder.flush();
+    encoder.close();
+    return { chunks, decoderConfig };
+  }
+
+  describe('skipFrames (non-standard)', () => {
+    it('should output only key frames with their timestamps for "nonkey"', async () => {
+      const { chunks, decoderConfig } = await encodeTestStream();
+
+      const keyTimestamps = chunks.filter((c) => c.type === 'key').map((c) => c.timestamp);
+      const outputTimestamps: number[] = [];
+      const decoder = new VideoDecoder({
+        output: (frame: any) => {
+          outputTimestamps.push(frame.timestamp);
+          frame.close();
+        },
+        error: () => {},
+      });
+      decoder.configure({ ...decoderConfig, skipFrames: 'nonkey', skipLoopFilter: true });
+      for (const chunk of chunks) decoder.decode(chunk);
+      await decoder.flush();
+      decoder.close();
+
+      expect(keyTimestamps.length).toBeGreaterThan(1);
+      expect(outputTimestamps).toEqual(keyTimestamps);
+    });
+
+    it('should throw TypeError for invalid skipFrames', () => {
+      const decoder = new VideoDecoder({ output: () => {}, error: () => {} });
+      expect(() => decoder.configure({ codec: 'avc1.42E01E', skipFrames: 'some' as any })).toThrow(
+        TypeError
+      );
+      decoder.close();
+    });
+  });
+
+  describe('outputFormat / outputSize (non-standard)', () => {
+    it('should deliver frames converted and scaled on the worker', async () => {
+      const { chunks, decoderConfig } = await encodeTestStream(64, 64, 5);
+      const frames: Array<{ format: string | null; width: number; height: number; ts: number }> =
+        [];
+      const decoder = new VideoDecoder({
+        output: (frame: any) => {
+          frames.push({
+            format: frame.format,
+            width: frame.codedWidth,
+            height: frame.codedHeight,
+            ts: frame.timestamp,
+          });
+          frame.close();
+        },
+        error: () => {},
+      });
+      decoder.configure({
+        ...decoderConfig,
+        outputFormat: 'RGBA',
+        outputSize: { width: 32, height: 16 },
+      });
+      for (const chunk of chunks) decoder.decode(chunk);
+      await decoder.flush();
+      decoder.close();
+
+      expect(frames.length).toBe(5);
+      for (const [i, frame] of frames.entries()) {
+        expect(frame).toEqual({ format: 'RGBA', width: 32, height: 16, ts: i * 200000 });
+      }
+    });
+
+    it('should throw TypeError for an unknown outputFormat', () => {
+      const decoder = new VideoDecoder({ output: () => {}, error: () => {} });
+      expect(() =>
+        decoder.configure({ codec: 'avc1.42E01E', outputFormat: 'YUYV' as any })
+      ).toThrow(TypeError);
+      decoder.close();
+    });
+  });
+
+  describe('registerOutputBuffers (non-standard)', () => {
+    it('should decode into registered buffers and recycle them on close', async () => {
+      const { chunks, decoderConfig } = await encodeTestStream(64, 64, 10);
+      const buffers = [new Uint8Array(32 * 32 * 4), new Uint8Array(32 * 32 * 4)];
+      let outputs = 0;
+      const decoder = new VideoDecoder({
+        output: (frame: any) => {
+          expect(frame.format).toBe('RGBA');
+          outputs++;
+          frame.close();
+        },
+        error: () => {},
+      });
+      decoder.configure({
+        ...decoderConfig,
+        outputFormat: 'RGBA',
+        outputSize: { width: 32, height: 32 },
+      });
+      decoder.registerOutputBuffers(buffers);
+      for (const chunk of chunks) decoder.decode(chunk);
+      await decoder.flush();
+      decoder.close();
+
+      // Ten frames through two buffers: both were written (opaque alpha)
+      expect(outputs).toBe(10);
+      expect(buffers[0][3]).toBe(255);
+      expect(buffers[1][3]).toBe(255);
+    });
+
+    it('should keep replaced buffers alive for frames still queued', async () => {
+      const { chunks, decoderConfig } = await encodeTestStream(64, 64, 10);
+      const size = 32 * 32 * 4;
+      let first: Uint8Array[] = [new Uint8Array(size), new Uint8Array(size)];
+      const second = [new Uint8Array(size), new Uint8Array(size), new Uint8Array(size)];
+      const copies: Promise<void>[] = [];
+      const alphas: number[] = [];
+      const errors: unknown[] = [];
+      const decoder = new VideoDecoder({
+        output: (frame: any) => {
+          const pixels = new Uint8Array(frame.allocationSize());
+          copies.push(
+            frame.copyTo(pixels).then(() => {
+              alphas.push(pixels[3]);
+              frame.close();
+            })
+          );
+        },
+        error: (e) => errors.push(e),
+      });
+      decoder.configure({
+        ...decoderConfig,
+        outputFormat: 'RGBA',
+        outputSize: { width: 32, height: 32 },
+      });
+      decoder.registerOutputBuffers(first);
+      for (const [i, chunk] of chunks.entries()) {
+        decoder.decode(chunk);
+        if (i === 4) decoder.registerOutputBuffers(second);
+      }
+      // Frames written into the first set may still be queued: drop the
+      // test's own references to it
+      first = [];
+      (globalThis as { gc?: () => void }).gc?.();
+      await decoder.flush();
+
+      decoder.registerOutputBuffers([]);
+      for (const chunk of chunks) decoder.decode(chunk);
+      await decoder.flush();
+      await Promise.all(copies);
+      decoder.close();
+
+      expect(errors).toEqual([]);
+      expect(alphas).toEqual(new Array(20).fill(255));
+      expect(second.some((buffer) => buffer[3] === 255)).toBe(true);
+    });
+
+    it('should keep buffers alive for frames that outlive the decoder', async () => {
+      const { chunks, decoderConfig } = await encodeTestStream(64, 64, 4);
+      const size = 32 * 32 * 4;
+      let buffers: Uint8Array[] = [new Uint8Array(size), new Uint8Array(size)];
+      const frames: any[] = [];
+      const decoder = new VideoDecoder({
+        output: (frame: any) => frames.push(frame),
+        error: () => {},
+      });
+      decoder.configure({
+        ...decoderConfig,
+        outputFormat: 'RGBA',
+        outputSize: { width: 32, height: 32 },
+      });
+      decoder.registerOutputBuffers(buffers);
+      decoder.decode(chunks[0]);
+      await decoder.flush();
+      decoder.close();
+
+      // Only the frame now refers to the registered memory
+      buffers = [];
+      (globalThis as { gc?: () => void }).gc?.();
+      expect(frames).toHaveLength(1);
+      const clone = frames[0].clone();
+      frames[0].close();
+      const pixels = new Uint8Array(clone.allocationSize());
+      await clone.copyTo(pixels);
+      clone.close();
+      expect(pixels[3]).toBe(255);
+    });
+
+    it('should reject detached buffers', () => {
+      const decoder = new VideoDecoder({ output: () => {}, error: () => {} });
+      decoder.configure({
+        codec: 'avc1.42E01E',
+        outputFormat: 'RGBA',
+        outputSize: { width: 32, height: 32 },
+      });
+      const buffer = new ArrayBuffer(32 * 32 * 4);
+      structuredClone(buffer, { transfer: [buffer] });
+      expect(() => decoder.registerOutputBuffers([buffer])).toThrow(/detached/);
+      decoder.close();
+    });
+
+    it('should require outputFormat and outputSize', () => {
+      const decoder = new VideoDecoder({ output: () => {}, error: () => {} });
+      decoder.configure({ codec: 'avc1.42E01E' });
+      expect(() => decoder.registerOutputBuffers([new Uint8Array(1024)])).toThrow(/outputFormat/);
+      decoder.close();
+    });
+
+    it('should reject buffers smaller than one frame', () => {
+      const decoder = new VideoDecoder({ output: () => {}, error: () => {} });
+      decoder.configure({
+        codec: 'avc1.42E01E',
+        outputFormat: 'RGBA',
+        outputSize: { width: 32, height: 32 },
+      });
+      expect(() => decoder.registerOutputBuffers([new Uint8Array(16)])).toThrow(TypeError);
+      decoder.close();
+    });
+  });
+
+  describe('decodeBatch (non-standard)', () => {
+    async function decodeTimestamps(submit: (decoder: VideoDecoder, chunks: any[]) => void) {
+      const { chunks, decoderConfig } = await encodeTestStream(64, 64, 10);
+      const timestamps: number[] = [];
+      const decoder = new VideoDecoder({
+        output: (frame: any) => {
+          timestamps.push(frame.timestamp);
+          frame.close();
+        },
+        error: () => {},
+      });
+      decoder.configure(decoderConfig);
+      submit(decoder, chunks);
+      await decoder.flush();
+      decoder.close();
+      return timestamps;
+    }
+
+    it('should output the same frames as decode() per chunk', async () => {
+      const single = await decodeTimestamps((decoder, chunks) => {
+        for (const chunk of chunks) decoder.decode(chunk);
+      });
+      const batched = await decodeTimestamps((decoder, chunks) => {
+        decoder.decodeBatch(chunks.slice(0, 4));
+        decoder.decodeBatch(chunks.slice(4));
+      });
+      expect(batched).toEqual(single);
+      expect(batched.length).toBe(10);
+    });
+
+    it('should keep chunks before an invalid element queued and throw', async () => {
+      let thrown: unknown;
+      const timestamps = await decodeTimestamps((decoder, chunks) => {
+        try {
+          decoder.decodeBatch([chunks[0], chunks[1], 42 as any, chunks[2]]);
+        } catch (e) {
+          thrown = e;
+        }
+      });
+      expect(thrown).toBeInstanceOf(TypeError);
+      expect(timestamps).toEqual([0, 200000]);
+    });
+
+    it('should require a key chunk first, like decode()', () => {
+      const decoder = new VideoDecoder({ output: () => {}, error: () => {} });
+      decoder.configure({ codec: 'avc1.42E01E' });
+      const delta = { type: 'delta', timestamp: 0, data: new Uint8Array([0, 0, 0, 1]) };
+      expect(() => decoder.decodeBatch([delta as any])).toThrow(/key/i);
+      decoder.close();
+    });
+  });
+
+  describe('codecContextCache (non-standard)', () => {
+    afterEach(() => {
+      VideoDecoder.codecContextCache({ maxEntries: 4 });
+    });
+
+    it('should adopt a warm context when reconfigured with the same config', async () => {
+      const { chunks, decoderConfig } = await encodeTestStream(64, 64, 4);
+      let outputs = 0;
+      const decoder = new VideoDecoder({
+        output: (frame: any) => {
+          outputs++;
+          frame.close();
+        },
+        error: () => {},
+      });
+
+      decoder.configure(decoderConfig);
+      for (const chunk of chunks) decoder.decode(chunk);
+      await decoder.flush();
+      const before = VideoDecoder.codecContextCache();
+
+      decoder.configure(decoderConfig);
+      for (const chunk of chunks) decoder.decode(chunk);
+      await decoder.flush();
+      const after = VideoDecoder.codecContextCache();
+      decoder.close();
+
+      expect(after.hits).toBe(before.hits + 1);
+      expect(outputs).toBe(8);
+    });
+
+    it('should not cache contexts when maxEntries is 0', async () => {
+      const stats = VideoDecoder.codecContextCache({ maxEntries: 0 });
+      expect(stats.maxEntries).toBe(0);
+      expect(stats.entries).toBe(0);
+
+      const { decoderConfig } = await encodeTestStream(64, 64, 1);
+      const decoder = new VideoDecoder({ output: () => {}, error: () => {} });
+      decoder.configure(decoderConfig);
+      await decoder.flush();
+      decoder.close();
+      expect(VideoDecoder.codecContextCache().entries).toBe(0);
+    });
+
+    it('should reject out-of-range maxEntries', () => {
+      expect(() => VideoDecoder.codecContextCache({ maxEntries: -1 })).toThrow(TypeError);
+      expect(() => VideoDecoder.codecContextCache({ maxEntries: 65 })).toThrow(TypeError);
+    });
+  });
+
   describe('Integration: configure → flush → reset cycle', () => {
     it('should complete configure → flush → reset cycle', async () => {
       const decoder = new VideoDecoder({
@@ -651,6 +651,346 @@ describe('VideoEncoder', () => {
     });
   });
 
+  describe('bitrateMode quantizer', () => {
+    // Textured I420 frame so the quantizer visibly affects output size
+    function createTexturedFrameData(width: number, height: number, seed: number): Uint8Array {
+      const data = new Uint8Array(width * height * 1.5);
+      for (let i = 0; i < data.length; i++) {
+        data[i] = (i * 31 + seed * 17 + ((i * i) % 251)) & 0xff;
+      }
+      return data;
+    }
+
+    async function encodeWithQuantizer(quantizer: number): Promise<number> {
+      const { VideoFrame } = await import('@pproenca/node-webcodecs');
+      let bytes = 0;
+      const errors: Error[] = [];
+      const encoder = new VideoEncoder({
+        output: (chunk) => {
+          bytes += chunk.byteLength;
+        },
+        error: (e) => errors.push(e),
+      });
+      encoder.configure({
+        codec: 'avc1.42E01E',
+        width: 128,
+        height: 128,
+        framerate: 30,
+        bitrateMode: 'quantizer',
+      });
+      for (let i = 0; i < 5; i++) {
+        const frame = new VideoFrame(createTexturedFrameData(128, 128, i), {
+          format: 'I420',
+          codedWidth: 128,
+          codedHeight: 128,
+          timestamp: i * 33333,
+        });
+        encoder.encode(frame, { keyFrame: i === 0, avc: { quantizer } });
+        frame.close();
+      }
+      await encoder.flush();
+      encoder.close();
+      expect(errors.length).toBe(0);
+      return bytes;
+    }
+
+    it('should honor the per-frame avc quantizer', async () => {
+      const fine = await encodeWithQuantizer(10);
+      const coarse = await encodeWithQuantizer(45);
+      expect(fine).toBeGreaterThan(coarse * 2);
+    });
+
+    it('should throw TypeError for an out-of-range quantizer', async () => {
+      const { VideoFrame } = await import('@pproenca/node-webcodecs');
+      const encoder = new VideoEncoder({ output: () => {}, error: () => {} });
+      encoder.configure({
+        codec: 'avc1.42E01E',
+        width: 64,
+        height: 64,
+        bitrateMode: 'quantizer',
+      });
+      const frame = new VideoFrame(createTexturedFrameData(64, 64, 0), {
+        format: 'I420',
+        codedWidth: 64,
+        codedHeight: 64,
+        timestamp: 0,
+      });
+      expect(() => encoder.encode(frame, { avc: { quantizer: 52 } })).toThrow(TypeError);
+      frame.close();
+      encoder.close();
+    });
+
+    it('should not support quantizer mode for vp9 and av1', async () => {
+      for (const codec of ['vp09.00.10.08', 'av01.0.04M.08']) {
+        const config = { codec, width: 64, height: 64, bitrateMode: 'quantizer' as const };
+        const support = await VideoEncoder.isConfigSupported(config);
+        expect(support.supported).toBe(false);
+
+        const encoder = new VideoEncoder({ output: () => {}, error: () => {} });
+        expect(() => encoder.configure(config)).toThrow(/not supported/);
+        encoder.close();
+      }
+    });
+  });
+
+  describe('latencyMode and encoderSpeed', () => {
+    it('should emit realtime output in order without waiting for flush', async () => {
+      const { VideoFrame } = await import('@pproenca/node-webcodecs');
+      const timestamps: number[] = [];
+      const errors: Error[] = [];
+      const encoder = new VideoEncoder({
+        output: (chunk) => timestamps.push(chunk.timestamp),
+        error: (e) => errors.push(e),
+      });
+      encoder.configure({
+        codec: 'avc1.42E01E',
+        width: 64,
+        height: 64,
+        framerate: 30,
+        latencyMode: 'realtime',
+        encoderSpeed: 10,
+      });
+
+      const total = 10;
+      for (let i = 0; i < total; i++) {
+        const data = new Uint8Array(64 * 64 * 1.5).fill(i * 10);
+        const frame = new VideoFrame(data, {
+          format: 'I420',
+          codedWidth: 64,
+          codedHeight: 64,
+          timestamp: i * 33333,
+        });
+        encoder.encode(frame, { keyFrame: i === 0 });
+        frame.close();
+      }
+
+      // No lookahead: chunks arrive while the encoder is still open
+      for (let i = 0; i < 200 && timestamps.length === 0; i++) {
+        await new Promise((resolve) => setTimeout(resolve, 10));
+      }
+      expect(timestamps.length).toBeGreaterThan(0);
+
+      // No B-frames: chunks come out in presentation order
+      await encoder.flush();
+      encoder.close();
+      expect(errors.length).toBe(0);
+      expect(timestamps).toEqual(Array.from({ length: total }, (_, i) => i * 33333));
+    });
+
+    it('should reject an out-of-range encoderSpeed', async () => {
+      const config = { codec: 'avc1.42E01E', width: 64, height: 64, encoderSpeed: 11 };
+      const negative = { ...config, encoderSpeed: -1 };
+      await expect(VideoEncoder.isConfigSupported(config)).rejects.toThrow(TypeError);
+      await expect(VideoEncoder.isConfigSupported(negative)).rejects.toThrow(TypeError);
+
+      const encoder = new VideoEncoder({ output: () => {}, error: () => {} });
+      expect(() => encoder.configure(config)).toThrow(TypeError);
+      encoder.close();
+    });
+
+    it('should echo a valid encoderSpeed from isConfigSupported', async () => {
+      const support = await VideoEncoder.isConfigSupported({
+        codec: 'avc1.42E01E',
+        width: 64,
+        height: 64,
+        encoderSpeed: 5,
+      });
+      expect((support.config as { encoderSpeed?: number }).encoderSpeed).toBe(5);
+    });
+  });
+
+  describe('frameDropPolicy', () => {
+    it('should account for every frame as encoded or dropped', async () => {
+      const { VideoFrame } = await import('@pproenca/node-webcodecs');
+      const timestamps: number[] = [];
+      const encoder = new VideoEncoder({
+        output: (chunk) => timestamps.push(chunk.timestamp),
+        error: () => {},
+      });
+      encoder.configure({
+        codec: 'avc1.42E01E',
+        width: 640,
+        height: 480,
+        framerate: 30,
+        latencyMode: 'realtime',
+        frameDropPolicy: { maxQueueSize: 2, dropWhenLate: true },
+      });
+
+      const total = 30;
+      const data = new Uint8Array(640 * 480 * 1.5).fill(128);
+      for (let i = 0; i < total; i++) {
+        const frame = new VideoFrame(data, {
+          format: 'I420',
+          codedWidth: 640,
+          codedHeight: 480,
+          timestamp: i * 33333,
+        });
+        encoder.encode(frame, { keyFrame: i === 0 });
+        frame.close();
+        expect(encoder.encodeQueueSize).toBeLessThanOrEqual(3);
+      }
+      await encoder.flush();
+
+      const stats = encoder.stats;
+      expect(stats.encodedFrames + stats.droppedFrames).toBe(total);
+      expect(stats.droppedFrames).toBe(stats.droppedFramesQueue + stats.droppedFramesLate);
+      // Surviving frames keep their original timestamps
+      expect(timestamps.length).toBe(stats.encodedFrames);
+      expect(timestamps[0]).toBe(0);
+      for (const ts of timestamps) {
+        expect(ts % 33333).toBe(0);
+      }
+      encoder.close();
+    });
+
+    it('should throw TypeError for maxQueueSize below 1', () => {
+      const encoder = new VideoEncoder({ output: () => {}, error: () => {} });
+      expect(() =>
+        encoder.configure({
+          codec: 'avc1.42E01E',
+          width: 64,
+          height: 64,
+          frameDropPolicy: { maxQueueSize: 0 },
+        })
+      ).toThrow(TypeError);
+      encoder.close();
+    });
+  });
+
+  describe('parallelSegments', () => {
+    it('should stitch segments in order with a single decoderConfig', async () => {
+      const { VideoFrame } = await import('@pproenca/node-webcodecs');
+      const chunks: Array<{ type: string; timestamp: number }> = [];
+      let decoderConfigs = 0;
+      const errors: Error[] = [];
+      const encoder = new VideoEncoder({
+        output: (chunk, metadata) => {
+          chunks.push({ type: chunk.type, timestamp: chunk.timestamp });
+          if (metadata?.decoderConfig) decoderConfigs++;
+        },
+        error: (e) => errors.push(e),
+      });
+      encoder.configure({
+        codec: 'avc1.42E01E',
+        width: 64,
+        height: 64,
+        framerate: 10,
+        parallelSegments: 3,
+      });
+
+      const total = 45; // 4.5 segments of 10 frames
+      for (let i = 0; i < total; i++) {
+        const data = new Uint8Array(64 * 64 * 1.5).fill(i * 5);
+        const frame = new VideoFrame(data, {
+          format: 'I420',
+          codedWidth: 64,
+          codedHeight: 64,
+          timestamp: i * 100000,
+        });
+        encoder.encode(frame, { keyFrame: i === 0 });
+        frame.close();
+      }
+      await encoder.flush();
+      encoder.close();
+
+      expect(errors.length).toBe(0);
+      expect(decoderConfigs).toBe(1);
+      expect(chunks.length).toBe(total);
+      expect(chunks[0].type).toBe('key');
+
+      // H.264 may reorder frames inside a GOP, but segments (one GOP of
+      // `framerate` frames each) must come out whole and in order
+      const segmentOf = (c: { timestamp: number }) => Math.floor(c.timestamp / 1000000);
+      const segments = chunks.map(segmentOf);
+      for (let i = 1; i < segments.length; i++) {
+        expect(segments[i]).toBeGreaterThanOrEqual(segments[i - 1]);
+        if (segments[i] !== segments[i - 1]) expect(chunks[i].type).toBe('key');
+      }
+      const keyTimestamps = chunks.filter((c) => c.type === 'key').map((c) => c.timestamp);
+      expect(keyTimestamps.length).toBeGreaterThanOrEqual(5);
+      for (let i = 1; i < keyTimestamps.length; i++) {
+        expect(keyTimestamps[i]).toBeGreaterThan(keyTimestamps[i - 1]);
+      }
+      for (let segment = 0; segment < 5; segment++) {
+        const timestamps = chunks
+          .filter((c) => segmentOf(c) === segment)
+          .map((c) => c.timestamp)
+          .sort((a, b) => a - b);
+        const first = segment * 10;
+        const count = Math.min(10, total - first);
+        expect(timestamps).toEqual(Array.from({ length: count }, (_, i) => (first + i) * 100000));
+      }
+    });
+
+    it('should reject parallelSegments with realtime latencyMode', () => {
+      const encoder = new VideoEncoder({ output: () => {}, error: () => {} });
+      expect(() =>
+        encoder.configure({
+          codec: 'avc1.42E01E',
+          width: 64,
+          height: 64,
+          latencyMode: 'realtime',
+          parallelSegments: 2,
+        })
+      ).toThrow(TypeError);
+      encoder.close();
+    });
+  });
+
+  describe('encodeBatch (non-standard)', () => {
+    it('should encode every frame in order with per-frame options', async () => {
+      const { VideoFrame } = await import('@pproenca/node-webcodecs');
+      const chunks: Array<{ type: string; timestamp: number }> = [];
+      const encoder = new VideoEncoder({
+        output: (chunk) => chunks.push({ type: chunk.type, timestamp: chunk.timestamp }),
+        error: () => {},
+      });
+      encoder.configure({ codec: 'avc1.42E01E', width: 64, height: 64, framerate: 30 });
+
+      const frames = Array.from(
+        { length: 6 },
+        (_, i) =>
+          new VideoFrame(new Uint8Array(64 * 64 * 1.5).fill(i * 20), {
+            format: 'I420',
+            codedWidth: 64,
+            codedHeight: 64,
+            timestamp: i * 33333,
+          })
+      );
+      encoder.encodeBatch(frames, frames.map((_, i) => ({ keyFrame: i === 0 || i === 3 })));
+      expect(encoder.encodeQueueSize).toBeLessThanOrEqual(6);
+      for (const frame of frames) frame.close();
+      await encoder.flush();
+      encoder.close();
+
+      expect(chunks.map((c) => c.timestamp)).toEqual(frames.map((_, i) => i * 33333));
+      expect(chunks[0].type).toBe('key');
+      expect(chunks[3].type).toBe('key');
+    });
+
+    it('should throw for a closed frame after queueing the ones before it', async () => {
+      const { VideoFrame } = await import('@pproenca/node-webcodecs');
+      let outputs = 0;
+      const encoder = new VideoEncoder({ output: () => outputs++, error: () => {} });
+      encoder.configure({ codec: 'avc1.42E01E', width: 64, height: 64 });
+      const make = (i: number) =>
+        new VideoFrame(new Uint8Array(64 * 64 * 1.5), {
+          format: 'I420',
+          codedWidth: 64,
+          codedHeight: 64,
+          timestamp: i * 33333,
+        });
+      const good = make(0);
+      const closed = make(1);
+      closed.close();
+      expect(() => encoder.encodeBatch([good, closed], { keyFrame: true })).toThrow(TypeError);
+      good.close();
+      await encoder.flush();
+      encoder.close();
+      expect(outputs).toBe(1);
+    });
+  });
+
   describe('Integration: configure → flush → reset cycle', () => {
     it('should complete configure → flush → reset cycle', async () => {
       const encoder = new VideoEncoder({
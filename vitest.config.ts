@@ -11,6 +11,9 @@ export default defineConfig({
     // Native addons require sequential file execution to avoid race conditions
     // with static constructor references (EncodedAudioChunk::constructor, etc.)
     fileParallelism: false,
+    benchmark: {
+      include: ['bench/**/*.bench.ts'],
+    },
     coverage: {
       provider: 'v8',
       reporter: ['text', 'json', 'html'],